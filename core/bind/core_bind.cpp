@@ -1194,7 +1194,7 @@ Error _File::open_encrypted(const String &p_path, ModeFlags p_mode_flags, const
 	}
 
 	FileAccessEncrypted *fae = memnew(FileAccessEncrypted);
-	err = fae->open_and_parse(f, p_key, (p_mode_flags == WRITE) ? FileAccessEncrypted::MODE_WRITE_AES256 : FileAccessEncrypted::MODE_READ);
+	err = fae->open_and_parse(f, p_key, (p_mode_flags == WRITE) ? FileAccessEncrypted::MODE_WRITE_AES256_BLOCKS : FileAccessEncrypted::MODE_READ);
 	if (err) {
 		memdelete(fae);
 		close();
@@ -1211,7 +1211,7 @@ Error _File::open_encrypted_pass(const String &p_path, ModeFlags p_mode_flags, c
 	}
 
 	FileAccessEncrypted *fae = memnew(FileAccessEncrypted);
-	err = fae->open_and_parse_password(f, p_pass, (p_mode_flags == WRITE) ? FileAccessEncrypted::MODE_WRITE_AES256 : FileAccessEncrypted::MODE_READ);
+	err = fae->open_and_parse_password(f, p_pass, (p_mode_flags == WRITE) ? FileAccessEncrypted::MODE_WRITE_AES256_BLOCKS : FileAccessEncrypted::MODE_READ);
 	if (err) {
 		memdelete(fae);
 		close();
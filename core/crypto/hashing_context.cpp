@@ -31,6 +31,14 @@
 #include "hashing_context.h"
 
 #include "core/crypto/crypto_core.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+#include "core/thread_work_pool.h"
+
+#ifndef NO_THREADS
+ThreadWorkPool *HashingContext::work_pool = nullptr;
+Mutex HashingContext::work_pool_mutex;
+#endif
 
 Error HashingContext::start(HashType p_type) {
 	ERR_FAIL_COND_V(ctx != nullptr, ERR_ALREADY_IN_USE);
@@ -86,6 +94,99 @@ PackedByteArray HashingContext::finish() {
 	return out;
 }
 
+template <class T>
+static Error _hash_file_stream(FileAccess *p_file, PackedByteArray &r_hash) {
+	T ctx;
+	Error err = ctx.start();
+	ERR_FAIL_COND_V(err != OK, err);
+
+	const int chunk_size = 65536;
+	Vector<uint8_t> chunk;
+	chunk.resize(chunk_size);
+	while (true) {
+		int read = p_file->get_buffer(chunk.ptrw(), chunk_size);
+		if (read <= 0) {
+			break;
+		}
+		err = ctx.update(chunk.ptr(), read);
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+	return ctx.finish(r_hash.ptrw());
+}
+
+void HashingContext::_hash_file(uint32_t p_index, HashFilesData *p_data) {
+	FileAccess *f = FileAccess::open(p_data->paths[p_index], FileAccess::READ);
+	if (!f) {
+		return;
+	}
+
+	// Each file gets its own context, so workers never share state.
+	PackedByteArray hash;
+	Error err = FAILED;
+	switch (p_data->type) {
+		case HASH_MD5:
+			hash.resize(16);
+			err = _hash_file_stream<CryptoCore::MD5Context>(f, hash);
+			break;
+		case HASH_SHA1:
+			hash.resize(20);
+			err = _hash_file_stream<CryptoCore::SHA1Context>(f, hash);
+			break;
+		case HASH_SHA256:
+			hash.resize(32);
+			err = _hash_file_stream<CryptoCore::SHA256Context>(f, hash);
+			break;
+	}
+	memdelete(f);
+
+	if (err == OK) {
+		p_data->results.write[p_index] = hash;
+	}
+}
+
+Array HashingContext::hash_files(HashType p_type, const PackedStringArray &p_paths) {
+	ERR_FAIL_INDEX_V(p_type, HASH_SHA256 + 1, Array());
+
+	HashFilesData data;
+	data.type = p_type;
+	data.paths = p_paths;
+	data.results.resize(p_paths.size());
+
+#ifndef NO_THREADS
+	if (p_paths.size() >= HASH_FILES_THREAD_THRESHOLD) {
+		MutexLock lock(work_pool_mutex);
+		if (!work_pool) {
+			work_pool = memnew(ThreadWorkPool);
+			work_pool->init(OS::get_singleton()->get_processor_count());
+		}
+		work_pool->do_work(p_paths.size(), this, &HashingContext::_hash_file, &data);
+	} else
+#endif
+	{
+		for (int i = 0; i < p_paths.size(); i++) {
+			_hash_file(i, &data);
+		}
+	}
+
+	Array ret;
+	ret.resize(data.results.size());
+	for (int i = 0; i < data.results.size(); i++) {
+		ret[i] = data.results[i];
+	}
+	return ret;
+}
+
+void HashingContext::finish_work_pool() {
+#ifndef NO_THREADS
+	MutexLock lock(work_pool_mutex);
+	if (work_pool) {
+		work_pool->finish();
+		memdelete(work_pool);
+		work_pool = nullptr;
+	}
+#endif
+}
+
 void HashingContext::_create_ctx(HashType p_type) {
 	type = p_type;
 	switch (type) {
@@ -122,6 +223,7 @@ void HashingContext::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("start", "type"), &HashingContext::start);
 	ClassDB::bind_method(D_METHOD("update", "chunk"), &HashingContext::update);
 	ClassDB::bind_method(D_METHOD("finish"), &HashingContext::finish);
+	ClassDB::bind_method(D_METHOD("hash_files", "type", "paths"), &HashingContext::hash_files);
 	BIND_ENUM_CONSTANT(HASH_MD5);
 	BIND_ENUM_CONSTANT(HASH_SHA1);
 	BIND_ENUM_CONSTANT(HASH_SHA256);
@@ -31,8 +31,11 @@
 #ifndef HASHING_CONTEXT_H
 #define HASHING_CONTEXT_H
 
+#include "core/os/mutex.h"
 #include "core/reference.h"
 
+class ThreadWorkPool;
+
 class HashingContext : public Reference {
 	GDCLASS(HashingContext, Reference);
 
@@ -47,6 +50,24 @@ private:
 	void *ctx = nullptr;
 	HashType type;
 
+	struct HashFilesData {
+		HashType type;
+		Vector<String> paths;
+		Vector<PackedByteArray> results;
+	};
+
+	enum {
+		HASH_FILES_THREAD_THRESHOLD = 4, // Fewer files are hashed on the calling thread.
+	};
+
+#ifndef NO_THREADS
+	// Shared by all the contexts, calls to hash_files() take turns using it.
+	static ThreadWorkPool *work_pool;
+	static Mutex work_pool_mutex;
+#endif
+
+	void _hash_file(uint32_t p_index, HashFilesData *p_data);
+
 protected:
 	static void _bind_methods();
 	void _create_ctx(HashType p_type);
@@ -57,6 +78,10 @@ public:
 	Error update(PackedByteArray p_chunk);
 	PackedByteArray finish();
 
+	Array hash_files(HashType p_type, const PackedStringArray &p_paths);
+
+	static void finish_work_pool();
+
 	HashingContext() {}
 	~HashingContext();
 };
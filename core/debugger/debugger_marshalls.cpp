@@ -113,6 +113,56 @@ bool DebuggerMarshalls::NetworkProfilerFrame::deserialize(const Array &p_arr) {
 	return true;
 }
 
+#define RPC_INFO_SIZE 12
+
+Array DebuggerMarshalls::NetworkRPCProfilerFrame::serialize() {
+	Array arr;
+	arr.push_back(infos.size() * RPC_INFO_SIZE);
+	for (int i = 0; i < infos.size(); ++i) {
+		const MultiplayerRPCInfo &info = infos[i];
+		arr.push_back(uint64_t(info.node));
+		arr.push_back(info.node_path);
+		arr.push_back(info.name);
+		arr.push_back(info.rset);
+		arr.push_back(info.incoming_calls);
+		arr.push_back(info.incoming_bytes);
+		arr.push_back(info.decode_usec);
+		arr.push_back(info.outgoing_calls);
+		arr.push_back(info.outgoing_bytes);
+		arr.push_back(info.encode_usec);
+		arr.push_back(info.unreliable_calls);
+		arr.push_back(info.peers);
+	}
+	return arr;
+}
+
+bool DebuggerMarshalls::NetworkRPCProfilerFrame::deserialize(const Array &p_arr) {
+	CHECK_SIZE(p_arr, 1, "NetworkRPCProfilerFrame");
+	uint32_t size = p_arr[0];
+	ERR_FAIL_COND_V(size % RPC_INFO_SIZE, false);
+	CHECK_SIZE(p_arr, size + 1, "NetworkRPCProfilerFrame");
+	infos.resize(size / RPC_INFO_SIZE);
+	int idx = 1;
+	for (int i = 0; i < infos.size(); ++i) {
+		MultiplayerRPCInfo &info = infos.write[i];
+		info.node = uint64_t(p_arr[idx]);
+		info.node_path = p_arr[idx + 1];
+		info.name = p_arr[idx + 2];
+		info.rset = p_arr[idx + 3];
+		info.incoming_calls = p_arr[idx + 4];
+		info.incoming_bytes = p_arr[idx + 5];
+		info.decode_usec = p_arr[idx + 6];
+		info.outgoing_calls = p_arr[idx + 7];
+		info.outgoing_bytes = p_arr[idx + 8];
+		info.encode_usec = p_arr[idx + 9];
+		info.unreliable_calls = p_arr[idx + 10];
+		info.peers = p_arr[idx + 11];
+		idx += RPC_INFO_SIZE;
+	}
+	CHECK_END(p_arr, idx, "NetworkRPCProfilerFrame");
+	return true;
+}
+
 Array DebuggerMarshalls::ServersProfilerFrame::serialize() {
 	Array arr;
 	arr.push_back(frame_number);
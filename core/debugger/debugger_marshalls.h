@@ -69,6 +69,28 @@ struct DebuggerMarshalls {
 		bool deserialize(const Array &p_arr);
 	};
 
+	struct MultiplayerRPCInfo {
+		ObjectID node;
+		String node_path;
+		String name;
+		bool rset = false;
+		int incoming_calls = 0;
+		int incoming_bytes = 0;
+		uint64_t decode_usec = 0;
+		int outgoing_calls = 0;
+		int outgoing_bytes = 0;
+		uint64_t encode_usec = 0;
+		int unreliable_calls = 0;
+		Vector<int> peers;
+	};
+
+	struct NetworkRPCProfilerFrame {
+		Vector<MultiplayerRPCInfo> infos;
+
+		Array serialize();
+		bool deserialize(const Array &p_arr);
+	};
+
 	// Script Profiler
 	class ScriptFunctionSignature {
 	public:
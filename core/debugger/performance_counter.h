@@ -0,0 +1,70 @@
+/*************************************************************************/
+/*  performance_counter.h                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef PERFORMANCE_COUNTER_H
+#define PERFORMANCE_COUNTER_H
+
+#include "core/typedefs.h"
+
+#include <atomic>
+
+// A named engine counter that the Performance singleton samples every frame.
+//
+// Counters are meant to be defined at namespace scope, they register themselves
+// during static initialization and live until the process exits. Updating one
+// is a single relaxed atomic operation, so it's fine from any thread. Per-frame
+// counters are reset each time they are sampled, the others act as gauges.
+class PerformanceCounter {
+	static PerformanceCounter *first;
+
+	PerformanceCounter *next = nullptr;
+	const char *name;
+	bool per_frame;
+	std::atomic<int64_t> value;
+	int64_t last = 0;
+
+public:
+	_FORCE_INLINE_ void add(int64_t p_amount = 1) { value.fetch_add(p_amount, std::memory_order_relaxed); }
+	_FORCE_INLINE_ void set(int64_t p_value) { value.store(p_value, std::memory_order_relaxed); }
+
+	// Value as of the last sample(), callers synchronize with the sampling thread.
+	int64_t get_last() const { return last; }
+	int64_t sample();
+
+	const char *get_name() const { return name; }
+	bool is_per_frame() const { return per_frame; }
+
+	static PerformanceCounter *get_first() { return first; }
+	PerformanceCounter *get_next() const { return next; }
+
+	PerformanceCounter(const char *p_name, bool p_per_frame);
+};
+
+#endif // PERFORMANCE_COUNTER_H
@@ -59,6 +59,7 @@ void RemoteDebugger::_bind_profiler(const String &p_name, T *p_prof) {
 struct RemoteDebugger::NetworkProfiler {
 public:
 	typedef DebuggerMarshalls::MultiplayerNodeInfo NodeInfo;
+	typedef DebuggerMarshalls::MultiplayerRPCInfo RPCInfo;
 	struct BandwidthFrame {
 		uint32_t timestamp;
 		int packet_size;
@@ -71,6 +72,7 @@ public:
 	uint64_t last_bandwidth_time = 0;
 
 	Map<ObjectID, NodeInfo> multiplayer_node_data;
+	Map<String, RPCInfo> multiplayer_rpc_data; // Keyed by node, method and kind.
 	uint64_t last_profile_time = 0;
 
 	NetworkProfiler() {}
@@ -110,6 +112,7 @@ public:
 
 	void toggle(bool p_enable, const Array &p_opts) {
 		multiplayer_node_data.clear();
+		multiplayer_rpc_data.clear();
 
 		if (!p_enable) {
 			bandwidth_in.clear();
@@ -137,15 +140,52 @@ public:
 			const String what = p_data[2];
 			init_node(id);
 			NodeInfo &info = multiplayer_node_data[id];
-			if (what == "rpc_in") {
+			if (what == "in_rpc") {
 				info.incoming_rpc++;
-			} else if (what == "rpc_out") {
+			} else if (what == "out_rpc") {
 				info.outgoing_rpc++;
-			} else if (what == "rset_in") {
-				info.incoming_rset = 0;
-			} else if (what == "rset_out") {
+			} else if (what == "in_rset") {
+				info.incoming_rset++;
+			} else if (what == "out_rset") {
 				info.outgoing_rset++;
 			}
+		} else if (type == "rpc") {
+			ERR_FAIL_COND(p_data.size() < 9);
+			const ObjectID id = p_data[1];
+			const String name = p_data[2];
+			const bool rset = p_data[3];
+			const bool incoming = p_data[4];
+			const int peer = p_data[5];
+			const bool unreliable = p_data[6];
+			const int bytes = p_data[7];
+			const uint64_t usec = p_data[8];
+
+			const String key = itos(uint64_t(id)) + "/" + name + (rset ? "/rset" : "/rpc");
+			if (!multiplayer_rpc_data.has(key)) {
+				Node *node = Object::cast_to<Node>(ObjectDB::get_instance(id));
+				RPCInfo info;
+				info.node = id;
+				info.node_path = node ? String(node->get_path()) : String();
+				info.name = name;
+				info.rset = rset;
+				multiplayer_rpc_data.insert(key, info);
+			}
+			RPCInfo &info = multiplayer_rpc_data[key];
+			if (incoming) {
+				info.incoming_calls++;
+				info.incoming_bytes += bytes;
+				info.decode_usec += usec;
+			} else {
+				info.outgoing_calls++;
+				info.outgoing_bytes += bytes;
+				info.encode_usec += usec;
+				if (unreliable) {
+					info.unreliable_calls++;
+				}
+			}
+			if (info.peers.find(peer) == -1) {
+				info.peers.push_back(peer);
+			}
 		} else if (type == "bandwidth") {
 			ERR_FAIL_COND(p_data.size() < 4);
 			const String inout = p_data[1];
@@ -183,6 +223,15 @@ public:
 			}
 			multiplayer_node_data.clear();
 			EngineDebugger::get_singleton()->send_message("network:profile_frame", frame.serialize());
+
+			if (!multiplayer_rpc_data.empty()) {
+				DebuggerMarshalls::NetworkRPCProfilerFrame rpc_frame;
+				for (Map<String, RPCInfo>::Element *E = multiplayer_rpc_data.front(); E; E = E->next()) {
+					rpc_frame.infos.push_back(E->get());
+				}
+				multiplayer_rpc_data.clear();
+				EngineDebugger::get_singleton()->send_message("network:rpc_profile_frame", rpc_frame.serialize());
+			}
 		}
 	}
 };
@@ -0,0 +1,178 @@
+/*************************************************************************/
+/*  trace_profiler.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "trace_profiler.h"
+
+#include "core/hash_map.h"
+#include "core/os/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/os.h"
+
+struct TraceProfiler::ThreadBuffer {
+	Event events[THREAD_BUFFER_SIZE];
+	std::atomic<uint64_t> count; // Zones ever recorded, only written by the owning thread.
+	int tid = 0;
+	String name;
+	ThreadBuffer *next = nullptr;
+};
+
+std::atomic<bool> TraceProfiler::active(false);
+thread_local TraceProfiler::ThreadBuffer *TraceProfiler::thread_buffer = nullptr;
+TraceProfiler::ThreadBuffer *TraceProfiler::buffers = nullptr;
+
+// Guards the buffer list, thread names and interned names, never taken when recording a zone.
+static Mutex trace_mutex;
+static HashMap<String, CharString> trace_names;
+static int trace_thread_count = 0;
+
+uint64_t TraceProfiler::_get_ticks() {
+	return OS::get_singleton()->get_ticks_usec();
+}
+
+TraceProfiler::ThreadBuffer *TraceProfiler::_create_thread_buffer() {
+	ThreadBuffer *tb = memnew(ThreadBuffer);
+	tb->count.store(0);
+
+	MutexLock lock(trace_mutex);
+	tb->tid = ++trace_thread_count;
+	tb->next = buffers;
+	buffers = tb;
+	thread_buffer = tb;
+	return tb;
+}
+
+void TraceProfiler::record(const char *p_name, uint64_t p_begin, uint64_t p_end) {
+	ThreadBuffer *tb = thread_buffer;
+	if (unlikely(!tb)) {
+		tb = _create_thread_buffer();
+	}
+
+	const uint64_t index = tb->count.load(std::memory_order_relaxed);
+	Event &e = tb->events[index & (THREAD_BUFFER_SIZE - 1)];
+	e.name = p_name;
+	e.begin = p_begin;
+	e.end = p_end;
+	tb->count.store(index + 1, std::memory_order_release);
+}
+
+const char *TraceProfiler::intern(const String &p_name) {
+	MutexLock lock(trace_mutex);
+	CharString *cs = trace_names.getptr(p_name);
+	if (!cs) {
+		trace_names[p_name] = p_name.utf8();
+		cs = trace_names.getptr(p_name);
+	}
+	return cs->get_data();
+}
+
+void TraceProfiler::set_thread_name(const String &p_name) {
+	ThreadBuffer *tb = thread_buffer;
+	if (!tb) {
+		tb = _create_thread_buffer();
+	}
+
+	MutexLock lock(trace_mutex);
+	tb->name = p_name;
+}
+
+void TraceProfiler::start() {
+	active.store(true);
+}
+
+void TraceProfiler::stop() {
+	active.store(false);
+}
+
+void TraceProfiler::clear() {
+	ERR_FAIL_COND_MSG(is_active(), "Can't clear the trace while recording.");
+
+	MutexLock lock(trace_mutex);
+	for (ThreadBuffer *tb = buffers; tb; tb = tb->next) {
+		tb->count.store(0);
+	}
+}
+
+Error TraceProfiler::save_chrome_trace(const String &p_path) {
+	Error err;
+	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(!f, err, "Cannot open file '" + p_path + "' to save the trace.");
+
+	const String pid = itos(OS::get_singleton()->get_process_id());
+	HashMap<uint64_t, String> escaped_names; // Keyed by name pointer, most zones share a few literals.
+
+	MutexLock lock(trace_mutex);
+
+	f->store_string("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	String chunk;
+	bool first = true;
+	for (ThreadBuffer *tb = buffers; tb; tb = tb->next) {
+		const String tid = itos(tb->tid);
+		const String thread_name = tb->name.empty() ? "Thread " + tid : tb->name;
+		chunk += String(first ? "" : ",\n") + "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":" + tid + ",\"args\":{\"name\":\"" + thread_name.json_escape() + "\"}}";
+		first = false;
+
+		const uint64_t count = tb->count.load(std::memory_order_acquire);
+		const uint64_t from = count > THREAD_BUFFER_SIZE ? count - THREAD_BUFFER_SIZE : 0;
+		for (uint64_t i = from; i < count; i++) {
+			const Event &e = tb->events[i & (THREAD_BUFFER_SIZE - 1)];
+
+			String *name = escaped_names.getptr((uint64_t)e.name);
+			if (!name) {
+				escaped_names[(uint64_t)e.name] = String::utf8(e.name).json_escape();
+				name = escaped_names.getptr((uint64_t)e.name);
+			}
+
+			chunk += ",\n{\"name\":\"" + *name + "\",\"ph\":\"X\",\"pid\":" + pid + ",\"tid\":" + tid + ",\"ts\":" + itos(e.begin) + ",\"dur\":" + itos(e.end - e.begin) + "}";
+			if (chunk.length() > 65536) {
+				f->store_string(chunk);
+				chunk = String();
+			}
+		}
+	}
+	chunk += "\n]}\n";
+	f->store_string(chunk);
+
+	f->close();
+	memdelete(f);
+	return OK;
+}
+
+void TraceProfiler::finalize() {
+	stop();
+
+	MutexLock lock(trace_mutex);
+	while (buffers) {
+		ThreadBuffer *tb = buffers;
+		buffers = tb->next;
+		memdelete(tb);
+	}
+	thread_buffer = nullptr;
+	trace_names.clear();
+}
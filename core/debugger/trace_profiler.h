@@ -0,0 +1,111 @@
+/*************************************************************************/
+/*  trace_profiler.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TRACE_PROFILER_H
+#define TRACE_PROFILER_H
+
+#include "core/error_list.h"
+#include "core/typedefs.h"
+
+#include <atomic>
+
+class String;
+
+// Scoped-zone instrumentation for finding where a slow frame went.
+//
+// Zones are recorded into a per-thread ring buffer without taking any lock,
+// and only while recording is active. Build with trace_profiler=no to remove
+// them entirely. Recorded zones can be saved as a Chrome trace (JSON), which
+// chrome://tracing and Perfetto can open.
+class TraceProfiler {
+public:
+	enum {
+		THREAD_BUFFER_SIZE = 1 << 16, // Zones kept per thread, the oldest ones are overwritten.
+	};
+
+	struct Event {
+		const char *name;
+		uint64_t begin;
+		uint64_t end;
+	};
+
+private:
+	struct ThreadBuffer;
+
+	static std::atomic<bool> active;
+	static thread_local ThreadBuffer *thread_buffer;
+	static ThreadBuffer *buffers;
+
+	static ThreadBuffer *_create_thread_buffer();
+	static uint64_t _get_ticks();
+
+public:
+	class Zone {
+		const char *name = nullptr;
+		uint64_t begin = 0;
+
+	public:
+		_FORCE_INLINE_ explicit Zone(const char *p_name) {
+			if (unlikely(active.load(std::memory_order_relaxed))) {
+				name = p_name;
+				begin = _get_ticks();
+			}
+		}
+
+		_FORCE_INLINE_ ~Zone() {
+			if (unlikely(name != nullptr)) {
+				record(name, begin, _get_ticks());
+			}
+		}
+	};
+
+	// p_name must outlive the recording, use intern() for names that aren't literals.
+	static void record(const char *p_name, uint64_t p_begin, uint64_t p_end);
+	static const char *intern(const String &p_name);
+	static void set_thread_name(const String &p_name);
+
+	static void start();
+	static void stop();
+	static bool is_active() { return active.load(std::memory_order_relaxed); }
+	static void clear();
+	static Error save_chrome_trace(const String &p_path);
+
+	static void finalize();
+};
+
+#ifdef TRACE_PROFILER_ENABLED
+#define _TRACE_ZONE_CONCAT_IMPL(m_a, m_b) m_a##m_b
+#define _TRACE_ZONE_CONCAT(m_a, m_b) _TRACE_ZONE_CONCAT_IMPL(m_a, m_b)
+#define TRACE_ZONE(m_name) TraceProfiler::Zone _TRACE_ZONE_CONCAT(_trace_zone_, __LINE__)(m_name)
+#else
+#define TRACE_ZONE(m_name)
+#endif
+
+#endif // TRACE_PROFILER_H
@@ -150,7 +150,7 @@ Error ConfigFile::save_encrypted(const String &p_path, const Vector<uint8_t> &p_
 	}
 
 	FileAccessEncrypted *fae = memnew(FileAccessEncrypted);
-	err = fae->open_and_parse(f, p_key, FileAccessEncrypted::MODE_WRITE_AES256);
+	err = fae->open_and_parse(f, p_key, FileAccessEncrypted::MODE_WRITE_AES256_BLOCKS);
 	if (err) {
 		memdelete(fae);
 		memdelete(f);
@@ -168,7 +168,7 @@ Error ConfigFile::save_encrypted_pass(const String &p_path, const String &p_pass
 	}
 
 	FileAccessEncrypted *fae = memnew(FileAccessEncrypted);
-	err = fae->open_and_parse_password(f, p_pass, FileAccessEncrypted::MODE_WRITE_AES256);
+	err = fae->open_and_parse_password(f, p_pass, FileAccessEncrypted::MODE_WRITE_AES256_BLOCKS);
 	if (err) {
 		memdelete(fae);
 		memdelete(f);
@@ -30,13 +30,16 @@
 
 #include "file_access_encrypted.h"
 
-#include "core/crypto/crypto_core.h"
+#include "core/io/marshalls.h"
 #include "core/os/copymem.h"
+#include "core/os/os.h"
 #include "core/print_string.h"
 #include "core/variant.h"
 
 #include <stdio.h>
 
+#include <atomic>
+
 #define COMP_MAGIC 0x43454447
 
 Error FileAccessEncrypted::open_and_parse(FileAccess *p_base, const Vector<uint8_t> &p_key, Mode p_mode) {
@@ -45,8 +48,22 @@ Error FileAccessEncrypted::open_and_parse(FileAccess *p_base, const Vector<uint8
 
 	pos = 0;
 	eofed = false;
+	streaming = false;
+	corrupt = false;
+	block.clear();
+	block_index = -1;
+
+	// Blocks are authenticated with a key derived from the encryption key, never with the key itself.
+	{
+		CryptoCore::SHA256Context sha;
+		sha.start();
+		sha.update(p_key.ptr(), p_key.size());
+		static const char *mac_tag = "FileAccessEncrypted block MAC";
+		sha.update((const uint8_t *)mac_tag, strlen(mac_tag));
+		sha.finish(mac_key);
+	}
 
-	if (p_mode == MODE_WRITE_AES256) {
+	if (p_mode == MODE_WRITE_AES256 || p_mode == MODE_WRITE_AES256_BLOCKS) {
 		data.clear();
 		writing = true;
 		file = p_base;
@@ -63,6 +80,27 @@ Error FileAccessEncrypted::open_and_parse(FileAccess *p_base, const Vector<uint8
 		ERR_FAIL_INDEX_V(mode, MODE_MAX, ERR_FILE_CORRUPT);
 		ERR_FAIL_COND_V(mode == 0, ERR_FILE_CORRUPT);
 
+		if (mode == MODE_WRITE_AES256_BLOCKS) {
+			block_size = p_base->get_32();
+			ERR_FAIL_COND_V(block_size == 0 || block_size % 16 || block_size > (1 << 24), ERR_FILE_CORRUPT);
+			length = p_base->get_64();
+			ERR_FAIL_COND_V(p_base->get_buffer(nonce, NONCE_SIZE) != NONCE_SIZE, ERR_FILE_CORRUPT);
+			base = p_base->get_position();
+
+			size_t last = length - (_get_block_count() - 1) * block_size;
+			if (last % 16) {
+				last += 16 - (last % 16);
+			}
+			size_t total = (_get_block_count() - 1) * (block_size + BLOCK_MAC_SIZE) + last + BLOCK_MAC_SIZE;
+			ERR_FAIL_COND_V(p_base->get_len() < base + total, ERR_FILE_CORRUPT);
+
+			aes.set_decode_key(key.ptr(), 256);
+			iv_aes.set_encode_key(key.ptr(), 256);
+			streaming = true;
+			file = p_base;
+			return OK;
+		}
+
 		unsigned char md5d[16];
 		p_base->get_buffer(md5d, 16);
 		length = p_base->get_64();
@@ -98,6 +136,152 @@ Error FileAccessEncrypted::open_and_parse(FileAccess *p_base, const Vector<uint8
 	return OK;
 }
 
+size_t FileAccessEncrypted::_get_block_count() const {
+	// Even an empty file has one (empty) block, so it can't be truncated to nothing unnoticed.
+	return MAX((length + block_size - 1) / block_size, (size_t)1);
+}
+
+void FileAccessEncrypted::_generate_nonce() {
+	// Only needs to be unique per written file, the block IVs derived from it are encrypted
+	// with the file key, which makes them unpredictable.
+	static std::atomic<uint64_t> counter(0);
+	uint64_t values[5] = {
+		OS::get_singleton()->get_ticks_usec(),
+		(uint64_t)OS::get_singleton()->get_unix_time(),
+		(uint64_t)OS::get_singleton()->get_process_id(),
+		(uint64_t)this,
+		counter.fetch_add(1),
+	};
+
+	uint8_t hash[32];
+	CryptoCore::SHA256Context sha;
+	sha.start();
+	sha.update((const uint8_t *)values, sizeof(values));
+	sha.finish(hash);
+	copymem(nonce, hash, NONCE_SIZE);
+}
+
+void FileAccessEncrypted::_compute_block_iv(uint64_t p_index, uint8_t *r_iv) const {
+	// CBC with an IV per block: the file nonce combined with the block index, encrypted.
+	copymem(r_iv, nonce, NONCE_SIZE);
+	for (int i = 0; i < 8; i++) {
+		r_iv[i] ^= (p_index >> (i * 8)) & 0xFF;
+	}
+	iv_aes.encrypt_ecb(r_iv, r_iv);
+}
+
+void FileAccessEncrypted::_compute_block_mac(uint64_t p_index, const uint8_t *p_cipher, size_t p_len, uint8_t *r_mac) const {
+	// HMAC-SHA256 over the block index, the block size, the total length, the nonce and the
+	// ciphertext, so blocks can't be reordered, swapped between files or truncated.
+	uint8_t header[20 + NONCE_SIZE];
+	encode_uint64(p_index, &header[0]);
+	encode_uint32(block_size, &header[8]);
+	encode_uint64(length, &header[12]);
+	copymem(&header[20], nonce, NONCE_SIZE);
+
+	uint8_t pad[64];
+	uint8_t inner[32];
+
+	CryptoCore::SHA256Context sha;
+	for (int i = 0; i < 64; i++) {
+		pad[i] = (i < 32 ? mac_key[i] : 0) ^ 0x36;
+	}
+	sha.start();
+	sha.update(pad, 64);
+	sha.update(header, sizeof(header));
+	sha.update(p_cipher, p_len);
+	sha.finish(inner);
+
+	for (int i = 0; i < 64; i++) {
+		pad[i] = (i < 32 ? mac_key[i] : 0) ^ 0x5c;
+	}
+	sha.start();
+	sha.update(pad, 64);
+	sha.update(inner, 32);
+	sha.finish(r_mac);
+}
+
+bool FileAccessEncrypted::_load_block(uint64_t p_index) const {
+	if ((int64_t)p_index == block_index) {
+		return true;
+	}
+	ERR_FAIL_COND_V(corrupt, false);
+
+	size_t valid = MIN((size_t)block_size, length - p_index * block_size);
+	size_t cipher_len = valid;
+	if (cipher_len % 16) {
+		cipher_len += 16 - (cipher_len % 16);
+	}
+
+	block.resize(cipher_len);
+	uint8_t mac[BLOCK_MAC_SIZE];
+	file->seek(base + p_index * (block_size + BLOCK_MAC_SIZE));
+	size_t read = file->get_buffer(block.ptrw(), cipher_len);
+	read += file->get_buffer(mac, BLOCK_MAC_SIZE);
+
+	uint8_t expected[BLOCK_MAC_SIZE];
+	_compute_block_mac(p_index, block.ptr(), cipher_len, expected);
+	uint8_t diff = read != cipher_len + BLOCK_MAC_SIZE;
+	for (int i = 0; i < BLOCK_MAC_SIZE; i++) {
+		diff |= mac[i] ^ expected[i];
+	}
+	if (diff) {
+		corrupt = true;
+		block_index = -1;
+		block.clear();
+		ERR_FAIL_V_MSG(false, "The MAC of encrypted block " + itos(p_index) + " does not match the expected value. It could be that the file is corrupt, or that the provided decryption key is invalid.");
+	}
+
+	uint8_t iv[16];
+	_compute_block_iv(p_index, iv);
+	aes.decrypt_cbc(cipher_len, iv, block.ptr(), block.ptrw());
+	block_index = p_index;
+	return true;
+}
+
+void FileAccessEncrypted::_store_blocks() {
+	block_size = BLOCK_SIZE;
+	length = data.size();
+	_generate_nonce();
+
+	file->store_32(COMP_MAGIC);
+	file->store_32(mode);
+	file->store_32(block_size);
+	file->store_64(length);
+	file->store_buffer(nonce, NONCE_SIZE);
+
+	CryptoCore::AESContext ctx;
+	ctx.set_encode_key(key.ptr(), 256);
+	iv_aes.set_encode_key(key.ptr(), 256);
+
+	Vector<uint8_t> cipher;
+	cipher.resize(block_size);
+	uint8_t *w = cipher.ptrw();
+	uint8_t mac[BLOCK_MAC_SIZE];
+
+	size_t count = _get_block_count();
+	for (size_t b = 0; b < count; b++) {
+		size_t from = b * block_size;
+		size_t valid = MIN((size_t)block_size, length - from);
+		size_t cipher_len = valid;
+		if (cipher_len % 16) {
+			cipher_len += 16 - (cipher_len % 16);
+		}
+
+		zeromem(w, cipher_len);
+		if (valid) {
+			copymem(w, &data.ptr()[from], valid);
+		}
+		uint8_t iv[16];
+		_compute_block_iv(b, iv);
+		ctx.encrypt_cbc(cipher_len, iv, w, w);
+		_compute_block_mac(b, w, cipher_len, mac);
+
+		file->store_buffer(w, cipher_len);
+		file->store_buffer(mac, BLOCK_MAC_SIZE);
+	}
+}
+
 Error FileAccessEncrypted::open_and_parse_password(FileAccess *p_base, const String &p_key, Mode p_mode) {
 	String cs = p_key.md5_text();
 	ERR_FAIL_COND_V(cs.length() != 32, ERR_INVALID_PARAMETER);
@@ -119,7 +303,14 @@ void FileAccessEncrypted::close() {
 		return;
 	}
 
-	if (writing) {
+	if (writing && mode == MODE_WRITE_AES256_BLOCKS) {
+		_store_blocks();
+		file->close();
+		memdelete(file);
+		file = nullptr;
+		data.clear();
+
+	} else if (writing) {
 		Vector<uint8_t> compressed;
 		size_t len = data.size();
 		if (len % 16) {
@@ -158,6 +349,9 @@ void FileAccessEncrypted::close() {
 		file->close();
 		memdelete(file);
 		data.clear();
+		block.clear();
+		block_index = -1;
+		streaming = false;
 		file = nullptr;
 	}
 }
@@ -183,8 +377,8 @@ String FileAccessEncrypted::get_path_absolute() const {
 }
 
 void FileAccessEncrypted::seek(size_t p_position) {
-	if (p_position > (size_t)data.size()) {
-		p_position = data.size();
+	if (p_position > get_len()) {
+		p_position = get_len();
 	}
 
 	pos = p_position;
@@ -192,7 +386,7 @@ void FileAccessEncrypted::seek(size_t p_position) {
 }
 
 void FileAccessEncrypted::seek_end(int64_t p_position) {
-	seek(data.size() + p_position);
+	seek(get_len() + p_position);
 }
 
 size_t FileAccessEncrypted::get_position() const {
@@ -200,7 +394,7 @@ size_t FileAccessEncrypted::get_position() const {
 }
 
 size_t FileAccessEncrypted::get_len() const {
-	return data.size();
+	return streaming ? length : data.size();
 }
 
 bool FileAccessEncrypted::eof_reached() const {
@@ -209,7 +403,12 @@ bool FileAccessEncrypted::eof_reached() const {
 
 uint8_t FileAccessEncrypted::get_8() const {
 	ERR_FAIL_COND_V_MSG(writing, 0, "File has not been opened in read mode.");
-	if (pos >= data.size()) {
+	if (streaming) {
+		uint8_t b = 0;
+		get_buffer(&b, 1);
+		return b;
+	}
+	if (pos >= (size_t)data.size()) {
 		eofed = true;
 		return 0;
 	}
@@ -222,7 +421,27 @@ uint8_t FileAccessEncrypted::get_8() const {
 int FileAccessEncrypted::get_buffer(uint8_t *p_dst, int p_length) const {
 	ERR_FAIL_COND_V_MSG(writing, 0, "File has not been opened in read mode.");
 
-	int to_copy = MIN(p_length, data.size() - pos);
+	if (streaming) {
+		int copied = 0;
+		while (copied < p_length && pos < length) {
+			uint64_t index = pos / block_size;
+			if (!_load_block(index)) {
+				break;
+			}
+			size_t offset = pos - index * block_size;
+			size_t valid = MIN((size_t)block_size, length - index * block_size);
+			int to_copy = MIN((size_t)(p_length - copied), valid - offset);
+			copymem(&p_dst[copied], &block.ptr()[offset], to_copy);
+			copied += to_copy;
+			pos += to_copy;
+		}
+		if (copied < p_length) {
+			eofed = true;
+		}
+		return copied;
+	}
+
+	int to_copy = MIN(p_length, data.size() - (int)pos);
 	for (int i = 0; i < to_copy; i++) {
 		p_dst[i] = data[pos++];
 	}
@@ -235,17 +454,20 @@ int FileAccessEncrypted::get_buffer(uint8_t *p_dst, int p_length) const {
 }
 
 Error FileAccessEncrypted::get_error() const {
+	if (corrupt) {
+		return ERR_FILE_CORRUPT;
+	}
 	return eofed ? ERR_FILE_EOF : OK;
 }
 
 void FileAccessEncrypted::store_buffer(const uint8_t *p_src, int p_length) {
 	ERR_FAIL_COND_MSG(!writing, "File has not been opened in read mode.");
 
-	if (pos < data.size()) {
+	if (pos < (size_t)data.size()) {
 		for (int i = 0; i < p_length; i++) {
 			store_8(p_src[i]);
 		}
-	} else if (pos == data.size()) {
+	} else if (pos == (size_t)data.size()) {
 		data.resize(pos + p_length);
 		for (int i = 0; i < p_length; i++) {
 			data.write[pos + i] = p_src[i];
@@ -263,10 +485,10 @@ void FileAccessEncrypted::flush() {
 void FileAccessEncrypted::store_8(uint8_t p_dest) {
 	ERR_FAIL_COND_MSG(!writing, "File has not been opened in read mode.");
 
-	if (pos < data.size()) {
+	if (pos < (size_t)data.size()) {
 		data.write[pos] = p_dest;
 		pos++;
-	} else if (pos == data.size()) {
+	} else if (pos == (size_t)data.size()) {
 		data.push_back(p_dest);
 		pos++;
 	}
@@ -31,6 +31,7 @@
 #ifndef FILE_ACCESS_ENCRYPTED_H
 #define FILE_ACCESS_ENCRYPTED_H
 
+#include "core/crypto/crypto_core.h"
 #include "core/os/file_access.h"
 
 class FileAccessEncrypted : public FileAccess {
@@ -38,20 +39,45 @@ public:
 	enum Mode {
 		MODE_READ,
 		MODE_WRITE_AES256,
+		MODE_WRITE_AES256_BLOCKS, // Per-block MACs, decrypted on demand when reading.
 		MODE_MAX
 	};
 
+	enum {
+		BLOCK_SIZE = 65536,
+		BLOCK_MAC_SIZE = 32,
+		NONCE_SIZE = 16,
+	};
+
 private:
 	Mode mode = MODE_MAX;
 	Vector<uint8_t> key;
+	uint8_t mac_key[32];
 	bool writing = false;
 	FileAccess *file = nullptr;
 	size_t base;
 	size_t length;
 	Vector<uint8_t> data;
-	mutable int pos = 0;
+	mutable size_t pos = 0;
 	mutable bool eofed = false;
 
+	// Block streaming (MODE_WRITE_AES256_BLOCKS files opened for reading).
+	bool streaming = false;
+	uint32_t block_size = 0;
+	uint8_t nonce[NONCE_SIZE];
+	mutable CryptoCore::AESContext aes;
+	mutable CryptoCore::AESContext iv_aes;
+	mutable Vector<uint8_t> block;
+	mutable int64_t block_index = -1;
+	mutable bool corrupt = false;
+
+	size_t _get_block_count() const;
+	void _generate_nonce();
+	void _compute_block_iv(uint64_t p_index, uint8_t *r_iv) const;
+	void _compute_block_mac(uint64_t p_index, const uint8_t *p_cipher, size_t p_len, uint8_t *r_mac) const;
+	bool _load_block(uint64_t p_index) const;
+	void _store_blocks();
+
 public:
 	Error open_and_parse(FileAccess *p_base, const Vector<uint8_t> &p_key, Mode p_mode);
 	Error open_and_parse_password(FileAccess *p_base, const String &p_key, Mode p_mode);
@@ -108,7 +108,7 @@ Ref<StreamPeer> HTTPClient::get_connection() const {
 Error HTTPClient::request_raw(Method p_method, const String &p_url, const Vector<String> &p_headers, const Vector<uint8_t> &p_body) {
 	ERR_FAIL_INDEX_V(p_method, METHOD_MAX, ERR_INVALID_PARAMETER);
 	ERR_FAIL_COND_V(!p_url.begins_with("/"), ERR_INVALID_PARAMETER);
-	ERR_FAIL_COND_V(status != STATUS_CONNECTED, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(!_can_request(), ERR_INVALID_PARAMETER);
 	ERR_FAIL_COND_V(connection.is_null(), ERR_INVALID_DATA);
 
 	String request = String(_methods[p_method]) + " " + p_url + " HTTP/1.1\r\n";
@@ -166,8 +166,7 @@ Error HTTPClient::request_raw(Method p_method, const String &p_url, const Vector
 		return err;
 	}
 
-	status = STATUS_REQUESTING;
-	head_request = p_method == METHOD_HEAD;
+	_request_sent(p_method);
 
 	return OK;
 }
@@ -175,7 +174,7 @@ Error HTTPClient::request_raw(Method p_method, const String &p_url, const Vector
 Error HTTPClient::request(Method p_method, const String &p_url, const Vector<String> &p_headers, const String &p_body) {
 	ERR_FAIL_INDEX_V(p_method, METHOD_MAX, ERR_INVALID_PARAMETER);
 	ERR_FAIL_COND_V(!p_url.begins_with("/"), ERR_INVALID_PARAMETER);
-	ERR_FAIL_COND_V(status != STATUS_CONNECTED, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(!_can_request(), ERR_INVALID_PARAMETER);
 	ERR_FAIL_COND_V(connection.is_null(), ERR_INVALID_DATA);
 
 	String request = String(_methods[p_method]) + " " + p_url + " HTTP/1.1\r\n";
@@ -221,12 +220,46 @@ Error HTTPClient::request(Method p_method, const String &p_url, const Vector<Str
 		return err;
 	}
 
-	status = STATUS_REQUESTING;
-	head_request = p_method == METHOD_HEAD;
+	_request_sent(p_method);
 
 	return OK;
 }
 
+bool HTTPClient::_can_request() const {
+	if (status == STATUS_CONNECTED) {
+		return true;
+	}
+	// When pipelining, more requests can be written while a response is still being read.
+	return pipelining && keep_alive && (status == STATUS_REQUESTING || status == STATUS_BODY);
+}
+
+void HTTPClient::_request_sent(Method p_method) {
+	if (status == STATUS_CONNECTED) {
+		status = STATUS_REQUESTING;
+		head_request = p_method == METHOD_HEAD;
+	} else {
+		pipelined_requests.push_back(p_method == METHOD_HEAD);
+	}
+}
+
+void HTTPClient::_response_finished() {
+	if (pipelined_requests.empty()) {
+		status = STATUS_CONNECTED;
+		return;
+	}
+
+	if (!keep_alive) {
+		// The server closes the connection after this response, the pipelined requests won't be answered.
+		close();
+		status = STATUS_CONNECTION_ERROR;
+		return;
+	}
+
+	head_request = pipelined_requests.front()->get();
+	pipelined_requests.pop_front();
+	status = STATUS_REQUESTING;
+}
+
 bool HTTPClient::has_response() const {
 	return response_headers.size() != 0;
 }
@@ -261,6 +294,8 @@ void HTTPClient::close() {
 	connection.unref();
 	status = STATUS_DISCONNECTED;
 	head_request = false;
+	keep_alive = true;
+	pipelined_requests.clear();
 	if (resolving != IP::RESOLVER_INVALID_ID) {
 		IP::get_singleton()->erase_resolve_item(resolving);
 		resolving = IP::RESOLVER_INVALID_ID;
@@ -422,7 +457,7 @@ Error HTTPClient::poll() {
 					// Per the HTTP 1.1 spec, keep-alive is the default.
 					// Not following that specification breaks standard implementations.
 					// Broken web servers should be fixed.
-					bool keep_alive = true;
+					keep_alive = true;
 
 					for (int i = 0; i < responses.size(); i++) {
 						String header = responses[i].strip_edges();
@@ -463,7 +498,7 @@ Error HTTPClient::poll() {
 						read_until_eof = true;
 						status = STATUS_BODY;
 					} else {
-						status = STATUS_CONNECTED;
+						_response_finished();
 					}
 					return OK;
 				}
@@ -515,8 +550,8 @@ PackedByteArray HTTPClient::read_response_body_chunk() {
 					if (cs == 2) {
 						// Finally over
 						chunk_trailer_part = false;
-						status = STATUS_CONNECTED;
 						chunk.clear();
+						_response_finished();
 						break;
 					} else {
 						// We do not process nor return the trailer data
@@ -574,26 +609,38 @@ PackedByteArray HTTPClient::read_response_body_chunk() {
 					}
 
 					chunk_left = len + 2;
-					chunk.resize(chunk_left);
+					chunk.clear();
+				}
+			} else if (chunk_left > 2) {
+				// Hand out the chunk data as it arrives, instead of buffering the whole chunk first.
+				int to_read = MIN(chunk_left - 2, read_chunk_size);
+				ret.resize(to_read);
+				int rec = 0;
+				err = _get_http_data(ret.ptrw(), to_read, rec);
+				ret.resize(rec);
+				chunk_left -= rec;
+
+				if (chunk_left > 2 || err != OK) {
+					break;
 				}
 			} else {
+				// Chunk data is over, only the terminator is left.
+				if (chunk.empty()) {
+					chunk.resize(2);
+				}
 				int rec = 0;
-				err = _get_http_data(&chunk.write[chunk.size() - chunk_left], chunk_left, rec);
+				err = _get_http_data(&chunk.write[2 - chunk_left], chunk_left, rec);
 				if (rec == 0) {
 					break;
 				}
 				chunk_left -= rec;
 
 				if (chunk_left == 0) {
-					if (chunk[chunk.size() - 2] != '\r' || chunk[chunk.size() - 1] != '\n') {
+					if (chunk[0] != '\r' || chunk[1] != '\n') {
 						ERR_PRINT("HTTP Invalid chunk terminator (not \\r\\n)");
 						status = STATUS_CONNECTION_ERROR;
 						break;
 					}
-
-					ret.resize(chunk.size() - 2);
-					uint8_t *w = ret.ptrw();
-					copymem(w, chunk.ptr(), chunk.size() - 2);
 					chunk.clear();
 				}
 
@@ -636,7 +683,7 @@ PackedByteArray HTTPClient::read_response_body_chunk() {
 			status = STATUS_CONNECTION_ERROR;
 		}
 	} else if (body_left == 0 && !chunked && !read_until_eof) {
-		status = STATUS_CONNECTED;
+		_response_finished();
 	}
 
 	return ret;
@@ -689,6 +736,22 @@ int HTTPClient::get_read_chunk_size() const {
 	return read_chunk_size;
 }
 
+void HTTPClient::set_pipelining_enabled(bool p_enable) {
+	pipelining = p_enable;
+}
+
+bool HTTPClient::is_pipelining_enabled() const {
+	return pipelining;
+}
+
+int HTTPClient::get_pipelined_request_count() const {
+	return pipelined_requests.size();
+}
+
+bool HTTPClient::is_connection_reusable() const {
+	return status == STATUS_CONNECTED && keep_alive && connection.is_valid();
+}
+
 HTTPClient::HTTPClient() {
 	tcp_connection.instance();
 }
@@ -776,6 +839,11 @@ void HTTPClient::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_read_chunk_size", "bytes"), &HTTPClient::set_read_chunk_size);
 	ClassDB::bind_method(D_METHOD("get_read_chunk_size"), &HTTPClient::get_read_chunk_size);
 
+	ClassDB::bind_method(D_METHOD("set_pipelining_enabled", "enabled"), &HTTPClient::set_pipelining_enabled);
+	ClassDB::bind_method(D_METHOD("is_pipelining_enabled"), &HTTPClient::is_pipelining_enabled);
+	ClassDB::bind_method(D_METHOD("get_pipelined_request_count"), &HTTPClient::get_pipelined_request_count);
+	ClassDB::bind_method(D_METHOD("is_connection_reusable"), &HTTPClient::is_connection_reusable);
+
 	ClassDB::bind_method(D_METHOD("set_blocking_mode", "enabled"), &HTTPClient::set_blocking_mode);
 	ClassDB::bind_method(D_METHOD("is_blocking_mode_enabled"), &HTTPClient::is_blocking_mode_enabled);
 
@@ -787,6 +855,7 @@ void HTTPClient::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "blocking_mode_enabled"), "set_blocking_mode", "is_blocking_mode_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "connection", PROPERTY_HINT_RESOURCE_TYPE, "StreamPeer", 0), "set_connection", "get_connection");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "read_chunk_size", PROPERTY_HINT_RANGE, "256,16777216"), "set_read_chunk_size", "get_read_chunk_size");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "pipelining_enabled"), "set_pipelining_enabled", "is_pipelining_enabled");
 
 	BIND_ENUM_CONSTANT(METHOD_GET);
 	BIND_ENUM_CONSTANT(METHOD_HEAD);
@@ -34,6 +34,7 @@
 #include "core/io/ip.h"
 #include "core/io/stream_peer.h"
 #include "core/io/stream_peer_tcp.h"
+#include "core/list.h"
 #include "core/reference.h"
 
 class HTTPClient : public Reference {
@@ -166,6 +167,9 @@ private:
 	bool blocking = false;
 	bool handshaking = false;
 	bool head_request = false;
+	bool keep_alive = true;
+	bool pipelining = false;
+	List<bool> pipelined_requests; // Whether each request sent ahead of the current response is a HEAD request.
 
 	Vector<uint8_t> response_str;
 
@@ -185,6 +189,9 @@ private:
 	int read_chunk_size = 4096;
 
 	Error _get_http_data(uint8_t *p_buffer, int p_bytes, int &r_received);
+	bool _can_request() const;
+	void _request_sent(Method p_method);
+	void _response_finished();
 
 #else
 #include "platform/javascript/http_client.h.inc"
@@ -222,6 +229,11 @@ public:
 	void set_read_chunk_size(int p_size);
 	int get_read_chunk_size() const;
 
+	void set_pipelining_enabled(bool p_enable);
+	bool is_pipelining_enabled() const;
+	int get_pipelined_request_count() const;
+	bool is_connection_reusable() const;
+
 	Error poll();
 
 	String query_string_from_dict(const Dictionary &p_dict);
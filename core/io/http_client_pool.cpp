@@ -0,0 +1,176 @@
+/*************************************************************************/
+/*  http_client_pool.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "http_client_pool.h"
+
+#include "core/os/os.h"
+
+String HTTPClientPool::_get_key(const String &p_host, int p_port, bool p_ssl, bool p_verify_host) {
+	// Mirrors how HTTPClient::connect_to_host() interprets its arguments.
+	String host = p_host.to_lower();
+	bool ssl = p_ssl;
+	if (host.begins_with("http://")) {
+		host = host.substr(7, host.length() - 7);
+	} else if (host.begins_with("https://")) {
+		ssl = true;
+		host = host.substr(8, host.length() - 8);
+	}
+
+	int port = p_port;
+	if (port < 0) {
+		port = ssl ? 443 : 80;
+	}
+
+	String key = host + ":" + itos(port);
+	if (ssl) {
+		key += p_verify_host ? "/ssl" : "/ssl-unverified";
+	}
+	return key;
+}
+
+Ref<HTTPClient> HTTPClientPool::acquire(const String &p_host, int p_port, bool p_ssl, bool p_verify_host) {
+	String key = _get_key(p_host, p_port, p_ssl, p_verify_host);
+
+	MutexLock lock(mutex);
+
+	Map<String, List<IdleClient>>::Element *E = idle_clients.find(key);
+	if (E) {
+		uint64_t now = OS::get_singleton()->get_ticks_msec();
+		List<IdleClient> &clients = E->get();
+		while (clients.size()) {
+			IdleClient idle = clients.back()->get();
+			clients.pop_back();
+
+			if (now - idle.released_msec > (uint64_t)idle_timeout * 1000) {
+				idle.client->close();
+				continue;
+			}
+
+			// Notices if the server closed the connection while it was idle.
+			idle.client->poll();
+			if (idle.client->is_connection_reusable()) {
+				acquired_clients[idle.client->get_instance_id()] = key;
+				return idle.client;
+			}
+		}
+		idle_clients.erase(E);
+	}
+
+	Ref<HTTPClient> client;
+	client.instance();
+	client->connect_to_host(p_host, p_port, p_ssl, p_verify_host); // On failure, the status tells why.
+	acquired_clients[client->get_instance_id()] = key;
+	return client;
+}
+
+void HTTPClientPool::release(Ref<HTTPClient> p_client) {
+	ERR_FAIL_COND(p_client.is_null());
+
+	MutexLock lock(mutex);
+
+	Map<ObjectID, String>::Element *E = acquired_clients.find(p_client->get_instance_id());
+	ERR_FAIL_COND_MSG(!E, "The HTTPClient was not acquired from this pool.");
+	String key = E->get();
+	acquired_clients.erase(E);
+
+	if (!p_client->is_connection_reusable() || max_idle_per_host == 0) {
+		p_client->close();
+		return;
+	}
+
+	List<IdleClient> &clients = idle_clients[key];
+	if (clients.size() >= max_idle_per_host) {
+		clients.front()->get().client->close();
+		clients.pop_front();
+	}
+
+	IdleClient idle;
+	idle.client = p_client;
+	idle.released_msec = OS::get_singleton()->get_ticks_msec();
+	clients.push_back(idle);
+}
+
+void HTTPClientPool::clear() {
+	MutexLock lock(mutex);
+
+	for (Map<String, List<IdleClient>>::Element *E = idle_clients.front(); E; E = E->next()) {
+		for (List<IdleClient>::Element *F = E->get().front(); F; F = F->next()) {
+			F->get().client->close();
+		}
+	}
+	idle_clients.clear();
+}
+
+int HTTPClientPool::get_idle_connection_count() const {
+	MutexLock lock(mutex);
+
+	int count = 0;
+	for (const Map<String, List<IdleClient>>::Element *E = idle_clients.front(); E; E = E->next()) {
+		count += E->get().size();
+	}
+	return count;
+}
+
+void HTTPClientPool::set_max_idle_per_host(int p_max) {
+	ERR_FAIL_COND(p_max < 0);
+	max_idle_per_host = p_max;
+}
+
+int HTTPClientPool::get_max_idle_per_host() const {
+	return max_idle_per_host;
+}
+
+void HTTPClientPool::set_idle_timeout(int p_seconds) {
+	ERR_FAIL_COND(p_seconds < 0);
+	idle_timeout = p_seconds;
+}
+
+int HTTPClientPool::get_idle_timeout() const {
+	return idle_timeout;
+}
+
+void HTTPClientPool::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("acquire", "host", "port", "use_ssl", "verify_host"), &HTTPClientPool::acquire, DEFVAL(-1), DEFVAL(false), DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("release", "client"), &HTTPClientPool::release);
+	ClassDB::bind_method(D_METHOD("clear"), &HTTPClientPool::clear);
+	ClassDB::bind_method(D_METHOD("get_idle_connection_count"), &HTTPClientPool::get_idle_connection_count);
+
+	ClassDB::bind_method(D_METHOD("set_max_idle_per_host", "max"), &HTTPClientPool::set_max_idle_per_host);
+	ClassDB::bind_method(D_METHOD("get_max_idle_per_host"), &HTTPClientPool::get_max_idle_per_host);
+	ClassDB::bind_method(D_METHOD("set_idle_timeout", "seconds"), &HTTPClientPool::set_idle_timeout);
+	ClassDB::bind_method(D_METHOD("get_idle_timeout"), &HTTPClientPool::get_idle_timeout);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_idle_per_host", PROPERTY_HINT_RANGE, "0,64"), "set_max_idle_per_host", "get_max_idle_per_host");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "idle_timeout", PROPERTY_HINT_RANGE, "0,3600"), "set_idle_timeout", "get_idle_timeout");
+}
+
+HTTPClientPool::~HTTPClientPool() {
+	clear();
+}
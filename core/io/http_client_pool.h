@@ -0,0 +1,77 @@
+/*************************************************************************/
+/*  http_client_pool.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef HTTP_CLIENT_POOL_H
+#define HTTP_CLIENT_POOL_H
+
+#include "core/io/http_client.h"
+#include "core/list.h"
+#include "core/map.h"
+#include "core/os/mutex.h"
+#include "core/reference.h"
+
+class HTTPClientPool : public Reference {
+	GDCLASS(HTTPClientPool, Reference);
+
+	struct IdleClient {
+		Ref<HTTPClient> client;
+		uint64_t released_msec = 0;
+	};
+
+	Mutex mutex;
+	Map<String, List<IdleClient>> idle_clients; // Per host, most recently released last.
+	Map<ObjectID, String> acquired_clients;
+
+	int max_idle_per_host = 4;
+	int idle_timeout = 30;
+
+	static String _get_key(const String &p_host, int p_port, bool p_ssl, bool p_verify_host);
+
+protected:
+	static void _bind_methods();
+
+public:
+	Ref<HTTPClient> acquire(const String &p_host, int p_port = -1, bool p_ssl = false, bool p_verify_host = true);
+	void release(Ref<HTTPClient> p_client);
+	void clear();
+
+	int get_idle_connection_count() const;
+
+	void set_max_idle_per_host(int p_max);
+	int get_max_idle_per_host() const;
+
+	void set_idle_timeout(int p_seconds);
+	int get_idle_timeout() const;
+
+	HTTPClientPool() {}
+	~HTTPClientPool();
+};
+
+#endif // HTTP_CLIENT_POOL_H
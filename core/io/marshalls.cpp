@@ -1511,3 +1511,547 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 	return OK;
 }
+
+// Returns nullptr when the padded result would be larger than p_max_size,
+// so nothing is allocated for values over the limit.
+static _FORCE_INLINE_ uint8_t *_grow_buffer(LocalVector<uint8_t> &r_buffer, uint64_t p_size, uint32_t p_max_size) {
+	uint64_t ofs = r_buffer.size();
+	if (((ofs + p_size + 3) & ~uint64_t(3)) > p_max_size) {
+		return nullptr;
+	}
+	r_buffer.resize(ofs + p_size);
+	return r_buffer.ptr() + ofs;
+}
+
+static _FORCE_INLINE_ void _pad_buffer(LocalVector<uint8_t> &r_buffer) {
+	while (r_buffer.size() % 4) {
+		r_buffer.push_back(0);
+	}
+}
+
+static Error _encode_utf8(const CharType *p_chars, int p_len, LocalVector<uint8_t> &r_buffer, bool p_null_terminate, uint32_t p_max_size) {
+	// Same output as String::utf8(), written in place instead of through a temporary CharString.
+	uint32_t bytes = 0;
+	for (int i = 0; i < p_len; i++) {
+		uint32_t c = p_chars[i];
+		if (c <= 0x7f) {
+			bytes += 1;
+		} else if (c <= 0x7ff) {
+			bytes += 2;
+		} else if (c <= 0xffff) {
+			bytes += 3;
+		} else if (c <= 0x001fffff) {
+			bytes += 4;
+		} else if (c <= 0x03ffffff) {
+			bytes += 5;
+		} else if (c <= 0x7fffffff) {
+			bytes += 6;
+		}
+	}
+
+	uint32_t total = bytes + (p_null_terminate ? 1 : 0);
+	uint8_t *w = _grow_buffer(r_buffer, 4 + total, p_max_size);
+	if (!w) {
+		return ERR_OUT_OF_MEMORY;
+	}
+	encode_uint32(total, w);
+	w += 4;
+
+	for (int i = 0; i < p_len; i++) {
+		uint32_t c = p_chars[i];
+		if (c <= 0x7f) {
+			*(w++) = c;
+		} else if (c <= 0x7ff) {
+			*(w++) = 0xc0 | ((c >> 6) & 0x1f);
+			*(w++) = 0x80 | (c & 0x3f);
+		} else if (c <= 0xffff) {
+			*(w++) = 0xe0 | ((c >> 12) & 0x0f);
+			*(w++) = 0x80 | ((c >> 6) & 0x3f);
+			*(w++) = 0x80 | (c & 0x3f);
+		} else if (c <= 0x001fffff) {
+			*(w++) = 0xf0 | ((c >> 18) & 0x07);
+			*(w++) = 0x80 | ((c >> 12) & 0x3f);
+			*(w++) = 0x80 | ((c >> 6) & 0x3f);
+			*(w++) = 0x80 | (c & 0x3f);
+		} else if (c <= 0x03ffffff) {
+			*(w++) = 0xf8 | ((c >> 24) & 0x03);
+			*(w++) = 0x80 | ((c >> 18) & 0x3f);
+			*(w++) = 0x80 | ((c >> 12) & 0x3f);
+			*(w++) = 0x80 | ((c >> 6) & 0x3f);
+			*(w++) = 0x80 | (c & 0x3f);
+		} else if (c <= 0x7fffffff) {
+			*(w++) = 0xfc | ((c >> 30) & 0x01);
+			*(w++) = 0x80 | ((c >> 24) & 0x3f);
+			*(w++) = 0x80 | ((c >> 18) & 0x3f);
+			*(w++) = 0x80 | ((c >> 12) & 0x3f);
+			*(w++) = 0x80 | ((c >> 6) & 0x3f);
+			*(w++) = 0x80 | (c & 0x3f);
+		}
+	}
+
+	if (p_null_terminate) {
+		*w = 0;
+	}
+
+	_pad_buffer(r_buffer);
+	return OK;
+}
+
+static _FORCE_INLINE_ Error _encode_string(const String &p_string, LocalVector<uint8_t> &r_buffer, uint32_t p_max_size) {
+	return _encode_utf8(p_string.ptr(), p_string.length(), r_buffer, false, p_max_size);
+}
+
+Error encode_variant(const Variant &p_variant, LocalVector<uint8_t> &r_buffer, bool p_full_objects, uint32_t p_max_size) {
+	switch (p_variant.get_type()) {
+		case Variant::STRING: {
+			uint8_t *w = _grow_buffer(r_buffer, 4, p_max_size);
+			if (!w) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(Variant::STRING, w);
+			return _encode_string(p_variant, r_buffer, p_max_size);
+		} break;
+		case Variant::STRING_NAME: {
+			uint8_t *w = _grow_buffer(r_buffer, 4, p_max_size);
+			if (!w) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(Variant::STRING_NAME, w);
+			return _encode_string(p_variant.operator StringName(), r_buffer, p_max_size);
+		} break;
+		case Variant::NODE_PATH: {
+			NodePath np = p_variant;
+			uint8_t *w = _grow_buffer(r_buffer, 16, p_max_size);
+			if (!w) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(Variant::NODE_PATH, w);
+			encode_uint32(uint32_t(np.get_name_count()) | 0x80000000, w + 4); // For compatibility with the old format.
+			encode_uint32(np.get_subname_count(), w + 8);
+			encode_uint32(np.is_absolute() ? 1 : 0, w + 12);
+
+			for (int i = 0; i < np.get_name_count(); i++) {
+				Error err = _encode_string(np.get_name(i), r_buffer, p_max_size);
+				if (err != OK) {
+					return err;
+				}
+			}
+			for (int i = 0; i < np.get_subname_count(); i++) {
+				Error err = _encode_string(np.get_subname(i), r_buffer, p_max_size);
+				if (err != OK) {
+					return err;
+				}
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary d = p_variant;
+			uint8_t *w = _grow_buffer(r_buffer, 8, p_max_size);
+			if (!w) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(Variant::DICTIONARY, w);
+			encode_uint32(uint32_t(d.size()), w + 4);
+
+			for (const Variant *K = d.next(nullptr); K; K = d.next(K)) {
+				Error err = encode_variant(*K, r_buffer, p_full_objects, p_max_size);
+				if (err != OK) {
+					return err;
+				}
+				const Variant *v = d.getptr(*K);
+				ERR_FAIL_COND_V(!v, ERR_BUG);
+				err = encode_variant(*v, r_buffer, p_full_objects, p_max_size);
+				if (err != OK) {
+					return err;
+				}
+			}
+		} break;
+		case Variant::ARRAY: {
+			Array arr = p_variant;
+			uint8_t *w = _grow_buffer(r_buffer, 8, p_max_size);
+			if (!w) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(Variant::ARRAY, w);
+			encode_uint32(uint32_t(arr.size()), w + 4);
+
+			for (int i = 0; i < arr.size(); i++) {
+				Error err = encode_variant(arr[i], r_buffer, p_full_objects, p_max_size);
+				if (err != OK) {
+					return err;
+				}
+			}
+		} break;
+		case Variant::PACKED_BYTE_ARRAY: {
+			Vector<uint8_t> data = p_variant;
+			uint8_t *w = _grow_buffer(r_buffer, 8 + (uint64_t)data.size(), p_max_size);
+			if (!w) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(Variant::PACKED_BYTE_ARRAY, w);
+			encode_uint32(data.size(), w + 4);
+			copymem(w + 8, data.ptr(), data.size());
+			_pad_buffer(r_buffer);
+		} break;
+		case Variant::PACKED_INT32_ARRAY: {
+			Vector<int32_t> data = p_variant;
+			uint8_t *w = _grow_buffer(r_buffer, 8 + (uint64_t)data.size() * 4, p_max_size);
+			if (!w) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(Variant::PACKED_INT32_ARRAY, w);
+			encode_uint32(data.size(), w + 4);
+			w += 8;
+			const int32_t *r = data.ptr();
+			for (int i = 0; i < data.size(); i++) {
+				encode_uint32(r[i], &w[i * 4]);
+			}
+		} break;
+		case Variant::PACKED_INT64_ARRAY: {
+			Vector<int64_t> data = p_variant;
+			uint8_t *w = _grow_buffer(r_buffer, 8 + (uint64_t)data.size() * 8, p_max_size);
+			if (!w) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(Variant::PACKED_INT64_ARRAY, w);
+			encode_uint32(data.size(), w + 4);
+			w += 8;
+			const int64_t *r = data.ptr();
+			for (int i = 0; i < data.size(); i++) {
+				encode_uint64(r[i], &w[i * 8]);
+			}
+		} break;
+		case Variant::PACKED_FLOAT32_ARRAY: {
+			Vector<float> data = p_variant;
+			uint8_t *w = _grow_buffer(r_buffer, 8 + (uint64_t)data.size() * 4, p_max_size);
+			if (!w) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(Variant::PACKED_FLOAT32_ARRAY, w);
+			encode_uint32(data.size(), w + 4);
+			w += 8;
+			const float *r = data.ptr();
+			for (int i = 0; i < data.size(); i++) {
+				encode_float(r[i], &w[i * 4]);
+			}
+		} break;
+		case Variant::PACKED_FLOAT64_ARRAY: {
+			Vector<double> data = p_variant;
+			uint8_t *w = _grow_buffer(r_buffer, 8 + (uint64_t)data.size() * 8, p_max_size);
+			if (!w) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(Variant::PACKED_FLOAT64_ARRAY, w);
+			encode_uint32(data.size(), w + 4);
+			w += 8;
+			const double *r = data.ptr();
+			for (int i = 0; i < data.size(); i++) {
+				encode_double(r[i], &w[i * 8]);
+			}
+		} break;
+		case Variant::PACKED_STRING_ARRAY: {
+			Vector<String> data = p_variant;
+			uint8_t *w = _grow_buffer(r_buffer, 8, p_max_size);
+			if (!w) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(Variant::PACKED_STRING_ARRAY, w);
+			encode_uint32(data.size(), w + 4);
+			const String *r = data.ptr();
+			for (int i = 0; i < data.size(); i++) {
+				Error err = _encode_utf8(r[i].ptr(), r[i].length(), r_buffer, true, p_max_size);
+				if (err != OK) {
+					return err;
+				}
+			}
+		} break;
+		case Variant::PACKED_VECTOR2_ARRAY: {
+			Vector<Vector2> data = p_variant;
+			uint8_t *w = _grow_buffer(r_buffer, 8 + (uint64_t)data.size() * 4 * 2, p_max_size);
+			if (!w) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(Variant::PACKED_VECTOR2_ARRAY, w);
+			encode_uint32(data.size(), w + 4);
+			w += 8;
+			const Vector2 *r = data.ptr();
+			for (int i = 0; i < data.size(); i++) {
+				encode_float(r[i].x, &w[0]);
+				encode_float(r[i].y, &w[4]);
+				w += 4 * 2;
+			}
+		} break;
+		case Variant::PACKED_VECTOR3_ARRAY: {
+			Vector<Vector3> data = p_variant;
+			uint8_t *w = _grow_buffer(r_buffer, 8 + (uint64_t)data.size() * 4 * 3, p_max_size);
+			if (!w) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(Variant::PACKED_VECTOR3_ARRAY, w);
+			encode_uint32(data.size(), w + 4);
+			w += 8;
+			const Vector3 *r = data.ptr();
+			for (int i = 0; i < data.size(); i++) {
+				encode_float(r[i].x, &w[0]);
+				encode_float(r[i].y, &w[4]);
+				encode_float(r[i].z, &w[8]);
+				w += 4 * 3;
+			}
+		} break;
+		case Variant::PACKED_COLOR_ARRAY: {
+			Vector<Color> data = p_variant;
+			uint8_t *w = _grow_buffer(r_buffer, 8 + (uint64_t)data.size() * 4 * 4, p_max_size);
+			if (!w) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			encode_uint32(Variant::PACKED_COLOR_ARRAY, w);
+			encode_uint32(data.size(), w + 4);
+			w += 8;
+			const Color *r = data.ptr();
+			for (int i = 0; i < data.size(); i++) {
+				encode_float(r[i].r, &w[0]);
+				encode_float(r[i].g, &w[4]);
+				encode_float(r[i].b, &w[8]);
+				encode_float(r[i].a, &w[12]);
+				w += 4 * 4;
+			}
+		} break;
+		case Variant::OBJECT: {
+			if (p_full_objects && p_variant.get_validated_object()) {
+				// Rare and arbitrarily large, measure it first.
+				int len;
+				Error err = encode_variant(p_variant, nullptr, len, p_full_objects);
+				ERR_FAIL_COND_V(err != OK, err);
+				uint8_t *w = _grow_buffer(r_buffer, len, p_max_size);
+				if (!w) {
+					return ERR_OUT_OF_MEMORY;
+				}
+				return encode_variant(p_variant, w, len, p_full_objects);
+			}
+			[[fallthrough]];
+		}
+		default: {
+			// Everything else has a small fixed size, a Transform being the largest.
+			uint32_t ofs = r_buffer.size();
+			r_buffer.resize(ofs + 4 + 12 * 4);
+			int len;
+			Error err = encode_variant(p_variant, r_buffer.ptr() + ofs, len, p_full_objects);
+			ERR_FAIL_COND_V(err != OK, err);
+			r_buffer.resize(ofs + len);
+			if (r_buffer.size() > p_max_size) {
+				return ERR_OUT_OF_MEMORY;
+			}
+		}
+	}
+
+	return OK;
+}
+
+static Error _skip_string(const uint8_t *&buf, int &len) {
+	ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
+	int32_t strlen = decode_uint32(buf);
+	ERR_FAIL_COND_V(strlen < 0 || strlen > INT_MAX - 7, ERR_INVALID_DATA);
+	int32_t size = 4 + ((strlen + 3) & ~3);
+	ERR_FAIL_COND_V(size > len, ERR_FILE_EOF);
+	buf += size;
+	len -= size;
+	return OK;
+}
+
+Error decode_variant_view(EncodedVariantView &r_view, const uint8_t *p_buffer, int p_len, int *r_len) {
+	ERR_FAIL_COND_V(p_len < 4, ERR_INVALID_DATA);
+
+	uint32_t header = decode_uint32(p_buffer);
+	ERR_FAIL_COND_V((header & ENCODE_MASK) >= Variant::VARIANT_MAX, ERR_INVALID_DATA);
+
+	const uint8_t *buf = p_buffer + 4;
+	int len = p_len - 4;
+	const uint8_t *data = buf;
+	int32_t count = 0;
+	Variant::Type type = Variant::Type(header & ENCODE_MASK);
+
+	switch (type) {
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			data = buf + 4;
+			Error err = _skip_string(buf, len);
+			if (err) {
+				return err;
+			}
+			count = decode_uint32(data - 4);
+		} break;
+		case Variant::NODE_PATH: {
+			ERR_FAIL_COND_V(len < 12, ERR_INVALID_DATA);
+			uint32_t namecount = decode_uint32(buf);
+			ERR_FAIL_COND_V(!(namecount & 0x80000000), ERR_INVALID_DATA); // Old format, not supported.
+			uint32_t subnamecount = decode_uint32(buf + 4);
+			if (decode_uint32(buf + 8) & 2) { // Obsolete format with property separate from subpath
+				subnamecount++;
+			}
+			count = (namecount & 0x7FFFFFFF) + subnamecount;
+			ERR_FAIL_COND_V(count < 0, ERR_INVALID_DATA);
+			buf += 12;
+			len -= 12;
+			data = buf;
+			for (int i = 0; i < count; i++) {
+				Error err = _skip_string(buf, len);
+				if (err) {
+					return err;
+				}
+			}
+		} break;
+		case Variant::OBJECT: {
+			if (header & ENCODE_FLAG_OBJECT_AS_ID) {
+				ERR_FAIL_COND_V(len < 8, ERR_INVALID_DATA);
+				buf += 8;
+				len -= 8;
+				break;
+			}
+
+			ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
+			bool is_null = decode_uint32(buf) == 0;
+			Error err = _skip_string(buf, len);
+			if (err) {
+				return err;
+			}
+			if (is_null) {
+				break;
+			}
+
+			ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
+			count = decode_uint32(buf);
+			ERR_FAIL_COND_V(count < 0, ERR_INVALID_DATA);
+			buf += 4;
+			len -= 4;
+			for (int i = 0; i < count; i++) {
+				err = _skip_string(buf, len);
+				if (err) {
+					return err;
+				}
+				EncodedVariantView value;
+				int used;
+				err = decode_variant_view(value, buf, len, &used);
+				if (err) {
+					return err;
+				}
+				buf += used;
+				len -= used;
+			}
+		} break;
+		case Variant::DICTIONARY:
+		case Variant::ARRAY: {
+			ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
+			count = decode_uint32(buf) & 0x7FFFFFFF;
+			buf += 4;
+			len -= 4;
+			data = buf;
+
+			ERR_FAIL_COND_V(type == Variant::DICTIONARY && count > INT_MAX / 2, ERR_INVALID_DATA);
+			int elements = type == Variant::DICTIONARY ? count * 2 : count;
+			for (int i = 0; i < elements; i++) {
+				EncodedVariantView element;
+				int used;
+				Error err = decode_variant_view(element, buf, len, &used);
+				if (err) {
+					return err;
+				}
+				buf += used;
+				len -= used;
+			}
+		} break;
+		case Variant::PACKED_STRING_ARRAY: {
+			ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
+			count = decode_uint32(buf);
+			ERR_FAIL_COND_V(count < 0, ERR_INVALID_DATA);
+			buf += 4;
+			len -= 4;
+			data = buf;
+			for (int i = 0; i < count; i++) {
+				Error err = _skip_string(buf, len);
+				if (err) {
+					return err;
+				}
+			}
+		} break;
+		case Variant::PACKED_BYTE_ARRAY:
+		case Variant::PACKED_INT32_ARRAY:
+		case Variant::PACKED_INT64_ARRAY:
+		case Variant::PACKED_FLOAT32_ARRAY:
+		case Variant::PACKED_FLOAT64_ARRAY:
+		case Variant::PACKED_VECTOR2_ARRAY:
+		case Variant::PACKED_VECTOR3_ARRAY:
+		case Variant::PACKED_COLOR_ARRAY: {
+			static const int element_sizes[] = { 1, 4, 8, 4, 8, 0, 8, 12, 16 };
+			int element_size = element_sizes[type - Variant::PACKED_BYTE_ARRAY];
+
+			ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
+			count = decode_uint32(buf);
+			buf += 4;
+			len -= 4;
+			data = buf;
+
+			ERR_FAIL_MUL_OF(count, element_size, ERR_INVALID_DATA);
+			int size = count * element_size;
+			if (type == Variant::PACKED_BYTE_ARRAY) {
+				ERR_FAIL_COND_V(size > INT_MAX - 3, ERR_INVALID_DATA);
+				size = (size + 3) & ~3;
+			}
+			ERR_FAIL_COND_V(size > len, ERR_INVALID_DATA);
+			buf += size;
+			len -= size;
+		} break;
+		default: {
+			// Fixed size types.
+			int size = 0;
+			switch (type) {
+				case Variant::BOOL:
+					size = 4;
+					break;
+				case Variant::INT:
+				case Variant::FLOAT:
+					size = (header & ENCODE_FLAG_64) ? 8 : 4;
+					break;
+				case Variant::VECTOR2:
+				case Variant::VECTOR2I:
+					size = 4 * 2;
+					break;
+				case Variant::VECTOR3:
+				case Variant::VECTOR3I:
+					size = 4 * 3;
+					break;
+				case Variant::RECT2:
+				case Variant::RECT2I:
+				case Variant::PLANE:
+				case Variant::QUAT:
+				case Variant::COLOR:
+					size = 4 * 4;
+					break;
+				case Variant::TRANSFORM2D:
+				case Variant::AABB:
+					size = 4 * 6;
+					break;
+				case Variant::BASIS:
+					size = 4 * 9;
+					break;
+				case Variant::TRANSFORM:
+					size = 4 * 12;
+					break;
+				default: {
+				} // NIL, RID, Callable and Signal carry no payload.
+			}
+			ERR_FAIL_COND_V(len < size, ERR_INVALID_DATA);
+			buf += size;
+			len -= size;
+		}
+	}
+
+	r_view.type = type;
+	r_view.buffer = p_buffer;
+	r_view.length = buf - p_buffer;
+	r_view.data = data;
+	r_view.count = count;
+	if (r_len) {
+		*r_len = r_view.length;
+	}
+
+	return OK;
+}
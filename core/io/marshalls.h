@@ -31,6 +31,7 @@
 #ifndef MARSHALLS_H
 #define MARSHALLS_H
 
+#include "core/local_vector.h"
 #include "core/reference.h"
 #include "core/typedefs.h"
 #include "core/variant.h"
@@ -181,6 +182,30 @@ public:
 };
 
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false);
+
+/**
+  * Non-owning view of an encoded Variant, filled by decode_variant_view().
+  * Strings and packed arrays are not copied: "data" points into the source
+  * buffer, which must outlive the view. Array and dictionary elements (keys
+  * and values alternating) are stored one after the other starting at "data",
+  * and can be walked with further calls to decode_variant_view().
+  */
+struct EncodedVariantView {
+	Variant::Type type = Variant::NIL;
+	const uint8_t *buffer = nullptr; ///< Start of the encoded value, header included.
+	int length = 0; ///< Size of the encoded value, padding included.
+	const uint8_t *data = nullptr; ///< Start of the payload, past the header and the element count if any.
+	int count = 0; ///< UTF-8 bytes for strings, elements for arrays and packed arrays, names for node paths, pairs for dictionaries.
+
+	Error get_variant(Variant &r_variant, bool p_allow_objects = false) const {
+		return decode_variant(r_variant, buffer, length, nullptr, p_allow_objects);
+	}
+};
+
+Error decode_variant_view(EncodedVariantView &r_view, const uint8_t *p_buffer, int p_len, int *r_len = nullptr);
 Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false);
+// Appends to r_buffer in a single pass. Fails with ERR_OUT_OF_MEMORY, without
+// allocating the rest of the value, as soon as r_buffer would grow past p_max_size.
+Error encode_variant(const Variant &p_variant, LocalVector<uint8_t> &r_buffer, bool p_full_objects = false, uint32_t p_max_size = UINT32_MAX);
 
 #endif // MARSHALLS_H
@@ -31,19 +31,23 @@
 #include "multiplayer_api.h"
 
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/performance_counter.h"
+#include "core/io/json.h"
 #include "core/io/marshalls.h"
+#include "core/io/multiplayer_replicator.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
 #include "scene/main/node.h"
 
 #include <stdint.h>
 
+static PerformanceCounter bytes_sent_counter("network/multiplayer_bytes_sent", true);
+static PerformanceCounter bytes_received_counter("network/multiplayer_bytes_received", true);
+
 #define NODE_ID_COMPRESSION_SHIFT 3
 #define NAME_ID_COMPRESSION_SHIFT 5
 #define BYTE_ONLY_OR_NO_ARGS_SHIFT 6
 
-#ifdef DEBUG_ENABLED
-#include "core/os/os.h"
-#endif
-
 _FORCE_INLINE_ bool _should_call_local(MultiplayerAPI::RPCMode mode, bool is_master, bool &r_skip_rpc) {
 	switch (mode) {
 		case MultiplayerAPI::RPC_MODE_DISABLED: {
@@ -98,11 +102,97 @@ _FORCE_INLINE_ bool _can_call_mode(Node *p_node, MultiplayerAPI::RPCMode mode, i
 	return false;
 }
 
+#ifdef DEBUG_ENABLED
+void _profile_node_data(const String &p_what, ObjectID p_id) {
+	if (EngineDebugger::is_profiling("multiplayer")) {
+		Array values;
+		values.push_back("node");
+		values.push_back(p_id);
+		values.push_back(p_what);
+		EngineDebugger::profiler_add_frame_data("multiplayer", values);
+	}
+}
+
+void _profile_bandwidth_data(const String &p_inout, int p_size) {
+	if (EngineDebugger::is_profiling("multiplayer")) {
+		Array values;
+		values.push_back("bandwidth");
+		values.push_back(p_inout);
+		values.push_back(OS::get_singleton()->get_ticks_msec());
+		values.push_back(p_size);
+		EngineDebugger::profiler_add_frame_data("multiplayer", values);
+	}
+}
+#endif
+
+bool MultiplayerAPI::_is_rpc_profiling() const {
+#ifdef DEBUG_ENABLED
+	if (EngineDebugger::is_profiling("multiplayer")) {
+		return true;
+	}
+#endif
+	return rpc_profiling;
+}
+
+void MultiplayerAPI::_profile_rpc(Node *p_node, const StringName &p_name, bool p_rset, bool p_incoming, int p_peer, bool p_unreliable, int p_bytes, uint64_t p_usec) {
+#ifdef DEBUG_ENABLED
+	if (EngineDebugger::is_profiling("multiplayer")) {
+		Array values;
+		values.push_back("rpc");
+		values.push_back(p_node->get_instance_id());
+		values.push_back(p_name);
+		values.push_back(p_rset);
+		values.push_back(p_incoming);
+		values.push_back(p_peer);
+		values.push_back(p_unreliable);
+		values.push_back(p_bytes);
+		values.push_back(p_usec);
+		EngineDebugger::profiler_add_frame_data("multiplayer", values);
+	}
+#endif
+
+	if (!rpc_profiling) {
+		return;
+	}
+
+	RPCProfileKey key;
+	key.node = p_node->get_instance_id();
+	key.name = p_name;
+	key.rset = p_rset;
+	RPCProfileInfo *info = rpc_profile.getptr(key);
+	if (!info) {
+		rpc_profile[key] = RPCProfileInfo();
+		info = rpc_profile.getptr(key);
+		info->node_path = p_node->get_path();
+	}
+
+	if (p_incoming) {
+		info->incoming_calls++;
+		info->incoming_bytes += p_bytes;
+		info->decode_usec += p_usec;
+	} else {
+		info->outgoing_calls++;
+		info->outgoing_bytes += p_bytes;
+		info->encode_usec += p_usec;
+		if (p_unreliable) {
+			info->unreliable_calls++;
+		}
+	}
+	info->peers.insert(p_peer);
+}
+
 void MultiplayerAPI::poll() {
 	if (!network_peer.is_valid() || network_peer->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_DISCONNECTED) {
 		return;
 	}
 
+	last_frame_packets_sent = frame_packets_sent;
+	last_frame_bytes_sent = frame_bytes_sent;
+	frame_packets_sent = 0;
+	frame_bytes_sent = 0;
+
+	flush_batches(); // Anything queued since the last flush goes out before polling.
+
 	network_peer->poll();
 
 	if (!network_peer.is_valid()) { // It's possible that polling might have resulted in a disconnection, so check here.
@@ -120,6 +210,11 @@ void MultiplayerAPI::poll() {
 			break; // Something is wrong!
 		}
 
+#ifdef DEBUG_ENABLED
+		_profile_bandwidth_data("in", len);
+#endif
+		bytes_received_counter.add(len);
+
 		rpc_sender_id = sender;
 		_process_packet(sender, packet, len);
 		rpc_sender_id = 0;
@@ -135,6 +230,12 @@ void MultiplayerAPI::clear() {
 	path_get_cache.clear();
 	path_send_cache.clear();
 	packet_cache.clear();
+	peer_batches.clear();
+	peer_stats.clear();
+	for (int i = 0; i < 3; i++) {
+		client_batch_target[i] = 0;
+	}
+	replicator->clear();
 	last_send_cache_id = 1;
 }
 
@@ -174,29 +275,6 @@ Ref<NetworkedMultiplayerPeer> MultiplayerAPI::get_network_peer() const {
 	return network_peer;
 }
 
-#ifdef DEBUG_ENABLED
-void _profile_node_data(const String &p_what, ObjectID p_id) {
-	if (EngineDebugger::is_profiling("multiplayer")) {
-		Array values;
-		values.push_back("node");
-		values.push_back(p_id);
-		values.push_back(p_what);
-		EngineDebugger::profiler_add_frame_data("multiplayer", values);
-	}
-}
-
-void _profile_bandwidth_data(const String &p_inout, int p_size) {
-	if (EngineDebugger::is_profiling("multiplayer")) {
-		Array values;
-		values.push_back("bandwidth");
-		values.push_back(p_inout);
-		values.push_back(OS::get_singleton()->get_ticks_msec());
-		values.push_back(p_size);
-		EngineDebugger::profiler_add_frame_data("multiplayer", values);
-	}
-}
-#endif
-
 // Returns the packet size stripping the node path added when the node is not yet cached.
 int get_packet_len(uint32_t p_node_target, int p_packet_len) {
 	if (p_node_target & 0x80000000) {
@@ -211,10 +289,6 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 	ERR_FAIL_COND_MSG(root_node == nullptr, "Multiplayer root node was not initialized. If you are using custom multiplayer, remember to set the root node via MultiplayerAPI.set_root_node before using it.");
 	ERR_FAIL_COND_MSG(p_packet_len < 1, "Invalid packet received. Size too small.");
 
-#ifdef DEBUG_ENABLED
-	_profile_bandwidth_data("in", p_packet_len);
-#endif
-
 	// Extract the `packet_type` from the LSB three bits:
 	uint8_t packet_type = p_packet[0] & 7;
 
@@ -310,6 +384,14 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 		case NETWORK_COMMAND_RAW: {
 			_process_raw(p_from, p_packet, p_packet_len);
 		} break;
+
+		case NETWORK_COMMAND_BATCH: {
+			_process_batch(p_from, p_packet, p_packet_len);
+		} break;
+
+		case NETWORK_COMMAND_REPLICATE: {
+			replicator->process_packet(p_from, p_packet, p_packet_len);
+		} break;
 	}
 }
 
@@ -397,6 +479,9 @@ void MultiplayerAPI::_process_rpc(Node *p_node, const uint16_t p_rpc_method_id,
 	_profile_node_data("in_rpc", p_node->get_instance_id());
 #endif
 
+	const bool profiling = _is_rpc_profiling();
+	const uint64_t profile_start = profiling ? OS::get_singleton()->get_ticks_usec() : 0;
+
 	if (byte_only) {
 		Vector<uint8_t> pure_data;
 		const int len = p_packet_len - p_offset;
@@ -418,6 +503,10 @@ void MultiplayerAPI::_process_rpc(Node *p_node, const uint16_t p_rpc_method_id,
 		}
 	}
 
+	if (profiling) {
+		_profile_rpc(p_node, name, false, true, p_from, false, p_packet_len, OS::get_singleton()->get_ticks_usec() - profile_start);
+	}
+
 	Callable::CallError ce;
 
 	p_node->call(name, (const Variant **)argp.ptr(), argc, ce);
@@ -447,11 +536,18 @@ void MultiplayerAPI::_process_rset(Node *p_node, const uint16_t p_rpc_property_i
 	_profile_node_data("in_rset", p_node->get_instance_id());
 #endif
 
+	const bool profiling = _is_rpc_profiling();
+	const uint64_t profile_start = profiling ? OS::get_singleton()->get_ticks_usec() : 0;
+
 	Variant value;
 	Error err = _decode_and_decompress_variant(value, &p_packet[p_offset], p_packet_len - p_offset, nullptr);
 
 	ERR_FAIL_COND_MSG(err != OK, "Invalid packet received. Unable to decode RSET value.");
 
+	if (profiling) {
+		_profile_rpc(p_node, name, true, true, p_from, false, p_packet_len, OS::get_singleton()->get_ticks_usec() - profile_start);
+	}
+
 	bool valid;
 
 	p_node->set(name, value, &valid);
@@ -504,9 +600,7 @@ void MultiplayerAPI::_process_simplify_path(int p_from, const uint8_t *p_packet,
 	packet.write[1] = valid_rpc_checksum;
 	encode_cstring(pname.get_data(), &packet.write[2]);
 
-	network_peer->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
-	network_peer->set_target_peer(p_from);
-	network_peer->put_packet(packet.ptr(), packet.size());
+	_send_packet(p_from, NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE, packet.ptr(), packet.size());
 }
 
 void MultiplayerAPI::_process_confirm_path(int p_from, const uint8_t *p_packet, int p_packet_len) {
@@ -582,9 +676,7 @@ bool MultiplayerAPI::_send_confirm_path(Node *p_node, NodePath p_path, PathSentC
 		ofs += encode_cstring(path.get_data(), &packet.write[ofs]);
 
 		for (List<int>::Element *E = peers_to_add.front(); E; E = E->next()) {
-			network_peer->set_target_peer(E->get()); // To all of you.
-			network_peer->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
-			network_peer->put_packet(packet.ptr(), packet.size());
+			_send_packet(E->get(), NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE, packet.ptr(), packet.size()); // To all of you.
 
 			psc->confirmed_peers.insert(E->get(), false); // Insert into confirmed, but as false since it was not confirmed.
 		}
@@ -763,6 +855,9 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 		ERR_FAIL_MSG("Attempt to remote call unexisting ID: " + itos(p_to) + ".");
 	}
 
+	const bool profiling = _is_rpc_profiling();
+	const uint64_t profile_start = profiling ? OS::get_singleton()->get_ticks_usec() : 0;
+
 	NodePath from_path = (root_node->get_path()).rel_path_to(p_from->get_path());
 	ERR_FAIL_COND_MSG(from_path.is_empty(), "Unable to send RPC. Relative path is empty. THIS IS LIKELY A BUG IN THE ENGINE!");
 
@@ -922,13 +1017,29 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 	_profile_bandwidth_data("out", ofs);
 #endif
 
-	// Take chance and set transfer mode, since all send methods will use it.
-	network_peer->set_transfer_mode(p_unreliable ? NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE : NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
+	// One sample per peer the packet reaches, the encoding time goes to the first one.
+	uint64_t encode_usec = profiling ? OS::get_singleton()->get_ticks_usec() - profile_start : 0;
+
+	const NetworkedMultiplayerPeer::TransferMode transfer_mode = p_unreliable ? NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE : NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE;
 
 	if (has_all_peers) {
 		// They all have verified paths, so send fast.
-		network_peer->set_target_peer(p_to); // To all of you.
-		network_peer->put_packet(packet_cache.ptr(), ofs); // A message with love.
+		_send_packet(p_to, transfer_mode, packet_cache.ptr(), ofs); // A message with love.
+
+		if (profiling) {
+			// Same targets as _put_packet(), clients only ever talk to the server directly.
+			if (p_to > 0 || !network_peer->is_server()) {
+				_profile_rpc(p_from, p_name, p_set, false, p_to > 0 ? p_to : (int)NetworkedMultiplayerPeer::TARGET_PEER_SERVER, p_unreliable, ofs, encode_usec);
+			} else {
+				for (Set<int>::Element *E = connected_peers.front(); E; E = E->next()) {
+					if (E->get() == -p_to) {
+						continue;
+					}
+					_profile_rpc(p_from, p_name, p_set, false, E->get(), p_unreliable, ofs, encode_usec);
+					encode_usec = 0;
+				}
+			}
+		}
 	} else {
 		// Unreachable because the node ID is never compressed if the peers doesn't know it.
 		CRASH_COND(node_id_compression != NETWORK_NODE_ID_COMPRESSION_32);
@@ -953,17 +1064,22 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 			Map<int, bool>::Element *F = psc->confirmed_peers.find(E->get());
 			ERR_CONTINUE(!F); // Should never happen.
 
-			network_peer->set_target_peer(E->get()); // To this one specifically.
-
 			if (F->get()) {
 				// This one confirmed path, so use id.
 				encode_uint32(psc->id, &(packet_cache.write[1]));
-				network_peer->put_packet(packet_cache.ptr(), ofs);
+				_send_packet(E->get(), transfer_mode, packet_cache.ptr(), ofs); // To this one specifically.
+				if (profiling) {
+					_profile_rpc(p_from, p_name, p_set, false, E->get(), p_unreliable, ofs, encode_usec);
+				}
 			} else {
 				// This one did not confirm path yet, so use entire path (sorry!).
 				encode_uint32(0x80000000 | ofs, &(packet_cache.write[1])); // Offset to path and flag.
-				network_peer->put_packet(packet_cache.ptr(), ofs + path_len);
+				_send_packet(E->get(), transfer_mode, packet_cache.ptr(), ofs + path_len);
+				if (profiling) {
+					_profile_rpc(p_from, p_name, p_set, false, E->get(), p_unreliable, ofs + path_len, encode_usec);
+				}
 			}
+			encode_usec = 0;
 		}
 	}
 }
@@ -976,6 +1092,9 @@ void MultiplayerAPI::_add_peer(int p_id) {
 
 void MultiplayerAPI::_del_peer(int p_id) {
 	connected_peers.erase(p_id);
+	peer_batches.erase(p_id);
+	peer_stats.erase(p_id);
+	replicator->del_peer(p_id);
 	// Cleanup get cache.
 	path_get_cache.erase(p_id);
 	// Cleanup sent cache.
@@ -1141,10 +1260,7 @@ Error MultiplayerAPI::send_bytes(Vector<uint8_t> p_data, int p_to, NetworkedMult
 	packet_cache.write[0] = NETWORK_COMMAND_RAW;
 	memcpy(&packet_cache.write[1], &r[0], p_data.size());
 
-	network_peer->set_target_peer(p_to);
-	network_peer->set_transfer_mode(p_mode);
-
-	return network_peer->put_packet(packet_cache.ptr(), p_data.size() + 1);
+	return _send_packet(p_to, p_mode, packet_cache.ptr(), p_data.size() + 1);
 }
 
 void MultiplayerAPI::_process_raw(int p_from, const uint8_t *p_packet, int p_packet_len) {
@@ -1160,6 +1276,223 @@ void MultiplayerAPI::_process_raw(int p_from, const uint8_t *p_packet, int p_pac
 	emit_signal("network_peer_packet", p_from, out);
 }
 
+void MultiplayerAPI::_process_batch(int p_from, const uint8_t *p_packet, int p_packet_len) {
+	int ofs = 1;
+	while (ofs < p_packet_len) {
+		ERR_FAIL_COND_MSG(ofs + 2 > p_packet_len, "Invalid packet received. Size too small.");
+		int len = decode_uint16(&p_packet[ofs]);
+		ofs += 2;
+		ERR_FAIL_COND_MSG(len < 1 || ofs + len > p_packet_len, "Invalid packet received. Batched packet size is out of bounds.");
+		ERR_FAIL_COND_MSG((p_packet[ofs] & 7) == NETWORK_COMMAND_BATCH, "Invalid packet received. Batches can't be nested.");
+
+		_process_packet(p_from, &p_packet[ofs], len);
+		ofs += len;
+
+		if (!network_peer.is_valid()) {
+			break; // A batched packet caused a disconnection.
+		}
+	}
+}
+
+Error MultiplayerAPI::_put_packet(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_data, int p_len) {
+	network_peer->set_transfer_mode(p_mode);
+	network_peer->set_target_peer(p_to);
+
+	// Account the packet to every peer it reaches. Clients only ever talk to the server directly.
+	if (p_to > 0 || !network_peer->is_server()) {
+		PeerStats &stats = peer_stats[p_to > 0 ? p_to : (int)NetworkedMultiplayerPeer::TARGET_PEER_SERVER];
+		stats.packets_sent++;
+		stats.bytes_sent += p_len;
+		frame_packets_sent++;
+		frame_bytes_sent += p_len;
+	} else {
+		for (Set<int>::Element *E = connected_peers.front(); E; E = E->next()) {
+			if (E->get() == -p_to) {
+				continue;
+			}
+			PeerStats &stats = peer_stats[E->get()];
+			stats.packets_sent++;
+			stats.bytes_sent += p_len;
+			frame_packets_sent++;
+			frame_bytes_sent += p_len;
+		}
+	}
+
+	bytes_sent_counter.add(p_len);
+
+	return network_peer->put_packet(p_data, p_len);
+}
+
+Error MultiplayerAPI::_send_packet(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_data, int p_len) {
+	if (!rpc_batching) {
+		return _put_packet(p_to, p_mode, p_data, p_len);
+	}
+
+	if (p_len > UINT16_MAX) {
+		// Too big to be batched, keep the order by sending what is queued first.
+		flush_batches();
+		return _put_packet(p_to, p_mode, p_data, p_len);
+	}
+
+	if (!network_peer->is_server()) {
+		// Clients reach other peers through the server, so broadcasts are not expanded.
+		// Batches are keyed by target instead, flushing when the target changes to keep the order.
+		if (client_batch_target[p_mode] != p_to) {
+			PeerBatches *previous = peer_batches.getptr(client_batch_target[p_mode]);
+			if (previous) {
+				_flush_batch(client_batch_target[p_mode], p_mode, previous->modes[p_mode]);
+			}
+			client_batch_target[p_mode] = p_to;
+		}
+		_batch_packet(p_to, p_mode, p_data, p_len);
+		return OK;
+	}
+
+	// The payload is encoded once and copied into the batch of each target peer.
+	for (Set<int>::Element *E = connected_peers.front(); E; E = E->next()) {
+		const int peer = E->get();
+		if ((p_to > 0 && peer != p_to) || (p_to < 0 && peer == -p_to)) {
+			continue;
+		}
+		_batch_packet(peer, p_mode, p_data, p_len);
+	}
+
+	return OK;
+}
+
+void MultiplayerAPI::_batch_packet(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_data, int p_len) {
+	PeerBatch &batch = peer_batches[p_to].modes[p_mode];
+	if (batch.count > 0 && (int)batch.buffer.size() + 2 + p_len > rpc_batch_max_size) {
+		_flush_batch(p_to, p_mode, batch);
+	}
+
+	uint32_t ofs = batch.buffer.size();
+	if (ofs == 0) {
+		batch.buffer.push_back(NETWORK_COMMAND_BATCH);
+		ofs = 1;
+	}
+	batch.buffer.resize(ofs + 2 + p_len);
+	encode_uint16(p_len, &batch.buffer[ofs]);
+	copymem(&batch.buffer[ofs + 2], p_data, p_len);
+	batch.count++;
+}
+
+void MultiplayerAPI::_flush_batch(int p_peer, NetworkedMultiplayerPeer::TransferMode p_mode, PeerBatch &p_batch) {
+	if (p_batch.count == 1) {
+		// A single packet is sent as is, without the batch header.
+		_put_packet(p_peer, p_mode, &p_batch.buffer[3], p_batch.buffer.size() - 3);
+	} else if (p_batch.count > 1) {
+		_put_packet(p_peer, p_mode, p_batch.buffer.ptr(), p_batch.buffer.size());
+	}
+
+	p_batch.buffer.clear();
+	p_batch.count = 0;
+}
+
+void MultiplayerAPI::flush_batches() {
+	if (peer_batches.empty() || !network_peer.is_valid()) {
+		return;
+	}
+
+	const int *k = nullptr;
+	while ((k = peer_batches.next(k))) {
+		PeerBatches &batches = peer_batches[*k];
+		// Reliable traffic first, it is what the unreliable state usually depends on.
+		_flush_batch(*k, NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE, batches.modes[NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE]);
+		_flush_batch(*k, NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE_ORDERED, batches.modes[NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE_ORDERED]);
+		_flush_batch(*k, NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE, batches.modes[NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE]);
+	}
+}
+
+void MultiplayerAPI::set_rpc_batching_enabled(bool p_enabled) {
+	if (rpc_batching && !p_enabled) {
+		flush_batches();
+	}
+	rpc_batching = p_enabled;
+}
+
+bool MultiplayerAPI::is_rpc_batching_enabled() const {
+	return rpc_batching;
+}
+
+void MultiplayerAPI::set_rpc_batch_max_size(int p_size) {
+	ERR_FAIL_COND_MSG(p_size < 16 || p_size > UINT16_MAX, "The batch size must be between 16 and 65535 bytes.");
+	rpc_batch_max_size = p_size;
+}
+
+int MultiplayerAPI::get_rpc_batch_max_size() const {
+	return rpc_batch_max_size;
+}
+
+Dictionary MultiplayerAPI::get_peer_stats(int p_peer_id) const {
+	Dictionary stats;
+	const PeerStats *ps = peer_stats.getptr(p_peer_id);
+	stats["packets_sent"] = ps ? ps->packets_sent : 0;
+	stats["bytes_sent"] = ps ? ps->bytes_sent : 0;
+	return stats;
+}
+
+void MultiplayerAPI::set_rpc_profiling_enabled(bool p_enabled) {
+	rpc_profiling = p_enabled;
+}
+
+bool MultiplayerAPI::is_rpc_profiling_enabled() const {
+	return rpc_profiling;
+}
+
+Array MultiplayerAPI::get_rpc_profile() const {
+	Array ret;
+	const RPCProfileKey *k = nullptr;
+	while ((k = rpc_profile.next(k))) {
+		const RPCProfileInfo &info = rpc_profile[*k];
+		Dictionary d;
+		d["node_path"] = info.node_path;
+		d["name"] = k->name;
+		d["type"] = k->rset ? "rset" : "rpc";
+		d["incoming_calls"] = info.incoming_calls;
+		d["incoming_bytes"] = info.incoming_bytes;
+		d["decode_usec"] = info.decode_usec;
+		d["outgoing_calls"] = info.outgoing_calls;
+		d["outgoing_bytes"] = info.outgoing_bytes;
+		d["encode_usec"] = info.encode_usec;
+		d["unreliable_calls"] = info.unreliable_calls;
+		Vector<int> peers;
+		for (Set<int>::Element *E = info.peers.front(); E; E = E->next()) {
+			peers.push_back(E->get());
+		}
+		d["peers"] = peers;
+		ret.push_back(d);
+	}
+	return ret;
+}
+
+void MultiplayerAPI::clear_rpc_profile() {
+	rpc_profile.clear();
+}
+
+Error MultiplayerAPI::dump_rpc_profile(const String &p_path) const {
+	Error err;
+	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(!f, err, "Cannot open file '" + p_path + "' to dump the RPC profile.");
+
+	f->store_string(JSON::print(get_rpc_profile(), "\t"));
+	f->close();
+	memdelete(f);
+	return OK;
+}
+
+void MultiplayerAPI::replicate_property(Node *p_node, const StringName &p_property, int p_bits, float p_min, float p_max) {
+	replicator->replicate_property(p_node, p_property, p_bits, p_min, p_max);
+}
+
+void MultiplayerAPI::stop_replicating(Node *p_node) {
+	replicator->stop_replicating(p_node);
+}
+
+void MultiplayerAPI::send_snapshot() {
+	replicator->send_snapshot();
+}
+
 int MultiplayerAPI::get_network_unique_id() const {
 	ERR_FAIL_COND_V_MSG(!network_peer.is_valid(), 0, "No network peer is assigned. Unable to get unique network ID.");
 	return network_peer->get_unique_id();
@@ -1217,9 +1550,26 @@ void MultiplayerAPI::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_refusing_new_network_connections"), &MultiplayerAPI::is_refusing_new_network_connections);
 	ClassDB::bind_method(D_METHOD("set_allow_object_decoding", "enable"), &MultiplayerAPI::set_allow_object_decoding);
 	ClassDB::bind_method(D_METHOD("is_object_decoding_allowed"), &MultiplayerAPI::is_object_decoding_allowed);
+	ClassDB::bind_method(D_METHOD("set_rpc_batching_enabled", "enabled"), &MultiplayerAPI::set_rpc_batching_enabled);
+	ClassDB::bind_method(D_METHOD("is_rpc_batching_enabled"), &MultiplayerAPI::is_rpc_batching_enabled);
+	ClassDB::bind_method(D_METHOD("set_rpc_batch_max_size", "size"), &MultiplayerAPI::set_rpc_batch_max_size);
+	ClassDB::bind_method(D_METHOD("get_rpc_batch_max_size"), &MultiplayerAPI::get_rpc_batch_max_size);
+	ClassDB::bind_method(D_METHOD("flush_batches"), &MultiplayerAPI::flush_batches);
+	ClassDB::bind_method(D_METHOD("get_peer_stats", "peer_id"), &MultiplayerAPI::get_peer_stats);
+	ClassDB::bind_method(D_METHOD("set_rpc_profiling_enabled", "enabled"), &MultiplayerAPI::set_rpc_profiling_enabled);
+	ClassDB::bind_method(D_METHOD("is_rpc_profiling_enabled"), &MultiplayerAPI::is_rpc_profiling_enabled);
+	ClassDB::bind_method(D_METHOD("get_rpc_profile"), &MultiplayerAPI::get_rpc_profile);
+	ClassDB::bind_method(D_METHOD("clear_rpc_profile"), &MultiplayerAPI::clear_rpc_profile);
+	ClassDB::bind_method(D_METHOD("dump_rpc_profile", "path"), &MultiplayerAPI::dump_rpc_profile);
+	ClassDB::bind_method(D_METHOD("replicate_property", "node", "property", "bits", "min", "max"), &MultiplayerAPI::replicate_property, DEFVAL(0), DEFVAL(0), DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("stop_replicating", "node"), &MultiplayerAPI::stop_replicating);
+	ClassDB::bind_method(D_METHOD("send_snapshot"), &MultiplayerAPI::send_snapshot);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "allow_object_decoding"), "set_allow_object_decoding", "is_object_decoding_allowed");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "refuse_new_network_connections"), "set_refuse_new_network_connections", "is_refusing_new_network_connections");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "rpc_batching_enabled"), "set_rpc_batching_enabled", "is_rpc_batching_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "rpc_batch_max_size", PROPERTY_HINT_RANGE, "16,65535,1"), "set_rpc_batch_max_size", "get_rpc_batch_max_size");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "rpc_profiling_enabled"), "set_rpc_profiling_enabled", "is_rpc_profiling_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "network_peer", PROPERTY_HINT_RESOURCE_TYPE, "NetworkedMultiplayerPeer", 0), "set_network_peer", "get_network_peer");
 	ADD_PROPERTY_DEFAULT("refuse_new_network_connections", false);
 
@@ -1240,9 +1590,11 @@ void MultiplayerAPI::_bind_methods() {
 }
 
 MultiplayerAPI::MultiplayerAPI() {
+	replicator = memnew(MultiplayerReplicator(this));
 	clear();
 }
 
 MultiplayerAPI::~MultiplayerAPI() {
 	clear();
+	memdelete(replicator);
 }
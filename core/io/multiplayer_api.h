@@ -32,11 +32,16 @@
 #define MULTIPLAYER_API_H
 
 #include "core/io/networked_multiplayer_peer.h"
+#include "core/local_vector.h"
 #include "core/reference.h"
 
+class MultiplayerReplicator;
+
 class MultiplayerAPI : public Reference {
 	GDCLASS(MultiplayerAPI, Reference);
 
+	friend class MultiplayerReplicator;
+
 private:
 	//path sent caches
 	struct PathSentCache {
@@ -64,6 +69,72 @@ private:
 	Node *root_node = nullptr;
 	bool allow_object_decoding = false;
 
+	// Outgoing packets coalesced per peer and transfer mode until the next flush.
+	struct PeerBatch {
+		LocalVector<uint8_t> buffer;
+		uint32_t count = 0;
+	};
+
+	struct PeerBatches {
+		PeerBatch modes[3]; // One per NetworkedMultiplayerPeer::TransferMode.
+	};
+
+	struct PeerStats {
+		uint64_t packets_sent = 0;
+		uint64_t bytes_sent = 0;
+	};
+
+	bool rpc_batching = false;
+	int rpc_batch_max_size = 1200;
+	HashMap<int, PeerBatches> peer_batches; // Keyed by peer on the server, by target on clients.
+	int client_batch_target[3] = { 0, 0, 0 };
+	HashMap<int, PeerStats> peer_stats;
+	uint64_t frame_packets_sent = 0;
+	uint64_t frame_bytes_sent = 0;
+	uint64_t last_frame_packets_sent = 0;
+	uint64_t last_frame_bytes_sent = 0;
+
+	MultiplayerReplicator *replicator = nullptr;
+
+	// Per node and per method RPC/RSET accounting, kept while rpc_profiling is enabled.
+	struct RPCProfileKey {
+		ObjectID node;
+		StringName name;
+		bool rset = false;
+
+		static uint32_t hash(const RPCProfileKey &p_key) {
+			uint32_t h = hash_djb2_one_64(uint64_t(p_key.node));
+			h = hash_djb2_one_32(p_key.name.hash(), h);
+			return hash_djb2_one_32(p_key.rset ? 1 : 0, h);
+		}
+		bool operator==(const RPCProfileKey &p_key) const {
+			return node == p_key.node && name == p_key.name && rset == p_key.rset;
+		}
+	};
+
+	struct RPCProfileInfo {
+		NodePath node_path;
+		uint64_t incoming_calls = 0;
+		uint64_t incoming_bytes = 0;
+		uint64_t decode_usec = 0;
+		uint64_t outgoing_calls = 0;
+		uint64_t outgoing_bytes = 0;
+		uint64_t encode_usec = 0;
+		uint64_t unreliable_calls = 0;
+		Set<int> peers;
+	};
+
+	bool rpc_profiling = false;
+	HashMap<RPCProfileKey, RPCProfileInfo, RPCProfileKey> rpc_profile;
+
+	bool _is_rpc_profiling() const;
+	void _profile_rpc(Node *p_node, const StringName &p_name, bool p_rset, bool p_incoming, int p_peer, bool p_unreliable, int p_bytes, uint64_t p_usec);
+
+	Error _put_packet(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_data, int p_len);
+	Error _send_packet(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_data, int p_len);
+	void _batch_packet(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_data, int p_len);
+	void _flush_batch(int p_peer, NetworkedMultiplayerPeer::TransferMode p_mode, PeerBatch &p_batch);
+
 protected:
 	static void _bind_methods();
 
@@ -74,6 +145,7 @@ protected:
 	void _process_rpc(Node *p_node, const uint16_t p_rpc_method_id, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
 	void _process_rset(Node *p_node, const uint16_t p_rpc_property_id, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
 	void _process_raw(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_batch(int p_from, const uint8_t *p_packet, int p_packet_len);
 
 	void _send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p_set, const StringName &p_name, const Variant **p_arg, int p_argcount);
 	bool _send_confirm_path(Node *p_node, NodePath p_path, PathSentCache *psc, int p_target);
@@ -88,6 +160,8 @@ public:
 		NETWORK_COMMAND_SIMPLIFY_PATH,
 		NETWORK_COMMAND_CONFIRM_PATH,
 		NETWORK_COMMAND_RAW,
+		NETWORK_COMMAND_BATCH,
+		NETWORK_COMMAND_REPLICATE,
 	};
 
 	enum NetworkNodeIdCompression {
@@ -141,6 +215,26 @@ public:
 	void set_allow_object_decoding(bool p_enable);
 	bool is_object_decoding_allowed() const;
 
+	void set_rpc_batching_enabled(bool p_enabled);
+	bool is_rpc_batching_enabled() const;
+	void set_rpc_batch_max_size(int p_size);
+	int get_rpc_batch_max_size() const;
+	void flush_batches();
+
+	Dictionary get_peer_stats(int p_peer_id) const;
+	uint64_t get_last_frame_packets_sent() const { return last_frame_packets_sent; }
+	uint64_t get_last_frame_bytes_sent() const { return last_frame_bytes_sent; }
+
+	void set_rpc_profiling_enabled(bool p_enabled);
+	bool is_rpc_profiling_enabled() const;
+	Array get_rpc_profile() const;
+	void clear_rpc_profile();
+	Error dump_rpc_profile(const String &p_path) const;
+
+	void replicate_property(Node *p_node, const StringName &p_property, int p_bits = 0, float p_min = 0, float p_max = 0);
+	void stop_replicating(Node *p_node);
+	void send_snapshot();
+
 	MultiplayerAPI();
 	~MultiplayerAPI();
 };
@@ -0,0 +1,610 @@
+/*************************************************************************/
+/*  multiplayer_replicator.cpp                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "multiplayer_replicator.h"
+
+#include "core/io/marshalls.h"
+#include "core/io/multiplayer_api.h"
+#include "scene/main/node.h"
+
+// Snapshot packets start with an 8 byte header (command, sequence, baseline
+// sequence, flags, node count) followed by the bit-packed node states.
+#define SNAPSHOT_HEADER_SIZE 8
+#define SNAPSHOT_FLAG_BASELINE 1
+#define REPLICATION_ACK_FLAG (1 << 3)
+
+class ReplicationBitWriter {
+	LocalVector<uint8_t> &buffer;
+	uint64_t acc = 0;
+	int acc_bits = 0;
+
+public:
+	_FORCE_INLINE_ void put(uint32_t p_value, int p_bits) {
+		if (p_bits < 32) {
+			p_value &= (1u << p_bits) - 1;
+		}
+		acc |= uint64_t(p_value) << acc_bits;
+		acc_bits += p_bits;
+		while (acc_bits >= 8) {
+			buffer.push_back(acc & 0xFF);
+			acc >>= 8;
+			acc_bits -= 8;
+		}
+	}
+
+	void flush() {
+		if (acc_bits > 0) {
+			buffer.push_back(acc & 0xFF);
+		}
+		acc = 0;
+		acc_bits = 0;
+	}
+
+	ReplicationBitWriter(LocalVector<uint8_t> &r_buffer) :
+			buffer(r_buffer) {}
+};
+
+class ReplicationBitReader {
+	const uint8_t *data;
+	int size;
+	int pos = 0;
+	uint64_t acc = 0;
+	int acc_bits = 0;
+
+public:
+	bool error = false;
+
+	_FORCE_INLINE_ uint32_t get(int p_bits) {
+		while (acc_bits < p_bits) {
+			if (pos >= size) {
+				error = true;
+				return 0;
+			}
+			acc |= uint64_t(data[pos++]) << acc_bits;
+			acc_bits += 8;
+		}
+		uint32_t value = p_bits < 32 ? uint32_t(acc & ((1u << p_bits) - 1)) : uint32_t(acc);
+		acc >>= p_bits;
+		acc_bits -= p_bits;
+		return value;
+	}
+
+	ReplicationBitReader(const uint8_t *p_data, int p_size) :
+			data(p_data),
+			size(p_size) {}
+};
+
+static _FORCE_INLINE_ int _get_component_bits(Variant::Type p_type, int p_bits) {
+	if (p_type == Variant::BOOL) {
+		return 1;
+	}
+	return p_bits > 0 ? p_bits : 32;
+}
+
+static _FORCE_INLINE_ uint32_t _quantize_real(real_t p_value, real_t p_min, real_t p_max, int p_bits) {
+	if (p_bits == 0) {
+		MarshallFloat mf;
+		mf.f = p_value;
+		return mf.i;
+	}
+	const double steps = double((uint64_t(1) << p_bits) - 1);
+	const double t = (CLAMP(p_value, p_min, p_max) - p_min) / (p_max - p_min);
+	return uint32_t(Math::round(t * steps));
+}
+
+static _FORCE_INLINE_ real_t _dequantize_real(uint32_t p_value, real_t p_min, real_t p_max, int p_bits) {
+	if (p_bits == 0) {
+		MarshallFloat mf;
+		mf.i = p_value;
+		return mf.f;
+	}
+	const double steps = double((uint64_t(1) << p_bits) - 1);
+	return p_min + (p_value / steps) * (p_max - p_min);
+}
+
+uint32_t MultiplayerReplicator::_get_word_count(Variant::Type p_type, int p_bits) {
+	switch (p_type) {
+		case Variant::BOOL:
+		case Variant::FLOAT:
+			return 1;
+		case Variant::INT:
+			return p_bits > 0 ? 1 : 2;
+		case Variant::VECTOR2:
+			return 2;
+		case Variant::VECTOR3:
+			return 3;
+		default:
+			return 0; // Sent in full as a variant.
+	}
+}
+
+void MultiplayerReplicator::_reset_history(NodeState &p_state) {
+	p_state.history.resize(HISTORY_SIZE * p_state.word_count);
+	for (int i = 0; i < HISTORY_SIZE; i++) {
+		p_state.history_valid[i] = false;
+	}
+	p_state.peer_first_seq.clear();
+}
+
+void MultiplayerReplicator::_quantize(const PropertySpec &p_spec, const Variant &p_value, uint32_t *r_words) {
+	switch (p_spec.type) {
+		case Variant::BOOL: {
+			r_words[0] = bool(p_value);
+		} break;
+		case Variant::INT: {
+			const int64_t value = p_value;
+			if (p_spec.bits > 0) {
+				const int64_t max = int64_t((uint64_t(1) << p_spec.bits) - 1);
+				r_words[0] = uint32_t(CLAMP(value - int64_t(p_spec.min), int64_t(0), max));
+			} else {
+				r_words[0] = uint32_t(uint64_t(value) & 0xFFFFFFFF);
+				r_words[1] = uint32_t(uint64_t(value) >> 32);
+			}
+		} break;
+		case Variant::FLOAT: {
+			r_words[0] = _quantize_real(p_value, p_spec.min, p_spec.max, p_spec.bits);
+		} break;
+		case Variant::VECTOR2: {
+			const Vector2 value = p_value;
+			r_words[0] = _quantize_real(value.x, p_spec.min, p_spec.max, p_spec.bits);
+			r_words[1] = _quantize_real(value.y, p_spec.min, p_spec.max, p_spec.bits);
+		} break;
+		case Variant::VECTOR3: {
+			const Vector3 value = p_value;
+			r_words[0] = _quantize_real(value.x, p_spec.min, p_spec.max, p_spec.bits);
+			r_words[1] = _quantize_real(value.y, p_spec.min, p_spec.max, p_spec.bits);
+			r_words[2] = _quantize_real(value.z, p_spec.min, p_spec.max, p_spec.bits);
+		} break;
+		default: {
+		}
+	}
+}
+
+Variant MultiplayerReplicator::_dequantize(const PropertySpec &p_spec, const uint32_t *p_words) {
+	switch (p_spec.type) {
+		case Variant::BOOL: {
+			return p_words[0] != 0;
+		}
+		case Variant::INT: {
+			if (p_spec.bits > 0) {
+				return int64_t(p_words[0]) + int64_t(p_spec.min);
+			}
+			return int64_t(uint64_t(p_words[0]) | (uint64_t(p_words[1]) << 32));
+		}
+		case Variant::FLOAT: {
+			return _dequantize_real(p_words[0], p_spec.min, p_spec.max, p_spec.bits);
+		}
+		case Variant::VECTOR2: {
+			return Vector2(
+					_dequantize_real(p_words[0], p_spec.min, p_spec.max, p_spec.bits),
+					_dequantize_real(p_words[1], p_spec.min, p_spec.max, p_spec.bits));
+		}
+		case Variant::VECTOR3: {
+			return Vector3(
+					_dequantize_real(p_words[0], p_spec.min, p_spec.max, p_spec.bits),
+					_dequantize_real(p_words[1], p_spec.min, p_spec.max, p_spec.bits),
+					_dequantize_real(p_words[2], p_spec.min, p_spec.max, p_spec.bits));
+		}
+		default: {
+			return Variant();
+		}
+	}
+}
+
+void MultiplayerReplicator::replicate_property(Node *p_node, const StringName &p_property, int p_bits, real_t p_min, real_t p_max) {
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND_MSG(p_bits < 0 || p_bits > 32, "Replication bit budget must be between 0 and 32.");
+
+	bool valid = false;
+	const Variant value = p_node->get(p_property, &valid);
+	ERR_FAIL_COND_MSG(!valid, "Property '" + String(p_property) + "' not found in node: " + String(p_node->get_name()) + ".");
+
+	PropertySpec spec;
+	spec.name = p_property;
+	spec.type = value.get_type();
+	spec.bits = p_bits;
+	spec.min = p_min;
+	spec.max = p_max;
+	spec.word_count = _get_word_count(spec.type, p_bits);
+
+	if (p_bits > 0 && (spec.type == Variant::FLOAT || spec.type == Variant::VECTOR2 || spec.type == Variant::VECTOR3)) {
+		ERR_FAIL_COND_MSG(p_max <= p_min, "Quantized properties need a valid range, got [" + rtos(p_min) + ", " + rtos(p_max) + "].");
+	}
+
+	const ObjectID id = p_node->get_instance_id();
+	NodeState *state = nodes.getptr(id);
+	if (!state) {
+		nodes[id] = NodeState();
+		state = nodes.getptr(id);
+	}
+
+	bool found = false;
+	for (uint32_t i = 0; i < state->properties.size(); i++) {
+		if (state->properties[i].name == p_property) {
+			state->properties[i] = spec;
+			found = true;
+			break;
+		}
+	}
+	if (!found) {
+		ERR_FAIL_COND_MSG(state->properties.size() >= MAX_PROPERTIES, "Too many replicated properties in node: " + String(p_node->get_name()) + ".");
+		state->properties.push_back(spec);
+	}
+
+	state->word_count = 0;
+	for (uint32_t i = 0; i < state->properties.size(); i++) {
+		state->properties[i].word_offset = state->word_count;
+		state->word_count += state->properties[i].word_count;
+	}
+	_reset_history(*state); // Layout changed, peers need a full state again.
+}
+
+void MultiplayerReplicator::stop_replicating(Node *p_node) {
+	ERR_FAIL_NULL(p_node);
+	nodes.erase(p_node->get_instance_id());
+}
+
+void MultiplayerReplicator::send_snapshot() {
+	ERR_FAIL_COND_MSG(multiplayer->network_peer.is_null(), "Trying to send a snapshot while no network peer is active.");
+	ERR_FAIL_COND_MSG(multiplayer->root_node == nullptr, "Multiplayer root node was not initialized. If you are using custom multiplayer, remember to set the root node via MultiplayerAPI.set_root_node before using it.");
+
+	if (multiplayer->network_peer->get_connection_status() != NetworkedMultiplayerPeer::CONNECTION_CONNECTED) {
+		return;
+	}
+
+	struct Outgoing {
+		Node *node = nullptr;
+		NodeState *state = nullptr;
+		NodePath path;
+		LocalVector<Variant> values; // Only filled for properties without a quantized form.
+	};
+
+	seq++;
+	const uint32_t slot = seq % HISTORY_SIZE;
+	const NodePath root_path = multiplayer->root_node->get_path();
+
+	LocalVector<ObjectID> freed;
+	LocalVector<Outgoing> outgoing;
+
+	// Capture the state once, it is shared by all peers.
+	for (const ObjectID *K = nodes.next(nullptr); K; K = nodes.next(K)) {
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(*K));
+		if (!node) {
+			freed.push_back(*K);
+			continue;
+		}
+		if (!node->is_inside_tree() || !node->is_network_master()) {
+			continue;
+		}
+
+		Outgoing out;
+		out.node = node;
+		out.state = nodes.getptr(*K);
+		out.path = root_path.rel_path_to(node->get_path());
+		out.values.resize(out.state->properties.size());
+
+		uint32_t *words = out.state->history.ptr() + slot * out.state->word_count;
+		for (uint32_t i = 0; i < out.state->properties.size(); i++) {
+			const PropertySpec &spec = out.state->properties[i];
+			if (spec.word_count) {
+				_quantize(spec, node->get(spec.name), words + spec.word_offset);
+			} else {
+				out.values[i] = node->get(spec.name);
+			}
+		}
+		out.state->history_seq[slot] = seq;
+		out.state->history_valid[slot] = true;
+
+		outgoing.push_back(out);
+	}
+
+	for (uint32_t i = 0; i < freed.size(); i++) {
+		nodes.erase(freed[i]);
+	}
+
+	LocalVector<uint8_t> packet;
+
+	for (Set<int>::Element *E = multiplayer->connected_peers.front(); E; E = E->next()) {
+		const int peer = E->get();
+		const uint16_t *ack = peer_acks.getptr(peer);
+		const bool has_baseline = ack && uint16_t(seq - *ack) < HISTORY_SIZE;
+		const uint16_t baseline = has_baseline ? *ack : 0;
+		const uint32_t baseline_slot = baseline % HISTORY_SIZE;
+
+		packet.resize(SNAPSHOT_HEADER_SIZE);
+		ReplicationBitWriter writer(packet);
+		uint32_t count = 0;
+
+		for (uint32_t i = 0; i < outgoing.size() && count < 0xFFFF; i++) {
+			const Outgoing &out = outgoing[i];
+			NodeState *state = out.state;
+
+			MultiplayerAPI::PathSentCache *psc = multiplayer->path_send_cache.getptr(out.path);
+			if (!psc) {
+				multiplayer->path_send_cache[out.path] = MultiplayerAPI::PathSentCache();
+				psc = multiplayer->path_send_cache.getptr(out.path);
+				psc->id = multiplayer->last_send_cache_id++;
+			}
+			if (!multiplayer->_send_confirm_path(out.node, out.path, psc, peer)) {
+				continue; // The peer can't resolve the node id yet.
+			}
+
+			uint16_t *first_seq = state->peer_first_seq.getptr(peer);
+			if (!first_seq) {
+				state->peer_first_seq[peer] = seq;
+				first_seq = state->peer_first_seq.getptr(peer);
+			} else if (uint16_t(seq - *first_seq) > HISTORY_SIZE) {
+				*first_seq = seq - HISTORY_SIZE; // Keep it comparable across sequence wrap around.
+			}
+
+			// Only delta against a snapshot the peer acknowledged and that contained this node.
+			const bool delta = has_baseline && int16_t(baseline - *first_seq) >= 0 && state->history_valid[baseline_slot] && state->history_seq[baseline_slot] == baseline;
+
+			const uint32_t id = psc->id;
+			if (id <= 0xFF) {
+				writer.put(MultiplayerAPI::NETWORK_NODE_ID_COMPRESSION_8, 2);
+				writer.put(id, 8);
+			} else if (id <= 0xFFFF) {
+				writer.put(MultiplayerAPI::NETWORK_NODE_ID_COMPRESSION_16, 2);
+				writer.put(id, 16);
+			} else {
+				writer.put(MultiplayerAPI::NETWORK_NODE_ID_COMPRESSION_32, 2);
+				writer.put(id, 32);
+			}
+			writer.put(delta, 1);
+			writer.put(state->properties.size(), 8);
+
+			const uint32_t *current = state->history.ptr() + slot * state->word_count;
+			const uint32_t *base = state->history.ptr() + baseline_slot * state->word_count;
+
+			for (uint32_t j = 0; j < state->properties.size(); j++) {
+				const PropertySpec &spec = state->properties[j];
+				const uint32_t *words = current + spec.word_offset;
+
+				if (!spec.word_count) {
+					if (delta) {
+						writer.put(1, 1); // Variants are not tracked, always changed.
+					}
+					int len = 0;
+					Error err = encode_variant(out.values[j], nullptr, len, false);
+					ERR_FAIL_COND_MSG(err != OK || len > 0xFFFF, "Unable to encode replicated property: " + String(spec.name) + ".");
+					Vector<uint8_t> bytes;
+					bytes.resize(len);
+					encode_variant(out.values[j], bytes.ptrw(), len, false);
+					writer.put(len, 16);
+					for (int k = 0; k < len; k++) {
+						writer.put(bytes[k], 8);
+					}
+					continue;
+				}
+
+				if (delta) {
+					const bool changed = memcmp(words, base + spec.word_offset, spec.word_count * sizeof(uint32_t)) != 0;
+					writer.put(changed, 1);
+					if (!changed) {
+						continue;
+					}
+				}
+
+				const int bits = _get_component_bits(spec.type, spec.bits);
+				for (uint32_t k = 0; k < spec.word_count; k++) {
+					writer.put(words[k], bits);
+				}
+			}
+			count++;
+		}
+		writer.flush();
+
+		// Sent even when empty, so acknowledgements keep moving forward.
+		packet[0] = MultiplayerAPI::NETWORK_COMMAND_REPLICATE;
+		encode_uint16(seq, &packet[1]);
+		encode_uint16(baseline, &packet[3]);
+		packet[5] = has_baseline ? SNAPSHOT_FLAG_BASELINE : 0;
+		encode_uint16(count, &packet[6]);
+
+		multiplayer->_send_packet(peer, NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE, packet.ptr(), packet.size());
+	}
+}
+
+void MultiplayerReplicator::process_packet(int p_from, const uint8_t *p_packet, int p_packet_len) {
+	if (p_packet[0] & REPLICATION_ACK_FLAG) {
+		_process_ack(p_from, p_packet, p_packet_len);
+	} else {
+		_process_snapshot(p_from, p_packet, p_packet_len);
+	}
+}
+
+void MultiplayerReplicator::_process_snapshot(int p_from, const uint8_t *p_packet, int p_packet_len) {
+	ERR_FAIL_COND_MSG(p_packet_len < SNAPSHOT_HEADER_SIZE, "Invalid packet received. Size too small.");
+
+	const uint16_t packet_seq = decode_uint16(&p_packet[1]);
+	const uint16_t baseline = decode_uint16(&p_packet[3]);
+	const bool has_baseline = p_packet[5] & SNAPSHOT_FLAG_BASELINE;
+	const uint32_t count = decode_uint16(&p_packet[6]);
+
+	RemotePeer *remote = remote_peers.getptr(p_from);
+	if (!remote) {
+		remote_peers[p_from] = RemotePeer();
+		remote = remote_peers.getptr(p_from);
+	}
+
+	if (remote->has_last && int16_t(packet_seq - remote->last_seq) <= 0) {
+		return; // Out of order or duplicated, a newer state was already applied.
+	}
+
+	const RemoteSnapshot *base = nullptr;
+	if (has_baseline) {
+		base = &remote->snapshots[baseline % HISTORY_SIZE];
+		ERR_FAIL_COND_MSG(!base->valid || base->seq != baseline, "Invalid packet received. Snapshot baseline is unknown.");
+	}
+
+	struct Incoming {
+		ObjectID instance;
+		uint32_t id = 0;
+		NodeState *state = nullptr;
+		LocalVector<uint32_t> words;
+		LocalVector<Variant> values;
+		LocalVector<bool> changed;
+	};
+
+	LocalVector<Incoming> incoming;
+	incoming.resize(count);
+
+	// Decode everything before touching the scene, a malformed packet is dropped as a whole.
+	ReplicationBitReader reader(&p_packet[SNAPSHOT_HEADER_SIZE], p_packet_len - SNAPSHOT_HEADER_SIZE);
+	for (uint32_t i = 0; i < count; i++) {
+		Incoming &in = incoming[i];
+
+		const uint32_t id_compression = reader.get(2);
+		in.id = reader.get(id_compression == MultiplayerAPI::NETWORK_NODE_ID_COMPRESSION_8 ? 8 : (id_compression == MultiplayerAPI::NETWORK_NODE_ID_COMPRESSION_16 ? 16 : 32));
+		const bool delta = reader.get(1);
+		const uint32_t property_count = reader.get(8);
+		ERR_FAIL_COND_MSG(reader.error, "Invalid packet received. Size smaller than declared.");
+
+		Node *node = multiplayer->_process_get_node(p_from, nullptr, in.id, 0);
+		ERR_FAIL_COND(node == nullptr);
+
+		in.instance = node->get_instance_id();
+		in.state = nodes.getptr(in.instance);
+		ERR_FAIL_COND_MSG(!in.state || in.state->properties.size() != property_count, "Invalid snapshot received. Replicated properties differ for node: " + String(node->get_name()) + ".");
+
+		const LocalVector<uint32_t> *base_words = nullptr;
+		if (delta) {
+			ERR_FAIL_COND_MSG(!base, "Invalid packet received. Delta state without baseline.");
+			base_words = base->nodes.getptr(in.id);
+			ERR_FAIL_COND_MSG(!base_words || base_words->size() != in.state->word_count, "Invalid packet received. Delta state for a node missing from the baseline.");
+		}
+
+		in.words.resize(in.state->word_count);
+		in.values.resize(property_count);
+		in.changed.resize(property_count);
+
+		for (uint32_t j = 0; j < property_count; j++) {
+			const PropertySpec &spec = in.state->properties[j];
+			const bool changed = delta ? reader.get(1) : true;
+			in.changed[j] = changed;
+
+			if (!spec.word_count) {
+				if (!changed) {
+					continue;
+				}
+				const int len = reader.get(16);
+				Vector<uint8_t> bytes;
+				bytes.resize(len);
+				for (int k = 0; k < len && !reader.error; k++) {
+					bytes.write[k] = reader.get(8);
+				}
+				ERR_FAIL_COND_MSG(reader.error, "Invalid packet received. Size smaller than declared.");
+				Error err = decode_variant(in.values[j], bytes.ptr(), len, nullptr, false);
+				ERR_FAIL_COND_MSG(err != OK, "Invalid packet received. Unable to decode replicated property: " + String(spec.name) + ".");
+				continue;
+			}
+
+			uint32_t *words = in.words.ptr() + spec.word_offset;
+			if (!changed) {
+				copymem(words, base_words->ptr() + spec.word_offset, spec.word_count * sizeof(uint32_t));
+				continue;
+			}
+			const int bits = _get_component_bits(spec.type, spec.bits);
+			for (uint32_t k = 0; k < spec.word_count; k++) {
+				words[k] = reader.get(bits);
+			}
+		}
+		ERR_FAIL_COND_MSG(reader.error, "Invalid packet received. Size smaller than declared.");
+	}
+
+	RemoteSnapshot &snapshot = remote->snapshots[packet_seq % HISTORY_SIZE];
+	snapshot.seq = packet_seq;
+	snapshot.valid = true;
+	snapshot.nodes.clear();
+
+	for (uint32_t i = 0; i < count; i++) {
+		Incoming &in = incoming[i];
+		snapshot.nodes[in.id] = in.words;
+
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(in.instance));
+		if (!node) {
+			continue; // Freed while applying a previous node.
+		}
+		ERR_CONTINUE_MSG(node->get_network_master() != p_from, "Ignoring replicated state for node '" + String(node->get_name()) + "' from a peer that is not its network master.");
+
+		for (uint32_t j = 0; j < in.changed.size(); j++) {
+			if (!in.changed[j]) {
+				continue;
+			}
+			const PropertySpec &spec = in.state->properties[j];
+			node->set(spec.name, spec.word_count ? _dequantize(spec, in.words.ptr() + spec.word_offset) : in.values[j]);
+		}
+	}
+
+	remote->last_seq = packet_seq;
+	remote->has_last = true;
+
+	uint8_t ack[3];
+	ack[0] = MultiplayerAPI::NETWORK_COMMAND_REPLICATE | REPLICATION_ACK_FLAG;
+	encode_uint16(packet_seq, &ack[1]);
+	multiplayer->_send_packet(p_from, NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE, ack, 3);
+}
+
+void MultiplayerReplicator::_process_ack(int p_from, const uint8_t *p_packet, int p_packet_len) {
+	ERR_FAIL_COND_MSG(p_packet_len < 3, "Invalid packet received. Size too small.");
+
+	const uint16_t ack = decode_uint16(&p_packet[1]);
+	ERR_FAIL_COND_MSG(int16_t(ack - seq) > 0, "Invalid packet received. Acknowledges a snapshot that was never sent.");
+
+	uint16_t *last_ack = peer_acks.getptr(p_from);
+	if (!last_ack) {
+		peer_acks[p_from] = ack;
+	} else if (int16_t(ack - *last_ack) > 0) {
+		*last_ack = ack;
+	}
+}
+
+void MultiplayerReplicator::del_peer(int p_id) {
+	peer_acks.erase(p_id);
+	remote_peers.erase(p_id);
+	for (const ObjectID *K = nodes.next(nullptr); K; K = nodes.next(K)) {
+		nodes.getptr(*K)->peer_first_seq.erase(p_id);
+	}
+}
+
+void MultiplayerReplicator::clear() {
+	// Declarations belong to the nodes and survive a peer change, only the connection state is reset.
+	seq = 0;
+	peer_acks.clear();
+	remote_peers.clear();
+	for (const ObjectID *K = nodes.next(nullptr); K; K = nodes.next(K)) {
+		_reset_history(*nodes.getptr(*K));
+	}
+}
+
+MultiplayerReplicator::MultiplayerReplicator(MultiplayerAPI *p_multiplayer) {
+	multiplayer = p_multiplayer;
+}
@@ -0,0 +1,118 @@
+/*************************************************************************/
+/*  multiplayer_replicator.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef MULTIPLAYER_REPLICATOR_H
+#define MULTIPLAYER_REPLICATOR_H
+
+#include "core/hash_map.h"
+#include "core/local_vector.h"
+#include "core/object.h"
+
+class MultiplayerAPI;
+class Node;
+
+// Snapshot based state replication for MultiplayerAPI.
+//
+// Nodes declare which properties are replicated and how many bits each one
+// may use. Every snapshot carries the quantized state of all nodes the local
+// peer is network master of, delta encoded per peer against the last snapshot
+// that peer acknowledged, and is sent over the unreliable channel. Both ends
+// must declare the same properties, in the same order, for a given node.
+class MultiplayerReplicator {
+public:
+	enum {
+		HISTORY_SIZE = 32, // Snapshots kept around to delta against, per node and per sender.
+		MAX_PROPERTIES = 255,
+	};
+
+private:
+	struct PropertySpec {
+		StringName name;
+		Variant::Type type = Variant::NIL;
+		uint8_t bits = 0; // Zero means full precision.
+		real_t min = 0;
+		real_t max = 0;
+		uint32_t word_offset = 0;
+		uint32_t word_count = 0; // Zero for types sent as plain variants.
+	};
+
+	struct NodeState {
+		LocalVector<PropertySpec> properties;
+		uint32_t word_count = 0;
+
+		// Quantized state of the last snapshots sent, indexed by seq % HISTORY_SIZE.
+		LocalVector<uint32_t> history;
+		uint16_t history_seq[HISTORY_SIZE] = {};
+		bool history_valid[HISTORY_SIZE] = {};
+
+		// First snapshot each peer received this node in.
+		HashMap<int, uint16_t> peer_first_seq;
+	};
+
+	struct RemoteSnapshot {
+		uint16_t seq = 0;
+		bool valid = false;
+		HashMap<uint32_t, LocalVector<uint32_t>> nodes; // Keyed by path cache id.
+	};
+
+	struct RemotePeer {
+		uint16_t last_seq = 0;
+		bool has_last = false;
+		RemoteSnapshot snapshots[HISTORY_SIZE];
+	};
+
+	MultiplayerAPI *multiplayer = nullptr;
+
+	HashMap<ObjectID, NodeState> nodes;
+	uint16_t seq = 0;
+	HashMap<int, uint16_t> peer_acks; // Last snapshot acknowledged by each peer.
+	HashMap<int, RemotePeer> remote_peers; // Snapshots received from each peer.
+
+	static uint32_t _get_word_count(Variant::Type p_type, int p_bits);
+	static void _reset_history(NodeState &p_state);
+	static void _quantize(const PropertySpec &p_spec, const Variant &p_value, uint32_t *r_words);
+	static Variant _dequantize(const PropertySpec &p_spec, const uint32_t *p_words);
+
+	void _process_snapshot(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_ack(int p_from, const uint8_t *p_packet, int p_packet_len);
+
+public:
+	void replicate_property(Node *p_node, const StringName &p_property, int p_bits, real_t p_min, real_t p_max);
+	void stop_replicating(Node *p_node);
+	void send_snapshot();
+
+	void process_packet(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void del_peer(int p_id);
+	void clear();
+
+	MultiplayerReplicator(MultiplayerAPI *p_multiplayer);
+};
+
+#endif // MULTIPLAYER_REPLICATOR_H
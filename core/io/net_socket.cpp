@@ -40,3 +40,13 @@ NetSocket *NetSocket::create() {
 	ERR_PRINT("Unable to create network socket, platform not supported");
 	return nullptr;
 }
+
+NetSocketReactor *(*NetSocketReactor::_create)() = nullptr;
+
+NetSocketReactor *NetSocketReactor::create() {
+	if (_create) {
+		return _create();
+	}
+
+	return nullptr;
+}
@@ -77,4 +77,31 @@ public:
 	virtual Error leave_multicast_group(const IP_Address &p_multi_address, String p_if_name) = 0;
 };
 
+// Readiness notification for many sockets at once, so callers only service
+// the sockets that actually have something to do. Sockets leave the reactor
+// on their own when closed.
+class NetSocketReactor : public Reference {
+protected:
+	static NetSocketReactor *(*_create)();
+
+public:
+	static NetSocketReactor *create(); // Returns nullptr if the platform has no reactor.
+
+	struct Event {
+		uint64_t id = 0;
+		bool readable = false;
+		bool writable = false;
+		bool error = false; // Error or hang up, reading will tell which.
+	};
+
+	virtual Error add_socket(Ref<NetSocket> p_sock, NetSocket::PollType p_type, uint64_t p_id) = 0;
+	virtual Error modify_socket(Ref<NetSocket> p_sock, NetSocket::PollType p_type, uint64_t p_id) = 0;
+	virtual void remove_socket(Ref<NetSocket> p_sock) = 0;
+	virtual int get_socket_count() const = 0;
+
+	// Fills up to p_max_events ready sockets, waiting at most p_timeout msecs (-1 blocks).
+	// Returns the number of events, or -1 on error.
+	virtual int wait(Event *r_events, int p_max_events, int p_timeout) = 0;
+};
+
 #endif // NET_SOCKET_H
@@ -0,0 +1,295 @@
+/*************************************************************************/
+/*  networked_multiplayer_loopback.cpp                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "networked_multiplayer_loopback.h"
+
+#include "core/os/os.h"
+
+NetworkedMultiplayerLoopback *NetworkedMultiplayerLoopback::_get_peer(ObjectID p_id) {
+	return Object::cast_to<NetworkedMultiplayerLoopback>(ObjectDB::get_instance(p_id));
+}
+
+void NetworkedMultiplayerLoopback::_push_event(EventType p_type, int p_peer) {
+	Event event;
+	event.type = p_type;
+	event.peer = p_peer;
+	events.push_back(event);
+}
+
+void NetworkedMultiplayerLoopback::_deliver(int p_from, const uint8_t *p_buffer, int p_buffer_size) {
+	Packet packet;
+	packet.from = p_from;
+	packet.data.resize(p_buffer_size);
+	if (p_buffer_size) {
+		copymem(packet.data.ptrw(), p_buffer, p_buffer_size);
+	}
+	incoming_packets.push_back(packet);
+}
+
+void NetworkedMultiplayerLoopback::_link(int p_id, NetworkedMultiplayerLoopback *p_peer) {
+	peers[p_id] = p_peer->get_instance_id();
+	_push_event(EVENT_PEER_CONNECTED, p_id);
+}
+
+void NetworkedMultiplayerLoopback::_unlink(int p_id) {
+	if (!peers.has(p_id)) {
+		return;
+	}
+	peers.erase(p_id);
+
+	if (server || p_id != 1) {
+		_push_event(EVENT_PEER_DISCONNECTED, p_id);
+		return;
+	}
+
+	// Lost the server, drop the other clients as well. The connection status
+	// changes when the event is handled in poll(), like a real peer would.
+	Map<int, ObjectID> linked = peers;
+	peers.clear();
+	for (Map<int, ObjectID>::Element *E = linked.front(); E; E = E->next()) {
+		NetworkedMultiplayerLoopback *peer = _get_peer(E->get());
+		if (peer) {
+			peer->_unlink(unique_id);
+		}
+	}
+	_push_event(EVENT_SERVER_DISCONNECTED);
+}
+
+void NetworkedMultiplayerLoopback::set_transfer_mode(TransferMode p_mode) {
+	transfer_mode = p_mode;
+}
+
+NetworkedMultiplayerPeer::TransferMode NetworkedMultiplayerLoopback::get_transfer_mode() const {
+	return transfer_mode;
+}
+
+void NetworkedMultiplayerLoopback::set_target_peer(int p_peer_id) {
+	target_peer = p_peer_id;
+}
+
+int NetworkedMultiplayerLoopback::get_packet_peer() const {
+	ERR_FAIL_COND_V_MSG(!active, 1, "The multiplayer instance isn't currently active.");
+	ERR_FAIL_COND_V(incoming_packets.size() == 0, 1);
+
+	return incoming_packets.front()->get().from;
+}
+
+bool NetworkedMultiplayerLoopback::is_server() const {
+	ERR_FAIL_COND_V_MSG(!active, false, "The multiplayer instance isn't currently active.");
+
+	return server;
+}
+
+void NetworkedMultiplayerLoopback::poll() {
+	ERR_FAIL_COND_MSG(!active, "The multiplayer instance isn't currently active.");
+
+	while (events.size()) {
+		Event event = events.front()->get();
+		events.pop_front();
+
+		switch (event.type) {
+			case EVENT_PEER_CONNECTED: {
+				emit_signal("peer_connected", event.peer);
+			} break;
+			case EVENT_PEER_DISCONNECTED: {
+				emit_signal("peer_disconnected", event.peer);
+			} break;
+			case EVENT_CONNECTION_SUCCEEDED: {
+				connection_status = CONNECTION_CONNECTED;
+				emit_signal("connection_succeeded");
+			} break;
+			case EVENT_SERVER_DISCONNECTED: {
+				close_connection();
+				emit_signal("server_disconnected");
+			} break;
+		}
+
+		if (!active) {
+			return; // Closed while emitting a signal.
+		}
+	}
+}
+
+int NetworkedMultiplayerLoopback::get_unique_id() const {
+	ERR_FAIL_COND_V_MSG(!active, 0, "The multiplayer instance isn't currently active.");
+
+	return unique_id;
+}
+
+void NetworkedMultiplayerLoopback::set_refuse_new_connections(bool p_enable) {
+	refuse_connections = p_enable;
+}
+
+bool NetworkedMultiplayerLoopback::is_refusing_new_connections() const {
+	return refuse_connections;
+}
+
+NetworkedMultiplayerPeer::ConnectionStatus NetworkedMultiplayerLoopback::get_connection_status() const {
+	return connection_status;
+}
+
+int NetworkedMultiplayerLoopback::get_available_packet_count() const {
+	return incoming_packets.size();
+}
+
+Error NetworkedMultiplayerLoopback::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
+	ERR_FAIL_COND_V_MSG(incoming_packets.size() == 0, ERR_UNAVAILABLE, "No incoming packets available.");
+
+	current_packet = incoming_packets.front()->get();
+	incoming_packets.pop_front();
+
+	*r_buffer = current_packet.data.ptr();
+	r_buffer_size = current_packet.data.size();
+
+	return OK;
+}
+
+Error NetworkedMultiplayerLoopback::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
+	ERR_FAIL_COND_V_MSG(!active, ERR_UNCONFIGURED, "The multiplayer instance isn't currently active.");
+	ERR_FAIL_COND_V_MSG(connection_status != CONNECTION_CONNECTED, ERR_UNCONFIGURED, "The multiplayer instance isn't currently connected to any server or client.");
+
+	if (target_peer > 0) {
+		ERR_FAIL_COND_V_MSG(!peers.has(target_peer), ERR_INVALID_PARAMETER, "Invalid target peer: " + itos(target_peer) + ".");
+	}
+
+	for (Map<int, ObjectID>::Element *E = peers.front(); E; E = E->next()) {
+		if (target_peer > 0 && E->key() != target_peer) {
+			continue;
+		}
+		if (target_peer < 0 && E->key() == -target_peer) {
+			continue;
+		}
+		if (transfer_mode != TRANSFER_MODE_RELIABLE && packet_loss > 0 && rng.randf() < packet_loss) {
+			continue; // Simulated loss only applies to unreliable packets.
+		}
+
+		NetworkedMultiplayerLoopback *peer = _get_peer(E->get());
+		ERR_CONTINUE(!peer);
+		peer->_deliver(unique_id, p_buffer, p_buffer_size);
+	}
+
+	return OK;
+}
+
+int NetworkedMultiplayerLoopback::get_max_packet_size() const {
+	return 1 << 24; // Only bound by memory.
+}
+
+Error NetworkedMultiplayerLoopback::create_server() {
+	ERR_FAIL_COND_V_MSG(active, ERR_ALREADY_IN_USE, "The multiplayer instance is already active.");
+
+	active = true;
+	server = true;
+	unique_id = 1;
+	next_client_id = 2;
+	connection_status = CONNECTION_CONNECTED;
+
+	return OK;
+}
+
+Error NetworkedMultiplayerLoopback::create_client(Ref<NetworkedMultiplayerLoopback> p_server) {
+	ERR_FAIL_COND_V_MSG(active, ERR_ALREADY_IN_USE, "The multiplayer instance is already active.");
+	ERR_FAIL_COND_V(p_server.is_null(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(!p_server->active || !p_server->server, ERR_CANT_CONNECT, "The given peer is not an active loopback server.");
+
+	NetworkedMultiplayerLoopback *host = p_server.ptr();
+	if (host->refuse_connections) {
+		return ERR_CANT_CONNECT;
+	}
+
+	active = true;
+	server = false;
+	unique_id = host->next_client_id++;
+	connection_status = CONNECTION_CONNECTING;
+
+	// Full mesh: every client talks to the others directly, which is what
+	// server relaying looks like from the point of view of MultiplayerAPI.
+	for (Map<int, ObjectID>::Element *E = host->peers.front(); E; E = E->next()) {
+		NetworkedMultiplayerLoopback *peer = _get_peer(E->get());
+		ERR_CONTINUE(!peer);
+		peer->_link(unique_id, this);
+		_link(E->key(), peer);
+	}
+	host->_link(unique_id, this);
+	_link(1, host);
+	_push_event(EVENT_CONNECTION_SUCCEEDED);
+
+	return OK;
+}
+
+void NetworkedMultiplayerLoopback::close_connection() {
+	if (!active) {
+		return;
+	}
+
+	Map<int, ObjectID> linked = peers;
+	peers.clear();
+	for (Map<int, ObjectID>::Element *E = linked.front(); E; E = E->next()) {
+		NetworkedMultiplayerLoopback *peer = _get_peer(E->get());
+		if (peer) {
+			peer->_unlink(unique_id);
+		}
+	}
+
+	active = false;
+	server = false;
+	unique_id = 0;
+	target_peer = 0;
+	connection_status = CONNECTION_DISCONNECTED;
+	incoming_packets.clear();
+	current_packet = Packet();
+	events.clear();
+}
+
+void NetworkedMultiplayerLoopback::set_packet_loss(float p_ratio) {
+	packet_loss = CLAMP(p_ratio, 0.0, 1.0);
+}
+
+float NetworkedMultiplayerLoopback::get_packet_loss() const {
+	return packet_loss;
+}
+
+void NetworkedMultiplayerLoopback::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("create_server"), &NetworkedMultiplayerLoopback::create_server);
+	ClassDB::bind_method(D_METHOD("create_client", "server"), &NetworkedMultiplayerLoopback::create_client);
+	ClassDB::bind_method(D_METHOD("close_connection"), &NetworkedMultiplayerLoopback::close_connection);
+	ClassDB::bind_method(D_METHOD("set_packet_loss", "ratio"), &NetworkedMultiplayerLoopback::set_packet_loss);
+	ClassDB::bind_method(D_METHOD("get_packet_loss"), &NetworkedMultiplayerLoopback::get_packet_loss);
+
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "packet_loss", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_packet_loss", "get_packet_loss");
+}
+
+NetworkedMultiplayerLoopback::NetworkedMultiplayerLoopback() {
+	rng.seed(OS::get_singleton()->get_ticks_usec());
+}
+
+NetworkedMultiplayerLoopback::~NetworkedMultiplayerLoopback() {
+	close_connection();
+}
@@ -0,0 +1,121 @@
+/*************************************************************************/
+/*  networked_multiplayer_loopback.h                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef NETWORKED_MULTIPLAYER_LOOPBACK_H
+#define NETWORKED_MULTIPLAYER_LOOPBACK_H
+
+#include "core/io/networked_multiplayer_peer.h"
+#include "core/list.h"
+#include "core/map.h"
+#include "core/math/random_pcg.h"
+
+// In-process peer: packets are handed directly to the receiving peer's queue.
+// Useful to measure replication bandwidth and CPU cost without a network.
+class NetworkedMultiplayerLoopback : public NetworkedMultiplayerPeer {
+	GDCLASS(NetworkedMultiplayerLoopback, NetworkedMultiplayerPeer);
+
+	enum EventType {
+		EVENT_PEER_CONNECTED,
+		EVENT_PEER_DISCONNECTED,
+		EVENT_CONNECTION_SUCCEEDED,
+		EVENT_SERVER_DISCONNECTED,
+	};
+
+	struct Event {
+		EventType type;
+		int peer = 0;
+	};
+
+	struct Packet {
+		Vector<uint8_t> data;
+		int from = 0;
+	};
+
+	bool active = false;
+	bool server = false;
+	int unique_id = 0;
+	int next_client_id = 2;
+	int target_peer = 0;
+	TransferMode transfer_mode = TRANSFER_MODE_RELIABLE;
+	bool refuse_connections = false;
+	ConnectionStatus connection_status = CONNECTION_DISCONNECTED;
+	float packet_loss = 0.0;
+	RandomPCG rng;
+
+	Map<int, ObjectID> peers; // Every peer reachable from this one, the server included.
+	List<Packet> incoming_packets;
+	Packet current_packet;
+	List<Event> events;
+
+	static NetworkedMultiplayerLoopback *_get_peer(ObjectID p_id);
+	void _push_event(EventType p_type, int p_peer = 0);
+	void _deliver(int p_from, const uint8_t *p_buffer, int p_buffer_size);
+	void _link(int p_id, NetworkedMultiplayerLoopback *p_peer);
+	void _unlink(int p_id);
+
+protected:
+	static void _bind_methods();
+
+public:
+	virtual void set_transfer_mode(TransferMode p_mode);
+	virtual TransferMode get_transfer_mode() const;
+	virtual void set_target_peer(int p_peer_id);
+
+	virtual int get_packet_peer() const;
+
+	virtual bool is_server() const;
+
+	virtual void poll();
+
+	virtual int get_unique_id() const;
+
+	virtual void set_refuse_new_connections(bool p_enable);
+	virtual bool is_refusing_new_connections() const;
+
+	virtual ConnectionStatus get_connection_status() const;
+
+	virtual int get_available_packet_count() const;
+	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size); ///< buffer is GONE after next get_packet
+	virtual Error put_packet(const uint8_t *p_buffer, int p_buffer_size);
+
+	virtual int get_max_packet_size() const;
+
+	Error create_server();
+	Error create_client(Ref<NetworkedMultiplayerLoopback> p_server);
+	void close_connection();
+
+	void set_packet_loss(float p_ratio);
+	float get_packet_loss() const;
+
+	NetworkedMultiplayerLoopback();
+	~NetworkedMultiplayerLoopback();
+};
+
+#endif // NETWORKED_MULTIPLAYER_LOOPBACK_H
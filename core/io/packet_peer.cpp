@@ -39,7 +39,7 @@ void PacketPeer::set_encode_buffer_max_size(int p_max_size) {
 	ERR_FAIL_COND_MSG(p_max_size < 1024, "Max encode buffer must be at least 1024 bytes");
 	ERR_FAIL_COND_MSG(p_max_size > 256 * 1024 * 1024, "Max encode buffer cannot exceed 256 MiB");
 	encode_buffer_max_size = next_power_of_2(p_max_size);
-	encode_buffer.resize(0);
+	encode_buffer.reset();
 }
 
 int PacketPeer::get_encode_buffer_max_size() const {
@@ -88,29 +88,34 @@ Error PacketPeer::get_var(Variant &r_variant, bool p_allow_objects) {
 	return decode_variant(r_variant, buffer, buffer_size, nullptr, p_allow_objects);
 }
 
-Error PacketPeer::put_var(const Variant &p_packet, bool p_full_objects) {
-	int len;
-	Error err = encode_variant(p_packet, nullptr, len, p_full_objects); // compute len first
+Error PacketPeer::get_var_view(EncodedVariantView &r_view) {
+	const uint8_t *buffer;
+	int buffer_size;
+	Error err = get_packet(&buffer, buffer_size);
 	if (err) {
 		return err;
 	}
 
-	if (len == 0) {
-		return OK;
-	}
-
-	ERR_FAIL_COND_V_MSG(len > encode_buffer_max_size, ERR_OUT_OF_MEMORY, "Failed to encode variant, encode size is bigger then encode_buffer_max_size. Consider raising it via 'set_encode_buffer_max_size'.");
+	return decode_variant_view(r_view, buffer, buffer_size);
+}
 
-	if (unlikely(encode_buffer.size() < len)) {
-		encode_buffer.resize(0); // Avoid realloc
-		encode_buffer.resize(next_power_of_2(len));
+Error PacketPeer::put_var(const Variant &p_packet, bool p_full_objects) {
+	// Encoded in a single pass, the buffer keeps its capacity between calls.
+	// The encoder stops as soon as the value gets bigger than the limit.
+	encode_buffer.clear();
+	Error err = encode_variant(p_packet, encode_buffer, p_full_objects, encode_buffer_max_size);
+	if (err == ERR_OUT_OF_MEMORY) {
+		encode_buffer.reset();
+		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Failed to encode variant, encode size is bigger then encode_buffer_max_size. Consider raising it via 'set_encode_buffer_max_size'.");
 	}
-
-	uint8_t *w = encode_buffer.ptrw();
-	err = encode_variant(p_packet, w, len, p_full_objects);
 	ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to encode Variant.");
 
-	return put_packet(w, len);
+	int len = encode_buffer.size();
+	if (len == 0) {
+		return OK;
+	}
+
+	return put_packet(encode_buffer.ptr(), len);
 }
 
 Variant PacketPeer::_bnd_get_var(bool p_allow_objects) {
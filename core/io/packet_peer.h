@@ -32,9 +32,12 @@
 #define PACKET_PEER_H
 
 #include "core/io/stream_peer.h"
+#include "core/local_vector.h"
 #include "core/object.h"
 #include "core/ring_buffer.h"
 
+struct EncodedVariantView;
+
 class PacketPeer : public Reference {
 	GDCLASS(PacketPeer, Reference);
 
@@ -49,7 +52,7 @@ class PacketPeer : public Reference {
 	mutable Error last_get_error = OK;
 
 	int encode_buffer_max_size = 8 * 1024 * 1024;
-	Vector<uint8_t> encode_buffer;
+	LocalVector<uint8_t> encode_buffer;
 
 public:
 	virtual int get_available_packet_count() const = 0;
@@ -64,6 +67,8 @@ public:
 	virtual Error put_packet_buffer(const Vector<uint8_t> &p_buffer);
 
 	virtual Error get_var(Variant &r_variant, bool p_allow_objects = false);
+	// The view points into the packet buffer, it's only valid until the next get_packet().
+	Error get_var_view(EncodedVariantView &r_view);
 	virtual Error put_var(const Variant &p_packet, bool p_full_objects = false);
 
 	void set_encode_buffer_max_size(int p_max_size);
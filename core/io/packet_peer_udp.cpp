@@ -306,6 +306,20 @@ bool PacketPeerUDP::is_listening() const {
 	return _sock.is_valid() && _sock->is_open();
 }
 
+Error PacketPeerUDP::add_to_reactor(Ref<NetSocketReactor> p_reactor, uint64_t p_id) {
+	ERR_FAIL_COND_V(p_reactor.is_null(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(_sock.is_null() || !_sock->is_open(), ERR_UNCONFIGURED);
+
+	return p_reactor->add_socket(_sock, NetSocket::POLL_TYPE_IN, p_id);
+}
+
+void PacketPeerUDP::remove_from_reactor(Ref<NetSocketReactor> p_reactor) {
+	ERR_FAIL_COND(p_reactor.is_null());
+	ERR_FAIL_COND(_sock.is_null() || !_sock->is_open());
+
+	p_reactor->remove_socket(_sock);
+}
+
 IP_Address PacketPeerUDP::get_packet_address() const {
 	return packet_ip;
 }
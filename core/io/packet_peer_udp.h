@@ -72,6 +72,10 @@ public:
 	Error wait();
 	bool is_listening() const;
 
+	// Readiness notifications, see NetSocketReactor. The socket leaves the reactor when closed.
+	Error add_to_reactor(Ref<NetSocketReactor> p_reactor, uint64_t p_id);
+	void remove_from_reactor(Ref<NetSocketReactor> p_reactor);
+
 	Error connect_socket(Ref<NetSocket> p_sock); // Used by UDPServer
 	Error connect_to_host(const IP_Address &p_host, int p_port);
 	bool is_connected_to_host() const;
@@ -30,6 +30,8 @@
 
 #include "resource_loader.h"
 
+#include "core/debugger/performance_counter.h"
+#include "core/debugger/trace_profiler.h"
 #include "core/io/resource_importer.h"
 #include "core/os/file_access.h"
 #include "core/os/os.h"
@@ -46,6 +48,8 @@
 
 Ref<ResourceFormatLoader> ResourceLoader::loader[ResourceLoader::MAX_LOADERS];
 
+static PerformanceCounter load_queue_counter("resource/threaded_load_tasks", false);
+
 int ResourceLoader::loader_count = 0;
 
 bool ResourceFormatLoader::recognize_path(const String &p_path, const String &p_for_type) const {
@@ -349,6 +353,7 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 		}
 
 		thread_load_tasks[local_path] = load_task;
+		load_queue_counter.set(thread_load_tasks.size());
 	}
 
 	ThreadLoadTask &load_task = thread_load_tasks[local_path];
@@ -496,6 +501,7 @@ RES ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
 			memdelete(load_task.thread);
 		}
 		thread_load_tasks.erase(local_path);
+		load_queue_counter.set(thread_load_tasks.size());
 	}
 
 	thread_load_mutex->unlock();
@@ -504,6 +510,7 @@ RES ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
 }
 
 RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p_no_cache, Error *r_error) {
+	TRACE_ZONE("ResourceLoader::load");
 	if (r_error) {
 		*r_error = ERR_CANT_OPEN;
 	}
@@ -572,6 +579,7 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 		load_task.loader_id = Thread::get_caller_id();
 
 		thread_load_tasks[local_path] = load_task;
+		load_queue_counter.set(thread_load_tasks.size());
 
 		thread_load_mutex->unlock();
 
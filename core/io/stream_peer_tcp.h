@@ -80,6 +80,10 @@ public:
 	// Poll functions (wait or check for writable, readable)
 	Error poll(NetSocket::PollType p_type, int timeout = 0);
 
+	// Readiness notifications, see NetSocketReactor. The socket leaves the reactor when closed.
+	Error add_to_reactor(Ref<NetSocketReactor> p_reactor, uint64_t p_id);
+	void remove_from_reactor(Ref<NetSocketReactor> p_reactor);
+
 	// Read/Write from StreamPeer
 	Error put_data(const uint8_t *p_data, int p_bytes);
 	Error put_partial_data(const uint8_t *p_data, int p_bytes, int &r_sent);
@@ -110,6 +110,20 @@ Ref<StreamPeerTCP> TCP_Server::take_connection() {
 	return conn;
 }
 
+Error TCP_Server::add_to_reactor(Ref<NetSocketReactor> p_reactor, uint64_t p_id) {
+	ERR_FAIL_COND_V(p_reactor.is_null(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(!_sock.is_valid() || !_sock->is_open(), ERR_UNCONFIGURED);
+
+	return p_reactor->add_socket(_sock, NetSocket::POLL_TYPE_IN, p_id);
+}
+
+void TCP_Server::remove_from_reactor(Ref<NetSocketReactor> p_reactor) {
+	ERR_FAIL_COND(p_reactor.is_null());
+	ERR_FAIL_COND(!_sock.is_valid() || !_sock->is_open());
+
+	p_reactor->remove_socket(_sock);
+}
+
 void TCP_Server::stop() {
 	if (_sock.is_valid()) {
 		_sock->close();
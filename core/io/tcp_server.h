@@ -55,6 +55,10 @@ public:
 
 	void stop(); // Stop listening
 
+	// Readiness notifications, see NetSocketReactor. The socket leaves the reactor when closed.
+	Error add_to_reactor(Ref<NetSocketReactor> p_reactor, uint64_t p_id);
+	void remove_from_reactor(Ref<NetSocketReactor> p_reactor);
+
 	TCP_Server();
 	~TCP_Server();
 };
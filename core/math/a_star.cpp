@@ -34,6 +34,8 @@
 #include "core/script_language.h"
 #include "scene/scene_string_names.h"
 
+#include <typeinfo>
+
 int AStar::get_available_point_id() const {
 	if (points.empty()) {
 		return 1;
@@ -62,17 +64,24 @@ void AStar::add_point(int p_id, const Vector3 &p_pos, real_t p_weight_scale) {
 	if (!p_exists) {
 		Point *pt = memnew(Point);
 		pt->id = p_id;
-		pt->pos = p_pos;
-		pt->weight_scale = p_weight_scale;
-		pt->prev_point = nullptr;
-		pt->open_pass = 0;
-		pt->closed_pass = 0;
-		pt->enabled = true;
+		pt->index = point_list.size();
 		points.set(p_id, pt);
+
+		PointData data;
+		data.pos = p_pos;
+		data.weight_scale = p_weight_scale;
+		data.id = p_id;
+		data.enabled = true;
+		point_list.push_back(pt);
+		point_data.push_back(data);
+
+		adjacency_dirty = true;
 	} else {
-		found_pt->pos = p_pos;
-		found_pt->weight_scale = p_weight_scale;
+		point_data[found_pt->index].pos = p_pos;
+		point_data[found_pt->index].weight_scale = p_weight_scale;
 	}
+
+	grid_dirty = true;
 }
 
 Vector3 AStar::get_point_position(int p_id) const {
@@ -80,7 +89,7 @@ Vector3 AStar::get_point_position(int p_id) const {
 	bool p_exists = points.lookup(p_id, p);
 	ERR_FAIL_COND_V(!p_exists, Vector3());
 
-	return p->pos;
+	return point_data[p->index].pos;
 }
 
 void AStar::set_point_position(int p_id, const Vector3 &p_pos) {
@@ -88,7 +97,8 @@ void AStar::set_point_position(int p_id, const Vector3 &p_pos) {
 	bool p_exists = points.lookup(p_id, p);
 	ERR_FAIL_COND(!p_exists);
 
-	p->pos = p_pos;
+	point_data[p->index].pos = p_pos;
+	grid_dirty = true;
 }
 
 real_t AStar::get_point_weight_scale(int p_id) const {
@@ -96,7 +106,7 @@ real_t AStar::get_point_weight_scale(int p_id) const {
 	bool p_exists = points.lookup(p_id, p);
 	ERR_FAIL_COND_V(!p_exists, 0);
 
-	return p->weight_scale;
+	return point_data[p->index].weight_scale;
 }
 
 void AStar::set_point_weight_scale(int p_id, real_t p_weight_scale) {
@@ -105,7 +115,7 @@ void AStar::set_point_weight_scale(int p_id, real_t p_weight_scale) {
 	ERR_FAIL_COND(!p_exists);
 	ERR_FAIL_COND(p_weight_scale < 1);
 
-	p->weight_scale = p_weight_scale;
+	point_data[p->index].weight_scale = p_weight_scale;
 }
 
 void AStar::remove_point(int p_id) {
@@ -129,9 +139,22 @@ void AStar::remove_point(int p_id) {
 		(*it.value)->unlinked_neighbours.remove(p->id);
 	}
 
+	// Keep the point arrays packed by moving the last point in the hole.
+	uint32_t last = point_list.size() - 1;
+	if (p->index != last) {
+		point_list[p->index] = point_list[last];
+		point_data[p->index] = point_data[last];
+		point_list[p->index]->index = p->index;
+	}
+	point_list.resize(last);
+	point_data.resize(last);
+
 	memdelete(p);
 	points.remove(p_id);
 	last_free_id = p_id;
+
+	adjacency_dirty = true;
+	grid_dirty = true;
 }
 
 void AStar::connect_points(int p_id, int p_with_id, bool bidirectional) {
@@ -170,6 +193,7 @@ void AStar::connect_points(int p_id, int p_with_id, bool bidirectional) {
 	}
 
 	segments.insert(s);
+	adjacency_dirty = true;
 }
 
 void AStar::disconnect_points(int p_id, int p_with_id, bool bidirectional) {
@@ -209,6 +233,7 @@ void AStar::disconnect_points(int p_id, int p_with_id, bool bidirectional) {
 		if (s.direction != Segment::NONE) {
 			segments.insert(s);
 		}
+		adjacency_dirty = true;
 	}
 }
 
@@ -255,6 +280,11 @@ void AStar::clear() {
 	}
 	segments.clear();
 	points.clear();
+	point_list.clear();
+	point_data.clear();
+
+	adjacency_dirty = true;
+	grid_dirty = true;
 }
 
 int AStar::get_point_count() const {
@@ -269,27 +299,153 @@ void AStar::reserve_space(int p_num_nodes) {
 	ERR_FAIL_COND_MSG(p_num_nodes <= 0, "New capacity must be greater than 0, was: " + itos(p_num_nodes) + ".");
 	ERR_FAIL_COND_MSG((uint32_t)p_num_nodes < points.get_capacity(), "New capacity must be greater than current capacity: " + itos(points.get_capacity()) + ", new was: " + itos(p_num_nodes) + ".");
 	points.reserve(p_num_nodes);
+	point_list.reserve(p_num_nodes);
+	point_data.reserve(p_num_nodes);
+}
+
+void AStar::_update_grid() const {
+	grid_dirty = false;
+
+	const uint32_t point_count = point_data.size();
+	if (point_count == 0) {
+		grid_size[0] = grid_size[1] = grid_size[2] = 0;
+		grid_offsets.clear();
+		grid_points.clear();
+		return;
+	}
+
+	AABB bounds(point_data[0].pos, Vector3());
+	for (uint32_t i = 1; i < point_count; i++) {
+		bounds.expand_to(point_data[i].pos);
+	}
+
+	// Aim for about one point per cell, ignoring the flat axes so that planar
+	// and linear graphs get a useful cell size too.
+	real_t volume = 1;
+	int axis_count = 0;
+	for (int i = 0; i < 3; i++) {
+		if (bounds.size[i] > CMP_EPSILON) {
+			volume *= bounds.size[i];
+			axis_count++;
+		}
+	}
+	grid_cell_size = axis_count > 0 ? Math::pow(volume / point_count, (real_t)1.0 / axis_count) : 1;
+	grid_cell_size = MAX(grid_cell_size, (real_t)CMP_EPSILON);
+
+	uint64_t cell_count;
+	while (true) {
+		cell_count = 1;
+		for (int i = 0; i < 3; i++) {
+			grid_size[i] = (int)(bounds.size[i] / grid_cell_size) + 1;
+			cell_count *= grid_size[i];
+		}
+		if (cell_count <= (uint64_t)point_count * 2 + 8) {
+			break;
+		}
+		grid_cell_size *= 1.5;
+	}
+	grid_origin = bounds.position;
+
+	// Bucket the points per cell.
+	grid_offsets.resize(cell_count + 1);
+	for (uint32_t i = 0; i < cell_count + 1; i++) {
+		grid_offsets[i] = 0;
+	}
+
+	LocalVector<uint32_t> point_cells;
+	point_cells.resize(point_count);
+	for (uint32_t i = 0; i < point_count; i++) {
+		Vector3 cell = (point_data[i].pos - grid_origin) / grid_cell_size;
+		int x = CLAMP((int)cell.x, 0, grid_size[0] - 1);
+		int y = CLAMP((int)cell.y, 0, grid_size[1] - 1);
+		int z = CLAMP((int)cell.z, 0, grid_size[2] - 1);
+		point_cells[i] = (z * grid_size[1] + y) * grid_size[0] + x;
+		grid_offsets[point_cells[i] + 1]++;
+	}
+
+	for (uint32_t i = 0; i < cell_count; i++) {
+		grid_offsets[i + 1] += grid_offsets[i];
+	}
+
+	grid_points.resize(point_count);
+	LocalVector<uint32_t> cell_fill;
+	cell_fill.resize(cell_count);
+	for (uint32_t i = 0; i < cell_count; i++) {
+		cell_fill[i] = grid_offsets[i];
+	}
+	for (uint32_t i = 0; i < point_count; i++) {
+		grid_points[cell_fill[point_cells[i]]++] = i;
+	}
 }
 
 int AStar::get_closest_point(const Vector3 &p_point, bool p_include_disabled) const {
+	MutexLock lock(mutex);
+
+	if (grid_dirty) {
+		_update_grid();
+	}
+
 	int closest_id = -1;
 	real_t closest_dist = 1e20;
 
-	for (OAHashMap<int, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
-		if (!p_include_disabled && !(*it.value)->enabled) {
-			continue; // Disabled points should not be considered.
+	if (point_data.size() == 0) {
+		return closest_id;
+	}
+
+	int center[3];
+	int max_ring = 0;
+	for (int i = 0; i < 3; i++) {
+		real_t cell = Math::floor((p_point[i] - grid_origin[i]) / grid_cell_size);
+		center[i] = (int)CLAMP(cell, (real_t)0, (real_t)(grid_size[i] - 1));
+		max_ring = MAX(max_ring, MAX(center[i], grid_size[i] - 1 - center[i]));
+	}
+
+	// Visit the cells in rings of growing distance around the cell of the
+	// point. The points of the cells not visited yet are at least
+	// `(ring - 1) * grid_cell_size` away, so we can stop once the closest
+	// point found is nearer than that.
+	for (int ring = 0; ring <= max_ring; ring++) {
+		if (closest_id != -1 && ring > 1) {
+			real_t ring_dist = (ring - 1) * grid_cell_size;
+			if (ring_dist * ring_dist > closest_dist) {
+				break;
+			}
 		}
 
-		// Keep the closest point's ID, and in case of multiple closest IDs,
-		// the smallest one (makes it deterministic).
-		real_t d = p_point.distance_squared_to((*it.value)->pos);
-		int id = *(it.key);
-		if (d <= closest_dist) {
-			if (d == closest_dist && id > closest_id) { // Keep lowest ID.
-				continue;
+		const int z_begin = MAX(center[2] - ring, 0);
+		const int z_end = MIN(center[2] + ring, grid_size[2] - 1);
+		const int y_begin = MAX(center[1] - ring, 0);
+		const int y_end = MIN(center[1] + ring, grid_size[1] - 1);
+		for (int z = z_begin; z <= z_end; z++) {
+			for (int y = y_begin; y <= y_end; y++) {
+				// Only the cells on the surface of the ring are visited.
+				bool on_surface = ABS(z - center[2]) == ring || ABS(y - center[1]) == ring;
+				int x_step = on_surface ? 1 : ring * 2;
+				for (int x = center[0] - ring; x <= center[0] + ring; x += MAX(x_step, 1)) {
+					if (x < 0 || x >= grid_size[0]) {
+						continue;
+					}
+
+					uint32_t cell_index = (z * grid_size[1] + y) * grid_size[0] + x;
+					for (uint32_t i = grid_offsets[cell_index]; i < grid_offsets[cell_index + 1]; i++) {
+						const PointData &data = point_data[grid_points[i]];
+						if (!p_include_disabled && !data.enabled) {
+							continue; // Disabled points should not be considered.
+						}
+
+						// Keep the closest point's ID, and in case of multiple closest IDs,
+						// the smallest one (makes it deterministic).
+						real_t d = p_point.distance_squared_to(data.pos);
+						if (d <= closest_dist) {
+							if (d == closest_dist && data.id > closest_id) { // Keep lowest ID.
+								continue;
+							}
+							closest_dist = d;
+							closest_id = data.id;
+						}
+					}
+				}
 			}
-			closest_dist = d;
-			closest_id = id;
 		}
 	}
 
@@ -305,13 +461,15 @@ Vector3 AStar::get_closest_position_in_segment(const Vector3 &p_point) const {
 		points.lookup(E->get().u, from_point);
 		points.lookup(E->get().v, to_point);
 
-		if (!(from_point->enabled && to_point->enabled)) {
+		const PointData &from_data = point_data[from_point->index];
+		const PointData &to_data = point_data[to_point->index];
+		if (!(from_data.enabled && to_data.enabled)) {
 			continue;
 		}
 
 		Vector3 segment[2] = {
-			from_point->pos,
-			to_point->pos,
+			from_data.pos,
+			to_data.pos,
 		};
 
 		Vector3 p = Geometry3D::get_closest_point_to_segment(p_point, segment);
@@ -325,62 +483,138 @@ Vector3 AStar::get_closest_position_in_segment(const Vector3 &p_point) const {
 	return closest_point;
 }
 
-bool AStar::_solve(Point *begin_point, Point *end_point) {
-	pass++;
+void AStar::_update_adjacency() {
+	adjacency_dirty = false;
 
-	if (!end_point->enabled) {
+	const uint32_t point_count = point_list.size();
+	adjacency_offsets.resize(point_count + 1);
+
+	uint32_t edge_count = 0;
+	for (uint32_t i = 0; i < point_count; i++) {
+		adjacency_offsets[i] = edge_count;
+		edge_count += point_list[i]->neighbours.get_num_elements();
+	}
+	adjacency_offsets[point_count] = edge_count;
+
+	adjacency.resize(edge_count);
+	for (uint32_t i = 0; i < point_count; i++) {
+		uint32_t edge = adjacency_offsets[i];
+		const OAHashMap<int, Point *> &neighbours = point_list[i]->neighbours;
+		for (OAHashMap<int, Point *>::Iterator it = neighbours.iter(); it.valid; it = neighbours.next_iter(it)) {
+			adjacency[edge++] = (*it.value)->index;
+		}
+	}
+}
+
+AStar::SearchContext *AStar::_acquire_search_context() {
+	MutexLock lock(mutex);
+
+	if (adjacency_dirty) {
+		_update_adjacency();
+	}
+
+	SearchContext *context;
+	if (free_search_contexts.size() > 0) {
+		context = free_search_contexts[free_search_contexts.size() - 1];
+		free_search_contexts.resize(free_search_contexts.size() - 1);
+	} else {
+		context = memnew(SearchContext);
+	}
+
+	if (context->states.size() < point_data.size()) {
+		context->states.resize(point_data.size());
+	}
+
+	return context;
+}
+
+void AStar::_release_search_context(SearchContext *p_context) {
+	MutexLock lock(mutex);
+	free_search_contexts.push_back(p_context);
+}
+
+template <class C>
+bool AStar::_solve(SearchContext *p_context, uint32_t p_begin_point, uint32_t p_end_point, C *p_costs) {
+	p_context->pass++;
+	const uint64_t pass = p_context->pass;
+
+	if (!point_data[p_end_point].enabled) {
 		return false;
 	}
 
 	bool found_route = false;
 
-	Vector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
-
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
+	const PointData *data = point_data.ptr();
+	const uint32_t *offsets = adjacency_offsets.ptr();
+	const uint32_t *neighbours = adjacency.ptr();
+	const int end_id = data[p_end_point].id;
+	const Vector3 end_pos = data[p_end_point].pos;
+
+	// Unless the cost functions are overridden (by a script or a derived class),
+	// both costs are plain distances, which can be computed from the point data
+	// directly instead of looking up ids for every edge.
+	ScriptInstance *si = p_costs->get_script_instance();
+	const bool custom_costs = typeid(*p_costs) != typeid(C) || (si && (si->has_method(SceneStringNames::get_singleton()->_estimate_cost) || si->has_method(SceneStringNames::get_singleton()->_compute_cost)));
+
+	PointState *states = p_context->states.ptr();
+	LocalVector<OpenPoint> &open_list = p_context->open_list;
+	SortArray<OpenPoint, SortPoints> sorter;
+	open_list.clear();
+
+	OpenPoint begin;
+	begin.index = p_begin_point;
+	begin.g_score = 0;
+	begin.f_score = custom_costs ? p_costs->_estimate_cost(data[p_begin_point].id, end_id) : data[p_begin_point].pos.distance_to(end_pos);
+	states[p_begin_point].g_score = 0;
+	states[p_begin_point].open_pass = pass;
+	open_list.push_back(begin);
 
 	while (!open_list.empty()) {
-		Point *p = open_list[0]; // The currently processed point
+		OpenPoint p = open_list[0]; // The currently processed point
+
+		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list
+		open_list.resize(open_list.size() - 1);
 
-		if (p == end_point) {
+		PointState &p_state = states[p.index];
+		if (p_state.closed_pass == pass || p.g_score != p_state.g_score) {
+			continue; // Outdated entry, the point was reached again through a better path.
+		}
+
+		if (p.index == p_end_point) {
 			found_route = true;
 			break;
 		}
 
-		sorter.pop_heap(0, open_list.size(), open_list.ptrw()); // Remove the current point from the open list
-		open_list.remove(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed
+		p_state.closed_pass = pass; // Mark the point as closed
 
-		for (OAHashMap<int, Point *>::Iterator it = p->neighbours.iter(); it.valid; it = p->neighbours.next_iter(it)) {
-			Point *e = *(it.value); // The neighbour point
+		const int p_id = data[p.index].id;
+		for (uint32_t i = offsets[p.index]; i < offsets[p.index + 1]; i++) {
+			const uint32_t e = neighbours[i]; // The neighbour point
+			PointState &e_state = states[e];
 
-			if (!e->enabled || e->closed_pass == pass) {
+			if (!data[e].enabled || e_state.closed_pass == pass) {
 				continue;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
-
-			bool new_point = false;
+			real_t cost = custom_costs ? p_costs->_compute_cost(p_id, data[e].id) : data[p.index].pos.distance_to(data[e].pos);
+			real_t tentative_g_score = p.g_score + cost * data[e].weight_scale;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
-				open_list.push_back(e);
-				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			if (e_state.open_pass == pass && tentative_g_score >= e_state.g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
-
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptrw());
-			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptrw());
-			}
+			// Instead of updating the position of the point in the open list,
+			// it's pushed again; the outdated entry is skipped when popped.
+			e_state.open_pass = pass;
+			e_state.prev_point = p.index;
+			e_state.g_score = tentative_g_score;
+
+			OpenPoint entry;
+			entry.index = e;
+			entry.g_score = tentative_g_score;
+			entry.f_score = tentative_g_score + (custom_costs ? p_costs->_estimate_cost(data[e].id, end_id) : data[e].pos.distance_to(end_pos));
+			open_list.push_back(entry);
+			sorter.push_heap(0, open_list.size() - 1, 0, entry, open_list.ptr());
 		}
 	}
 
@@ -400,7 +634,7 @@ real_t AStar::_estimate_cost(int p_from_id, int p_to_id) {
 	bool to_exists = points.lookup(p_to_id, to_point);
 	ERR_FAIL_COND_V(!to_exists, 0);
 
-	return from_point->pos.distance_to(to_point->pos);
+	return point_data[from_point->index].pos.distance_to(point_data[to_point->index].pos);
 }
 
 real_t AStar::_compute_cost(int p_from_id, int p_to_id) {
@@ -416,7 +650,7 @@ real_t AStar::_compute_cost(int p_from_id, int p_to_id) {
 	bool to_exists = points.lookup(p_to_id, to_point);
 	ERR_FAIL_COND_V(!to_exists, 0);
 
-	return from_point->pos.distance_to(to_point->pos);
+	return point_data[from_point->index].pos.distance_to(point_data[to_point->index].pos);
 }
 
 Vector<Vector3> AStar::get_point_path(int p_from_id, int p_to_id) {
@@ -430,23 +664,26 @@ Vector<Vector3> AStar::get_point_path(int p_from_id, int p_to_id) {
 
 	if (a == b) {
 		Vector<Vector3> ret;
-		ret.push_back(a->pos);
+		ret.push_back(point_data[a->index].pos);
 		return ret;
 	}
 
-	Point *begin_point = a;
-	Point *end_point = b;
+	uint32_t begin_point = a->index;
+	uint32_t end_point = b->index;
 
-	bool found_route = _solve(begin_point, end_point);
+	SearchContext *context = _acquire_search_context();
+	bool found_route = _solve(context, begin_point, end_point, this);
 	if (!found_route) {
+		_release_search_context(context);
 		return Vector<Vector3>();
 	}
 
-	Point *p = end_point;
+	const PointState *states = context->states.ptr();
+	uint32_t p = end_point;
 	int pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = states[p].prev_point;
 	}
 
 	Vector<Vector3> path;
@@ -455,16 +692,17 @@ Vector<Vector3> AStar::get_point_path(int p_from_id, int p_to_id) {
 	{
 		Vector3 *w = path.ptrw();
 
-		Point *p2 = end_point;
+		uint32_t p2 = end_point;
 		int idx = pc - 1;
 		while (p2 != begin_point) {
-			w[idx--] = p2->pos;
-			p2 = p2->prev_point;
+			w[idx--] = point_data[p2].pos;
+			p2 = states[p2].prev_point;
 		}
 
-		w[0] = p2->pos; // Assign first
+		w[0] = point_data[p2].pos; // Assign first
 	}
 
+	_release_search_context(context);
 	return path;
 }
 
@@ -483,19 +721,22 @@ Vector<int> AStar::get_id_path(int p_from_id, int p_to_id) {
 		return ret;
 	}
 
-	Point *begin_point = a;
-	Point *end_point = b;
+	uint32_t begin_point = a->index;
+	uint32_t end_point = b->index;
 
-	bool found_route = _solve(begin_point, end_point);
+	SearchContext *context = _acquire_search_context();
+	bool found_route = _solve(context, begin_point, end_point, this);
 	if (!found_route) {
+		_release_search_context(context);
 		return Vector<int>();
 	}
 
-	Point *p = end_point;
+	const PointState *states = context->states.ptr();
+	uint32_t p = end_point;
 	int pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = states[p].prev_point;
 	}
 
 	Vector<int> path;
@@ -507,13 +748,14 @@ Vector<int> AStar::get_id_path(int p_from_id, int p_to_id) {
 		p = end_point;
 		int idx = pc - 1;
 		while (p != begin_point) {
-			w[idx--] = p->id;
-			p = p->prev_point;
+			w[idx--] = point_data[p].id;
+			p = states[p].prev_point;
 		}
 
-		w[0] = p->id; // Assign first
+		w[0] = point_data[p].id; // Assign first
 	}
 
+	_release_search_context(context);
 	return path;
 }
 
@@ -522,7 +764,7 @@ void AStar::set_point_disabled(int p_id, bool p_disabled) {
 	bool p_exists = points.lookup(p_id, p);
 	ERR_FAIL_COND(!p_exists);
 
-	p->enabled = !p_disabled;
+	point_data[p->index].enabled = !p_disabled;
 }
 
 bool AStar::is_point_disabled(int p_id) const {
@@ -530,7 +772,7 @@ bool AStar::is_point_disabled(int p_id) const {
 	bool p_exists = points.lookup(p_id, p);
 	ERR_FAIL_COND_V(!p_exists, false);
 
-	return !p->enabled;
+	return !point_data[p->index].enabled;
 }
 
 void AStar::_bind_methods() {
@@ -569,6 +811,10 @@ void AStar::_bind_methods() {
 
 AStar::~AStar() {
 	clear();
+
+	for (uint32_t i = 0; i < free_search_contexts.size(); i++) {
+		memdelete(free_search_contexts[i]);
+	}
 }
 
 /////////////////////////////////////////////////////////////
@@ -672,7 +918,7 @@ real_t AStar2D::_estimate_cost(int p_from_id, int p_to_id) {
 	bool to_exists = astar.points.lookup(p_to_id, to_point);
 	ERR_FAIL_COND_V(!to_exists, 0);
 
-	return from_point->pos.distance_to(to_point->pos);
+	return astar.point_data[from_point->index].pos.distance_to(astar.point_data[to_point->index].pos);
 }
 
 real_t AStar2D::_compute_cost(int p_from_id, int p_to_id) {
@@ -688,7 +934,7 @@ real_t AStar2D::_compute_cost(int p_from_id, int p_to_id) {
 	bool to_exists = astar.points.lookup(p_to_id, to_point);
 	ERR_FAIL_COND_V(!to_exists, 0);
 
-	return from_point->pos.distance_to(to_point->pos);
+	return astar.point_data[from_point->index].pos.distance_to(astar.point_data[to_point->index].pos);
 }
 
 Vector<Vector2> AStar2D::get_point_path(int p_from_id, int p_to_id) {
@@ -701,24 +947,28 @@ Vector<Vector2> AStar2D::get_point_path(int p_from_id, int p_to_id) {
 	ERR_FAIL_COND_V(!to_exists, Vector<Vector2>());
 
 	if (a == b) {
+		Vector3 pos = astar.point_data[a->index].pos;
 		Vector<Vector2> ret;
-		ret.push_back(Vector2(a->pos.x, a->pos.y));
+		ret.push_back(Vector2(pos.x, pos.y));
 		return ret;
 	}
 
-	AStar::Point *begin_point = a;
-	AStar::Point *end_point = b;
+	uint32_t begin_point = a->index;
+	uint32_t end_point = b->index;
 
-	bool found_route = _solve(begin_point, end_point);
+	AStar::SearchContext *context = astar._acquire_search_context();
+	bool found_route = astar._solve(context, begin_point, end_point, this);
 	if (!found_route) {
+		astar._release_search_context(context);
 		return Vector<Vector2>();
 	}
 
-	AStar::Point *p = end_point;
+	const AStar::PointState *states = context->states.ptr();
+	uint32_t p = end_point;
 	int pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = states[p].prev_point;
 	}
 
 	Vector<Vector2> path;
@@ -727,16 +977,19 @@ Vector<Vector2> AStar2D::get_point_path(int p_from_id, int p_to_id) {
 	{
 		Vector2 *w = path.ptrw();
 
-		AStar::Point *p2 = end_point;
+		uint32_t p2 = end_point;
 		int idx = pc - 1;
 		while (p2 != begin_point) {
-			w[idx--] = Vector2(p2->pos.x, p2->pos.y);
-			p2 = p2->prev_point;
+			const Vector3 &pos = astar.point_data[p2].pos;
+			w[idx--] = Vector2(pos.x, pos.y);
+			p2 = states[p2].prev_point;
 		}
 
-		w[0] = Vector2(p2->pos.x, p2->pos.y); // Assign first
+		const Vector3 &pos = astar.point_data[p2].pos;
+		w[0] = Vector2(pos.x, pos.y); // Assign first
 	}
 
+	astar._release_search_context(context);
 	return path;
 }
 
@@ -755,19 +1008,22 @@ Vector<int> AStar2D::get_id_path(int p_from_id, int p_to_id) {
 		return ret;
 	}
 
-	AStar::Point *begin_point = a;
-	AStar::Point *end_point = b;
+	uint32_t begin_point = a->index;
+	uint32_t end_point = b->index;
 
-	bool found_route = _solve(begin_point, end_point);
+	AStar::SearchContext *context = astar._acquire_search_context();
+	bool found_route = astar._solve(context, begin_point, end_point, this);
 	if (!found_route) {
+		astar._release_search_context(context);
 		return Vector<int>();
 	}
 
-	AStar::Point *p = end_point;
+	const AStar::PointState *states = context->states.ptr();
+	uint32_t p = end_point;
 	int pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = states[p].prev_point;
 	}
 
 	Vector<int> path;
@@ -779,78 +1035,17 @@ Vector<int> AStar2D::get_id_path(int p_from_id, int p_to_id) {
 		p = end_point;
 		int idx = pc - 1;
 		while (p != begin_point) {
-			w[idx--] = p->id;
-			p = p->prev_point;
+			w[idx--] = astar.point_data[p].id;
+			p = states[p].prev_point;
 		}
 
-		w[0] = p->id; // Assign first
+		w[0] = astar.point_data[p].id; // Assign first
 	}
 
+	astar._release_search_context(context);
 	return path;
 }
 
-bool AStar2D::_solve(AStar::Point *begin_point, AStar::Point *end_point) {
-	astar.pass++;
-
-	if (!end_point->enabled) {
-		return false;
-	}
-
-	bool found_route = false;
-
-	Vector<AStar::Point *> open_list;
-	SortArray<AStar::Point *, AStar::SortPoints> sorter;
-
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
-
-	while (!open_list.empty()) {
-		AStar::Point *p = open_list[0]; // The currently processed point
-
-		if (p == end_point) {
-			found_route = true;
-			break;
-		}
-
-		sorter.pop_heap(0, open_list.size(), open_list.ptrw()); // Remove the current point from the open list
-		open_list.remove(open_list.size() - 1);
-		p->closed_pass = astar.pass; // Mark the point as closed
-
-		for (OAHashMap<int, AStar::Point *>::Iterator it = p->neighbours.iter(); it.valid; it = p->neighbours.next_iter(it)) {
-			AStar::Point *e = *(it.value); // The neighbour point
-
-			if (!e->enabled || e->closed_pass == astar.pass) {
-				continue;
-			}
-
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
-
-			bool new_point = false;
-
-			if (e->open_pass != astar.pass) { // The point wasn't inside the open list.
-				e->open_pass = astar.pass;
-				open_list.push_back(e);
-				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
-				continue;
-			}
-
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
-
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptrw());
-			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptrw());
-			}
-		}
-	}
-
-	return found_route;
-}
-
 void AStar2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_available_point_id"), &AStar2D::get_available_point_id);
 	ClassDB::bind_method(D_METHOD("add_point", "id", "position", "weight_scale"), &AStar2D::add_point, DEFVAL(1.0));
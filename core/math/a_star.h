@@ -31,7 +31,9 @@
 #ifndef A_STAR_H
 #define A_STAR_H
 
+#include "core/local_vector.h"
 #include "core/oa_hash_map.h"
+#include "core/os/mutex.h"
 #include "core/reference.h"
 
 /**
@@ -48,33 +50,54 @@ class AStar : public Reference {
 		Point() {}
 
 		int id;
-		Vector3 pos;
-		real_t weight_scale;
-		bool enabled;
+		uint32_t index; // Index of the point in `point_list` and `point_data`.
 
 		OAHashMap<int, Point *> neighbours = 4u;
 		OAHashMap<int, Point *> unlinked_neighbours = 4u;
+	};
+
+	// The data needed by the search, stored contiguously and indexed by `Point::index`.
+	struct PointData {
+		Vector3 pos;
+		real_t weight_scale;
+		int id;
+		bool enabled;
+	};
 
-		// Used for pathfinding.
-		Point *prev_point;
+	// The search state of a point, indexed by `Point::index`.
+	struct PointState {
 		real_t g_score;
+		uint32_t prev_point;
+		uint64_t open_pass = 0;
+		uint64_t closed_pass = 0;
+	};
+
+	struct OpenPoint {
 		real_t f_score;
-		uint64_t open_pass;
-		uint64_t closed_pass;
+		real_t g_score;
+		uint32_t index;
 	};
 
 	struct SortPoints {
-		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
-			if (A->f_score > B->f_score) {
+		_FORCE_INLINE_ bool operator()(const OpenPoint &A, const OpenPoint &B) const { // Returns true when the Point A is worse than Point B.
+			if (A.f_score > B.f_score) {
 				return true;
-			} else if (A->f_score < B->f_score) {
+			} else if (A.f_score < B.f_score) {
 				return false;
 			} else {
-				return A->g_score < B->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+				return A.g_score < B.g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
 			}
 		}
 	};
 
+	// The memory used by a single search, reused across searches. Each
+	// concurrent search uses its own context.
+	struct SearchContext {
+		uint64_t pass = 0;
+		LocalVector<PointState> states;
+		LocalVector<OpenPoint> open_list;
+	};
+
 	struct Segment {
 		union {
 			struct {
@@ -109,12 +132,40 @@ class AStar : public Reference {
 	};
 
 	int last_free_id = 0;
-	uint64_t pass = 1;
 
 	OAHashMap<int, Point *> points;
 	Set<Segment> segments;
 
-	bool _solve(Point *begin_point, Point *end_point);
+	LocalVector<Point *> point_list;
+	LocalVector<PointData> point_data;
+
+	// Connections in compressed sparse row form: the neighbours of the point
+	// at index `i` are `adjacency[adjacency_offsets[i]..adjacency_offsets[i + 1]]`.
+	// Rebuilt before the next search when the connections change.
+	bool adjacency_dirty = true;
+	LocalVector<uint32_t> adjacency_offsets;
+	LocalVector<uint32_t> adjacency;
+
+	// Uniform grid used by `get_closest_point`, rebuilt before the next query
+	// when the points move.
+	mutable bool grid_dirty = true;
+	mutable Vector3 grid_origin;
+	mutable real_t grid_cell_size = 1;
+	mutable int grid_size[3] = { 0, 0, 0 };
+	mutable LocalVector<uint32_t> grid_offsets;
+	mutable LocalVector<uint32_t> grid_points;
+
+	mutable Mutex mutex;
+	LocalVector<SearchContext *> free_search_contexts;
+
+	void _update_adjacency();
+	void _update_grid() const;
+
+	SearchContext *_acquire_search_context();
+	void _release_search_context(SearchContext *p_context);
+
+	template <class C>
+	bool _solve(SearchContext *p_context, uint32_t p_begin_point, uint32_t p_end_point, C *p_costs);
 
 protected:
 	static void _bind_methods();
@@ -159,9 +210,9 @@ public:
 
 class AStar2D : public Reference {
 	GDCLASS(AStar2D, Reference);
-	AStar astar;
+	friend class AStar;
 
-	bool _solve(AStar::Point *begin_point, AStar::Point *end_point);
+	AStar astar;
 
 protected:
 	static void _bind_methods();
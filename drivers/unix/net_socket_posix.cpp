@@ -56,6 +56,11 @@
 
 #include <netinet/tcp.h>
 
+#if defined(__linux__)
+#include <sys/epoll.h>
+#define NET_SOCKET_EPOLL_ENABLED
+#endif
+
 // BSD calls this flag IPV6_JOIN_GROUP
 #if !defined(IPV6_ADD_MEMBERSHIP) && defined(IPV6_JOIN_GROUP)
 #define IPV6_ADD_MEMBERSHIP IPV6_JOIN_GROUP
@@ -157,9 +162,11 @@ void NetSocketPosix::make_default() {
 	}
 #endif
 	_create = _create_func;
+	NetSocketReactorPosix::make_default();
 }
 
 void NetSocketPosix::cleanup() {
+	NetSocketReactorPosix::cleanup();
 #if defined(WINDOWS_ENABLED)
 	if (_create != nullptr) {
 		WSACleanup();
@@ -367,6 +374,10 @@ Error NetSocketPosix::open(Type p_sock_type, IP::Type &ip_type) {
 }
 
 void NetSocketPosix::close() {
+	if (_reactor) {
+		_reactor->_remove(this);
+	}
+
 	if (_sock != SOCK_EMPTY) {
 		SOCK_CLOSE(_sock);
 	}
@@ -744,4 +755,206 @@ Error NetSocketPosix::join_multicast_group(const IP_Address &p_multi_address, St
 Error NetSocketPosix::leave_multicast_group(const IP_Address &p_multi_address, String p_if_name) {
 	return _change_multicast_group(p_multi_address, p_if_name, false);
 }
+
+NetSocketReactor *NetSocketReactorPosix::_create_func() {
+	return memnew(NetSocketReactorPosix);
+}
+
+void NetSocketReactorPosix::make_default() {
+#if !defined(WINDOWS_ENABLED)
+	_create = _create_func;
+#endif
+}
+
+void NetSocketReactorPosix::cleanup() {
+	_create = nullptr;
+}
+
+#ifdef NET_SOCKET_EPOLL_ENABLED
+static uint32_t _get_epoll_events(NetSocket::PollType p_type) {
+	switch (p_type) {
+		case NetSocket::POLL_TYPE_IN:
+			return EPOLLIN;
+		case NetSocket::POLL_TYPE_OUT:
+			return EPOLLOUT;
+		case NetSocket::POLL_TYPE_IN_OUT:
+			return EPOLLIN | EPOLLOUT;
+	}
+	return EPOLLIN;
+}
+#endif
+
+void NetSocketReactorPosix::_remove(NetSocketPosix *p_sock) {
+#ifdef NET_SOCKET_EPOLL_ENABLED
+	if (_epoll_fd != -1 && p_sock->_sock != SOCK_EMPTY) {
+		struct epoll_event ev; // Ignored, but required by kernels before 2.6.9.
+		epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, p_sock->_sock, &ev);
+	}
+#endif
+
+	const uint32_t index = p_sock->_reactor_index;
+	const uint32_t last = _sockets.size() - 1;
+	if (index != last) {
+		_sockets[index] = _sockets[last];
+		_sockets[index]->_reactor_index = index;
+	}
+	_sockets.resize(last);
+
+	p_sock->_reactor = nullptr;
+	p_sock->_reactor_index = 0;
+}
+
+Error NetSocketReactorPosix::add_socket(Ref<NetSocket> p_sock, NetSocket::PollType p_type, uint64_t p_id) {
+	ERR_FAIL_COND_V(p_sock.is_null(), ERR_INVALID_PARAMETER);
+	// Sockets are created by NetSocketPosix::_create_func on the platforms this reactor exists on.
+	NetSocketPosix *sock = static_cast<NetSocketPosix *>(p_sock.ptr());
+	ERR_FAIL_COND_V(!sock->is_open(), ERR_UNCONFIGURED);
+	ERR_FAIL_COND_V_MSG(sock->_reactor != nullptr, ERR_ALREADY_IN_USE, "Socket is already registered with a reactor.");
+
+#ifdef NET_SOCKET_EPOLL_ENABLED
+	ERR_FAIL_COND_V(_epoll_fd == -1, ERR_UNAVAILABLE);
+	struct epoll_event ev;
+	ev.events = _get_epoll_events(p_type);
+	ev.data.u64 = p_id;
+	if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, sock->_sock, &ev) != 0) {
+		print_verbose("Unable to add socket to epoll, errno: " + itos(errno));
+		return FAILED;
+	}
+#endif
+
+	sock->_reactor = this;
+	sock->_reactor_index = _sockets.size();
+	sock->_reactor_type = p_type;
+	sock->_reactor_id = p_id;
+	_sockets.push_back(sock);
+	return OK;
+}
+
+Error NetSocketReactorPosix::modify_socket(Ref<NetSocket> p_sock, NetSocket::PollType p_type, uint64_t p_id) {
+	ERR_FAIL_COND_V(p_sock.is_null(), ERR_INVALID_PARAMETER);
+	NetSocketPosix *sock = static_cast<NetSocketPosix *>(p_sock.ptr());
+	ERR_FAIL_COND_V_MSG(sock->_reactor != this, ERR_DOES_NOT_EXIST, "Socket is not registered with this reactor.");
+
+#ifdef NET_SOCKET_EPOLL_ENABLED
+	struct epoll_event ev;
+	ev.events = _get_epoll_events(p_type);
+	ev.data.u64 = p_id;
+	if (epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, sock->_sock, &ev) != 0) {
+		print_verbose("Unable to modify socket in epoll, errno: " + itos(errno));
+		return FAILED;
+	}
+#endif
+
+	sock->_reactor_type = p_type;
+	sock->_reactor_id = p_id;
+	return OK;
+}
+
+void NetSocketReactorPosix::remove_socket(Ref<NetSocket> p_sock) {
+	ERR_FAIL_COND(p_sock.is_null());
+	NetSocketPosix *sock = static_cast<NetSocketPosix *>(p_sock.ptr());
+	ERR_FAIL_COND_MSG(sock->_reactor != this, "Socket is not registered with this reactor.");
+
+	_remove(sock);
+}
+
+int NetSocketReactorPosix::get_socket_count() const {
+	return _sockets.size();
+}
+
+int NetSocketReactorPosix::wait(Event *r_events, int p_max_events, int p_timeout) {
+	ERR_FAIL_COND_V(p_max_events <= 0, -1);
+
+#if defined(NET_SOCKET_EPOLL_ENABLED)
+	ERR_FAIL_COND_V(_epoll_fd == -1, -1);
+
+	LocalVector<struct epoll_event> events;
+	events.resize(MAX(1, MIN(p_max_events, (int)_sockets.size())));
+	int ret = epoll_wait(_epoll_fd, events.ptr(), events.size(), p_timeout);
+	if (ret < 0) {
+		if (errno == EINTR) {
+			return 0;
+		}
+		print_verbose("Error when waiting on epoll, errno: " + itos(errno));
+		return -1;
+	}
+
+	for (int i = 0; i < ret; i++) {
+		Event &ev = r_events[i];
+		ev.id = events[i].data.u64;
+		ev.error = events[i].events & (EPOLLERR | EPOLLHUP);
+		ev.readable = (events[i].events & EPOLLIN) || ev.error;
+		ev.writable = events[i].events & EPOLLOUT;
+	}
+	return ret;
+#elif !defined(WINDOWS_ENABLED)
+	if (_sockets.size() == 0) {
+		return 0;
+	}
+
+	LocalVector<struct pollfd> pfds;
+	pfds.resize(_sockets.size());
+	for (uint32_t i = 0; i < _sockets.size(); i++) {
+		pfds[i].fd = _sockets[i]->_sock;
+		pfds[i].revents = 0;
+		switch (_sockets[i]->_reactor_type) {
+			case NetSocket::POLL_TYPE_IN:
+				pfds[i].events = POLLIN;
+				break;
+			case NetSocket::POLL_TYPE_OUT:
+				pfds[i].events = POLLOUT;
+				break;
+			case NetSocket::POLL_TYPE_IN_OUT:
+				pfds[i].events = POLLIN | POLLOUT;
+		}
+	}
+
+	int ret = ::poll(pfds.ptr(), pfds.size(), p_timeout);
+	if (ret < 0) {
+		if (errno == EINTR) {
+			return 0;
+		}
+		print_verbose("Error when polling sockets.");
+		return -1;
+	}
+
+	int count = 0;
+	for (uint32_t i = 0; i < pfds.size() && count < p_max_events; i++) {
+		if (!pfds[i].revents) {
+			continue;
+		}
+		Event &ev = r_events[count++];
+		ev.id = _sockets[i]->_reactor_id;
+		ev.error = pfds[i].revents & (POLLERR | POLLHUP | POLLNVAL);
+		ev.readable = (pfds[i].revents & POLLIN) || ev.error;
+		ev.writable = pfds[i].revents & POLLOUT;
+	}
+	return count;
+#else
+	ERR_FAIL_V_MSG(-1, "Socket reactor is not supported on this platform.");
+#endif
+}
+
+NetSocketReactorPosix::NetSocketReactorPosix() {
+#ifdef NET_SOCKET_EPOLL_ENABLED
+	_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (_epoll_fd == -1) {
+		ERR_PRINT("Unable to create epoll instance, errno: " + itos(errno) + ".");
+	}
+#endif
+}
+
+NetSocketReactorPosix::~NetSocketReactorPosix() {
+	for (uint32_t i = 0; i < _sockets.size(); i++) {
+		_sockets[i]->_reactor = nullptr;
+		_sockets[i]->_reactor_index = 0;
+	}
+	_sockets.clear();
+
+#ifdef NET_SOCKET_EPOLL_ENABLED
+	if (_epoll_fd != -1) {
+		::close(_epoll_fd);
+	}
+#endif
+}
 #endif
@@ -32,6 +32,7 @@
 #define NET_SOCKET_UNIX_H
 
 #include "core/io/net_socket.h"
+#include "core/local_vector.h"
 
 #if defined(WINDOWS_ENABLED)
 #include <winsock2.h>
@@ -44,12 +45,22 @@
 
 #endif
 
+class NetSocketReactorPosix;
+
 class NetSocketPosix : public NetSocket {
+	friend class NetSocketReactorPosix;
+
 private:
 	SOCKET_TYPE _sock; // NOLINT - the default value is defined in the .cpp
 	IP::Type _ip_type = IP::TYPE_NONE;
 	bool _is_stream = false;
 
+	// Reactor this socket is registered with, if any. Cleared by the reactor when it goes away.
+	NetSocketReactorPosix *_reactor = nullptr;
+	uint32_t _reactor_index = 0;
+	PollType _reactor_type = POLL_TYPE_IN;
+	uint64_t _reactor_id = 0;
+
 	enum NetError {
 		ERR_NET_WOULD_BLOCK,
 		ERR_NET_IS_CONNECTED,
@@ -101,4 +112,32 @@ public:
 	~NetSocketPosix();
 };
 
+// Uses epoll on Linux and a single poll() call over all the sockets on other
+// Unix systems. Not available on Windows, where NetSocketReactor::create()
+// returns nullptr and callers keep polling sockets one by one.
+class NetSocketReactorPosix : public NetSocketReactor {
+	friend class NetSocketPosix;
+
+	LocalVector<NetSocketPosix *> _sockets;
+	int _epoll_fd = -1;
+
+	void _remove(NetSocketPosix *p_sock);
+
+protected:
+	static NetSocketReactor *_create_func();
+
+public:
+	static void make_default();
+	static void cleanup();
+
+	virtual Error add_socket(Ref<NetSocket> p_sock, NetSocket::PollType p_type, uint64_t p_id);
+	virtual Error modify_socket(Ref<NetSocket> p_sock, NetSocket::PollType p_type, uint64_t p_id);
+	virtual void remove_socket(Ref<NetSocket> p_sock);
+	virtual int get_socket_count() const;
+	virtual int wait(Event *r_events, int p_max_events, int p_timeout);
+
+	NetSocketReactorPosix();
+	~NetSocketReactorPosix();
+};
+
 #endif
@@ -69,6 +69,45 @@ void EditorNetworkProfiler::_update_frame() {
 		node->set_text(3, E->get().outgoing_rpc == 0 ? "-" : itos(E->get().outgoing_rpc));
 		node->set_text(4, E->get().outgoing_rset == 0 ? "-" : itos(E->get().outgoing_rset));
 	}
+
+	rpc_display->clear();
+	root = rpc_display->create_item();
+
+	// Heaviest senders first, they are what eats the bandwidth budget.
+	Vector<const DebuggerMarshalls::MultiplayerRPCInfo *> infos;
+	for (Map<String, DebuggerMarshalls::MultiplayerRPCInfo>::Element *E = rpc_data.front(); E; E = E->next()) {
+		infos.push_back(&E->get());
+	}
+	struct RPCInfoSort {
+		bool operator()(const DebuggerMarshalls::MultiplayerRPCInfo *A, const DebuggerMarshalls::MultiplayerRPCInfo *B) const {
+			return A->outgoing_bytes + A->incoming_bytes > B->outgoing_bytes + B->incoming_bytes;
+		}
+	};
+	infos.sort_custom<RPCInfoSort>();
+
+	for (int i = 0; i < infos.size(); i++) {
+		const DebuggerMarshalls::MultiplayerRPCInfo &info = *infos[i];
+		TreeItem *item = rpc_display->create_item(root);
+
+		for (int j = 0; j < rpc_display->get_columns(); ++j) {
+			item->set_text_align(j, j > 0 ? TreeItem::ALIGN_RIGHT : TreeItem::ALIGN_LEFT);
+		}
+
+		String peers;
+		for (int j = 0; j < info.peers.size(); j++) {
+			peers += (j > 0 ? ", " : "") + itos(info.peers[j]);
+		}
+
+		item->set_text(0, info.node_path + (info.rset ? " (rset) " : " ") + info.name);
+		item->set_text(1, info.incoming_calls == 0 ? "-" : itos(info.incoming_calls));
+		item->set_text(2, info.incoming_calls == 0 ? "-" : String::humanize_size(info.incoming_bytes));
+		item->set_text(3, info.incoming_calls == 0 ? "-" : vformat(TTR("%s ms"), String::num(info.decode_usec / 1000.0, 3)));
+		item->set_text(4, info.outgoing_calls == 0 ? "-" : itos(info.outgoing_calls));
+		item->set_text(5, info.outgoing_calls == 0 ? "-" : String::humanize_size(info.outgoing_bytes));
+		item->set_text(6, info.outgoing_calls == 0 ? "-" : vformat(TTR("%s ms"), String::num(info.encode_usec / 1000.0, 3)));
+		item->set_text(7, peers);
+		item->set_tooltip(7, peers);
+	}
 }
 
 void EditorNetworkProfiler::_activate_pressed() {
@@ -84,6 +123,7 @@ void EditorNetworkProfiler::_activate_pressed() {
 
 void EditorNetworkProfiler::_clear_pressed() {
 	nodes_data.clear();
+	rpc_data.clear();
 	set_bandwidth(0, 0);
 	if (frame_delay->is_stopped()) {
 		frame_delay->set_wait_time(0.1);
@@ -107,6 +147,32 @@ void EditorNetworkProfiler::add_node_frame_data(const DebuggerMarshalls::Multipl
 	}
 }
 
+void EditorNetworkProfiler::add_rpc_frame_data(const DebuggerMarshalls::MultiplayerRPCInfo &p_frame) {
+	const String key = itos(uint64_t(p_frame.node)) + "/" + p_frame.name + (p_frame.rset ? "/rset" : "/rpc");
+	if (!rpc_data.has(key)) {
+		rpc_data.insert(key, p_frame);
+	} else {
+		DebuggerMarshalls::MultiplayerRPCInfo &info = rpc_data[key];
+		info.incoming_calls += p_frame.incoming_calls;
+		info.incoming_bytes += p_frame.incoming_bytes;
+		info.decode_usec += p_frame.decode_usec;
+		info.outgoing_calls += p_frame.outgoing_calls;
+		info.outgoing_bytes += p_frame.outgoing_bytes;
+		info.encode_usec += p_frame.encode_usec;
+		info.unreliable_calls += p_frame.unreliable_calls;
+		for (int i = 0; i < p_frame.peers.size(); i++) {
+			if (info.peers.find(p_frame.peers[i]) == -1) {
+				info.peers.push_back(p_frame.peers[i]);
+			}
+		}
+	}
+
+	if (frame_delay->is_stopped()) {
+		frame_delay->set_wait_time(0.1);
+		frame_delay->start();
+	}
+}
+
 void EditorNetworkProfiler::set_bandwidth(int p_incoming, int p_outgoing) {
 	incoming_bandwidth_text->set_text(vformat(TTR("%s/s"), String::humanize_size(p_incoming)));
 	outgoing_bandwidth_text->set_text(vformat(TTR("%s/s"), String::humanize_size(p_outgoing)));
@@ -169,6 +235,10 @@ EditorNetworkProfiler::EditorNetworkProfiler() {
 	// Set initial texts in the incoming/outgoing bandwidth labels
 	set_bandwidth(0, 0);
 
+	VSplitContainer *split = memnew(VSplitContainer);
+	split->set_v_size_flags(SIZE_EXPAND_FILL);
+	add_child(split);
+
 	counters_display = memnew(Tree);
 	counters_display->set_custom_minimum_size(Size2(300, 0) * EDSCALE);
 	counters_display->set_v_size_flags(SIZE_EXPAND_FILL);
@@ -191,7 +261,25 @@ EditorNetworkProfiler::EditorNetworkProfiler() {
 	counters_display->set_column_title(4, TTR("Outgoing RSET"));
 	counters_display->set_column_expand(4, false);
 	counters_display->set_column_min_width(4, 120 * EDSCALE);
-	add_child(counters_display);
+	split->add_child(counters_display);
+
+	rpc_display = memnew(Tree);
+	rpc_display->set_custom_minimum_size(Size2(300, 0) * EDSCALE);
+	rpc_display->set_v_size_flags(SIZE_EXPAND_FILL);
+	rpc_display->set_hide_folding(true);
+	rpc_display->set_hide_root(true);
+	rpc_display->set_columns(8);
+	rpc_display->set_column_titles_visible(true);
+	rpc_display->set_column_title(0, TTR("Method"));
+	rpc_display->set_column_expand(0, true);
+	rpc_display->set_column_min_width(0, 60 * EDSCALE);
+	const char *rpc_columns[] = { TTRC("Calls In"), TTRC("Bytes In"), TTRC("Decode"), TTRC("Calls Out"), TTRC("Bytes Out"), TTRC("Encode"), TTRC("Peers") };
+	for (int i = 0; i < 7; i++) {
+		rpc_display->set_column_title(i + 1, TTRGET(rpc_columns[i]));
+		rpc_display->set_column_expand(i + 1, false);
+		rpc_display->set_column_min_width(i + 1, 90 * EDSCALE);
+	}
+	split->add_child(rpc_display);
 
 	frame_delay = memnew(Timer);
 	frame_delay->set_wait_time(0.1);
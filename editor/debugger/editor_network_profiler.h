@@ -45,12 +45,14 @@ private:
 	Button *activate;
 	Button *clear_button;
 	Tree *counters_display;
+	Tree *rpc_display;
 	LineEdit *incoming_bandwidth_text;
 	LineEdit *outgoing_bandwidth_text;
 
 	Timer *frame_delay;
 
 	Map<ObjectID, DebuggerMarshalls::MultiplayerNodeInfo> nodes_data;
+	Map<String, DebuggerMarshalls::MultiplayerRPCInfo> rpc_data;
 
 	void _update_frame();
 
@@ -63,6 +65,7 @@ protected:
 
 public:
 	void add_node_frame_data(const DebuggerMarshalls::MultiplayerNodeInfo p_frame);
+	void add_rpc_frame_data(const DebuggerMarshalls::MultiplayerRPCInfo &p_frame);
 	void set_bandwidth(int p_incoming, int p_outgoing);
 	bool is_profiling();
 
@@ -696,6 +696,13 @@ void ScriptEditorDebugger::_parse_message(const String &p_msg, const Array &p_da
 			network_profiler->add_node_frame_data(frame.infos[i]);
 		}
 
+	} else if (p_msg == "network:rpc_profile_frame") {
+		DebuggerMarshalls::NetworkRPCProfilerFrame frame;
+		frame.deserialize(p_data);
+		for (int i = 0; i < frame.infos.size(); i++) {
+			network_profiler->add_rpc_frame_data(frame.infos[i]);
+		}
+
 	} else if (p_msg == "network:bandwidth") {
 		ERR_FAIL_COND(p_data.size() < 2);
 		network_profiler->set_bandwidth(p_data[0], p_data[1]);
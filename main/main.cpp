@@ -32,6 +32,7 @@
 
 #include "core/crypto/crypto.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/trace_profiler.h"
 #include "core/input/input.h"
 #include "core/input/input_map.h"
 #include "core/io/file_access_network.h"
@@ -160,6 +161,8 @@ static int frame_delay = 0;
 static bool disable_render_loop = false;
 static int fixed_fps = -1;
 static bool print_fps = false;
+static String trace_path;
+static String dump_monitors_path;
 
 /* Helper methods */
 
@@ -326,6 +329,8 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  -d, --debug                      Debug (local stdout debugger).\n");
 	OS::get_singleton()->print("  -b, --breakpoints                Breakpoint list as source::line comma-separated pairs, no spaces (use %%20 instead).\n");
 	OS::get_singleton()->print("  --profiling                      Enable profiling in the script debugger.\n");
+	OS::get_singleton()->print("  --trace <file>                   Record instrumented engine zones and save them as a Chrome trace (JSON) on exit.\n");
+	OS::get_singleton()->print("  --dump-monitors <file>           Save monitor statistics (min/max/avg/percentiles) every second and on exit, as CSV or as JSON with a .json extension.\n");
 	OS::get_singleton()->print("  --gpu-abort                      Abort on GPU errors (usually validation layer errors), may help see the problem if your system freezes.\n");
 	OS::get_singleton()->print("  --remote-debug <uri>             Remote debug (<protocol>://<host/IP>[:<port>], e.g. tcp://127.0.0.1:6007).\n");
 #if defined(DEBUG_ENABLED) && !defined(SERVER_ENABLED)
@@ -874,6 +879,22 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			}
 		} else if (I->get() == "--print-fps") {
 			print_fps = true;
+		} else if (I->get() == "--trace") {
+			if (I->next()) {
+				trace_path = I->next()->get();
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing trace file argument, aborting.\n");
+				goto error;
+			}
+		} else if (I->get() == "--dump-monitors") {
+			if (I->next()) {
+				dump_monitors_path = I->next()->get();
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing monitor stats file argument, aborting.\n");
+				goto error;
+			}
 		} else if (I->get() == "--disable-crash-handler") {
 			OS::get_singleton()->disable_crash_handler();
 		} else if (I->get() == "--skip-breakpoints") {
@@ -885,6 +906,15 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 		I = N;
 	}
 
+	if (trace_path != String()) {
+#ifdef TRACE_PROFILER_ENABLED
+		TraceProfiler::set_thread_name("Main");
+		TraceProfiler::start();
+#else
+		WARN_PRINT("--trace was passed, but this binary was built with trace_profiler=no. The trace will be empty.");
+#endif
+	}
+
 #ifdef TOOLS_ENABLED
 	if (editor && project_manager) {
 		OS::get_singleton()->print("Error: Command line arguments implied opening both editor and project manager, which is not possible. Aborting.\n");
@@ -1251,6 +1281,7 @@ error:
 	if (message_queue) {
 		memdelete(message_queue);
 	}
+	TraceProfiler::finalize();
 	OS::get_singleton()->finalize_core();
 	locale = String();
 
@@ -2132,6 +2163,8 @@ bool Main::iteration() {
 	//for now do not error on this
 	//ERR_FAIL_COND_V(iterating, false);
 
+	TRACE_ZONE("Main::iteration");
+
 	iterating++;
 
 	uint64_t ticks = OS::get_singleton()->get_ticks_usec();
@@ -2171,6 +2204,7 @@ bool Main::iteration() {
 	Engine::get_singleton()->_in_physics = true;
 
 	for (int iters = 0; iters < advance.physics_steps; ++iters) {
+		TRACE_ZONE("Main::physics_step");
 		uint64_t physics_begin = OS::get_singleton()->get_ticks_usec();
 
 		PhysicsServer3D::get_singleton()->sync();
@@ -2228,6 +2262,8 @@ bool Main::iteration() {
 	idle_process_max = MAX(idle_process_ticks, idle_process_max);
 	uint64_t frame_time = OS::get_singleton()->get_ticks_usec() - ticks;
 
+	performance->sample_frame(frame_time, idle_process_ticks, physics_process_ticks);
+
 	for (int i = 0; i < ScriptServer::get_language_count(); i++) {
 		ScriptServer::get_language(i)->frame();
 	}
@@ -2256,6 +2292,11 @@ bool Main::iteration() {
 		idle_process_max = 0;
 		physics_process_max = 0;
 
+		if (dump_monitors_path != String()) {
+			// Rewritten every second so soak tests that get killed still leave stats behind.
+			performance->save_monitor_stats(dump_monitors_path);
+		}
+
 		frame %= 1000000;
 		frames = 0;
 	}
@@ -2316,6 +2357,18 @@ void Main::force_redraw() {
 void Main::cleanup() {
 	ERR_FAIL_COND(!_start_success);
 
+	if (trace_path != String()) {
+		TraceProfiler::stop();
+		Error err = TraceProfiler::save_chrome_trace(trace_path);
+		if (err == OK) {
+			print_line("Trace saved to: " + trace_path);
+		}
+	}
+
+	if (dump_monitors_path != String()) {
+		performance->save_monitor_stats(dump_monitors_path);
+	}
+
 	EngineDebugger::deinitialize();
 
 	ResourceLoader::remove_custom_loaders();
@@ -2408,6 +2461,8 @@ void Main::cleanup() {
 		OS::get_singleton()->set_restart_on_exit(false, List<String>()); //clear list (uses memory)
 	}
 
+	TraceProfiler::finalize();
+
 	unregister_core_driver_types();
 	unregister_core_types();
 
@@ -30,7 +30,10 @@
 
 #include "performance.h"
 
+#include "core/debugger/performance_counter.h"
+#include "core/io/json.h"
 #include "core/message_queue.h"
+#include "core/os/file_access.h"
 #include "core/os/os.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
@@ -44,6 +47,17 @@ Performance *Performance::singleton = nullptr;
 void Performance::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_monitor", "monitor"), &Performance::get_monitor);
 
+	ClassDB::bind_method(D_METHOD("add_custom_monitor", "id", "per_frame"), &Performance::add_custom_monitor, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("remove_custom_monitor", "id"), &Performance::remove_custom_monitor);
+	ClassDB::bind_method(D_METHOD("has_custom_monitor", "id"), &Performance::has_custom_monitor);
+	ClassDB::bind_method(D_METHOD("set_custom_monitor", "id", "value"), &Performance::set_custom_monitor);
+	ClassDB::bind_method(D_METHOD("add_to_custom_monitor", "id", "amount"), &Performance::add_to_custom_monitor, DEFVAL(1.0));
+	ClassDB::bind_method(D_METHOD("get_custom_monitor", "id"), &Performance::get_custom_monitor);
+	ClassDB::bind_method(D_METHOD("get_custom_monitor_names"), &Performance::get_custom_monitor_names);
+
+	ClassDB::bind_method(D_METHOD("get_monitor_stats", "id"), &Performance::get_monitor_stats);
+	ClassDB::bind_method(D_METHOD("save_monitor_stats", "path"), &Performance::save_monitor_stats);
+
 	BIND_ENUM_CONSTANT(TIME_FPS);
 	BIND_ENUM_CONSTANT(TIME_PROCESS);
 	BIND_ENUM_CONSTANT(TIME_PHYSICS_PROCESS);
@@ -71,6 +85,10 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(PHYSICS_3D_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PHYSICS_3D_ISLAND_COUNT);
 	BIND_ENUM_CONSTANT(AUDIO_OUTPUT_LATENCY);
+	BIND_ENUM_CONSTANT(PHYSICS_PICKING_QUERIES);
+	BIND_ENUM_CONSTANT(TIME_PHYSICS_PICKING);
+	BIND_ENUM_CONSTANT(NETWORK_PACKETS_SENT);
+	BIND_ENUM_CONSTANT(NETWORK_BYTES_SENT);
 
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
@@ -84,6 +102,38 @@ float Performance::_get_node_count() const {
 	return sml->get_node_count();
 }
 
+float Performance::_get_physics_picking_queries() const {
+	SceneTree *sml = Object::cast_to<SceneTree>(OS::get_singleton()->get_main_loop());
+	if (!sml) {
+		return 0;
+	}
+	return sml->get_physics_picking_queries();
+}
+
+float Performance::_get_physics_picking_time() const {
+	SceneTree *sml = Object::cast_to<SceneTree>(OS::get_singleton()->get_main_loop());
+	if (!sml) {
+		return 0;
+	}
+	return sml->get_physics_picking_usec() / 1000000.0;
+}
+
+float Performance::_get_network_packets_sent() const {
+	SceneTree *sml = Object::cast_to<SceneTree>(OS::get_singleton()->get_main_loop());
+	if (!sml || sml->get_multiplayer().is_null()) {
+		return 0;
+	}
+	return sml->get_multiplayer()->get_last_frame_packets_sent();
+}
+
+float Performance::_get_network_bytes_sent() const {
+	SceneTree *sml = Object::cast_to<SceneTree>(OS::get_singleton()->get_main_loop());
+	if (!sml || sml->get_multiplayer().is_null()) {
+		return 0;
+	}
+	return sml->get_multiplayer()->get_last_frame_bytes_sent();
+}
+
 String Performance::get_monitor_name(Monitor p_monitor) const {
 	ERR_FAIL_INDEX_V(p_monitor, MONITOR_MAX, String());
 	static const char *names[MONITOR_MAX] = {
@@ -115,6 +165,10 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"physics_3d/collision_pairs",
 		"physics_3d/islands",
 		"audio/output_latency",
+		"picking/queries",
+		"picking/time",
+		"network/packets_sent",
+		"network/bytes_sent",
 
 	};
 
@@ -177,6 +231,14 @@ float Performance::get_monitor(Monitor p_monitor) const {
 			return PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT);
 		case AUDIO_OUTPUT_LATENCY:
 			return AudioServer::get_singleton()->get_output_latency();
+		case PHYSICS_PICKING_QUERIES:
+			return _get_physics_picking_queries();
+		case TIME_PHYSICS_PICKING:
+			return _get_physics_picking_time();
+		case NETWORK_PACKETS_SENT:
+			return _get_network_packets_sent();
+		case NETWORK_BYTES_SENT:
+			return _get_network_bytes_sent();
 
 		default: {
 		}
@@ -217,6 +279,10 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
 
 	};
 
@@ -231,8 +297,199 @@ void Performance::set_physics_process_time(float p_pt) {
 	_physics_process_time = p_pt;
 }
 
+void Performance::History::push(float p_value) {
+	if (samples.size() < HISTORY_SIZE) {
+		samples.push_back(p_value);
+	} else {
+		samples[pos] = p_value;
+	}
+	pos = (pos + 1) % HISTORY_SIZE;
+}
+
+void Performance::_push_history(const StringName &p_name, float p_value) {
+	History *h = histories.getptr(p_name);
+	if (!h) {
+		histories[p_name] = History();
+		history_order.push_back(p_name);
+		h = histories.getptr(p_name);
+	}
+	h->push(p_value);
+}
+
+Dictionary Performance::_get_history_stats(const History &p_history) const {
+	LocalVector<float> sorted = p_history.samples;
+	sorted.sort();
+
+	uint32_t count = sorted.size();
+	double total = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		total += sorted[i];
+	}
+
+	// Nearest-rank percentile.
+	const float percentiles[3] = { 0.5, 0.95, 0.99 };
+	float values[3] = { 0, 0, 0 };
+	for (int i = 0; i < 3 && count > 0; i++) {
+		uint32_t rank = (uint32_t)Math::ceil(percentiles[i] * count);
+		values[i] = sorted[CLAMP(rank, 1u, count) - 1];
+	}
+
+	Dictionary d;
+	d["samples"] = count;
+	d["min"] = count ? sorted[0] : 0;
+	d["max"] = count ? sorted[count - 1] : 0;
+	d["avg"] = count ? total / count : 0;
+	d["p50"] = values[0];
+	d["p95"] = values[1];
+	d["p99"] = values[2];
+	return d;
+}
+
+void Performance::add_custom_monitor(const StringName &p_id, bool p_per_frame) {
+	MutexLock lock(monitor_mutex);
+	ERR_FAIL_COND_MSG(custom_monitors.has(p_id) || engine_counters.has(p_id), "Monitor '" + String(p_id) + "' already exists.");
+
+	CustomMonitor monitor;
+	monitor.per_frame = p_per_frame;
+	custom_monitors[p_id] = monitor;
+}
+
+void Performance::remove_custom_monitor(const StringName &p_id) {
+	MutexLock lock(monitor_mutex);
+	ERR_FAIL_COND_MSG(!custom_monitors.has(p_id), "Custom monitor '" + String(p_id) + "' doesn't exist.");
+
+	custom_monitors.erase(p_id);
+	histories.erase(p_id);
+	history_order.erase(p_id);
+}
+
+bool Performance::has_custom_monitor(const StringName &p_id) const {
+	MutexLock lock(monitor_mutex);
+	return custom_monitors.has(p_id);
+}
+
+void Performance::set_custom_monitor(const StringName &p_id, float p_value) {
+	MutexLock lock(monitor_mutex);
+	CustomMonitor *monitor = custom_monitors.getptr(p_id);
+	ERR_FAIL_COND_MSG(!monitor, "Custom monitor '" + String(p_id) + "' doesn't exist.");
+	monitor->value = p_value;
+}
+
+void Performance::add_to_custom_monitor(const StringName &p_id, float p_amount) {
+	MutexLock lock(monitor_mutex);
+	CustomMonitor *monitor = custom_monitors.getptr(p_id);
+	ERR_FAIL_COND_MSG(!monitor, "Custom monitor '" + String(p_id) + "' doesn't exist.");
+	monitor->value += p_amount;
+}
+
+float Performance::get_custom_monitor(const StringName &p_id) const {
+	MutexLock lock(monitor_mutex);
+	const CustomMonitor *monitor = custom_monitors.getptr(p_id);
+	if (monitor) {
+		return monitor->per_frame ? monitor->last : monitor->value;
+	}
+	PerformanceCounter *const *counter = engine_counters.getptr(p_id);
+	ERR_FAIL_COND_V_MSG(!counter, 0, "Monitor '" + String(p_id) + "' doesn't exist.");
+	return (*counter)->get_last();
+}
+
+Array Performance::get_custom_monitor_names() const {
+	MutexLock lock(monitor_mutex);
+	Array names;
+	const StringName *k = nullptr;
+	while ((k = engine_counters.next(k))) {
+		names.push_back(*k);
+	}
+	k = nullptr;
+	while ((k = custom_monitors.next(k))) {
+		names.push_back(*k);
+	}
+	return names;
+}
+
+Dictionary Performance::get_monitor_stats(const StringName &p_id) const {
+	MutexLock lock(monitor_mutex);
+	const History *h = histories.getptr(p_id);
+	ERR_FAIL_COND_V_MSG(!h, Dictionary(), "No samples were recorded for monitor '" + String(p_id) + "'.");
+	return _get_history_stats(*h);
+}
+
+Error Performance::save_monitor_stats(const String &p_path) const {
+	Dictionary stats;
+	Vector<StringName> order;
+	{
+		MutexLock lock(monitor_mutex);
+		order = history_order;
+		for (int i = 0; i < order.size(); i++) {
+			stats[order[i]] = _get_history_stats(histories[order[i]]);
+		}
+	}
+
+	Error err;
+	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(!f, err, "Cannot open file '" + p_path + "' to save the monitor stats.");
+
+	if (p_path.get_extension().to_lower() == "json") {
+		f->store_string(JSON::print(stats, "\t"));
+	} else {
+		static const char *columns[7] = { "min", "max", "avg", "p50", "p95", "p99", "samples" };
+		String line = "monitor";
+		for (int i = 0; i < 7; i++) {
+			line += String(",") + columns[i];
+		}
+		f->store_line(line);
+
+		for (int i = 0; i < order.size(); i++) {
+			Dictionary d = stats[order[i]];
+			line = String(order[i]);
+			for (int j = 0; j < 7; j++) {
+				line += "," + String(d[columns[j]]);
+			}
+			f->store_line(line);
+		}
+	}
+
+	f->close();
+	memdelete(f);
+	return OK;
+}
+
+void Performance::sample_frame(uint64_t p_frame_usec, uint64_t p_process_usec, uint64_t p_physics_process_usec) {
+	MutexLock lock(monitor_mutex);
+
+	_push_history(time_frame_name, USEC_TO_SEC(p_frame_usec));
+	_push_history(time_process_name, USEC_TO_SEC(p_process_usec));
+	_push_history(time_physics_process_name, USEC_TO_SEC(p_physics_process_usec));
+
+	const StringName *k = nullptr;
+	while ((k = engine_counters.next(k))) {
+		_push_history(*k, engine_counters[*k]->sample());
+	}
+
+	k = nullptr;
+	while ((k = custom_monitors.next(k))) {
+		CustomMonitor &monitor = custom_monitors[*k];
+		if (monitor.per_frame) {
+			monitor.last = monitor.value;
+			monitor.value = 0;
+			_push_history(*k, monitor.last);
+		} else {
+			_push_history(*k, monitor.value);
+		}
+	}
+}
+
 Performance::Performance() {
 	_process_time = 0;
 	_physics_process_time = 0;
+
+	time_frame_name = "time/frame";
+	time_process_name = "time/process";
+	time_physics_process_name = "time/physics_process";
+
+	for (PerformanceCounter *counter = PerformanceCounter::get_first(); counter; counter = counter->get_next()) {
+		engine_counters[counter->get_name()] = counter;
+	}
+
 	singleton = this;
 }
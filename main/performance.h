@@ -31,11 +31,16 @@
 #ifndef PERFORMANCE_H
 #define PERFORMANCE_H
 
+#include "core/hash_map.h"
+#include "core/local_vector.h"
 #include "core/object.h"
+#include "core/os/mutex.h"
 
 #define PERF_WARN_OFFLINE_FUNCTION
 #define PERF_WARN_PROCESS_SYNC
 
+class PerformanceCounter;
+
 class Performance : public Object {
 	GDCLASS(Performance, Object);
 
@@ -43,10 +48,46 @@ class Performance : public Object {
 	static void _bind_methods();
 
 	float _get_node_count() const;
+	float _get_physics_picking_queries() const;
+	float _get_physics_picking_time() const;
+	float _get_network_packets_sent() const;
+	float _get_network_bytes_sent() const;
 
 	float _process_time;
 	float _physics_process_time;
 
+	enum {
+		HISTORY_SIZE = 1024, // Frames kept for each named monitor.
+	};
+
+	// Rolling window of the last HISTORY_SIZE samples of a named monitor.
+	struct History {
+		LocalVector<float> samples;
+		uint32_t pos = 0;
+
+		void push(float p_value);
+	};
+
+	struct CustomMonitor {
+		bool per_frame = false;
+		double value = 0;
+		double last = 0;
+	};
+
+	// Guards custom monitors and histories, scripts may update monitors from any thread.
+	mutable Mutex monitor_mutex;
+	HashMap<StringName, CustomMonitor> custom_monitors;
+	HashMap<StringName, PerformanceCounter *> engine_counters;
+	HashMap<StringName, History> histories;
+	Vector<StringName> history_order;
+
+	StringName time_frame_name;
+	StringName time_process_name;
+	StringName time_physics_process_name;
+
+	void _push_history(const StringName &p_name, float p_value);
+	Dictionary _get_history_stats(const History &p_history) const;
+
 public:
 	enum Monitor {
 
@@ -78,6 +119,10 @@ public:
 		PHYSICS_3D_ISLAND_COUNT,
 		//physics
 		AUDIO_OUTPUT_LATENCY,
+		PHYSICS_PICKING_QUERIES,
+		TIME_PHYSICS_PICKING,
+		NETWORK_PACKETS_SENT,
+		NETWORK_BYTES_SENT,
 		MONITOR_MAX
 	};
 
@@ -95,6 +140,19 @@ public:
 	void set_process_time(float p_pt);
 	void set_physics_process_time(float p_pt);
 
+	void add_custom_monitor(const StringName &p_id, bool p_per_frame = false);
+	void remove_custom_monitor(const StringName &p_id);
+	bool has_custom_monitor(const StringName &p_id) const;
+	void set_custom_monitor(const StringName &p_id, float p_value);
+	void add_to_custom_monitor(const StringName &p_id, float p_amount = 1.0);
+	float get_custom_monitor(const StringName &p_id) const;
+	Array get_custom_monitor_names() const;
+
+	Dictionary get_monitor_stats(const StringName &p_id) const;
+	Error save_monitor_stats(const String &p_path) const;
+
+	void sample_frame(uint64_t p_frame_usec, uint64_t p_process_usec, uint64_t p_physics_process_usec);
+
 	static Performance *get_singleton() { return singleton; }
 
 	Performance();
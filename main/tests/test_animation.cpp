@@ -0,0 +1,246 @@
+/*************************************************************************/
+/*  test_animation.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_animation.h"
+
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "scene/resources/animation.h"
+
+#include <stdio.h>
+
+namespace TestAnimation {
+
+static Ref<Animation> make_animation(int p_tracks, int p_keys, float p_length, bool p_static = false) {
+	Ref<Animation> anim;
+	anim.instance();
+	anim->set_length(p_length);
+
+	for (int i = 0; i < p_tracks; i++) {
+		int track = anim->add_track(Animation::TYPE_TRANSFORM);
+		anim->track_set_path(track, NodePath("Skeleton:bone" + itos(i)));
+		Vector3 axis = Vector3(Math::randf() - 0.5, Math::randf() - 0.5, Math::randf() - 0.5).normalized();
+		for (int j = 0; j < p_keys; j++) {
+			float t = p_length * j / (p_keys - 1);
+			if (p_static) {
+				anim->transform_track_insert_key(track, t, Vector3(1, 2, 3), Quat(axis, 0.5), Vector3(1, 1, 1));
+			} else {
+				Vector3 loc(Math::sin(t + i) * 2.0, Math::randf() * 0.1, Math::cos(t * 3.0) * 5.0);
+				Quat rot(axis, t * 2.0 + Math::randf() * 0.1);
+				anim->transform_track_insert_key(track, t, loc, rot, Vector3(1, 1, 1) + Vector3(Math::randf(), Math::randf(), Math::randf()) * 0.2);
+			}
+		}
+	}
+
+	return anim;
+}
+
+bool test_cursor() {
+	// Sampling with a cursor must give the same results as a binary search,
+	// whether the time moves forward, backward, or jumps around.
+
+	Math::seed(0);
+	Ref<Animation> anim = make_animation(4, 50, 10.0);
+	anim->set_loop(true);
+
+	int value_track = anim->add_track(Animation::TYPE_VALUE);
+	for (int i = 0; i < 40; i++) {
+		anim->track_insert_key(value_track, i * 0.25, Math::randf());
+	}
+
+	int cursors[5] = { -1, -1, -1, -1, -1 };
+	for (int i = 0; i < 3000; i++) {
+		float t;
+		if (i < 1000) {
+			t = i * 0.0107;
+		} else if (i < 2000) {
+			t = 10.0 - (i - 1000) * 0.0107;
+		} else {
+			t = Math::randf() * 10.0;
+		}
+
+		for (int j = 0; j < 4; j++) {
+			Vector3 loc[2];
+			Quat rot[2];
+			Vector3 scale[2];
+			anim->transform_track_interpolate(j, t, &loc[0], &rot[0], &scale[0]);
+			anim->transform_track_interpolate(j, t, &loc[1], &rot[1], &scale[1], &cursors[j]);
+			if (loc[0] != loc[1] || rot[0] != rot[1] || scale[0] != scale[1]) {
+				printf("Track %d at %.4f: cursor sampling differs\n", j, t);
+				return false;
+			}
+		}
+
+		Variant a = anim->value_track_interpolate(value_track, t);
+		Variant b = anim->value_track_interpolate(value_track, t, &cursors[4]);
+		if (a != b) {
+			printf("Value track at %.4f: cursor sampling differs\n", t);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool test_compression() {
+	// Compressed tracks must stay within the quantization error of the original.
+
+	Math::seed(1);
+	Ref<Animation> anim = make_animation(8, 100, 5.0);
+	Ref<Animation> compressed = anim->duplicate();
+	compressed->compress();
+
+	for (int i = 0; i < anim->get_track_count(); i++) {
+		if (!compressed->track_is_compressed(i) || compressed->track_get_key_count(i) != anim->track_get_key_count(i)) {
+			printf("Track %d: not compressed or keys lost\n", i);
+			return false;
+		}
+	}
+
+	for (int i = 0; i < 500; i++) {
+		float t = Math::randf() * 5.0;
+		for (int j = 0; j < anim->get_track_count(); j++) {
+			Vector3 loc[2];
+			Quat rot[2];
+			Vector3 scale[2];
+			anim->transform_track_interpolate(j, t, &loc[0], &rot[0], &scale[0]);
+			compressed->transform_track_interpolate(j, t, &loc[1], &rot[1], &scale[1]);
+			if (loc[0].distance_to(loc[1]) > 0.001 || scale[0].distance_to(scale[1]) > 0.0001 || Math::abs(rot[0].dot(rot[1])) < 0.99999) {
+				printf("Track %d at %.4f: compression error too large\n", j, t);
+				return false;
+			}
+		}
+	}
+
+	// Saving and loading keeps the compressed data as is.
+	Ref<Animation> loaded;
+	loaded.instance();
+	loaded->set_length(5.0);
+	loaded->set("tracks/0/type", "transform");
+	loaded->set("tracks/0/keys", compressed->get("tracks/0/keys"));
+	Vector3 loc[2];
+	Quat rot[2];
+	Vector3 scale[2];
+	loaded->transform_track_get_key(0, 10, &loc[0], &rot[0], &scale[0]);
+	compressed->transform_track_get_key(0, 10, &loc[1], &rot[1], &scale[1]);
+	if (!loaded->track_is_compressed(0) || loc[0] != loc[1] || rot[0] != rot[1] || scale[0] != scale[1]) {
+		printf("Compressed keys were not saved and loaded correctly\n");
+		return false;
+	}
+
+	// Editing a key decompresses the track.
+	compressed->track_set_key_transition(0, 0, 0.5);
+	if (compressed->track_is_compressed(0) || compressed->track_get_key_count(0) != 100) {
+		printf("Editing a compressed track failed\n");
+		return false;
+	}
+
+	// Runs of identical keys collapse to their ends.
+	Ref<Animation> still = make_animation(1, 100, 5.0, true);
+	still->compress();
+	if (still->track_get_key_count(0) != 2) {
+		printf("Static track kept %d keys\n", still->track_get_key_count(0));
+		return false;
+	}
+
+	return true;
+}
+
+bool test_benchmark() {
+	// A character clip: 200 bones, 30 seconds at 30 keys per second.
+
+	Math::seed(2);
+	const int bones = 200;
+	const int frames = 900;
+	Ref<Animation> anim = make_animation(bones, frames, 30.0);
+	Ref<Animation> compressed = anim->duplicate();
+	compressed->compress();
+
+	printf("%d bones, %d keys: %.2f MiB, %.2f MiB compressed\n", bones, frames, anim->get_memory_usage() / (1024.0 * 1024.0), compressed->get_memory_usage() / (1024.0 * 1024.0));
+
+	Vector<int> cursors;
+	cursors.resize(bones);
+	const char *modes[] = { "binary search", "cursor", "compressed + cursor" };
+
+	for (int mode = 0; mode < 3; mode++) {
+		Animation *a = mode == 2 ? compressed.ptr() : anim.ptr();
+		for (int i = 0; i < bones; i++) {
+			cursors.write[i] = -1;
+		}
+		int *cursor_ptr = cursors.ptrw();
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		Vector3 loc;
+		Quat rot;
+		Vector3 scale;
+		for (int f = 0; f < frames * 2; f++) {
+			float t = f / 60.0;
+			for (int i = 0; i < bones; i++) {
+				a->transform_track_interpolate(i, t, &loc, &rot, &scale, mode == 0 ? nullptr : &cursor_ptr[i]);
+			}
+		}
+		uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+		printf("Sampling %d frames (%s): %.2f ms\n", frames * 2, modes[mode], usec / 1000.0);
+	}
+
+	return true;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+	test_cursor,
+	test_compression,
+	test_benchmark,
+	nullptr
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return nullptr;
+}
+
+} // namespace TestAnimation
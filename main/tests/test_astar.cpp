@@ -375,6 +375,94 @@ bool test_solutions() {
 	return true;
 }
 
+bool test_closest_point() {
+	// Compare the grid accelerated lookup against a brute force search
+
+	const int N = 500;
+	Math::seed(1);
+
+	AStar a;
+	Vector3 p[N];
+	for (int i = 0; i < N; i++) {
+		p[i] = Vector3(Math::rand() % 1000, Math::rand() % 1000, Math::rand() % 50);
+		a.add_point(i, p[i]);
+	}
+	// Disabled points and moved points must be honored too.
+	for (int i = 0; i < N; i += 7) {
+		a.set_point_disabled(i, true);
+	}
+	for (int i = 3; i < N; i += 11) {
+		p[i] = Vector3(Math::rand() % 2000, Math::rand() % 2000, Math::rand() % 50);
+		a.set_point_position(i, p[i]);
+	}
+
+	for (int test = 0; test < 1000; test++) {
+		Vector3 q(Math::rand() % 2400 - 200, Math::rand() % 2400 - 200, Math::rand() % 100 - 25);
+		int expected = -1;
+		real_t expected_dist = 1e20;
+		for (int i = 0; i < N; i++) {
+			if (i % 7 == 0) {
+				continue;
+			}
+			real_t d = q.distance_squared_to(p[i]);
+			if (d < expected_dist) {
+				expected = i;
+				expected_dist = d;
+			}
+		}
+		int got = a.get_closest_point(q);
+		if (got != expected && !Math::is_equal_approx(q.distance_squared_to(p[got]), expected_dist)) {
+			printf("Closest to (%.1f, %.1f, %.1f): expected %d, got %d\n", q.x, q.y, q.z, expected, got);
+			return false;
+		}
+	}
+	return true;
+}
+
+bool test_benchmark() {
+	// Large grid graph; prints timings, only fails if paths are missing
+
+	const int W = 300;
+	AStar a;
+	a.reserve_space(W * W);
+	for (int y = 0; y < W; y++) {
+		for (int x = 0; x < W; x++) {
+			a.add_point(y * W + x, Vector3(x, y, 0));
+		}
+	}
+	for (int y = 0; y < W; y++) {
+		for (int x = 0; x < W; x++) {
+			if (x + 1 < W) {
+				a.connect_points(y * W + x, y * W + x + 1);
+			}
+			if (y + 1 < W) {
+				a.connect_points(y * W + x, (y + 1) * W + x);
+			}
+		}
+	}
+
+	Math::seed(2);
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < 50; i++) {
+		int from = Math::rand() % (W * W);
+		int to = Math::rand() % (W * W);
+		if (a.get_id_path(from, to).size() == 0) {
+			printf("No path from %d to %d\n", from, to);
+			return false;
+		}
+	}
+	uint64_t path_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < 10000; i++) {
+		a.get_closest_point(Vector3(Math::randf() * W, Math::randf() * W, 0));
+	}
+	uint64_t closest_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	printf("%d points: 50 paths in %.2f ms, 10000 closest point queries in %.2f ms\n", W * W, path_usec / 1000.0, closest_usec / 1000.0);
+	return true;
+}
+
 typedef bool (*TestFunc)();
 
 TestFunc test_funcs[] = {
@@ -382,6 +470,8 @@ TestFunc test_funcs[] = {
 	test_abcx,
 	test_add_remove,
 	test_solutions,
+	test_closest_point,
+	test_benchmark,
 	nullptr
 };
 
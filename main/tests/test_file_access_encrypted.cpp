@@ -0,0 +1,228 @@
+/*************************************************************************/
+/*  test_file_access_encrypted.cpp                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_file_access_encrypted.h"
+
+#include "core/io/file_access_encrypted.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+
+namespace TestFileAccessEncrypted {
+
+static String get_test_path() {
+	return OS::get_singleton()->get_cache_path().plus_file("test_file_access_encrypted.bin");
+}
+
+static Vector<uint8_t> make_key() {
+	Vector<uint8_t> key;
+	key.resize(32);
+	for (int i = 0; i < 32; i++) {
+		key.write[i] = i * 7;
+	}
+	return key;
+}
+
+static Vector<uint8_t> make_data(int p_size) {
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	for (int i = 0; i < p_size; i++) {
+		// Repeating 16 byte pattern, identical plaintext blocks must not give identical ciphertext.
+		data.write[i] = i % 16;
+	}
+	return data;
+}
+
+static bool write_file(const Vector<uint8_t> &p_data, FileAccessEncrypted::Mode p_mode) {
+	FileAccess *f = FileAccess::open(get_test_path(), FileAccess::WRITE);
+	if (!f) {
+		OS::get_singleton()->print("\tCan't open '%ls' for writing.\n", get_test_path().c_str());
+		return false;
+	}
+
+	FileAccessEncrypted *fae = memnew(FileAccessEncrypted);
+	if (fae->open_and_parse(f, make_key(), p_mode) != OK) {
+		memdelete(fae);
+		memdelete(f);
+		return false;
+	}
+	fae->store_buffer(p_data.ptr(), p_data.size());
+	memdelete(fae);
+	return true;
+}
+
+static FileAccessEncrypted *open_file() {
+	FileAccess *f = FileAccess::open(get_test_path(), FileAccess::READ);
+	ERR_FAIL_COND_V(!f, nullptr);
+
+	FileAccessEncrypted *fae = memnew(FileAccessEncrypted);
+	if (fae->open_and_parse(f, make_key(), FileAccessEncrypted::MODE_READ) != OK) {
+		memdelete(fae);
+		memdelete(f);
+		return nullptr;
+	}
+	return fae;
+}
+
+static bool check_round_trip(int p_size, FileAccessEncrypted::Mode p_mode) {
+	Vector<uint8_t> data = make_data(p_size);
+	if (!write_file(data, p_mode)) {
+		return false;
+	}
+
+	FileAccessEncrypted *fae = open_file();
+	if (!fae) {
+		OS::get_singleton()->print("\tCan't open a file of %d bytes for reading.\n", p_size);
+		return false;
+	}
+
+	Vector<uint8_t> read;
+	read.resize(p_size);
+	bool pass = fae->get_len() == (size_t)p_size;
+	pass = pass && fae->get_buffer(read.ptrw(), p_size) == p_size;
+	pass = pass && (p_size == 0 || memcmp(read.ptr(), data.ptr(), p_size) == 0);
+	pass = pass && fae->get_error() == OK;
+
+	// Random access across a block boundary.
+	if (p_size > FileAccessEncrypted::BLOCK_SIZE + 8) {
+		fae->seek(FileAccessEncrypted::BLOCK_SIZE - 8);
+		for (int i = 0; i < 16; i++) {
+			pass = pass && fae->get_8() == data[FileAccessEncrypted::BLOCK_SIZE - 8 + i];
+		}
+	}
+
+	memdelete(fae);
+	if (!pass) {
+		OS::get_singleton()->print("\tRound trip of %d bytes failed.\n", p_size);
+	}
+	return pass;
+}
+
+bool test_round_trip() {
+	bool pass = true;
+	const int sizes[] = { 0, 1, 16, 1000, FileAccessEncrypted::BLOCK_SIZE, FileAccessEncrypted::BLOCK_SIZE * 2 + 123 };
+	for (int i = 0; i < 6; i++) {
+		pass = check_round_trip(sizes[i], FileAccessEncrypted::MODE_WRITE_AES256_BLOCKS) && pass;
+	}
+
+	// Files in the older single block format must still be readable.
+	pass = check_round_trip(1000, FileAccessEncrypted::MODE_WRITE_AES256) && pass;
+	return pass;
+}
+
+bool test_no_repeated_blocks() {
+	if (!write_file(make_data(256), FileAccessEncrypted::MODE_WRITE_AES256_BLOCKS)) {
+		return false;
+	}
+
+	Vector<uint8_t> raw = FileAccess::get_file_as_array(get_test_path());
+	int base = raw.size() - 256 - FileAccessEncrypted::BLOCK_MAC_SIZE;
+	if (base < 0) {
+		return false;
+	}
+
+	for (int i = 16; i < 256; i += 16) {
+		if (memcmp(&raw[base], &raw[base + i], 16) == 0) {
+			OS::get_singleton()->print("\tEqual plaintext blocks gave equal ciphertext.\n");
+			return false;
+		}
+	}
+	return true;
+}
+
+bool test_corruption() {
+	const int size = FileAccessEncrypted::BLOCK_SIZE * 2 + 123;
+	if (!write_file(make_data(size), FileAccessEncrypted::MODE_WRITE_AES256_BLOCKS)) {
+		return false;
+	}
+
+	// Flip one byte in the middle of the second block.
+	FileAccess *f = FileAccess::open(get_test_path(), FileAccess::READ_WRITE);
+	if (!f) {
+		return false;
+	}
+	size_t offset = f->get_len() - size / 2;
+	f->seek(offset);
+	uint8_t b = f->get_8();
+	f->seek(offset);
+	f->store_8(b ^ 1);
+	memdelete(f);
+
+	FileAccessEncrypted *fae = open_file();
+	if (!fae) {
+		return false;
+	}
+
+	Vector<uint8_t> read;
+	read.resize(size);
+	int got = fae->get_buffer(read.ptrw(), size);
+	bool pass = got < size && fae->get_error() == ERR_FILE_CORRUPT;
+	memdelete(fae);
+
+	if (!pass) {
+		OS::get_singleton()->print("\tA corrupted block was read without error (%d bytes).\n", got);
+	}
+	return pass;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+	test_round_trip,
+	test_no_repeated_blocks,
+	test_corruption,
+	nullptr
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	DirAccess::remove_file_or_error(get_test_path());
+
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return nullptr;
+}
+
+} // namespace TestFileAccessEncrypted
@@ -34,12 +34,17 @@
 
 #ifdef DEBUG_ENABLED
 
+#include "test_animation.h"
 #include "test_astar.h"
 #include "test_basis.h"
 #include "test_class_db.h"
+#include "test_file_access_encrypted.h"
 #include "test_gdscript.h"
 #include "test_gui.h"
+#include "test_marshalls.h"
 #include "test_math.h"
+#include "test_navigation.h"
+#include "test_node.h"
 #include "test_oa_hash_map.h"
 #include "test_ordered_hash_map.h"
 #include "test_physics_2d.h"
@@ -66,6 +71,11 @@ const char **tests_get_names() {
 		"gd_bytecode",
 		"ordered_hash_map",
 		"astar",
+		"navigation",
+		"animation",
+		"node",
+		"marshalls",
+		"file_encrypted",
 		nullptr
 	};
 
@@ -139,6 +149,26 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestAStar::test();
 	}
 
+	if (p_test == "navigation") {
+		return TestNavigation::test();
+	}
+
+	if (p_test == "animation") {
+		return TestAnimation::test();
+	}
+
+	if (p_test == "node") {
+		return TestNode::test();
+	}
+
+	if (p_test == "marshalls") {
+		return TestMarshalls::test();
+	}
+
+	if (p_test == "file_encrypted") {
+		return TestFileAccessEncrypted::test();
+	}
+
 	print_line("Unknown test: " + p_test);
 	return nullptr;
 }
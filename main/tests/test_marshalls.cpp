@@ -0,0 +1,276 @@
+/*************************************************************************/
+/*  test_marshalls.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_marshalls.h"
+
+#include "core/io/marshalls.h"
+#include "core/os/os.h"
+
+#include <stdio.h>
+
+namespace TestMarshalls {
+
+static Array make_values() {
+	Array values;
+	values.push_back(Variant());
+	values.push_back(true);
+	values.push_back(42);
+	values.push_back(int64_t(1) << 40);
+	values.push_back(0.5);
+	values.push_back(0.1);
+	values.push_back("Hello");
+	values.push_back(String::utf8("Ünïcödé ✓"));
+	values.push_back(StringName("name"));
+	values.push_back(NodePath("/root/Node:position:x"));
+	values.push_back(Vector2(1, 2));
+	values.push_back(Vector3i(1, 2, 3));
+	values.push_back(Transform(Basis(Vector3(0, 1, 0), 1.0), Vector3(1, 2, 3)));
+	values.push_back(Color(0.1, 0.2, 0.3, 0.4));
+
+	Vector<uint8_t> bytes;
+	for (int i = 0; i < 37; i++) {
+		bytes.push_back(i);
+	}
+	values.push_back(bytes);
+
+	Vector<String> strings;
+	strings.push_back("a");
+	strings.push_back("bcd");
+	strings.push_back("");
+	values.push_back(strings);
+
+	Vector<Vector3> vectors;
+	vectors.push_back(Vector3(1, 2, 3));
+	vectors.push_back(Vector3(4, 5, 6));
+	values.push_back(vectors);
+
+	Vector<int64_t> ints;
+	ints.push_back(1);
+	ints.push_back(-(int64_t(1) << 50));
+	values.push_back(ints);
+
+	Dictionary dict;
+	dict["position"] = Vector3(1, 2, 3);
+	dict["name"] = "Player";
+	dict[7] = Array();
+	values.push_back(dict);
+
+	return values;
+}
+
+static Vector<uint8_t> encode_two_pass(const Variant &p_value) {
+	Vector<uint8_t> out;
+	int len;
+	encode_variant(p_value, nullptr, len);
+	out.resize(len);
+	encode_variant(p_value, out.ptrw(), len);
+	return out;
+}
+
+static bool same_encoding(const Variant &p_a, const Variant &p_b) {
+	Vector<uint8_t> a = encode_two_pass(p_a);
+	Vector<uint8_t> b = encode_two_pass(p_b);
+	return a.size() == b.size() && memcmp(a.ptr(), b.ptr(), a.size()) == 0;
+}
+
+bool test_encode() {
+	OS::get_singleton()->print("\n\nTest 1: Single pass encoding matches the two pass encoder\n");
+
+	Array values = make_values();
+	values.push_back(values.duplicate());
+
+	LocalVector<uint8_t> buffer;
+	for (int i = 0; i < values.size(); i++) {
+		Vector<uint8_t> expected = encode_two_pass(values[i]);
+
+		buffer.clear();
+		Error err = encode_variant(values[i], buffer);
+		if (err != OK || buffer.size() != (uint32_t)expected.size() || memcmp(buffer.ptr(), expected.ptr(), expected.size()) != 0) {
+			OS::get_singleton()->print("\tMismatch encoding %s\n", Variant::get_type_name(values[i].get_type()).utf8().get_data());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool test_view() {
+	OS::get_singleton()->print("\n\nTest 2: Views point into the encoded buffer\n");
+
+	Array values = make_values();
+	LocalVector<uint8_t> buffer;
+	encode_variant(values, buffer);
+
+	EncodedVariantView root;
+	int used = 0;
+	if (decode_variant_view(root, buffer.ptr(), buffer.size(), &used) != OK || used != (int)buffer.size() || root.type != Variant::ARRAY || root.count != values.size()) {
+		return false;
+	}
+
+	const uint8_t *ptr = root.data;
+	int len = buffer.size() - (root.data - buffer.ptr());
+	for (int i = 0; i < root.count; i++) {
+		EncodedVariantView view;
+		if (decode_variant_view(view, ptr, len, &used) != OK) {
+			return false;
+		}
+
+		// Containers compare by reference, so check the value survives a round trip instead.
+		Variant decoded;
+		if (view.get_variant(decoded) != OK || !same_encoding(decoded, values[i])) {
+			OS::get_singleton()->print("\tMismatch decoding %s\n", Variant::get_type_name(view.type).utf8().get_data());
+			return false;
+		}
+
+		if (view.type == Variant::STRING && String::utf8((const char *)view.data, view.count) != values[i].operator String()) {
+			return false;
+		}
+		if (view.type == Variant::PACKED_BYTE_ARRAY) {
+			Vector<uint8_t> bytes = values[i];
+			if (view.count != bytes.size() || memcmp(view.data, bytes.ptr(), bytes.size()) != 0) {
+				return false;
+			}
+		}
+
+		ptr += used;
+		len -= used;
+	}
+
+	// Truncated input must fail instead of reading past the end.
+	EncodedVariantView view;
+	if (decode_variant_view(view, buffer.ptr(), buffer.size() - 1) == OK || decode_variant_view(view, buffer.ptr(), buffer.size() / 2) == OK) {
+		OS::get_singleton()->print("\tTruncated buffer accepted\n");
+		return false;
+	}
+
+	return true;
+}
+
+bool test_max_size() {
+	OS::get_singleton()->print("\n\nTest 3: Encoding stops at the size limit\n");
+
+	const uint32_t max_size = 1024;
+
+	Vector<uint8_t> bytes;
+	bytes.resize(1024 * 1024);
+	Array arr;
+	arr.push_back("small");
+	arr.push_back(bytes);
+
+	LocalVector<uint8_t> buffer;
+	Error err = encode_variant(arr, buffer, false, max_size);
+	if (err != ERR_OUT_OF_MEMORY || buffer.size() > max_size) {
+		OS::get_singleton()->print("\tOversized value encoded to %d bytes (error %d)\n", (int)buffer.size(), (int)err);
+		return false;
+	}
+
+	// Values up to the limit still encode like without it.
+	Vector<uint8_t> expected = encode_two_pass(arr[0]);
+	buffer.clear();
+	err = encode_variant(arr[0], buffer, false, expected.size());
+	return err == OK && buffer.size() == (uint32_t)expected.size();
+}
+
+bool test_benchmark() {
+	OS::get_singleton()->print("\n\nTest 4: Benchmark\n");
+
+	Array values = make_values();
+	const int iterations = 20000;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	int total = 0;
+	for (int i = 0; i < iterations; i++) {
+		total += encode_two_pass(values).size();
+	}
+	uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+	printf("Encode, two passes: %.2f ms (%.2f MiB/s)\n", usec / 1000.0, total / (usec / 1000000.0) / (1024.0 * 1024.0));
+
+	LocalVector<uint8_t> buffer;
+	begin = OS::get_singleton()->get_ticks_usec();
+	total = 0;
+	for (int i = 0; i < iterations; i++) {
+		buffer.clear();
+		encode_variant(values, buffer);
+		total += buffer.size();
+	}
+	usec = OS::get_singleton()->get_ticks_usec() - begin;
+	printf("Encode, single pass: %.2f ms (%.2f MiB/s)\n", usec / 1000.0, total / (usec / 1000000.0) / (1024.0 * 1024.0));
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		Variant decoded;
+		decode_variant(decoded, buffer.ptr(), buffer.size());
+	}
+	usec = OS::get_singleton()->get_ticks_usec() - begin;
+	printf("Decode to Variant: %.2f ms\n", usec / 1000.0);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		EncodedVariantView view;
+		decode_variant_view(view, buffer.ptr(), buffer.size());
+	}
+	usec = OS::get_singleton()->get_ticks_usec() - begin;
+	printf("Decode to view: %.2f ms\n", usec / 1000.0);
+
+	return true;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+	test_encode,
+	test_view,
+	test_max_size,
+	test_benchmark,
+	nullptr
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return nullptr;
+}
+
+} // namespace TestMarshalls
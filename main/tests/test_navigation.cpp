@@ -0,0 +1,236 @@
+/*************************************************************************/
+/*  test_navigation.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_navigation.h"
+
+#include "core/engine.h"
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/resources/navigation_mesh.h"
+#include "scene/resources/primitive_meshes.h"
+#include "servers/navigation_server_3d.h"
+
+namespace TestNavigation {
+
+class AvoidanceReceiver : public Object {
+	GDCLASS(AvoidanceReceiver, Object);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("_avoidance_done", "velocity"), &AvoidanceReceiver::_avoidance_done);
+	}
+
+public:
+	uint64_t callbacks = 0;
+
+	void _avoidance_done(Vector3 p_velocity) {
+		callbacks++;
+	}
+};
+
+static int find_polygon_group(Vector<int> &p_groups, int p_polygon) {
+	while (p_groups[p_polygon] != p_polygon) {
+		p_polygon = p_groups[p_polygon];
+	}
+	return p_polygon;
+}
+
+// Checks that a tiled navigation mesh has no duplicated vertices on the tile
+// edges, and that all of its polygons are connected through shared edges.
+bool check_welded(Ref<NavigationMesh> p_nav_mesh) {
+	Vector<Vector3> vertices = p_nav_mesh->get_vertices();
+	for (int i = 0; i < vertices.size(); i++) {
+		for (int j = i + 1; j < vertices.size(); j++) {
+			if (vertices[i].distance_to(vertices[j]) < 0.01) {
+				OS::get_singleton()->print("\tVertices %d and %d at %s are not welded.\n", i, j, String(vertices[i]).utf8().get_data());
+				return false;
+			}
+		}
+	}
+
+	Vector<int> groups;
+	groups.resize(p_nav_mesh->get_polygon_count());
+	for (int i = 0; i < groups.size(); i++) {
+		groups.write[i] = i;
+	}
+
+	Map<Vector2i, int> edges;
+	for (int i = 0; i < p_nav_mesh->get_polygon_count(); i++) {
+		Vector<int> polygon = p_nav_mesh->get_polygon(i);
+		for (int j = 0; j < polygon.size(); j++) {
+			int a = polygon[j];
+			int b = polygon[(j + 1) % polygon.size()];
+			Vector2i edge(MIN(a, b), MAX(a, b));
+			Map<Vector2i, int>::Element *E = edges.find(edge);
+			if (E) {
+				groups.write[find_polygon_group(groups, i)] = find_polygon_group(groups, E->get());
+			} else {
+				edges[edge] = i;
+			}
+		}
+	}
+
+	for (int i = 1; i < groups.size(); i++) {
+		if (find_polygon_group(groups, i) != find_polygon_group(groups, 0)) {
+			OS::get_singleton()->print("\tPolygon %d is not connected to polygon 0.\n", i);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Bakes a flat plane spanning several tiles, then rebuilds a part of it.
+bool test_tiled_bake() {
+	Object *generator = Engine::get_singleton()->get_singleton_object("NavigationMeshGenerator");
+	if (!generator) {
+		OS::get_singleton()->print("\tNavigationMeshGenerator not available, skipped.\n");
+		return true;
+	}
+
+	Node3D *root = memnew(Node3D);
+	MeshInstance3D *mesh_instance = memnew(MeshInstance3D);
+	Ref<PlaneMesh> plane;
+	plane.instance();
+	plane->set_size(Size2(20, 20));
+	mesh_instance->set_mesh(plane);
+	root->add_child(mesh_instance);
+
+	Ref<NavigationMesh> nav_mesh;
+	nav_mesh.instance();
+	nav_mesh->set_tile_size(16);
+
+	bool pass = true;
+
+	generator->call("bake", nav_mesh, root);
+	const int polygon_count = nav_mesh->get_polygon_count();
+	OS::get_singleton()->print("\tBaked %d polygons, %d vertices.\n", polygon_count, nav_mesh->get_vertices().size());
+	if (polygon_count == 0) {
+		OS::get_singleton()->print("\tNothing was baked.\n");
+		pass = false;
+	}
+	pass = pass && check_welded(nav_mesh);
+
+	generator->call("bake_area", nav_mesh, root, AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2)));
+	if (nav_mesh->get_polygon_count() != polygon_count) {
+		OS::get_singleton()->print("\tRebuilding an unchanged area gave %d polygons instead of %d.\n", nav_mesh->get_polygon_count(), polygon_count);
+		pass = false;
+	}
+	pass = pass && check_welded(nav_mesh);
+
+	generator->call("clear", nav_mesh);
+	memdelete(root);
+
+	return pass;
+}
+
+// Measures the time spent by the collision avoidance for a growing amount of
+// agents moving toward the center of a square crowd. Fails if the agents never
+// reported their avoidance velocity.
+bool benchmark_agents(int p_agent_count, int p_steps) {
+	NavigationServer3D *ns = NavigationServer3D::get_singleton_mut();
+	AvoidanceReceiver receiver;
+
+	RID map = ns->map_create();
+	ns->map_set_active(map, true);
+
+	const int side = Math::ceil(Math::sqrt((float)p_agent_count));
+	Vector<RID> agents;
+	Vector<Vector3> positions;
+	agents.resize(p_agent_count);
+	positions.resize(p_agent_count);
+
+	for (int i = 0; i < p_agent_count; i++) {
+		Vector3 pos((i % side) * 1.5, 0, (i / side) * 1.5);
+		RID agent = ns->agent_create();
+		ns->agent_set_map(agent, map);
+		ns->agent_set_neighbor_dist(agent, 5.0);
+		ns->agent_set_max_neighbors(agent, 10);
+		ns->agent_set_time_horizon(agent, 1.0);
+		ns->agent_set_radius(agent, 0.5);
+		ns->agent_set_max_speed(agent, 2.0);
+		ns->agent_set_ignore_y(agent, true);
+		ns->agent_set_position(agent, pos);
+		ns->agent_set_callback(agent, &receiver, "_avoidance_done");
+		agents.write[i] = agent;
+		positions.write[i] = pos;
+	}
+
+	// The first process syncs the map, keep it out of the measure.
+	ns->process(1.0 / 60.0);
+
+	const Vector3 center(side * 0.75, 0, side * 0.75);
+	uint64_t usec = 0;
+	for (int s = 0; s < p_steps; s++) {
+		for (int i = 0; i < p_agent_count; i++) {
+			Vector3 dir = center - positions[i];
+			positions.write[i] += dir.normalized() * (1.0 / 60.0);
+			ns->agent_set_position(agents[i], positions[i]);
+			ns->agent_set_target_velocity(agents[i], dir.normalized() * 2.0);
+		}
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		ns->process(1.0 / 60.0);
+		usec += OS::get_singleton()->get_ticks_usec() - begin;
+	}
+
+	OS::get_singleton()->print("\t%6d agents: %8.3f msec/step (%d callbacks)\n", p_agent_count, (usec / 1000.0) / p_steps, (int)receiver.callbacks);
+
+	for (int i = 0; i < p_agent_count; i++) {
+		ns->free(agents[i]);
+	}
+	ns->free(map);
+	ns->process(1.0 / 60.0);
+
+	return receiver.callbacks > 0;
+}
+
+MainLoop *test() {
+	// Callbacks are called by name, the method must be bound.
+	ClassDB::register_class<AvoidanceReceiver>();
+
+	OS::get_singleton()->print("Tiled navigation mesh bake:\n");
+	bool pass = test_tiled_bake();
+	OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+	OS::get_singleton()->print("Collision avoidance scaling:\n");
+
+	const int agent_counts[] = { 1000, 5000, 10000, 25000, 50000 };
+	pass = true;
+	for (int i = 0; i < 5; i++) {
+		pass = benchmark_agents(agent_counts[i], 10) && pass;
+	}
+	OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+	return nullptr;
+}
+
+} // namespace TestNavigation
@@ -0,0 +1,237 @@
+/*************************************************************************/
+/*  test_node.cpp                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_node.h"
+
+#include "core/os/os.h"
+#include "scene/main/node.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+
+#include <stdio.h>
+
+namespace TestNode {
+
+static Node *make_node(const String &p_name) {
+	Node *node = memnew(Node);
+	node->set_name(p_name);
+	return node;
+}
+
+static bool check_lookups(Node *p_parent) {
+	for (int i = 0; i < p_parent->get_child_count(); i++) {
+		Node *child = p_parent->get_child(i);
+		if (p_parent->get_node_or_null(NodePath(child->get_name())) != child) {
+			OS::get_singleton()->print("\tCan't find child '%ls'.\n", String(child->get_name()).c_str());
+			return false;
+		}
+	}
+
+	return p_parent->get_node_or_null(NodePath("Missing")) == nullptr;
+}
+
+bool test_serial_names() {
+	// Readable unique names must not depend on whether children are looked up
+	// by scanning or through the name index.
+
+	Node *parent = memnew(Node);
+	bool pass = true;
+
+	for (int i = 0; i < 100; i++) {
+		Node *child = make_node("Item");
+		parent->add_child(child, true);
+		String expected = i == 0 ? String("Item") : "Item" + itos(i + 1);
+		if (String(child->get_name()) != expected) {
+			OS::get_singleton()->print("\tChild %i named '%ls', expected '%ls'.\n", i, String(child->get_name()).c_str(), expected.c_str());
+			pass = false;
+		}
+	}
+
+	// Freed names are reused.
+	Node *removed = parent->get_node(NodePath("Item5"));
+	parent->remove_child(removed);
+	memdelete(removed);
+
+	Node *child = make_node("Item");
+	parent->add_child(child, true);
+	pass = pass && String(child->get_name()) == "Item5";
+
+	// Renaming to a taken name picks the next free one, renaming to its own name keeps it.
+	Node::set_human_readable_collision_renaming(true);
+	child = parent->get_node(NodePath("Item7"));
+	child->set_name("Item20");
+	pass = pass && String(child->get_name()) == "Item101";
+	child->set_name("Item101");
+	pass = pass && String(child->get_name()) == "Item101";
+	pass = pass && parent->get_node_or_null(NodePath("Item7")) == nullptr;
+	Node::set_human_readable_collision_renaming(false);
+
+	child = make_node("Item");
+	parent->add_child(child, true);
+	pass = pass && String(child->get_name()) == "Item7";
+
+	// Fast unique names.
+	child = make_node("Item");
+	parent->add_child(child);
+	pass = pass && String(child->get_name()).begins_with("@Item@");
+
+	pass = pass && check_lookups(parent);
+
+	memdelete(parent);
+	return pass;
+}
+
+bool test_benchmark() {
+	const int counts[] = { 1000, 20000 };
+
+	for (int c = 0; c < 2; c++) {
+		int count = counts[c];
+		Node *parent = memnew(Node);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			parent->add_child(make_node("Enemy"), true);
+		}
+		uint64_t add_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		Vector<NodePath> paths;
+		for (int i = 0; i < count; i++) {
+			paths.push_back(NodePath(parent->get_child(i)->get_name()));
+		}
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		int found = 0;
+		for (int i = 0; i < count; i++) {
+			found += parent->get_node_or_null(paths[i]) ? 1 : 0;
+		}
+		uint64_t get_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		printf("%d children: add_child %.2f ms, get_node %.2f ms\n", count, add_usec / 1000.0, get_usec / 1000.0);
+
+		memdelete(parent);
+		if (found != count) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+class ProcessRecorder : public Node {
+	GDCLASS(ProcessRecorder, Node);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_PROCESS) {
+			order->push_back(get_name());
+		}
+	}
+
+public:
+	Vector<String> *order = nullptr;
+};
+
+static bool check_process_order(SceneTree *p_tree, Vector<String> &r_order, const String &p_expected) {
+	r_order.clear();
+	p_tree->idle(1.0 / 60.0);
+
+	String got = String(",").join(r_order);
+	if (got != p_expected) {
+		OS::get_singleton()->print("\tProcessed in order '%ls', expected '%ls'.\n", got.c_str(), p_expected.c_str());
+		return false;
+	}
+	return true;
+}
+
+bool test_process_order() {
+	// Reordering siblings must reorder their _process() calls too.
+
+	ClassDB::register_class<ProcessRecorder>();
+
+	SceneTree *tree = memnew(SceneTree);
+	tree->init();
+
+	Vector<String> order;
+	Node *parent = make_node("Parent");
+	tree->get_root()->add_child(parent);
+
+	const char *names[3] = { "A", "B", "C" };
+	for (int i = 0; i < 3; i++) {
+		ProcessRecorder *child = memnew(ProcessRecorder);
+		child->set_name(names[i]);
+		child->order = &order;
+		parent->add_child(child);
+		child->set_process(true);
+	}
+
+	bool pass = check_process_order(tree, order, "A,B,C");
+
+	parent->move_child(parent->get_node(NodePath("C")), 0);
+	pass = check_process_order(tree, order, "C,A,B") && pass;
+
+	parent->get_node(NodePath("A"))->raise();
+	pass = check_process_order(tree, order, "C,B,A") && pass;
+
+	tree->finish();
+	memdelete(tree);
+	return pass;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+	test_serial_names,
+	test_benchmark,
+	test_process_order,
+	nullptr
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return nullptr;
+}
+
+} // namespace TestNode
@@ -68,6 +68,8 @@ complete -c godot -l disable-vsync-via-compositor -d "Disable Vsync via the OS'
 complete -c godot -s d -l debug -d "Debug (local stdout debugger)"
 complete -c godot -s b -l breakpoints -d "Specify the breakpoint list as source::line comma-separated pairs, no spaces (use %20 instead)" -x
 complete -c godot -l profiling -d "Enable profiling in the script debugger"
+complete -c godot -l trace -d "Record instrumented engine zones and save them as a Chrome trace on exit" -r
+complete -c godot -l dump-monitors -d "Save monitor statistics every second and on exit, as CSV or JSON" -r
 complete -c godot -l remote-debug -d "Enable remote debugging"
 complete -c godot -l debug-collisions -d "Show collision shapes when running the scene"
 complete -c godot -l debug-navigation -d "Show navigation polygons when running the scene"
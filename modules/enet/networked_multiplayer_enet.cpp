@@ -66,6 +66,20 @@ int NetworkedMultiplayerENet::get_last_packet_channel() const {
 	return current_packet.channel;
 }
 
+uint64_t NetworkedMultiplayerENet::get_packet_timestamp() const {
+	ERR_FAIL_COND_V_MSG(!active, 0, "The multiplayer instance isn't currently active.");
+	ERR_FAIL_COND_V(incoming_packets.size() == 0, 0);
+
+	return incoming_packets.front()->get().time;
+}
+
+uint64_t NetworkedMultiplayerENet::get_last_packet_timestamp() const {
+	ERR_FAIL_COND_V_MSG(!active, 0, "The multiplayer instance isn't currently active.");
+	ERR_FAIL_COND_V(!current_packet.packet, 0);
+
+	return current_packet.time;
+}
+
 Error NetworkedMultiplayerENet::create_server(int p_port, int p_max_clients, int p_in_bandwidth, int p_out_bandwidth) {
 	ERR_FAIL_COND_V_MSG(active, ERR_ALREADY_IN_USE, "The multiplayer instance is already active.");
 	ERR_FAIL_COND_V_MSG(p_port < 0 || p_port > 65535, ERR_INVALID_PARAMETER, "The port number must be set between 0 and 65535 (inclusive).");
@@ -112,6 +126,7 @@ Error NetworkedMultiplayerENet::create_server(int p_port, int p_max_clients, int
 	refuse_connections = false;
 	unique_id = 1;
 	connection_status = CONNECTION_CONNECTED;
+	_start_thread();
 	return OK;
 }
 
@@ -202,6 +217,7 @@ Error NetworkedMultiplayerENet::create_client(const String &p_address, int p_por
 	active = true;
 	server = false;
 	refuse_connections = false;
+	_start_thread();
 
 	return OK;
 }
@@ -211,6 +227,15 @@ void NetworkedMultiplayerENet::poll() {
 
 	_pop_current_packet();
 
+	if (thread) {
+		// The network thread already serviced the host, just handle what it queued.
+		ThreadEvent thread_event;
+		while (active && thread_events.pop(thread_event)) {
+			_process_event(thread_event.event, thread_event.time);
+		}
+		return;
+	}
+
 	ENetEvent event;
 	/* Keep servicing until there are no available events left in queue. */
 	while (true) {
@@ -227,206 +252,212 @@ void NetworkedMultiplayerENet::poll() {
 			break;
 		}
 
-		switch (event.type) {
-			case ENET_EVENT_TYPE_CONNECT: {
-				// Store any relevant client information here.
+		_process_event(event, OS::get_singleton()->get_ticks_usec());
+	}
+}
 
-				if (server && refuse_connections) {
-					enet_peer_reset(event.peer);
-					break;
-				}
+void NetworkedMultiplayerENet::_process_event(ENetEvent &p_event, uint64_t p_time) {
+	switch (p_event.type) {
+		case ENET_EVENT_TYPE_CONNECT: {
+			// Store any relevant client information here.
 
-				// A client joined with an invalid ID (negative values, 0, and 1 are reserved).
-				// Probably trying to exploit us.
-				if (server && ((int)event.data < 2 || peer_map.has((int)event.data))) {
-					enet_peer_reset(event.peer);
-					ERR_CONTINUE(true);
-				}
+			if (server && refuse_connections) {
+				_peer_reset(p_event.peer);
+				break;
+			}
 
-				int *new_id = memnew(int);
-				*new_id = event.data;
+			// A client joined with an invalid ID (negative values, 0, and 1 are reserved).
+			// Probably trying to exploit us.
+			if (server && ((int)p_event.data < 2 || peer_map.has((int)p_event.data))) {
+				_peer_reset(p_event.peer);
+				ERR_FAIL_MSG("Invalid peer ID received on connection.");
+			}
 
-				if (*new_id == 0) { // Data zero is sent by server (enet won't let you configure this). Server is always 1.
-					*new_id = 1;
-				}
+			int *new_id = memnew(int);
+			*new_id = p_event.data;
 
-				event.peer->data = new_id;
+			if (*new_id == 0) { // Data zero is sent by server (enet won't let you configure this). Server is always 1.
+				*new_id = 1;
+			}
 
-				peer_map[*new_id] = event.peer;
+			p_event.peer->data = new_id;
 
-				connection_status = CONNECTION_CONNECTED; // If connecting, this means it connected to something!
+			peer_map[*new_id] = p_event.peer;
 
-				emit_signal("peer_connected", *new_id);
+			connection_status = CONNECTION_CONNECTED; // If connecting, this means it connected to something!
 
-				if (server) {
-					// Do not notify other peers when server_relay is disabled.
-					if (!server_relay) {
-						break;
-					}
+			emit_signal("peer_connected", *new_id);
 
-					// Someone connected, notify all the peers available
-					for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
-						if (E->key() == *new_id) {
-							continue;
-						}
-						// Send existing peers to new peer
-						ENetPacket *packet = enet_packet_create(nullptr, 8, ENET_PACKET_FLAG_RELIABLE);
-						encode_uint32(SYSMSG_ADD_PEER, &packet->data[0]);
-						encode_uint32(E->key(), &packet->data[4]);
-						enet_peer_send(event.peer, SYSCH_CONFIG, packet);
-						// Send the new peer to existing peers
-						packet = enet_packet_create(nullptr, 8, ENET_PACKET_FLAG_RELIABLE);
-						encode_uint32(SYSMSG_ADD_PEER, &packet->data[0]);
-						encode_uint32(*new_id, &packet->data[4]);
-						enet_peer_send(E->get(), SYSCH_CONFIG, packet);
-					}
-				} else {
-					emit_signal("connection_succeeded");
+			if (server) {
+				// Do not notify other peers when server_relay is disabled.
+				if (!server_relay) {
+					break;
 				}
 
-			} break;
-			case ENET_EVENT_TYPE_DISCONNECT: {
-				// Reset the peer's client information.
-
-				int *id = (int *)event.peer->data;
-
-				if (!id) {
-					if (!server) {
-						emit_signal("connection_failed");
+				// Someone connected, notify all the peers available
+				for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
+					if (E->key() == *new_id) {
+						continue;
 					}
-					// Never fully connected.
-					break;
+					// Send existing peers to new peer
+					ENetPacket *packet = enet_packet_create(nullptr, 8, ENET_PACKET_FLAG_RELIABLE);
+					encode_uint32(SYSMSG_ADD_PEER, &packet->data[0]);
+					encode_uint32(E->key(), &packet->data[4]);
+					_peer_send(p_event.peer, SYSCH_CONFIG, packet);
+					// Send the new peer to existing peers
+					packet = enet_packet_create(nullptr, 8, ENET_PACKET_FLAG_RELIABLE);
+					encode_uint32(SYSMSG_ADD_PEER, &packet->data[0]);
+					encode_uint32(*new_id, &packet->data[4]);
+					_peer_send(E->get(), SYSCH_CONFIG, packet);
 				}
+			} else {
+				emit_signal("connection_succeeded");
+			}
 
-				if (!server) {
-					// Client just disconnected from server.
-					emit_signal("server_disconnected");
-					close_connection();
-					return;
-				} else if (server_relay) {
-					// Server just received a client disconnect and is in relay mode, notify everyone else.
-					for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
-						if (E->key() == *id) {
-							continue;
-						}
+		} break;
+		case ENET_EVENT_TYPE_DISCONNECT: {
+			// Reset the peer's client information.
 
-						ENetPacket *packet = enet_packet_create(nullptr, 8, ENET_PACKET_FLAG_RELIABLE);
-						encode_uint32(SYSMSG_REMOVE_PEER, &packet->data[0]);
-						encode_uint32(*id, &packet->data[4]);
-						enet_peer_send(E->get(), SYSCH_CONFIG, packet);
-					}
+			int *id = (int *)p_event.peer->data;
+
+			if (!id) {
+				if (!server) {
+					emit_signal("connection_failed");
 				}
+				// Never fully connected.
+				break;
+			}
 
-				emit_signal("peer_disconnected", *id);
-				peer_map.erase(*id);
-				memdelete(id);
-			} break;
-			case ENET_EVENT_TYPE_RECEIVE: {
-				if (event.channelID == SYSCH_CONFIG) {
-					// Some config message
-					ERR_CONTINUE(event.packet->dataLength < 8);
-
-					// Only server can send config messages
-					ERR_CONTINUE(server);
-
-					int msg = decode_uint32(&event.packet->data[0]);
-					int id = decode_uint32(&event.packet->data[4]);
-
-					switch (msg) {
-						case SYSMSG_ADD_PEER: {
-							peer_map[id] = nullptr;
-							emit_signal("peer_connected", id);
-
-						} break;
-						case SYSMSG_REMOVE_PEER: {
-							peer_map.erase(id);
-							emit_signal("peer_disconnected", id);
-						} break;
+			if (!server) {
+				// Client just disconnected from server.
+				emit_signal("server_disconnected");
+				close_connection();
+				return;
+			} else if (server_relay) {
+				// Server just received a client disconnect and is in relay mode, notify everyone else.
+				for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
+					if (E->key() == *id) {
+						continue;
 					}
 
-					enet_packet_destroy(event.packet);
-				} else if (event.channelID < channel_count) {
-					Packet packet;
-					packet.packet = event.packet;
+					ENetPacket *packet = enet_packet_create(nullptr, 8, ENET_PACKET_FLAG_RELIABLE);
+					encode_uint32(SYSMSG_REMOVE_PEER, &packet->data[0]);
+					encode_uint32(*id, &packet->data[4]);
+					_peer_send(E->get(), SYSCH_CONFIG, packet);
+				}
+			}
 
-					uint32_t *id = (uint32_t *)event.peer->data;
+			emit_signal("peer_disconnected", *id);
+			peer_map.erase(*id);
+			memdelete(id);
+		} break;
+		case ENET_EVENT_TYPE_RECEIVE: {
+			if (p_event.channelID == SYSCH_CONFIG) {
+				// Some config message
+				ERR_FAIL_COND(p_event.packet->dataLength < 8);
+
+				// Only server can send config messages
+				ERR_FAIL_COND(server);
+
+				int msg = decode_uint32(&p_event.packet->data[0]);
+				int id = decode_uint32(&p_event.packet->data[4]);
+
+				switch (msg) {
+					case SYSMSG_ADD_PEER: {
+						peer_map[id] = nullptr;
+						emit_signal("peer_connected", id);
+
+					} break;
+					case SYSMSG_REMOVE_PEER: {
+						peer_map.erase(id);
+						emit_signal("peer_disconnected", id);
+					} break;
+				}
 
-					ERR_CONTINUE(event.packet->dataLength < 8);
+				enet_packet_destroy(p_event.packet);
+			} else if (p_event.channelID < channel_count) {
+				Packet packet;
+				packet.packet = p_event.packet;
 
-					uint32_t source = decode_uint32(&event.packet->data[0]);
-					int target = decode_uint32(&event.packet->data[4]);
+				uint32_t *id = (uint32_t *)p_event.peer->data;
 
-					packet.from = source;
-					packet.channel = event.channelID;
+				ERR_FAIL_COND(p_event.packet->dataLength < 8);
 
-					if (server) {
-						// Someone is cheating and trying to fake the source!
-						ERR_CONTINUE(source != *id);
+				uint32_t source = decode_uint32(&p_event.packet->data[0]);
+				int target = decode_uint32(&p_event.packet->data[4]);
 
-						packet.from = *id;
+				packet.from = source;
+				packet.channel = p_event.channelID;
+				packet.time = p_time;
 
-						if (target == 1) {
-							// To myself and only myself
-							incoming_packets.push_back(packet);
-						} else if (!server_relay) {
-							// No other destination is allowed when server is not relaying
-							continue;
-						} else if (target == 0) {
-							// Re-send to everyone but sender :|
+				if (server) {
+					// Someone is cheating and trying to fake the source!
+					ERR_FAIL_COND(source != *id);
 
-							incoming_packets.push_back(packet);
-							// And make copies for sending
-							for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
-								if (uint32_t(E->key()) == source) { // Do not resend to self
-									continue;
-								}
+					packet.from = *id;
 
-								ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, packet.packet->flags);
+					if (target == 1) {
+						// To myself and only myself
+						incoming_packets.push_back(packet);
+					} else if (!server_relay) {
+						// No other destination is allowed when server is not relaying
+						enet_packet_destroy(packet.packet);
+						return;
+					} else if (target == 0) {
+						// Re-send to everyone but sender :|
 
-								enet_peer_send(E->get(), event.channelID, packet2);
+						incoming_packets.push_back(packet);
+						// And make copies for sending
+						for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
+							if (uint32_t(E->key()) == source) { // Do not resend to self
+								continue;
 							}
 
-						} else if (target < 0) {
-							// To all but one
+							ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, packet.packet->flags);
 
-							// And make copies for sending
-							for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
-								if (uint32_t(E->key()) == source || E->key() == -target) { // Do not resend to self, also do not send to excluded
-									continue;
-								}
+							_peer_send(E->get(), p_event.channelID, packet2);
+						}
 
-								ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, packet.packet->flags);
+					} else if (target < 0) {
+						// To all but one
 
-								enet_peer_send(E->get(), event.channelID, packet2);
+						// And make copies for sending
+						for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
+							if (uint32_t(E->key()) == source || E->key() == -target) { // Do not resend to self, also do not send to excluded
+								continue;
 							}
 
-							if (-target != 1) {
-								// Server is not excluded
-								incoming_packets.push_back(packet);
-							} else {
-								// Server is excluded, erase packet
-								enet_packet_destroy(packet.packet);
-							}
+							ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, packet.packet->flags);
+
+							_peer_send(E->get(), p_event.channelID, packet2);
+						}
 
+						if (-target != 1) {
+							// Server is not excluded
+							incoming_packets.push_back(packet);
 						} else {
-							// To someone else, specifically
-							ERR_CONTINUE(!peer_map.has(target));
-							enet_peer_send(peer_map[target], event.channelID, packet.packet);
+							// Server is excluded, erase packet
+							enet_packet_destroy(packet.packet);
 						}
+
 					} else {
-						incoming_packets.push_back(packet);
+						// To someone else, specifically
+						ERR_FAIL_COND(!peer_map.has(target));
+						_peer_send(peer_map[target], p_event.channelID, packet.packet);
 					}
-
-					// Destroy packet later
 				} else {
-					ERR_CONTINUE(true);
+					incoming_packets.push_back(packet);
 				}
 
-			} break;
-			case ENET_EVENT_TYPE_NONE: {
-				// Do nothing
-			} break;
-		}
+				// Destroy packet later
+			} else {
+				ERR_FAIL_MSG("Invalid channel received.");
+			}
+
+		} break;
+		case ENET_EVENT_TYPE_NONE: {
+			// Do nothing
+		} break;
 	}
 }
 
@@ -440,6 +471,7 @@ void NetworkedMultiplayerENet::close_connection(uint32_t wait_usec) {
 	ERR_FAIL_COND_MSG(!active, "The multiplayer instance isn't currently active.");
 
 	_pop_current_packet();
+	_stop_thread();
 
 	bool peers_disconnected = false;
 	for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
@@ -474,7 +506,7 @@ void NetworkedMultiplayerENet::disconnect_peer(int p_peer, bool now) {
 
 	if (now) {
 		int *id = (int *)peer_map[p_peer]->data;
-		enet_peer_disconnect_now(peer_map[p_peer], 0);
+		_peer_disconnect(peer_map[p_peer], true);
 
 		// enet_peer_disconnect_now doesn't generate ENET_EVENT_TYPE_DISCONNECT,
 		// notify everyone else, send disconnect signal & remove from peer_map like in poll()
@@ -487,7 +519,7 @@ void NetworkedMultiplayerENet::disconnect_peer(int p_peer, bool now) {
 				ENetPacket *packet = enet_packet_create(nullptr, 8, ENET_PACKET_FLAG_RELIABLE);
 				encode_uint32(SYSMSG_REMOVE_PEER, &packet->data[0]);
 				encode_uint32(p_peer, &packet->data[4]);
-				enet_peer_send(E->get(), SYSCH_CONFIG, packet);
+				_peer_send(E->get(), SYSCH_CONFIG, packet);
 			}
 		}
 
@@ -498,7 +530,7 @@ void NetworkedMultiplayerENet::disconnect_peer(int p_peer, bool now) {
 		emit_signal("peer_disconnected", p_peer);
 		peer_map.erase(p_peer);
 	} else {
-		enet_peer_disconnect_later(peer_map[p_peer], 0);
+		_peer_disconnect(peer_map[p_peer], false);
 	}
 }
 
@@ -564,7 +596,7 @@ Error NetworkedMultiplayerENet::put_packet(const uint8_t *p_buffer, int p_buffer
 
 	if (server) {
 		if (target_peer == 0) {
-			enet_host_broadcast(host, channel, packet);
+			_host_broadcast(channel, packet);
 		} else if (target_peer < 0) {
 			// Send to all but one
 			// and make copies for sending
@@ -578,19 +610,19 @@ Error NetworkedMultiplayerENet::put_packet(const uint8_t *p_buffer, int p_buffer
 
 				ENetPacket *packet2 = enet_packet_create(packet->data, packet->dataLength, packet_flags);
 
-				enet_peer_send(F->get(), channel, packet2);
+				_peer_send(F->get(), channel, packet2);
 			}
 
 			enet_packet_destroy(packet); // Original packet no longer needed
 		} else {
-			enet_peer_send(E->get(), channel, packet);
+			_peer_send(E->get(), channel, packet);
 		}
 	} else {
 		ERR_FAIL_COND_V(!peer_map.has(1), ERR_BUG);
-		enet_peer_send(peer_map[1], channel, packet); // Send to server for broadcast
+		_peer_send(peer_map[1], channel, packet); // Send to server for broadcast
 	}
 
-	enet_host_flush(host);
+	_host_flush();
 
 	return OK;
 }
@@ -605,6 +637,156 @@ void NetworkedMultiplayerENet::_pop_current_packet() {
 		current_packet.packet = nullptr;
 		current_packet.from = 0;
 		current_packet.channel = -1;
+		current_packet.time = 0;
+	}
+}
+
+void NetworkedMultiplayerENet::_run_command(const Command &p_command) {
+	if (p_command.peer && p_command.peer->connectID != p_command.connect_id) {
+		// The peer was reset, and possibly handed to a new client, after the command was queued.
+		if (p_command.packet && p_command.packet->referenceCount == 0) {
+			enet_packet_destroy(p_command.packet);
+		}
+		return;
+	}
+
+	switch (p_command.type) {
+		case COMMAND_SEND: {
+			enet_peer_send(p_command.peer, p_command.channel, p_command.packet);
+		} break;
+		case COMMAND_BROADCAST: {
+			enet_host_broadcast(host, p_command.channel, p_command.packet);
+		} break;
+		case COMMAND_RESET: {
+			enet_peer_reset(p_command.peer);
+		} break;
+		case COMMAND_DISCONNECT_NOW: {
+			enet_peer_disconnect_now(p_command.peer, 0);
+		} break;
+		case COMMAND_DISCONNECT_LATER: {
+			enet_peer_disconnect_later(p_command.peer, 0);
+		} break;
+	}
+}
+
+void NetworkedMultiplayerENet::_send_command(const Command &p_command) {
+	if (!thread) {
+		_run_command(p_command);
+		return;
+	}
+
+	while (!thread_commands.push(p_command)) {
+		OS::get_singleton()->delay_usec(100); // The network thread is behind, let it catch up.
+	}
+}
+
+void NetworkedMultiplayerENet::_peer_send(ENetPeer *p_peer, int p_channel, ENetPacket *p_packet) {
+	Command command;
+	command.type = COMMAND_SEND;
+	command.peer = p_peer;
+	command.connect_id = p_peer->connectID;
+	command.channel = p_channel;
+	command.packet = p_packet;
+	_send_command(command);
+}
+
+void NetworkedMultiplayerENet::_peer_reset(ENetPeer *p_peer) {
+	Command command;
+	command.type = COMMAND_RESET;
+	command.peer = p_peer;
+	command.connect_id = p_peer->connectID;
+	_send_command(command);
+}
+
+void NetworkedMultiplayerENet::_peer_disconnect(ENetPeer *p_peer, bool p_now) {
+	Command command;
+	command.type = p_now ? COMMAND_DISCONNECT_NOW : COMMAND_DISCONNECT_LATER;
+	command.peer = p_peer;
+	command.connect_id = p_peer->connectID;
+	_send_command(command);
+}
+
+void NetworkedMultiplayerENet::_host_broadcast(int p_channel, ENetPacket *p_packet) {
+	Command command;
+	command.type = COMMAND_BROADCAST;
+	command.channel = p_channel;
+	command.packet = p_packet;
+	_send_command(command);
+}
+
+void NetworkedMultiplayerENet::_host_flush() {
+	if (!thread) {
+		enet_host_flush(host);
+	} // Otherwise the network thread flushes after running the queued commands.
+}
+
+void NetworkedMultiplayerENet::_thread_func(void *p_userdata) {
+	NetworkedMultiplayerENet *enet = (NetworkedMultiplayerENet *)p_userdata;
+	while (!enet->thread_exit.load()) {
+		enet->_thread_poll();
+	}
+}
+
+void NetworkedMultiplayerENet::_thread_poll() {
+	Command command;
+	while (thread_commands.pop(command)) {
+		_run_command(command);
+	}
+	enet_host_flush(host);
+
+	const uint32_t timeout = 1000 / service_frequency;
+
+	if (thread_events.is_full()) {
+		// The main thread is behind. Keep servicing the connections so acks and pings
+		// still go out, but leave the events queued in ENet until it catches up.
+		enet_host_service(host, nullptr, timeout);
+		return;
+	}
+
+	// Returns as soon as something arrives, so receive latency doesn't depend on the frequency.
+	ThreadEvent thread_event;
+	int ret = enet_host_service(host, &thread_event.event, timeout);
+	while (ret > 0) {
+		thread_event.time = OS::get_singleton()->get_ticks_usec();
+		thread_events.push(thread_event);
+		if (thread_events.is_full()) {
+			break;
+		}
+		ret = enet_host_check_events(host, &thread_event.event);
+	}
+}
+
+void NetworkedMultiplayerENet::_start_thread() {
+	if (!threaded) {
+		return;
+	}
+
+	thread_events.clear(THREAD_QUEUE_SIZE);
+	thread_commands.clear(THREAD_QUEUE_SIZE);
+	thread_exit.store(false);
+	thread = Thread::create(_thread_func, this);
+}
+
+void NetworkedMultiplayerENet::_stop_thread() {
+	if (!thread) {
+		return;
+	}
+
+	thread_exit.store(true);
+	Thread::wait_to_finish(thread);
+	memdelete(thread);
+	thread = nullptr;
+
+	// Anything still queued is handled here, the host is only used by this thread from now on.
+	Command command;
+	while (thread_commands.pop(command)) {
+		_run_command(command);
+	}
+	ThreadEvent thread_event;
+	while (thread_events.pop(thread_event)) {
+		if (thread_event.event.type == ENET_EVENT_TYPE_RECEIVE) {
+			enet_packet_destroy(thread_event.event.packet);
+		}
 	}
 }
 
@@ -646,6 +828,24 @@ bool NetworkedMultiplayerENet::is_refusing_new_connections() const {
 	return refuse_connections;
 }
 
+void NetworkedMultiplayerENet::set_threaded(bool p_enabled) {
+	ERR_FAIL_COND_MSG(active, "The network thread can only be enabled or disabled before creating a server or client.");
+	threaded = p_enabled;
+}
+
+bool NetworkedMultiplayerENet::is_threaded() const {
+	return threaded;
+}
+
+void NetworkedMultiplayerENet::set_service_frequency(int p_frequency) {
+	ERR_FAIL_COND_MSG(p_frequency < 1 || p_frequency > 1000, "The service frequency must be between 1 and 1000 (inclusive).");
+	service_frequency = p_frequency;
+}
+
+int NetworkedMultiplayerENet::get_service_frequency() const {
+	return service_frequency;
+}
+
 void NetworkedMultiplayerENet::set_compression_mode(CompressionMode p_mode) {
 	compression_mode = p_mode;
 }
@@ -842,12 +1042,20 @@ void NetworkedMultiplayerENet::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_always_ordered"), &NetworkedMultiplayerENet::is_always_ordered);
 	ClassDB::bind_method(D_METHOD("set_server_relay_enabled", "enabled"), &NetworkedMultiplayerENet::set_server_relay_enabled);
 	ClassDB::bind_method(D_METHOD("is_server_relay_enabled"), &NetworkedMultiplayerENet::is_server_relay_enabled);
+	ClassDB::bind_method(D_METHOD("set_threaded", "enabled"), &NetworkedMultiplayerENet::set_threaded);
+	ClassDB::bind_method(D_METHOD("is_threaded"), &NetworkedMultiplayerENet::is_threaded);
+	ClassDB::bind_method(D_METHOD("set_service_frequency", "frequency"), &NetworkedMultiplayerENet::set_service_frequency);
+	ClassDB::bind_method(D_METHOD("get_service_frequency"), &NetworkedMultiplayerENet::get_service_frequency);
+	ClassDB::bind_method(D_METHOD("get_packet_timestamp"), &NetworkedMultiplayerENet::get_packet_timestamp);
+	ClassDB::bind_method(D_METHOD("get_last_packet_timestamp"), &NetworkedMultiplayerENet::get_last_packet_timestamp);
 
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "compression_mode", PROPERTY_HINT_ENUM, "None,Range Coder,FastLZ,ZLib,ZStd"), "set_compression_mode", "get_compression_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "transfer_channel"), "set_transfer_channel", "get_transfer_channel");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "channel_count"), "set_channel_count", "get_channel_count");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "always_ordered"), "set_always_ordered", "is_always_ordered");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "server_relay"), "set_server_relay_enabled", "is_server_relay_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "threaded"), "set_threaded", "is_threaded");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "service_frequency", PROPERTY_HINT_RANGE, "1,1000,1"), "set_service_frequency", "get_service_frequency");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "dtls_verify"), "set_dtls_verify_enabled", "is_dtls_verify_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_dtls"), "set_dtls_enabled", "is_dtls_enabled");
 
@@ -866,6 +1074,7 @@ NetworkedMultiplayerENet::NetworkedMultiplayerENet() {
 	unique_id = 0;
 	target_peer = 0;
 	current_packet.packet = nullptr;
+	current_packet.time = 0;
 	transfer_mode = TRANSFER_MODE_RELIABLE;
 	channel_count = SYSCH_MAX;
 	transfer_channel = -1;
@@ -881,6 +1090,8 @@ NetworkedMultiplayerENet::NetworkedMultiplayerENet() {
 
 	dtls_enabled = false;
 	dtls_verify = true;
+
+	thread_exit.store(false);
 }
 
 NetworkedMultiplayerENet::~NetworkedMultiplayerENet() {
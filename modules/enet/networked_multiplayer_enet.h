@@ -34,9 +34,13 @@
 #include "core/crypto/crypto.h"
 #include "core/io/compression.h"
 #include "core/io/networked_multiplayer_peer.h"
+#include "core/local_vector.h"
+#include "core/os/thread.h"
 
 #include <enet/enet.h>
 
+#include <atomic>
+
 class NetworkedMultiplayerENet : public NetworkedMultiplayerPeer {
 	GDCLASS(NetworkedMultiplayerENet, NetworkedMultiplayerPeer);
 
@@ -88,8 +92,104 @@ private:
 		ENetPacket *packet;
 		int from;
 		int channel;
+		uint64_t time;
+	};
+
+	// Single producer, single consumer ring used to hand events and commands
+	// between the main thread and the network thread without locking.
+	template <class T>
+	class PacketQueue {
+		LocalVector<T> buffer;
+		uint32_t mask = 0;
+		std::atomic<uint32_t> head; // Next slot to read, owned by the consumer.
+		std::atomic<uint32_t> tail; // Next slot to write, owned by the producer.
+
+	public:
+		// Must only be called while no other thread uses the queue.
+		void clear(uint32_t p_size) {
+			buffer.resize(p_size);
+			mask = p_size - 1;
+			head.store(0);
+			tail.store(0);
+		}
+
+		bool is_full() const {
+			return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_acquire) > mask;
+		}
+
+		bool push(const T &p_value) {
+			uint32_t t = tail.load(std::memory_order_relaxed);
+			if (t - head.load(std::memory_order_acquire) > mask) {
+				return false;
+			}
+			buffer[t & mask] = p_value;
+			tail.store(t + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool pop(T &r_value) {
+			uint32_t h = head.load(std::memory_order_relaxed);
+			if (h == tail.load(std::memory_order_acquire)) {
+				return false;
+			}
+			r_value = buffer[h & mask];
+			head.store(h + 1, std::memory_order_release);
+			return true;
+		}
+
+		PacketQueue() {
+			head.store(0);
+			tail.store(0);
+		}
+	};
+
+	enum CommandType {
+		COMMAND_SEND,
+		COMMAND_BROADCAST,
+		COMMAND_RESET,
+		COMMAND_DISCONNECT_NOW,
+		COMMAND_DISCONNECT_LATER,
+	};
+
+	struct Command {
+		CommandType type = COMMAND_SEND;
+		ENetPeer *peer = nullptr;
+		enet_uint32 connect_id = 0; // ENet reuses peer slots, a different ID means the command is stale.
+		int channel = 0;
+		ENetPacket *packet = nullptr;
+	};
+
+	struct ThreadEvent {
+		ENetEvent event;
+		uint64_t time = 0;
 	};
 
+	enum {
+		THREAD_QUEUE_SIZE = 8192 // Must be a power of two.
+	};
+
+	bool threaded = false;
+	int service_frequency = 1000;
+	Thread *thread = nullptr;
+	std::atomic<bool> thread_exit;
+	PacketQueue<ThreadEvent> thread_events;
+	PacketQueue<Command> thread_commands;
+
+	static void _thread_func(void *p_userdata);
+	void _thread_poll();
+	void _start_thread();
+	void _stop_thread();
+
+	void _run_command(const Command &p_command);
+	void _send_command(const Command &p_command);
+	void _peer_send(ENetPeer *p_peer, int p_channel, ENetPacket *p_packet);
+	void _peer_reset(ENetPeer *p_peer);
+	void _peer_disconnect(ENetPeer *p_peer, bool p_now);
+	void _host_broadcast(int p_channel, ENetPacket *p_packet);
+	void _host_flush();
+
+	void _process_event(ENetEvent &p_event, uint64_t p_time);
+
 	CompressionMode compression_mode;
 
 	List<Packet> incoming_packets;
@@ -165,6 +265,13 @@ public:
 	bool is_always_ordered() const;
 	void set_server_relay_enabled(bool p_enabled);
 	bool is_server_relay_enabled() const;
+	void set_threaded(bool p_enabled);
+	bool is_threaded() const;
+	void set_service_frequency(int p_frequency);
+	int get_service_frequency() const;
+
+	uint64_t get_packet_timestamp() const;
+	uint64_t get_last_packet_timestamp() const;
 
 	NetworkedMultiplayerENet();
 	~NetworkedMultiplayerENet();
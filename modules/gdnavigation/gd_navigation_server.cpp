@@ -30,12 +30,15 @@
 
 #include "gd_navigation_server.h"
 
+#include "core/debugger/performance_counter.h"
 #include "core/os/mutex.h"
 
 #ifndef _3D_DISABLED
 #include "navigation_mesh_generator.h"
 #endif
 
+static PerformanceCounter path_query_counter("navigation/path_queries", true);
+
 /**
 	@author AndreaCatania
 */
@@ -115,10 +118,16 @@
 
 GdNavigationServer::GdNavigationServer() :
 		NavigationServer3D() {
+#ifndef NO_THREADS
+	step_work_pool.init();
+#endif
 }
 
 GdNavigationServer::~GdNavigationServer() {
 	flush_queries();
+#ifndef NO_THREADS
+	step_work_pool.finish();
+#endif
 }
 
 void GdNavigationServer::add_command(SetCommand *command) const {
@@ -204,6 +213,7 @@ Vector<Vector3> GdNavigationServer::map_get_path(RID p_map, Vector3 p_origin, Ve
 	const NavMap *map = map_owner.getornull(p_map);
 	ERR_FAIL_COND_V(map == nullptr, Vector<Vector3>());
 
+	path_query_counter.add();
 	return map->get_path(p_origin, p_destination, p_optimize);
 }
 
@@ -492,7 +502,7 @@ void GdNavigationServer::process(real_t p_delta_time) {
 	MutexLock lock(operations_mutex);
 	for (int i(0); i < active_maps.size(); i++) {
 		active_maps[i]->sync();
-		active_maps[i]->step(p_delta_time);
+		active_maps[i]->step(p_delta_time, step_work_pool);
 		active_maps[i]->dispatch_callbacks();
 	}
 }
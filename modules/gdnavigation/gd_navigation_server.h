@@ -81,6 +81,9 @@ class GdNavigationServer : public NavigationServer3D {
 	bool active = true;
 	Vector<NavMap *> active_maps;
 
+	/// Shared by all the maps, to compute the agents avoidance in parallel.
+	ThreadWorkPool step_work_pool;
+
 public:
 	GdNavigationServer();
 	virtual ~GdNavigationServer();
@@ -30,7 +30,6 @@
 
 #include "nav_map.h"
 
-#include "core/os/threaded_array_processor.h"
 #include "nav_region.h"
 #include "rvo_agent.h"
 
@@ -42,6 +41,8 @@
 
 #define USE_ENTRY_POINT
 
+#define AGENT_TREE_MAX_REFITS 15
+
 void NavMap::set_up(Vector3 p_up) {
 	up = p_up;
 	regenerate_polygons = true;
@@ -550,6 +551,7 @@ void NavMap::set_agent_as_controlled(RvoAgent *agent) {
 	if (!exist) {
 		ERR_FAIL_COND(!has_agent(agent));
 		controlled_agents.push_back(agent);
+		controlled_agents_dirty = true;
 	}
 }
 
@@ -557,6 +559,7 @@ void NavMap::remove_agent_as_controlled(RvoAgent *agent) {
 	auto it = std::find(controlled_agents.begin(), controlled_agents.end(), agent);
 	if (it != controlled_agents.end()) {
 		controlled_agents.erase(it);
+		controlled_agents_dirty = true;
 	}
 }
 
@@ -717,26 +720,51 @@ void NavMap::sync() {
 			raw_agents.push_back(agents[i]->get_agent());
 		}
 		rvo.buildAgentTree(raw_agents);
+		agent_tree_refits = 0;
+	} else if (agent_tree_refits < AGENT_TREE_MAX_REFITS) {
+		// The agents moved since the last sync, refitting the bounds keeps the
+		// neighbour search exact without partitioning the agents again.
+		rvo.refitAgentTree();
+		agent_tree_refits++;
+	} else {
+		// Once in a while partition again, so the tree follows the crowd. The
+		// order of the previous build makes it cheap.
+		rvo.rebuildAgentTree();
+		agent_tree_refits = 0;
+	}
+
+	if (controlled_agents_dirty) {
+		controlled_raw_agents.resize(controlled_agents.size());
+		for (size_t i(0); i < controlled_agents.size(); i++) {
+			controlled_raw_agents[i] = controlled_agents[i]->get_agent();
+		}
 	}
 
 	regenerate_polygons = false;
 	regenerate_links = false;
 	agents_dirty = false;
+	controlled_agents_dirty = false;
 }
 
-void NavMap::compute_single_step(uint32_t index, RvoAgent **agent) {
-	(*(agent + index))->get_agent()->computeNeighbors(&rvo);
-	(*(agent + index))->get_agent()->computeNewVelocity(deltatime);
+void NavMap::compute_single_step(uint32_t index, RVO::Agent **agent) {
+	agent[index]->computeNeighbors(&rvo);
+	agent[index]->computeNewVelocity(deltatime);
 }
 
-void NavMap::step(real_t p_deltatime) {
+void NavMap::step(real_t p_deltatime, ThreadWorkPool &p_work_pool) {
 	deltatime = p_deltatime;
-	if (controlled_agents.size() > 0) {
-		thread_process_array(
-				controlled_agents.size(),
+	if (controlled_raw_agents.size() > 0) {
+#ifndef NO_THREADS
+		p_work_pool.do_work(
+				controlled_raw_agents.size(),
 				this,
 				&NavMap::compute_single_step,
-				controlled_agents.data());
+				controlled_raw_agents.data());
+#else
+		for (uint32_t i(0); i < controlled_raw_agents.size(); i++) {
+			compute_single_step(i, controlled_raw_agents.data());
+		}
+#endif
 	}
 }
 
@@ -34,6 +34,7 @@
 #include "nav_rid.h"
 
 #include "core/math/math_defs.h"
+#include "core/thread_work_pool.h"
 #include "nav_utils.h"
 #include <KdTree.h>
 
@@ -76,6 +77,17 @@ class NavMap : public NavRid {
 	/// Controlled agents
 	std::vector<RvoAgent *> controlled_agents;
 
+	/// Is controlled agent array modified?
+	bool controlled_agents_dirty = false;
+
+	/// The rvo agents of the controlled agents, packed in a flat array so the
+	/// step doesn't need to go through the `RvoAgent`.
+	std::vector<RVO::Agent *> controlled_raw_agents;
+
+	/// Syncs since the agent tree was last partitioned, in between only its
+	/// bounds are refitted.
+	uint32_t agent_tree_refits = 0;
+
 	/// Physics delta time
 	real_t deltatime = 0.0;
 
@@ -129,11 +141,13 @@ public:
 	}
 
 	void sync();
-	void step(real_t p_deltatime);
+	/// `p_work_pool` is shared by all the maps, to compute the avoidance of
+	/// the agents in parallel.
+	void step(real_t p_deltatime, ThreadWorkPool &p_work_pool);
 	void dispatch_callbacks();
 
 private:
-	void compute_single_step(uint32_t index, RvoAgent **agent);
+	void compute_single_step(uint32_t index, RVO::Agent **agent);
 	void clip_path(const std::vector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly) const;
 };
 
@@ -33,7 +33,9 @@
 #include "navigation_mesh_generator.h"
 
 #include "core/math/quick_hull.h"
+#include "core/pair.h"
 #include "core/os/thread.h"
+#include "core/os/threaded_array_processor.h"
 #include "scene/3d/collision_shape_3d.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/physics_body_3d.h"
@@ -273,6 +275,30 @@ void NavigationMeshGenerator::_parse_geometry(Transform p_accumulated_transform,
 	}
 }
 
+void NavigationMeshGenerator::_fill_recast_config(Ref<NavigationMesh> p_nav_mesh, rcConfig &r_cfg) {
+	memset(&r_cfg, 0, sizeof(r_cfg));
+
+	r_cfg.cs = p_nav_mesh->get_cell_size();
+	r_cfg.ch = p_nav_mesh->get_cell_height();
+	r_cfg.walkableSlopeAngle = p_nav_mesh->get_agent_max_slope();
+	r_cfg.walkableHeight = (int)Math::ceil(p_nav_mesh->get_agent_height() / r_cfg.ch);
+	r_cfg.walkableClimb = (int)Math::floor(p_nav_mesh->get_agent_max_climb() / r_cfg.ch);
+	r_cfg.walkableRadius = (int)Math::ceil(p_nav_mesh->get_agent_radius() / r_cfg.cs);
+	r_cfg.maxEdgeLen = (int)(p_nav_mesh->get_edge_max_length() / p_nav_mesh->get_cell_size());
+	r_cfg.maxSimplificationError = p_nav_mesh->get_edge_max_error();
+	r_cfg.minRegionArea = (int)(p_nav_mesh->get_region_min_size() * p_nav_mesh->get_region_min_size());
+	r_cfg.mergeRegionArea = (int)(p_nav_mesh->get_region_merge_size() * p_nav_mesh->get_region_merge_size());
+	r_cfg.maxVertsPerPoly = (int)p_nav_mesh->get_verts_per_poly();
+	r_cfg.detailSampleDist = p_nav_mesh->get_detail_sample_distance() < 0.9f ? 0 : p_nav_mesh->get_cell_size() * p_nav_mesh->get_detail_sample_distance();
+	r_cfg.detailSampleMaxError = p_nav_mesh->get_cell_height() * p_nav_mesh->get_detail_sample_max_error();
+}
+
+uint32_t NavigationMeshGenerator::_get_filters(Ref<NavigationMesh> p_nav_mesh) {
+	return (p_nav_mesh->get_filter_low_hanging_obstacles() ? 1 : 0) |
+			(p_nav_mesh->get_filter_ledge_spans() ? 2 : 0) |
+			(p_nav_mesh->get_filter_walkable_low_height_spans() ? 4 : 0);
+}
+
 void NavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh) {
 	Vector<Vector3> nav_vertices;
 
@@ -300,6 +326,31 @@ void NavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_mesh(con
 	}
 }
 
+void NavigationMeshGenerator::_convert_detail_mesh_to_baked_tile(const rcPolyMeshDetail *p_detail_mesh, BakedTile &r_tile) {
+	r_tile.vertices.resize(p_detail_mesh->nverts);
+	for (int i = 0; i < p_detail_mesh->nverts; i++) {
+		const float *v = &p_detail_mesh->verts[i * 3];
+		r_tile.vertices.write[i] = Vector3(v[0], v[1], v[2]);
+	}
+
+	for (int i = 0; i < p_detail_mesh->nmeshes; i++) {
+		const unsigned int *m = &p_detail_mesh->meshes[i * 4];
+		const unsigned int bverts = m[0];
+		const unsigned int btris = m[2];
+		const unsigned int ntris = m[3];
+		const unsigned char *tris = &p_detail_mesh->tris[btris * 4];
+		for (unsigned int j = 0; j < ntris; j++) {
+			Vector<int> nav_indices;
+			nav_indices.resize(3);
+			// Polygon order in recast is opposite than godot's
+			nav_indices.write[0] = ((int)(bverts + tris[j * 4 + 0]));
+			nav_indices.write[1] = ((int)(bverts + tris[j * 4 + 2]));
+			nav_indices.write[2] = ((int)(bverts + tris[j * 4 + 1]));
+			r_tile.polygons.push_back(nav_indices);
+		}
+	}
+}
+
 void NavigationMeshGenerator::_build_recast_navigation_mesh(
 		Ref<NavigationMesh> p_nav_mesh,
 #ifdef TOOLS_ENABLED
@@ -329,21 +380,7 @@ void NavigationMeshGenerator::_build_recast_navigation_mesh(
 	rcCalcBounds(verts, nverts, bmin, bmax);
 
 	rcConfig cfg;
-	memset(&cfg, 0, sizeof(cfg));
-
-	cfg.cs = p_nav_mesh->get_cell_size();
-	cfg.ch = p_nav_mesh->get_cell_height();
-	cfg.walkableSlopeAngle = p_nav_mesh->get_agent_max_slope();
-	cfg.walkableHeight = (int)Math::ceil(p_nav_mesh->get_agent_height() / cfg.ch);
-	cfg.walkableClimb = (int)Math::floor(p_nav_mesh->get_agent_max_climb() / cfg.ch);
-	cfg.walkableRadius = (int)Math::ceil(p_nav_mesh->get_agent_radius() / cfg.cs);
-	cfg.maxEdgeLen = (int)(p_nav_mesh->get_edge_max_length() / p_nav_mesh->get_cell_size());
-	cfg.maxSimplificationError = p_nav_mesh->get_edge_max_error();
-	cfg.minRegionArea = (int)(p_nav_mesh->get_region_min_size() * p_nav_mesh->get_region_min_size());
-	cfg.mergeRegionArea = (int)(p_nav_mesh->get_region_merge_size() * p_nav_mesh->get_region_merge_size());
-	cfg.maxVertsPerPoly = (int)p_nav_mesh->get_verts_per_poly();
-	cfg.detailSampleDist = p_nav_mesh->get_detail_sample_distance() < 0.9f ? 0 : p_nav_mesh->get_cell_size() * p_nav_mesh->get_detail_sample_distance();
-	cfg.detailSampleMaxError = p_nav_mesh->get_cell_height() * p_nav_mesh->get_detail_sample_max_error();
+	_fill_recast_config(p_nav_mesh, cfg);
 
 	cfg.bmin[0] = bmin[0];
 	cfg.bmin[1] = bmin[1];
@@ -477,34 +514,399 @@ void NavigationMeshGenerator::_build_recast_navigation_mesh(
 	detail_mesh = nullptr;
 }
 
-NavigationMeshGenerator *NavigationMeshGenerator::get_singleton() {
-	return singleton;
-}
+bool NavigationMeshGenerator::_build_recast_tile(
+		const rcConfig &p_tile_cfg,
+		Ref<NavigationMesh> p_nav_mesh,
+		rcHeightfield *&hf,
+		rcCompactHeightfield *&chf,
+		rcContourSet *&cset,
+		rcPolyMesh *&poly_mesh,
+		rcPolyMeshDetail *&detail_mesh,
+		const float *p_verts,
+		int p_nverts,
+		const int *p_tris,
+		int p_ntris,
+		BakedTile &r_tile) {
+	// Each tile uses its own context, so the tiles can be built in parallel.
+	rcContext ctx;
 
-NavigationMeshGenerator::NavigationMeshGenerator() {
-	singleton = this;
+	hf = rcAllocHeightfield();
+
+	ERR_FAIL_COND_V(!hf, false);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(&ctx, *hf, p_tile_cfg.width, p_tile_cfg.height, p_tile_cfg.bmin, p_tile_cfg.bmax, p_tile_cfg.cs, p_tile_cfg.ch), false);
+
+	{
+		Vector<unsigned char> tri_areas;
+		tri_areas.resize(p_ntris);
+
+		ERR_FAIL_COND_V(tri_areas.size() == 0, false);
+
+		memset(tri_areas.ptrw(), 0, p_ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, p_tile_cfg.walkableSlopeAngle, p_verts, p_nverts, p_tris, p_ntris, tri_areas.ptrw());
+
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(&ctx, p_verts, p_nverts, p_tris, tri_areas.ptr(), p_ntris, *hf, p_tile_cfg.walkableClimb), false);
+	}
+
+	if (p_nav_mesh->get_filter_low_hanging_obstacles()) {
+		rcFilterLowHangingWalkableObstacles(&ctx, p_tile_cfg.walkableClimb, *hf);
+	}
+	if (p_nav_mesh->get_filter_ledge_spans()) {
+		rcFilterLedgeSpans(&ctx, p_tile_cfg.walkableHeight, p_tile_cfg.walkableClimb, *hf);
+	}
+	if (p_nav_mesh->get_filter_walkable_low_height_spans()) {
+		rcFilterWalkableLowHeightSpans(&ctx, p_tile_cfg.walkableHeight, *hf);
+	}
+
+	chf = rcAllocCompactHeightfield();
+
+	ERR_FAIL_COND_V(!chf, false);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(&ctx, p_tile_cfg.walkableHeight, p_tile_cfg.walkableClimb, *hf, *chf), false);
+
+	rcFreeHeightField(hf);
+	hf = nullptr;
+
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(&ctx, p_tile_cfg.walkableRadius, *chf), false);
+
+	// The border of the tile is only used to get the same regions and
+	// contours on both sides of the tile edges, it's removed from the result.
+	if (p_nav_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
+		ERR_FAIL_COND_V(!rcBuildDistanceField(&ctx, *chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(&ctx, *chf, p_tile_cfg.borderSize, p_tile_cfg.minRegionArea, p_tile_cfg.mergeRegionArea), false);
+	} else if (p_nav_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(&ctx, *chf, p_tile_cfg.borderSize, p_tile_cfg.minRegionArea, p_tile_cfg.mergeRegionArea), false);
+	} else {
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(&ctx, *chf, p_tile_cfg.borderSize, p_tile_cfg.minRegionArea), false);
+	}
+
+	cset = rcAllocContourSet();
+
+	ERR_FAIL_COND_V(!cset, false);
+	ERR_FAIL_COND_V(!rcBuildContours(&ctx, *chf, p_tile_cfg.maxSimplificationError, p_tile_cfg.maxEdgeLen, *cset), false);
+
+	if (cset->nconts == 0) {
+		// Nothing walkable in this tile.
+		return true;
+	}
+
+	poly_mesh = rcAllocPolyMesh();
+	ERR_FAIL_COND_V(!poly_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(&ctx, *cset, p_tile_cfg.maxVertsPerPoly, *poly_mesh), false);
+
+	detail_mesh = rcAllocPolyMeshDetail();
+	ERR_FAIL_COND_V(!detail_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, p_tile_cfg.detailSampleDist, p_tile_cfg.detailSampleMaxError, *detail_mesh), false);
+
+	_convert_detail_mesh_to_baked_tile(detail_mesh, r_tile);
+	return true;
 }
 
-NavigationMeshGenerator::~NavigationMeshGenerator() {
+void NavigationMeshGenerator::_bake_tile(uint32_t p_index, TileBakeJob *p_job) {
+	const Vector2i &tile = p_job->tiles[p_index];
+	const Vector<int> &triangles = p_job->tile_triangles[p_index];
+	if (triangles.size() == 0) {
+		return;
+	}
+
+	rcConfig cfg = *p_job->cfg;
+	const float border = cfg.borderSize * cfg.cs;
+	const float tile_world_size = cfg.tileSize * cfg.cs;
+	cfg.bmin[0] = tile.x * tile_world_size - border;
+	cfg.bmin[2] = tile.y * tile_world_size - border;
+	cfg.bmax[0] = (tile.x + 1) * tile_world_size + border;
+	cfg.bmax[2] = (tile.y + 1) * tile_world_size + border;
+
+	// Gather the indices of the triangles overlapping this tile.
+	Vector<int> tris;
+	tris.resize(triangles.size() * 3);
+	const int *src_indices = p_job->indices->ptr();
+	int *dst_indices = tris.ptrw();
+	for (int i = 0; i < triangles.size(); i++) {
+		dst_indices[i * 3 + 0] = src_indices[triangles[i] * 3 + 0];
+		dst_indices[i * 3 + 1] = src_indices[triangles[i] * 3 + 1];
+		dst_indices[i * 3 + 2] = src_indices[triangles[i] * 3 + 2];
+	}
+
+	rcHeightfield *hf = nullptr;
+	rcCompactHeightfield *chf = nullptr;
+	rcContourSet *cset = nullptr;
+	rcPolyMesh *poly_mesh = nullptr;
+	rcPolyMeshDetail *detail_mesh = nullptr;
+
+	BakedTile &result = p_job->results.write[p_index];
+	if (!_build_recast_tile(cfg, p_job->nav_mesh, hf, chf, cset, poly_mesh, detail_mesh, p_job->vertices->ptr(), p_job->vertices->size() / 3, tris.ptr(), triangles.size(), result)) {
+		result = BakedTile();
+	}
+
+	rcFreeHeightField(hf);
+	rcFreeCompactHeightfield(chf);
+	rcFreeContourSet(cset);
+	rcFreePolyMesh(poly_mesh);
+	rcFreePolyMeshDetail(detail_mesh);
 }
 
-void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node) {
-	ERR_FAIL_COND(!p_nav_mesh.is_valid());
+void NavigationMeshGenerator::_build_recast_tiled_navigation_mesh(
+		Ref<NavigationMesh> p_nav_mesh,
+#ifdef TOOLS_ENABLED
+		EditorProgress *ep,
+#endif
+		const Vector<float> &vertices,
+		const Vector<int> &indices,
+		const AABB *p_changed_area) {
+#ifdef TOOLS_ENABLED
+	if (ep) {
+		ep->step(TTR("Setting up Configuration..."), 1);
+	}
+#endif
+
+	const float *verts = vertices.ptr();
+	const int nverts = vertices.size() / 3;
+	const int *tris = indices.ptr();
+	const int ntris = indices.size() / 3;
+
+	float bmin[3], bmax[3];
+	rcCalcBounds(verts, nverts, bmin, bmax);
+
+	rcConfig cfg;
+	_fill_recast_config(p_nav_mesh, cfg);
+	cfg.tileSize = p_nav_mesh->get_tile_size();
+	cfg.borderSize = cfg.walkableRadius + 3;
+	cfg.width = cfg.tileSize + cfg.borderSize * 2;
+	cfg.height = cfg.tileSize + cfg.borderSize * 2;
+	cfg.bmin[1] = bmin[1];
+	cfg.bmax[1] = bmax[1];
+
+	const float border = cfg.borderSize * cfg.cs;
+	const float tile_world_size = cfg.tileSize * cfg.cs;
+
+	// The tile grid is aligned to the origin, so a tile keeps its coordinates
+	// when the geometry bounds change.
+	const Vector2i grid_begin(Math::floor(bmin[0] / tile_world_size), Math::floor(bmin[2] / tile_world_size));
+	const Vector2i grid_end(Math::floor(bmax[0] / tile_world_size), Math::floor(bmax[2] / tile_world_size));
+
+	MutexLock lock(tile_cache_mutex);
+
+	// Drop the caches of the navigation meshes that don't exist anymore.
+	Vector<ObjectID> to_erase;
+	for (Map<ObjectID, TileCache>::Element *E = tile_cache.front(); E; E = E->next()) {
+		if (ObjectDB::get_instance(E->key()) == nullptr) {
+			to_erase.push_back(E->key());
+		}
+	}
+	for (int i = 0; i < to_erase.size(); i++) {
+		tile_cache.erase(to_erase[i]);
+	}
+
+	TileCache &cache = tile_cache[p_nav_mesh->get_instance_id()];
+
+	// The cached tiles can only be reused if they were baked with the same
+	// settings; the bounds are not part of the comparison.
+	bool cache_valid = p_changed_area != nullptr;
+	cache_valid = cache_valid && cache.cfg.cs == cfg.cs && cache.cfg.ch == cfg.ch && cache.cfg.tileSize == cfg.tileSize;
+	cache_valid = cache_valid && cache.cfg.walkableSlopeAngle == cfg.walkableSlopeAngle && cache.cfg.walkableHeight == cfg.walkableHeight;
+	cache_valid = cache_valid && cache.cfg.walkableClimb == cfg.walkableClimb && cache.cfg.walkableRadius == cfg.walkableRadius;
+	cache_valid = cache_valid && cache.cfg.maxEdgeLen == cfg.maxEdgeLen && cache.cfg.maxSimplificationError == cfg.maxSimplificationError;
+	cache_valid = cache_valid && cache.cfg.minRegionArea == cfg.minRegionArea && cache.cfg.mergeRegionArea == cfg.mergeRegionArea;
+	cache_valid = cache_valid && cache.cfg.maxVertsPerPoly == cfg.maxVertsPerPoly;
+	cache_valid = cache_valid && cache.cfg.detailSampleDist == cfg.detailSampleDist && cache.cfg.detailSampleMaxError == cfg.detailSampleMaxError;
+	cache_valid = cache_valid && cache.partition_type == p_nav_mesh->get_sample_partition_type() && cache.filters == _get_filters(p_nav_mesh);
+	if (!cache_valid) {
+		cache.tiles.clear();
+	}
+	cache.cfg = cfg;
+	cache.partition_type = p_nav_mesh->get_sample_partition_type();
+	cache.filters = _get_filters(p_nav_mesh);
+
+	// Forget the tiles that are now out of the geometry bounds.
+	Vector<Vector2i> tiles_to_erase;
+	for (Map<Vector2i, BakedTile>::Element *E = cache.tiles.front(); E; E = E->next()) {
+		const Vector2i &tile = E->key();
+		if (tile.x < grid_begin.x || tile.y < grid_begin.y || tile.x > grid_end.x || tile.y > grid_end.y) {
+			tiles_to_erase.push_back(tile);
+		}
+	}
+	for (int i = 0; i < tiles_to_erase.size(); i++) {
+		cache.tiles.erase(tiles_to_erase[i]);
+	}
+
+	// Select the tiles to rebuild. A tile depends on the geometry within its
+	// border, so the changed area is grown by the border size.
+	TileBakeJob job;
+	job.cfg = &cfg;
+	job.vertices = &vertices;
+	job.indices = &indices;
+	job.nav_mesh = p_nav_mesh;
+
+	Map<Vector2i, int> tile_jobs;
+	for (int z = grid_begin.y; z <= grid_end.y; z++) {
+		for (int x = grid_begin.x; x <= grid_end.x; x++) {
+			if (cache_valid) {
+				Rect2 tile_rect(x * tile_world_size - border, z * tile_world_size - border, tile_world_size + border * 2, tile_world_size + border * 2);
+				Rect2 changed_rect(p_changed_area->position.x, p_changed_area->position.z, p_changed_area->size.x, p_changed_area->size.z);
+				if (!tile_rect.intersects(changed_rect, true)) {
+					continue;
+				}
+			}
+			tile_jobs[Vector2i(x, z)] = job.tiles.size();
+			job.tiles.push_back(Vector2i(x, z));
+		}
+	}
+
+	job.tile_triangles.resize(job.tiles.size());
+	job.results.resize(job.tiles.size());
 
 #ifdef TOOLS_ENABLED
-	EditorProgress *ep(nullptr);
-	if (Engine::get_singleton()->is_editor_hint()) {
-		ep = memnew(EditorProgress("bake", TTR("Navigation Mesh Generator Setup:"), 11));
+	if (ep) {
+		ep->step(TTR("Assigning geometry to tiles..."), 2);
 	}
+#endif
+
+	for (int i = 0; i < ntris; i++) {
+		float tri_min[2] = { Math_INF, Math_INF };
+		float tri_max[2] = { -Math_INF, -Math_INF };
+		for (int j = 0; j < 3; j++) {
+			const float *v = &verts[tris[i * 3 + j] * 3];
+			tri_min[0] = MIN(tri_min[0], v[0]);
+			tri_min[1] = MIN(tri_min[1], v[2]);
+			tri_max[0] = MAX(tri_max[0], v[0]);
+			tri_max[1] = MAX(tri_max[1], v[2]);
+		}
 
+		const int tx_begin = MAX(grid_begin.x, (int)Math::floor((tri_min[0] - border) / tile_world_size));
+		const int tz_begin = MAX(grid_begin.y, (int)Math::floor((tri_min[1] - border) / tile_world_size));
+		const int tx_end = MIN(grid_end.x, (int)Math::floor((tri_max[0] + border) / tile_world_size));
+		const int tz_end = MIN(grid_end.y, (int)Math::floor((tri_max[1] + border) / tile_world_size));
+		for (int z = tz_begin; z <= tz_end; z++) {
+			for (int x = tx_begin; x <= tx_end; x++) {
+				const Map<Vector2i, int>::Element *E = tile_jobs.find(Vector2i(x, z));
+				if (E) {
+					job.tile_triangles.write[E->get()].push_back(i);
+				}
+			}
+		}
+	}
+
+#ifdef TOOLS_ENABLED
 	if (ep) {
-		ep->step(TTR("Parsing Geometry..."), 0);
+		ep->step(vformat(TTR("Baking %d tiles..."), job.tiles.size()), 3);
 	}
 #endif
 
-	Vector<float> vertices;
-	Vector<int> indices;
+	if (job.tiles.size() > 0) {
+		thread_process_array(job.tiles.size(), this, &NavigationMeshGenerator::_bake_tile, &job);
+	}
+
+	for (int i = 0; i < job.tiles.size(); i++) {
+		if (job.results[i].polygons.size() > 0) {
+			cache.tiles[job.tiles[i]] = job.results[i];
+		} else {
+			cache.tiles.erase(job.tiles[i]);
+		}
+	}
+
+#ifdef TOOLS_ENABLED
+	if (ep) {
+		ep->step(TTR("Converting to native navigation mesh..."), 10);
+	}
+#endif
+
+	// Merge the tiles. Each tile has its own copy of the vertices on its
+	// edges, which are welded with the ones of the tiles already merged so
+	// the polygons on both sides of a tile edge share the same vertices.
+	// A vertex is on a tile edge when it's within half a cell of the tile
+	// grid, and it's welded to a vertex of another tile in the same cell
+	// that is at most a step (walkable climb) above or below it.
+	const float weld_height = MAX(cfg.walkableClimb, 1) * cfg.ch;
+
+	int vertex_count = 0;
+	for (Map<Vector2i, BakedTile>::Element *E = cache.tiles.front(); E; E = E->next()) {
+		vertex_count += E->get().vertices.size();
+	}
+
+	Vector<Vector3> nav_vertices;
+	nav_vertices.resize(vertex_count);
+	Vector3 *nav_vertices_ptr = nav_vertices.ptrw();
+	int nav_vertex_count = 0;
+
+	Map<Vector2i, Vector<int>> edge_vertices;
+	Vector<Pair<Vector2i, int>> tile_edge_vertices;
+	Vector<int> remap;
+
+	p_nav_mesh->clear_polygons();
+	for (Map<Vector2i, BakedTile>::Element *E = cache.tiles.front(); E; E = E->next()) {
+		const BakedTile &tile = E->get();
+
+		remap.resize(tile.vertices.size());
+		tile_edge_vertices.clear();
+		for (int i = 0; i < tile.vertices.size(); i++) {
+			const Vector3 &v = tile.vertices[i];
+			const float grid_x = v.x / tile_world_size;
+			const float grid_z = v.z / tile_world_size;
+			const bool on_edge = Math::abs(grid_x - Math::round(grid_x)) * tile_world_size <= cfg.cs * 0.5 ||
+					Math::abs(grid_z - Math::round(grid_z)) * tile_world_size <= cfg.cs * 0.5;
+
+			int index = -1;
+			Vector2i cell;
+			if (on_edge) {
+				cell = Vector2i(Math::round(v.x / cfg.cs), Math::round(v.z / cfg.cs));
+				const Map<Vector2i, Vector<int>>::Element *C = edge_vertices.find(cell);
+				if (C) {
+					const Vector<int> &candidates = C->get();
+					for (int j = 0; j < candidates.size(); j++) {
+						if (Math::abs(nav_vertices_ptr[candidates[j]].y - v.y) <= weld_height) {
+							index = candidates[j];
+							break;
+						}
+					}
+				}
+			}
+
+			if (index == -1) {
+				index = nav_vertex_count++;
+				nav_vertices_ptr[index] = v;
+				if (on_edge) {
+					// Only welded with the vertices of the next tiles, the
+					// vertices of a tile are never merged together.
+					tile_edge_vertices.push_back(Pair<Vector2i, int>(cell, index));
+				}
+			}
+			remap.write[i] = index;
+		}
+
+		for (int i = 0; i < tile_edge_vertices.size(); i++) {
+			edge_vertices[tile_edge_vertices[i].first].push_back(tile_edge_vertices[i].second);
+		}
+
+		for (int i = 0; i < tile.polygons.size(); i++) {
+			Vector<int> polygon = tile.polygons[i];
+			int *polygon_ptr = polygon.ptrw();
+			bool degenerate = false;
+			for (int j = 0; j < polygon.size(); j++) {
+				polygon_ptr[j] = remap[polygon_ptr[j]];
+				for (int k = 0; k < j; k++) {
+					degenerate = degenerate || polygon_ptr[k] == polygon_ptr[j];
+				}
+			}
+			if (!degenerate) {
+				p_nav_mesh->add_polygon(polygon);
+			}
+		}
+	}
+	nav_vertices.resize(nav_vertex_count);
+	p_nav_mesh->set_vertices(nav_vertices);
+}
 
+NavigationMeshGenerator *NavigationMeshGenerator::get_singleton() {
+	return singleton;
+}
+
+NavigationMeshGenerator::NavigationMeshGenerator() {
+	singleton = this;
+}
+
+NavigationMeshGenerator::~NavigationMeshGenerator() {
+}
+
+void NavigationMeshGenerator::_parse_nodes(Ref<NavigationMesh> p_nav_mesh, Node *p_node, Vector<float> &p_verticies, Vector<int> &p_indices) {
 	List<Node *> parse_nodes;
 
 	if (p_nav_mesh->get_source_geometry_mode() == NavigationMesh::SOURCE_GEOMETRY_NAVMESH_CHILDREN) {
@@ -518,10 +920,39 @@ void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node)
 		int geometry_type = p_nav_mesh->get_parsed_geometry_type();
 		uint32_t collision_mask = p_nav_mesh->get_collision_mask();
 		bool recurse_children = p_nav_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
-		_parse_geometry(navmesh_xform, E->get(), vertices, indices, geometry_type, collision_mask, recurse_children);
+		_parse_geometry(navmesh_xform, E->get(), p_verticies, p_indices, geometry_type, collision_mask, recurse_children);
 	}
+}
+
+void NavigationMeshGenerator::_bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node, const AABB *p_changed_area) {
+	ERR_FAIL_COND(!p_nav_mesh.is_valid());
 
-	if (vertices.size() > 0 && indices.size() > 0) {
+#ifdef TOOLS_ENABLED
+	EditorProgress *ep(nullptr);
+	if (Engine::get_singleton()->is_editor_hint()) {
+		ep = memnew(EditorProgress("bake", TTR("Navigation Mesh Generator Setup:"), 11));
+	}
+
+	if (ep) {
+		ep->step(TTR("Parsing Geometry..."), 0);
+	}
+#endif
+
+	Vector<float> vertices;
+	Vector<int> indices;
+
+	_parse_nodes(p_nav_mesh, p_node, vertices, indices);
+
+	if (vertices.size() > 0 && indices.size() > 0 && p_nav_mesh->get_tile_size() > 0) {
+		_build_recast_tiled_navigation_mesh(
+				p_nav_mesh,
+#ifdef TOOLS_ENABLED
+				ep,
+#endif
+				vertices,
+				indices,
+				p_changed_area);
+	} else if (vertices.size() > 0 && indices.size() > 0) {
 		rcHeightfield *hf = nullptr;
 		rcCompactHeightfield *chf = nullptr;
 		rcContourSet *cset = nullptr;
@@ -568,15 +999,27 @@ void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node)
 #endif
 }
 
+void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node) {
+	_bake(p_nav_mesh, p_node, nullptr);
+}
+
+void NavigationMeshGenerator::bake_area(Ref<NavigationMesh> p_nav_mesh, Node *p_node, const AABB &p_area) {
+	_bake(p_nav_mesh, p_node, &p_area);
+}
+
 void NavigationMeshGenerator::clear(Ref<NavigationMesh> p_nav_mesh) {
 	if (p_nav_mesh.is_valid()) {
 		p_nav_mesh->clear_polygons();
 		p_nav_mesh->set_vertices(Vector<Vector3>());
+
+		MutexLock lock(tile_cache_mutex);
+		tile_cache.erase(p_nav_mesh->get_instance_id());
 	}
 }
 
 void NavigationMeshGenerator::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("bake", "nav_mesh", "root_node"), &NavigationMeshGenerator::bake);
+	ClassDB::bind_method(D_METHOD("bake_area", "nav_mesh", "root_node", "area"), &NavigationMeshGenerator::bake_area);
 	ClassDB::bind_method(D_METHOD("clear", "nav_mesh"), &NavigationMeshGenerator::clear);
 }
 
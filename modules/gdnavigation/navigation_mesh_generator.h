@@ -33,6 +33,7 @@
 
 #ifndef _3D_DISABLED
 
+#include "core/os/mutex.h"
 #include "scene/3d/navigation_region_3d.h"
 
 #include <Recast.h>
@@ -46,6 +47,35 @@ class NavigationMeshGenerator : public Object {
 
 	static NavigationMeshGenerator *singleton;
 
+	/// The result of the bake of a single tile, already converted to the
+	/// native navigation mesh format.
+	struct BakedTile {
+		Vector<Vector3> vertices;
+		Vector<Vector<int>> polygons;
+	};
+
+	/// Tiles baked for a navigation mesh, kept to rebuild only the tiles
+	/// touched by a change. It's invalidated when the bake settings change.
+	struct TileCache {
+		rcConfig cfg;
+		int partition_type = 0;
+		uint32_t filters = 0;
+		Map<Vector2i, BakedTile> tiles;
+	};
+
+	struct TileBakeJob {
+		const rcConfig *cfg;
+		const Vector<float> *vertices;
+		const Vector<int> *indices;
+		Ref<NavigationMesh> nav_mesh;
+		Vector<Vector2i> tiles;
+		Vector<Vector<int>> tile_triangles;
+		Vector<BakedTile> results;
+	};
+
+	Mutex tile_cache_mutex;
+	Map<ObjectID, TileCache> tile_cache;
+
 protected:
 	static void _bind_methods();
 
@@ -54,7 +84,12 @@ protected:
 	static void _add_faces(const PackedVector3Array &p_faces, const Transform &p_xform, Vector<float> &p_verticies, Vector<int> &p_indices);
 	static void _parse_geometry(Transform p_accumulated_transform, Node *p_node, Vector<float> &p_verticies, Vector<int> &p_indices, int p_generate_from, uint32_t p_collision_mask, bool p_recurse_children);
 
+	static void _parse_nodes(Ref<NavigationMesh> p_nav_mesh, Node *p_node, Vector<float> &p_verticies, Vector<int> &p_indices);
+	static void _fill_recast_config(Ref<NavigationMesh> p_nav_mesh, rcConfig &r_cfg);
+	static uint32_t _get_filters(Ref<NavigationMesh> p_nav_mesh);
+
 	static void _convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh);
+	static void _convert_detail_mesh_to_baked_tile(const rcPolyMeshDetail *p_detail_mesh, BakedTile &r_tile);
 	static void _build_recast_navigation_mesh(
 			Ref<NavigationMesh> p_nav_mesh,
 #ifdef TOOLS_ENABLED
@@ -68,6 +103,31 @@ protected:
 			Vector<float> &vertices,
 			Vector<int> &indices);
 
+	static bool _build_recast_tile(
+			const rcConfig &p_tile_cfg,
+			Ref<NavigationMesh> p_nav_mesh,
+			rcHeightfield *&hf,
+			rcCompactHeightfield *&chf,
+			rcContourSet *&cset,
+			rcPolyMesh *&poly_mesh,
+			rcPolyMeshDetail *&detail_mesh,
+			const float *p_verts,
+			int p_nverts,
+			const int *p_tris,
+			int p_ntris,
+			BakedTile &r_tile);
+	void _bake_tile(uint32_t p_index, TileBakeJob *p_job);
+	void _build_recast_tiled_navigation_mesh(
+			Ref<NavigationMesh> p_nav_mesh,
+#ifdef TOOLS_ENABLED
+			EditorProgress *ep,
+#endif
+			const Vector<float> &vertices,
+			const Vector<int> &indices,
+			const AABB *p_changed_area);
+
+	void _bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node, const AABB *p_changed_area);
+
 public:
 	static NavigationMeshGenerator *get_singleton();
 
@@ -75,6 +135,7 @@ public:
 	~NavigationMeshGenerator();
 
 	void bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node);
+	void bake_area(Ref<NavigationMesh> p_nav_mesh, Node *p_node, const AABB &p_area);
 	void clear(Ref<NavigationMesh> p_nav_mesh);
 };
 
@@ -30,6 +30,7 @@
 
 #include "gdscript_compiler.h"
 
+#include "core/debugger/trace_profiler.h"
 #include "gdscript.h"
 
 bool GDScriptCompiler::_is_class_member_property(CodeGen &codegen, const StringName &p_name) {
@@ -1828,6 +1829,9 @@ Error GDScriptCompiler::_parse_function(GDScript *p_script, const GDScriptParser
 #endif
 	gdfunc->_script = p_script;
 	gdfunc->source = source;
+#ifdef TRACE_PROFILER_ENABLED
+	gdfunc->_trace_name = TraceProfiler::intern(String(source) + "::" + String(func_name));
+#endif
 
 #ifdef DEBUG_ENABLED
 
@@ -30,10 +30,14 @@
 
 #include "gdscript_function.h"
 
+#include "core/debugger/performance_counter.h"
+#include "core/debugger/trace_profiler.h"
 #include "core/os/os.h"
 #include "gdscript.h"
 #include "gdscript_functions.h"
 
+static PerformanceCounter call_counter("script/gdscript_calls", true);
+
 Variant *GDScriptFunction::_get_variant(int p_address, GDScriptInstance *p_instance, GDScript *p_script, Variant &self, Variant &static_ref, Variant *p_stack, String &r_error) const {
 	int address = p_address & ADDR_MASK;
 
@@ -255,6 +259,9 @@ String GDScriptFunction::_get_call_error(const Callable::CallError &p_err, const
 Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state) {
 	OPCODES_TABLE;
 
+	TRACE_ZONE(_trace_name);
+	call_counter.add();
+
 	if (!_code_ptr) {
 		return Variant();
 	}
@@ -226,6 +226,9 @@ private:
 	friend class GDScriptCompiler;
 
 	StringName source;
+#ifdef TRACE_PROFILER_ENABLED
+	const char *_trace_name = "GDScript"; // Interned, so it outlives the function in saved traces.
+#endif
 
 	mutable Variant nil;
 	mutable Variant *_constants_ptr;
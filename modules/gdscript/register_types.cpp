@@ -112,7 +112,7 @@ public:
 					key.write[i] = v;
 				}
 				FileAccessEncrypted *fae = memnew(FileAccessEncrypted);
-				Error err = fae->open_and_parse(fa, key, FileAccessEncrypted::MODE_WRITE_AES256);
+				Error err = fae->open_and_parse(fa, key, FileAccessEncrypted::MODE_WRITE_AES256_BLOCKS);
 
 				if (err == OK) {
 					fae->store_buffer(file.ptr(), file.size());
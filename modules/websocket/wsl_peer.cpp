@@ -227,6 +227,13 @@ WSLPeer::WriteMode WSLPeer::get_write_mode() const {
 	return write_mode;
 }
 
+void WSLPeer::_request_poll() {
+	if (_data && _data->is_server) {
+		WSLServer *helper = (WSLServer *)_data->obj;
+		helper->_set_peer_active(_data->id);
+	}
+}
+
 void WSLPeer::poll() {
 	if (!_data) {
 		return;
@@ -237,6 +244,14 @@ void WSLPeer::poll() {
 	}
 }
 
+bool WSLPeer::needs_poll() const {
+	if (!_data) {
+		return true; // Must be reported as disconnected.
+	}
+	// SSL may hold decrypted data the socket no longer reports.
+	return _data->closing || _data->conn.ptr() != _data->tcp.ptr() || wslay_event_want_write(_data->ctx);
+}
+
 Error WSLPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
 	ERR_FAIL_COND_V(!is_connected_to_host(), FAILED);
 
@@ -250,6 +265,9 @@ Error WSLPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
 		close_now();
 		return FAILED;
 	}
+	if (wslay_event_want_write(_data->ctx)) {
+		_request_poll(); // Socket buffer is full, finish sending on the next poll.
+	}
 	return OK;
 }
 
@@ -299,6 +317,7 @@ void WSLPeer::close(int p_code, String p_reason) {
 		wslay_event_queue_close(_data->ctx, p_code, (uint8_t *)cs.ptr(), cs.size());
 		wslay_event_send(_data->ctx);
 		_data->closing = true;
+		_request_poll();
 	}
 
 	_in_buffer.clear();
@@ -80,6 +80,8 @@ private:
 	static bool _wsl_poll(struct PeerData *p_data);
 	static void _wsl_destroy(struct PeerData **p_data);
 
+	void _request_poll();
+
 	struct PeerData *_data;
 	uint8_t _is_string;
 	// Our packet info is just a boolean (is_string), using uint8_t for it.
@@ -93,6 +95,7 @@ public:
 	int close_code;
 	String close_reason;
 	void poll(); // Used by client and server.
+	bool needs_poll() const; // True when there is work to do even if the socket has no data.
 
 	virtual int get_available_packet_count() const;
 	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size);
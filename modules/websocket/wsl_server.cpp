@@ -176,17 +176,68 @@ Error WSLServer::listen(int p_port, const Vector<String> p_protocols, bool gd_mp
 	for (int i = 0; i < p_protocols.size(); i++) {
 		pw[i] = p_protocols[i].strip_edges();
 	}
-	return _server->listen(p_port, bind_ip);
+	Error err = _server->listen(p_port, bind_ip);
+	if (err == OK && _reactor.is_valid() && _server->add_to_reactor(_reactor, LISTENER_ID) != OK) {
+		_disable_reactor();
+	}
+	return err;
+}
+
+void WSLServer::_disable_reactor() {
+	print_verbose("WebSocket server unable to use the socket reactor, polling every peer.");
+	_reactor.unref();
+	_events.clear();
+	_active_peers.clear();
+}
+
+void WSLServer::_set_peer_active(int p_peer_id) {
+	if (_reactor.is_valid()) {
+		_active_peers.insert(p_peer_id);
+	}
+}
+
+void WSLServer::_poll_peer(int p_id, const Ref<WebSocketPeer> &p_peer, List<int> &r_remove_ids) {
+	Ref<WSLPeer> peer = (WSLPeer *)p_peer.ptr();
+	peer->poll();
+	if (!peer->is_connected_to_host()) {
+		_on_disconnect(p_id, peer->close_code != -1);
+		r_remove_ids.push_back(p_id);
+	} else if (_reactor.is_valid() && peer->needs_poll()) {
+		_active_peers.insert(p_id);
+	}
 }
 
 void WSLServer::poll() {
+	bool accept_ready = true;
 	List<int> remove_ids;
-	for (Map<int, Ref<WebSocketPeer>>::Element *E = _peer_map.front(); E; E = E->next()) {
-		Ref<WSLPeer> peer = (WSLPeer *)E->get().ptr();
-		peer->poll();
-		if (!peer->is_connected_to_host()) {
-			_on_disconnect(E->key(), peer->close_code != -1);
-			remove_ids.push_back(E->key());
+	if (_reactor.is_valid()) {
+		// Idle peers are skipped, only ready sockets and peers with pending work are polled.
+		accept_ready = false;
+		_events.resize(MAX(1, _reactor->get_socket_count()));
+		int count = _reactor->wait(_events.ptr(), _events.size(), 0);
+		for (int i = 0; i < count; i++) {
+			if (_events[i].id == LISTENER_ID) {
+				accept_ready = true;
+			} else {
+				_active_peers.insert(int(_events[i].id));
+			}
+		}
+
+		LocalVector<int> active;
+		for (Set<int>::Element *E = _active_peers.front(); E; E = E->next()) {
+			active.push_back(E->get());
+		}
+		_active_peers.clear();
+
+		for (uint32_t i = 0; i < active.size(); i++) {
+			Map<int, Ref<WebSocketPeer>>::Element *E = _peer_map.find(active[i]);
+			if (E) {
+				_poll_peer(E->key(), E->get(), remove_ids);
+			}
+		}
+	} else {
+		for (Map<int, Ref<WebSocketPeer>>::Element *E = _peer_map.front(); E; E = E->next()) {
+			_poll_peer(E->key(), E->get(), remove_ids);
 		}
 	}
 	for (List<int>::Element *E = remove_ids.front(); E; E = E->next()) {
@@ -219,6 +270,10 @@ void WSLServer::poll() {
 		ws_peer->set_no_delay(true);
 
 		_peer_map[id] = ws_peer;
+		if (_reactor.is_valid() && ppeer->tcp->add_to_reactor(_reactor, id) != OK) {
+			_disable_reactor();
+		}
+		_set_peer_active(id); // Data may have arrived with the handshake.
 		remove_peers.push_back(ppeer);
 		_on_connect(id, ppeer->protocol);
 	}
@@ -227,7 +282,7 @@ void WSLServer::poll() {
 	}
 	remove_peers.clear();
 
-	if (!_server->is_listening()) {
+	if (!_server->is_listening() || !accept_ready) {
 		return;
 	}
 
@@ -270,6 +325,7 @@ void WSLServer::stop() {
 	_pending.clear();
 	_peer_map.clear();
 	_protocols.clear();
+	_active_peers.clear();
 }
 
 bool WSLServer::has_peer(int p_id) const {
@@ -315,6 +371,7 @@ WSLServer::WSLServer() {
 	_out_buf_size = DEF_BUF_SHIFT;
 	_out_pkt_size = DEF_PKT_SHIFT;
 	_server.instance();
+	_reactor = Ref<NetSocketReactor>(NetSocketReactor::create());
 }
 
 WSLServer::~WSLServer() {
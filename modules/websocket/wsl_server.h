@@ -39,6 +39,7 @@
 #include "core/io/stream_peer_ssl.h"
 #include "core/io/stream_peer_tcp.h"
 #include "core/io/tcp_server.h"
+#include "core/local_vector.h"
 
 #define WSL_SERVER_TIMEOUT 1000
 
@@ -78,6 +79,17 @@ private:
 	Ref<TCP_Server> _server;
 	Vector<String> _protocols;
 
+	// When available, only peers whose socket is ready or that asked for it are polled.
+	enum {
+		LISTENER_ID = 0, // Peer IDs are never 0.
+	};
+	Ref<NetSocketReactor> _reactor;
+	LocalVector<NetSocketReactor::Event> _events;
+	Set<int> _active_peers;
+
+	void _poll_peer(int p_id, const Ref<WebSocketPeer> &p_peer, List<int> &r_remove_ids);
+	void _disable_reactor();
+
 public:
 	Error set_buffers(int p_in_buffer, int p_in_packets, int p_out_buffer, int p_out_packets);
 	Error listen(int p_port, const Vector<String> p_protocols = Vector<String>(), bool gd_mp_api = false);
@@ -91,6 +103,8 @@ public:
 	void disconnect_peer(int p_peer_id, int p_code = 1000, String p_reason = "");
 	virtual void poll();
 
+	void _set_peer_active(int p_peer_id);
+
 	WSLServer();
 	~WSLServer();
 };
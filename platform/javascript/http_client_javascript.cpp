@@ -194,6 +194,23 @@ int HTTPClient::get_read_chunk_size() const {
 	return read_limit;
 }
 
+void HTTPClient::set_pipelining_enabled(bool p_enable) {
+	ERR_FAIL_COND_MSG(p_enable, "HTTPClient pipelining is not supported for the HTML5 platform.");
+}
+
+bool HTTPClient::is_pipelining_enabled() const {
+	return false;
+}
+
+int HTTPClient::get_pipelined_request_count() const {
+	return 0;
+}
+
+bool HTTPClient::is_connection_reusable() const {
+	// The browser manages the actual connections.
+	return status == STATUS_CONNECTED;
+}
+
 Error HTTPClient::poll() {
 	switch (status) {
 		case STATUS_DISCONNECTED:
@@ -31,6 +31,7 @@
 #include "cpu_particles_2d.h"
 
 #include "core/core_string_names.h"
+#include "core/os/thread.h"
 #include "scene/2d/gpu_particles_2d.h"
 #include "scene/main/canvas_item.h"
 #include "scene/resources/particles_material.h"
@@ -50,19 +51,34 @@ void CPUParticles2D::set_emitting(bool p_emitting) {
 void CPUParticles2D::set_amount(int p_amount) {
 	ERR_FAIL_COND_MSG(p_amount < 1, "Amount of particles must be greater than 0.");
 
-	particles.resize(p_amount);
-	{
-		Particle *w = particles.ptrw();
-
-		for (int i = 0; i < p_amount; i++) {
-			w[i].active = false;
-		}
+	particle_count = p_amount;
+
+	particles.transform.resize(p_amount);
+	particles.velocity.resize(p_amount);
+	particles.rotation.resize(p_amount);
+	particles.base_color.resize(p_amount);
+	particles.custom.resize(p_amount * 4);
+	particles.time.resize(p_amount);
+	particles.lifetime.resize(p_amount);
+	particles.rand.resize(p_amount * 4);
+	particles.seed.resize(p_amount);
+	particles.active.resize(p_amount);
+
+	for (int i = 0; i < p_amount; i++) {
+		particles.active[i] = false;
 	}
 
-	particle_data.resize((8 + 4 + 4) * p_amount);
+	particle_data.resize(PARTICLE_DATA_STRIDE * p_amount);
+	unsorted_particle_data.resize(PARTICLE_DATA_STRIDE * p_amount);
 	RS::get_singleton()->multimesh_allocate(multimesh, p_amount, RS::MULTIMESH_TRANSFORM_2D, true, true);
 
 	particle_order.resize(p_amount);
+	{
+		int *w = particle_order.ptrw();
+		for (int i = 0; i < p_amount; i++) {
+			w[i] = i;
+		}
+	}
 }
 
 void CPUParticles2D::set_lifetime(float p_lifetime) {
@@ -104,7 +120,7 @@ bool CPUParticles2D::is_emitting() const {
 }
 
 int CPUParticles2D::get_amount() const {
-	return particles.size();
+	return particle_count;
 }
 
 float CPUParticles2D::get_lifetime() const {
@@ -278,13 +294,8 @@ void CPUParticles2D::restart() {
 	cycle = 0;
 	emitting = false;
 
-	{
-		int pc = particles.size();
-		Particle *w = particles.ptrw();
-
-		for (int i = 0; i < pc; i++) {
-			w[i].active = false;
-		}
+	for (int i = 0; i < particle_count; i++) {
+		particles.active[i] = false;
 	}
 
 	set_emitting(true);
@@ -342,8 +353,23 @@ static void _adjust_curve_range(const Ref<Curve> &p_curve, float p_min, float p_
 void CPUParticles2D::set_param_curve(Parameter p_param, const Ref<Curve> &p_curve) {
 	ERR_FAIL_INDEX(p_param, PARAM_MAX);
 
+	Ref<Curve> old_curve = curve_parameters[p_param];
 	curve_parameters[p_param] = p_curve;
 
+	if (old_curve.is_valid() && old_curve != p_curve) {
+		bool used = false;
+		for (int i = 0; i < PARAM_MAX; i++) {
+			used = used || curve_parameters[i] == old_curve;
+		}
+		if (!used) {
+			old_curve->disconnect(CoreStringNames::get_singleton()->changed, callable_mp(this, &CPUParticles2D::_curves_changed));
+		}
+	}
+	if (p_curve.is_valid() && !p_curve->is_connected(CoreStringNames::get_singleton()->changed, callable_mp(this, &CPUParticles2D::_curves_changed))) {
+		curve_parameters[p_param]->connect(CoreStringNames::get_singleton()->changed, callable_mp(this, &CPUParticles2D::_curves_changed));
+	}
+	baked_curves_dirty = true;
+
 	switch (p_param) {
 		case PARAM_INITIAL_LINEAR_VELOCITY: {
 			//do none for this one
@@ -399,7 +425,17 @@ Color CPUParticles2D::get_color() const {
 }
 
 void CPUParticles2D::set_color_ramp(const Ref<Gradient> &p_ramp) {
+	if (color_ramp == p_ramp) {
+		return;
+	}
+	if (color_ramp.is_valid()) {
+		color_ramp->disconnect(CoreStringNames::get_singleton()->changed, callable_mp(this, &CPUParticles2D::_curves_changed));
+	}
 	color_ramp = p_ramp;
+	if (color_ramp.is_valid()) {
+		color_ramp->connect(CoreStringNames::get_singleton()->changed, callable_mp(this, &CPUParticles2D::_curves_changed));
+	}
+	baked_curves_dirty = true;
 }
 
 Ref<Gradient> CPUParticles2D::get_color_ramp() const {
@@ -526,8 +562,26 @@ static float rand_from_seed(uint32_t &seed) {
 	return float(seed % uint32_t(65536)) / 65535.0;
 }
 
+static _FORCE_INLINE_ float sample_baked_curve(const LocalVector<float> &p_baked, float p_offset) {
+	float pos = CLAMP(p_offset, 0.0f, 1.0f) * (p_baked.size() - 1);
+	uint32_t idx = uint32_t(pos);
+	if (idx >= p_baked.size() - 1) {
+		return p_baked[p_baked.size() - 1];
+	}
+	return Math::lerp(p_baked[idx], p_baked[idx + 1], pos - idx);
+}
+
+static _FORCE_INLINE_ Color sample_baked_color_ramp(const LocalVector<Color> &p_baked, float p_offset) {
+	float pos = CLAMP(p_offset, 0.0f, 1.0f) * (p_baked.size() - 1);
+	uint32_t idx = uint32_t(pos);
+	if (idx >= p_baked.size() - 1) {
+		return p_baked[p_baked.size() - 1];
+	}
+	return p_baked[idx].lerp(p_baked[idx + 1], pos - idx);
+}
+
 void CPUParticles2D::_update_internal() {
-	if (particles.size() == 0 || !is_visible_in_tree()) {
+	if (particle_count == 0 || !is_visible_in_tree()) {
 		_set_redraw(false);
 		return;
 	}
@@ -551,6 +605,24 @@ void CPUParticles2D::_update_internal() {
 	}
 	_set_redraw(true);
 
+	// Only the last step of the frame writes the multimesh data.
+	float fixed_frame_time = 0.0;
+	float fixed_todo = 0.0;
+	bool has_steps = true;
+
+	if (fixed_fps > 0) {
+		fixed_frame_time = 1.0 / fixed_fps;
+
+		float ldelta = delta;
+		if (ldelta > 0.1) { //avoid recursive stalls if fps goes below 10
+			ldelta = 0.1;
+		} else if (ldelta <= 0.0) { //unlikely but..
+			ldelta = 0.001;
+		}
+		fixed_todo = frame_remainder + ldelta;
+		has_steps = fixed_todo >= fixed_frame_time;
+	}
+
 	if (time == 0 && pre_process_time > 0.0) {
 		float frame_time;
 		if (fixed_fps > 0) {
@@ -562,47 +634,30 @@ void CPUParticles2D::_update_internal() {
 		float todo = pre_process_time;
 
 		while (todo >= 0) {
-			_particles_process(frame_time);
 			todo -= frame_time;
+			_particles_process(frame_time, todo < 0 && !has_steps);
 		}
 	}
 
 	if (fixed_fps > 0) {
-		float frame_time = 1.0 / fixed_fps;
-		float decr = frame_time;
-
-		float ldelta = delta;
-		if (ldelta > 0.1) { //avoid recursive stalls if fps goes below 10
-			ldelta = 0.1;
-		} else if (ldelta <= 0.0) { //unlikely but..
-			ldelta = 0.001;
-		}
-		float todo = frame_remainder + ldelta;
-
-		while (todo >= frame_time) {
-			_particles_process(frame_time);
-			todo -= decr;
+		while (fixed_todo >= fixed_frame_time) {
+			fixed_todo -= fixed_frame_time;
+			_particles_process(fixed_frame_time, fixed_todo < fixed_frame_time);
 		}
 
-		frame_remainder = todo;
+		frame_remainder = fixed_todo;
 
 	} else {
-		_particles_process(delta);
+		_particles_process(delta, true);
 	}
-
-	_update_particle_data_buffer();
 }
 
-void CPUParticles2D::_particles_process(float p_delta) {
-	p_delta *= speed_scale;
-
-	int pcount = particles.size();
-	Particle *w = particles.ptrw();
-
-	Particle *parray = w;
+void CPUParticles2D::_particles_process(float p_delta, bool p_update_buffer) {
+	ProcessStep step;
+	step.delta = p_delta * speed_scale;
 
-	float prev_time = time;
-	time += p_delta;
+	step.prev_time = time;
+	time += step.delta;
 	if (time > lifetime) {
 		time = Math::fmod(time, lifetime);
 		cycle++;
@@ -612,24 +667,91 @@ void CPUParticles2D::_particles_process(float p_delta) {
 		}
 	}
 
-	Transform2D emission_xform;
-	Transform2D velocity_xform;
 	if (!local_coords) {
-		emission_xform = get_global_transform();
-		velocity_xform = emission_xform;
-		velocity_xform[2] = Vector2();
+		step.emission_xform = get_global_transform();
+		step.velocity_xform = step.emission_xform;
+		step.velocity_xform[2] = Vector2();
 	}
 
-	float system_phase = time / lifetime;
+	step.system_phase = time / lifetime;
+	step.random_seed = Math::rand();
 
-	for (int i = 0; i < pcount; i++) {
-		Particle &p = parray[i];
+	if (baked_curves_dirty) {
+		_bake_curves();
+	}
+
+	step.buffer = nullptr;
+	if (p_update_buffer) {
+		update_mutex.lock();
+		step.buffer = draw_order == DRAW_ORDER_INDEX ? particle_data.ptrw() : unsorted_particle_data.ptr();
+	}
 
-		if (!emitting && !p.active) {
+	uint32_t chunk_count = (particle_count + PROCESS_CHUNK_SIZE - 1) / PROCESS_CHUNK_SIZE;
+#ifndef NO_THREADS
+	if (chunk_count > 1 && Thread::get_caller_id() == Thread::get_main_id()) {
+		get_tree()->get_work_pool().do_work(chunk_count, this, &CPUParticles2D::_process_chunk, (const ProcessStep *)&step);
+	} else
+#endif
+	{
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			_process_chunk(i, &step);
+		}
+	}
+
+	if (p_update_buffer) {
+		if (draw_order != DRAW_ORDER_INDEX) {
+			_sort_particle_data_buffer();
+		}
+		update_mutex.unlock();
+	}
+}
+
+void CPUParticles2D::_process_chunk(uint32_t p_chunk, const ProcessStep *p_step) {
+	int from = p_chunk * PROCESS_CHUNK_SIZE;
+	int to = MIN(from + PROCESS_CHUNK_SIZE, particle_count);
+
+	const float delta = p_step->delta;
+	const float prev_time = p_step->prev_time;
+	const float system_phase = p_step->system_phase;
+	const Transform2D &emission_xform = p_step->emission_xform;
+	const Transform2D &velocity_xform = p_step->velocity_xform;
+	const int pcount = particle_count;
+
+	Transform2D *transforms = particles.transform.ptr();
+	Vector2 *velocities = particles.velocity.ptr();
+	float *rotations = particles.rotation.ptr();
+	Color *base_colors = particles.base_color.ptr();
+	float *customs = particles.custom.ptr();
+	float *times = particles.time.ptr();
+	float *lifetimes = particles.lifetime.ptr();
+	float *rands = particles.rand.ptr();
+	uint32_t *seeds = particles.seed.ptr();
+	uint8_t *actives = particles.active.ptr();
+
+	for (int i = from; i < to; i++) {
+		Transform2D &xform = transforms[i];
+		Vector2 &velocity = velocities[i];
+		float &rotation = rotations[i];
+		float *custom = &customs[i * 4];
+		float &ptime = times[i];
+		float &plifetime = lifetimes[i];
+		float &angle_rand = rands[i * 4 + 0];
+		float &scale_rand = rands[i * 4 + 1];
+		float &hue_rot_rand = rands[i * 4 + 2];
+		float &anim_offset_rand = rands[i * 4 + 3];
+		uint8_t &active = actives[i];
+
+		float *row = p_step->buffer ? p_step->buffer + i * PARTICLE_DATA_STRIDE : nullptr;
+
+
+		if (!emitting && !active) {
+			if (row) {
+				zeromem(row, sizeof(float) * 8);
+			}
 			continue;
 		}
 
-		float local_delta = p_delta;
+		float local_delta = delta;
 
 		// The phase is a ratio between 0 (birth) and 1 (end of life) for each particle.
 		// While we use time in tests later on, for randomness we use the phase as done in the
@@ -676,66 +798,72 @@ void CPUParticles2D::_particles_process(float p_delta) {
 			}
 		}
 
-		if (p.time * (1.0 - explosiveness_ratio) > p.lifetime) {
+		if (ptime * (1.0 - explosiveness_ratio) > plifetime) {
 			restart = true;
 		}
 
 		if (restart) {
 			if (!emitting) {
-				p.active = false;
+				active = false;
+				if (row) {
+					zeromem(row, sizeof(float) * 8);
+				}
 				continue;
 			}
-			p.active = true;
+			active = true;
+
+			// Math::randf() can't be used from the worker threads, each restarted particle gets its own sequence.
+			uint32_t rng = idhash(p_step->random_seed + uint32_t(i));
 
 			/*float tex_linear_velocity = 0;
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->interpolate(0);
+			if (!baked_curves[PARAM_INITIAL_LINEAR_VELOCITY].empty()) {
+				tex_linear_velocity = baked_curves[PARAM_INITIAL_LINEAR_VELOCITY][0];
 			}*/
 
 			float tex_angle = 0.0;
-			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_angle = curve_parameters[PARAM_ANGLE]->interpolate(0);
+			if (!baked_curves[PARAM_ANGLE].empty()) {
+				tex_angle = baked_curves[PARAM_ANGLE][0];
 			}
 
 			float tex_anim_offset = 0.0;
-			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_anim_offset = curve_parameters[PARAM_ANGLE]->interpolate(0);
+			if (!baked_curves[PARAM_ANGLE].empty()) {
+				tex_anim_offset = baked_curves[PARAM_ANGLE][0];
 			}
 
-			p.seed = Math::rand();
+			seeds[i] = idhash(rng ^ uint32_t(0x9e3779b9));
 
-			p.angle_rand = Math::randf();
-			p.scale_rand = Math::randf();
-			p.hue_rot_rand = Math::randf();
-			p.anim_offset_rand = Math::randf();
+			angle_rand = rand_from_seed(rng);
+			scale_rand = rand_from_seed(rng);
+			hue_rot_rand = rand_from_seed(rng);
+			anim_offset_rand = rand_from_seed(rng);
 
-			float angle1_rad = Math::atan2(direction.y, direction.x) + (Math::randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
+			float angle1_rad = Math::atan2(direction.y, direction.x) + (rand_from_seed(rng) * 2.0 - 1.0) * Math_PI * spread / 180.0;
 			Vector2 rot = Vector2(Math::cos(angle1_rad), Math::sin(angle1_rad));
-			p.velocity = rot * parameters[PARAM_INITIAL_LINEAR_VELOCITY] * Math::lerp(1.0f, float(Math::randf()), randomness[PARAM_INITIAL_LINEAR_VELOCITY]);
+			velocity = rot * parameters[PARAM_INITIAL_LINEAR_VELOCITY] * Math::lerp(1.0f, rand_from_seed(rng), randomness[PARAM_INITIAL_LINEAR_VELOCITY]);
 
-			float base_angle = (parameters[PARAM_ANGLE] + tex_angle) * Math::lerp(1.0f, p.angle_rand, randomness[PARAM_ANGLE]);
-			p.rotation = Math::deg2rad(base_angle);
+			float base_angle = (parameters[PARAM_ANGLE] + tex_angle) * Math::lerp(1.0f, angle_rand, randomness[PARAM_ANGLE]);
+			rotation = Math::deg2rad(base_angle);
 
-			p.custom[0] = 0.0; // unused
-			p.custom[1] = 0.0; // phase [0..1]
-			p.custom[2] = (parameters[PARAM_ANIM_OFFSET] + tex_anim_offset) * Math::lerp(1.0f, p.anim_offset_rand, randomness[PARAM_ANIM_OFFSET]); //animation phase [0..1]
-			p.custom[3] = 0.0;
-			p.transform = Transform2D();
-			p.time = 0;
-			p.lifetime = lifetime * (1.0 - Math::randf() * lifetime_randomness);
-			p.base_color = Color(1, 1, 1, 1);
+			custom[0] = 0.0; // unused
+			custom[1] = 0.0; // phase [0..1]
+			custom[2] = (parameters[PARAM_ANIM_OFFSET] + tex_anim_offset) * Math::lerp(1.0f, anim_offset_rand, randomness[PARAM_ANIM_OFFSET]); //animation phase [0..1]
+			custom[3] = 0.0;
+			xform = Transform2D();
+			ptime = 0;
+			plifetime = lifetime * (1.0 - rand_from_seed(rng) * lifetime_randomness);
+			base_colors[i] = Color(1, 1, 1, 1);
 
 			switch (emission_shape) {
 				case EMISSION_SHAPE_POINT: {
 					//do none
 				} break;
 				case EMISSION_SHAPE_SPHERE: {
-					float s = Math::randf(), t = 2.0 * Math_PI * Math::randf();
+					float s = rand_from_seed(rng), t = 2.0 * Math_PI * rand_from_seed(rng);
 					float radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
-					p.transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
+					xform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
 				} break;
 				case EMISSION_SHAPE_RECTANGLE: {
-					p.transform[2] = Vector2(Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0) * emission_rect_extents;
+					xform[2] = Vector2(rand_from_seed(rng) * 2.0 - 1.0, rand_from_seed(rng) * 2.0 - 1.0) * emission_rect_extents;
 				} break;
 				case EMISSION_SHAPE_POINTS:
 				case EMISSION_SHAPE_DIRECTED_POINTS: {
@@ -744,16 +872,17 @@ void CPUParticles2D::_particles_process(float p_delta) {
 						break;
 					}
 
-					int random_idx = Math::rand() % pc;
+					rng = idhash(rng + 1);
+					int random_idx = rng % uint32_t(pc);
 
-					p.transform[2] = emission_points.get(random_idx);
+					xform[2] = emission_points.get(random_idx);
 
 					if (emission_shape == EMISSION_SHAPE_DIRECTED_POINTS && emission_normals.size() == pc) {
-						p.velocity = emission_normals.get(random_idx);
+						velocity = emission_normals.get(random_idx);
 					}
 
 					if (emission_colors.size() == pc) {
-						p.base_color = emission_colors.get(random_idx);
+						base_colors[i] = emission_colors.get(random_idx);
 					}
 				} break;
 				case EMISSION_SHAPE_MAX: { // Max value for validity check.
@@ -762,74 +891,77 @@ void CPUParticles2D::_particles_process(float p_delta) {
 			}
 
 			if (!local_coords) {
-				p.velocity = velocity_xform.xform(p.velocity);
-				p.transform = emission_xform * p.transform;
+				velocity = velocity_xform.xform(velocity);
+				xform = emission_xform * xform;
 			}
 
-		} else if (!p.active) {
+		} else if (!active) {
+			if (row) {
+				zeromem(row, sizeof(float) * 8);
+			}
 			continue;
-		} else if (p.time > p.lifetime) {
-			p.active = false;
+		} else if (ptime > plifetime) {
+			active = false;
 		} else {
-			uint32_t alt_seed = p.seed;
+			uint32_t alt_seed = seeds[i];
 
-			p.time += local_delta;
-			p.custom[1] = p.time / lifetime;
+			ptime += local_delta;
+			custom[1] = ptime / lifetime;
 
 			float tex_linear_velocity = 0.0;
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->interpolate(p.custom[1]);
+			if (!baked_curves[PARAM_INITIAL_LINEAR_VELOCITY].empty()) {
+				tex_linear_velocity = sample_baked_curve(baked_curves[PARAM_INITIAL_LINEAR_VELOCITY], custom[1]);
 			}
 
 			float tex_orbit_velocity = 0.0;
-			if (curve_parameters[PARAM_ORBIT_VELOCITY].is_valid()) {
-				tex_orbit_velocity = curve_parameters[PARAM_ORBIT_VELOCITY]->interpolate(p.custom[1]);
+			if (!baked_curves[PARAM_ORBIT_VELOCITY].empty()) {
+				tex_orbit_velocity = sample_baked_curve(baked_curves[PARAM_ORBIT_VELOCITY], custom[1]);
 			}
 
 			float tex_angular_velocity = 0.0;
-			if (curve_parameters[PARAM_ANGULAR_VELOCITY].is_valid()) {
-				tex_angular_velocity = curve_parameters[PARAM_ANGULAR_VELOCITY]->interpolate(p.custom[1]);
+			if (!baked_curves[PARAM_ANGULAR_VELOCITY].empty()) {
+				tex_angular_velocity = sample_baked_curve(baked_curves[PARAM_ANGULAR_VELOCITY], custom[1]);
 			}
 
 			float tex_linear_accel = 0.0;
-			if (curve_parameters[PARAM_LINEAR_ACCEL].is_valid()) {
-				tex_linear_accel = curve_parameters[PARAM_LINEAR_ACCEL]->interpolate(p.custom[1]);
+			if (!baked_curves[PARAM_LINEAR_ACCEL].empty()) {
+				tex_linear_accel = sample_baked_curve(baked_curves[PARAM_LINEAR_ACCEL], custom[1]);
 			}
 
 			float tex_tangential_accel = 0.0;
-			if (curve_parameters[PARAM_TANGENTIAL_ACCEL].is_valid()) {
-				tex_tangential_accel = curve_parameters[PARAM_TANGENTIAL_ACCEL]->interpolate(p.custom[1]);
+			if (!baked_curves[PARAM_TANGENTIAL_ACCEL].empty()) {
+				tex_tangential_accel = sample_baked_curve(baked_curves[PARAM_TANGENTIAL_ACCEL], custom[1]);
 			}
 
 			float tex_radial_accel = 0.0;
-			if (curve_parameters[PARAM_RADIAL_ACCEL].is_valid()) {
-				tex_radial_accel = curve_parameters[PARAM_RADIAL_ACCEL]->interpolate(p.custom[1]);
+			if (!baked_curves[PARAM_RADIAL_ACCEL].empty()) {
+				tex_radial_accel = sample_baked_curve(baked_curves[PARAM_RADIAL_ACCEL], custom[1]);
 			}
 
 			float tex_damping = 0.0;
-			if (curve_parameters[PARAM_DAMPING].is_valid()) {
-				tex_damping = curve_parameters[PARAM_DAMPING]->interpolate(p.custom[1]);
+			if (!baked_curves[PARAM_DAMPING].empty()) {
+				tex_damping = sample_baked_curve(baked_curves[PARAM_DAMPING], custom[1]);
 			}
 
 			float tex_angle = 0.0;
-			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_angle = curve_parameters[PARAM_ANGLE]->interpolate(p.custom[1]);
+			if (!baked_curves[PARAM_ANGLE].empty()) {
+				tex_angle = sample_baked_curve(baked_curves[PARAM_ANGLE], custom[1]);
 			}
 			float tex_anim_speed = 0.0;
-			if (curve_parameters[PARAM_ANIM_SPEED].is_valid()) {
-				tex_anim_speed = curve_parameters[PARAM_ANIM_SPEED]->interpolate(p.custom[1]);
+			if (!baked_curves[PARAM_ANIM_SPEED].empty()) {
+				tex_anim_speed = sample_baked_curve(baked_curves[PARAM_ANIM_SPEED], custom[1]);
 			}
 
 			float tex_anim_offset = 0.0;
-			if (curve_parameters[PARAM_ANIM_OFFSET].is_valid()) {
-				tex_anim_offset = curve_parameters[PARAM_ANIM_OFFSET]->interpolate(p.custom[1]);
+			if (!baked_curves[PARAM_ANIM_OFFSET].empty()) {
+				tex_anim_offset = sample_baked_curve(baked_curves[PARAM_ANIM_OFFSET], custom[1]);
 			}
 
 			Vector2 force = gravity;
-			Vector2 pos = p.transform[2];
+			Vector2 pos = xform[2];
 
 			//apply linear acceleration
-			force += p.velocity.length() > 0.0 ? p.velocity.normalized() * (parameters[PARAM_LINEAR_ACCEL] + tex_linear_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_LINEAR_ACCEL]) : Vector2();
+			force += velocity.length() > 0.0 ? velocity.normalized() * (parameters[PARAM_LINEAR_ACCEL] + tex_linear_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_LINEAR_ACCEL]) : Vector2();
 			//apply radial acceleration
 			Vector2 org = emission_xform[2];
 			Vector2 diff = pos - org;
@@ -838,7 +970,7 @@ void CPUParticles2D::_particles_process(float p_delta) {
 			Vector2 yx = Vector2(diff.y, diff.x);
 			force += yx.length() > 0.0 ? (yx * Vector2(-1.0, 1.0)).normalized() * ((parameters[PARAM_TANGENTIAL_ACCEL] + tex_tangential_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_TANGENTIAL_ACCEL])) : Vector2();
 			//apply attractor forces
-			p.velocity += force * local_delta;
+			velocity += force * local_delta;
 			//orbit velocity
 			float orbit_amount = (parameters[PARAM_ORBIT_VELOCITY] + tex_orbit_velocity) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_ORBIT_VELOCITY]);
 			if (orbit_amount != 0.0) {
@@ -846,130 +978,160 @@ void CPUParticles2D::_particles_process(float p_delta) {
 				// Not sure why the ParticlesMaterial code uses a clockwise rotation matrix,
 				// but we use -ang here to reproduce its behavior.
 				Transform2D rot = Transform2D(-ang, Vector2());
-				p.transform[2] -= diff;
-				p.transform[2] += rot.basis_xform(diff);
+				xform[2] -= diff;
+				xform[2] += rot.basis_xform(diff);
 			}
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				p.velocity = p.velocity.normalized() * tex_linear_velocity;
+			if (!baked_curves[PARAM_INITIAL_LINEAR_VELOCITY].empty()) {
+				velocity = velocity.normalized() * tex_linear_velocity;
 			}
 
 			if (parameters[PARAM_DAMPING] + tex_damping > 0.0) {
-				float v = p.velocity.length();
+				float v = velocity.length();
 				float damp = (parameters[PARAM_DAMPING] + tex_damping) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_DAMPING]);
 				v -= damp * local_delta;
 				if (v < 0.0) {
-					p.velocity = Vector2();
+					velocity = Vector2();
 				} else {
-					p.velocity = p.velocity.normalized() * v;
+					velocity = velocity.normalized() * v;
 				}
 			}
-			float base_angle = (parameters[PARAM_ANGLE] + tex_angle) * Math::lerp(1.0f, p.angle_rand, randomness[PARAM_ANGLE]);
-			base_angle += p.custom[1] * lifetime * (parameters[PARAM_ANGULAR_VELOCITY] + tex_angular_velocity) * Math::lerp(1.0f, rand_from_seed(alt_seed) * 2.0f - 1.0f, randomness[PARAM_ANGULAR_VELOCITY]);
-			p.rotation = Math::deg2rad(base_angle); //angle
-			float animation_phase = (parameters[PARAM_ANIM_OFFSET] + tex_anim_offset) * Math::lerp(1.0f, p.anim_offset_rand, randomness[PARAM_ANIM_OFFSET]) + p.custom[1] * (parameters[PARAM_ANIM_SPEED] + tex_anim_speed) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_ANIM_SPEED]);
-			p.custom[2] = animation_phase;
+			float base_angle = (parameters[PARAM_ANGLE] + tex_angle) * Math::lerp(1.0f, angle_rand, randomness[PARAM_ANGLE]);
+			base_angle += custom[1] * lifetime * (parameters[PARAM_ANGULAR_VELOCITY] + tex_angular_velocity) * Math::lerp(1.0f, rand_from_seed(alt_seed) * 2.0f - 1.0f, randomness[PARAM_ANGULAR_VELOCITY]);
+			rotation = Math::deg2rad(base_angle); //angle
+			float animation_phase = (parameters[PARAM_ANIM_OFFSET] + tex_anim_offset) * Math::lerp(1.0f, anim_offset_rand, randomness[PARAM_ANIM_OFFSET]) + custom[1] * (parameters[PARAM_ANIM_SPEED] + tex_anim_speed) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_ANIM_SPEED]);
+			custom[2] = animation_phase;
 		}
 		//apply color
 		//apply hue rotation
 
 		float tex_scale = 1.0;
-		if (curve_parameters[PARAM_SCALE].is_valid()) {
-			tex_scale = curve_parameters[PARAM_SCALE]->interpolate(p.custom[1]);
+		if (!baked_curves[PARAM_SCALE].empty()) {
+			tex_scale = sample_baked_curve(baked_curves[PARAM_SCALE], custom[1]);
 		}
 
-		float tex_hue_variation = 0.0;
-		if (curve_parameters[PARAM_HUE_VARIATION].is_valid()) {
-			tex_hue_variation = curve_parameters[PARAM_HUE_VARIATION]->interpolate(p.custom[1]);
-		}
+		if (row) {
+			// Only the step that writes the multimesh data needs the color.
+			float tex_hue_variation = 0.0;
+			if (!baked_curves[PARAM_HUE_VARIATION].empty()) {
+				tex_hue_variation = sample_baked_curve(baked_curves[PARAM_HUE_VARIATION], custom[1]);
+			}
 
-		float hue_rot_angle = (parameters[PARAM_HUE_VARIATION] + tex_hue_variation) * Math_PI * 2.0 * Math::lerp(1.0f, p.hue_rot_rand * 2.0f - 1.0f, randomness[PARAM_HUE_VARIATION]);
-		float hue_rot_c = Math::cos(hue_rot_angle);
-		float hue_rot_s = Math::sin(hue_rot_angle);
+			float hue_rot_angle = (parameters[PARAM_HUE_VARIATION] + tex_hue_variation) * Math_PI * 2.0 * Math::lerp(1.0f, hue_rot_rand * 2.0f - 1.0f, randomness[PARAM_HUE_VARIATION]);
+			float hue_rot_c = Math::cos(hue_rot_angle);
+			float hue_rot_s = Math::sin(hue_rot_angle);
 
-		Basis hue_rot_mat;
-		{
-			Basis mat1(0.299, 0.587, 0.114, 0.299, 0.587, 0.114, 0.299, 0.587, 0.114);
-			Basis mat2(0.701, -0.587, -0.114, -0.299, 0.413, -0.114, -0.300, -0.588, 0.886);
-			Basis mat3(0.168, 0.330, -0.497, -0.328, 0.035, 0.292, 1.250, -1.050, -0.203);
+			Basis hue_rot_mat;
+			{
+				Basis mat1(0.299, 0.587, 0.114, 0.299, 0.587, 0.114, 0.299, 0.587, 0.114);
+				Basis mat2(0.701, -0.587, -0.114, -0.299, 0.413, -0.114, -0.300, -0.588, 0.886);
+				Basis mat3(0.168, 0.330, -0.497, -0.328, 0.035, 0.292, 1.250, -1.050, -0.203);
 
-			for (int j = 0; j < 3; j++) {
-				hue_rot_mat[j] = mat1[j] + mat2[j] * hue_rot_c + mat3[j] * hue_rot_s;
+				for (int j = 0; j < 3; j++) {
+					hue_rot_mat[j] = mat1[j] + mat2[j] * hue_rot_c + mat3[j] * hue_rot_s;
+				}
 			}
-		}
 
-		if (color_ramp.is_valid()) {
-			p.color = color_ramp->get_color_at_offset(p.custom[1]) * color;
-		} else {
-			p.color = color;
-		}
+			Color pcolor;
+			if (!baked_color_ramp.empty()) {
+				pcolor = sample_baked_color_ramp(baked_color_ramp, custom[1]) * color;
+			} else {
+				pcolor = color;
+			}
 
-		Vector3 color_rgb = hue_rot_mat.xform_inv(Vector3(p.color.r, p.color.g, p.color.b));
-		p.color.r = color_rgb.x;
-		p.color.g = color_rgb.y;
-		p.color.b = color_rgb.z;
+			Vector3 color_rgb = hue_rot_mat.xform_inv(Vector3(pcolor.r, pcolor.g, pcolor.b));
+			pcolor.r = color_rgb.x;
+			pcolor.g = color_rgb.y;
+			pcolor.b = color_rgb.z;
 
-		p.color *= p.base_color;
+			pcolor *= base_colors[i];
+
+			row[8] = pcolor.r;
+			row[9] = pcolor.g;
+			row[10] = pcolor.b;
+			row[11] = pcolor.a;
+		}
 
 		if (flags[FLAG_ALIGN_Y_TO_VELOCITY]) {
-			if (p.velocity.length() > 0.0) {
-				p.transform.elements[1] = p.velocity.normalized();
-				p.transform.elements[0] = p.transform.elements[1].tangent();
+			if (velocity.length() > 0.0) {
+				xform.elements[1] = velocity.normalized();
+				xform.elements[0] = xform.elements[1].tangent();
 			}
 
 		} else {
-			p.transform.elements[0] = Vector2(Math::cos(p.rotation), -Math::sin(p.rotation));
-			p.transform.elements[1] = Vector2(Math::sin(p.rotation), Math::cos(p.rotation));
+			xform.elements[0] = Vector2(Math::cos(rotation), -Math::sin(rotation));
+			xform.elements[1] = Vector2(Math::sin(rotation), Math::cos(rotation));
 		}
 
 		//scale by scale
-		float base_scale = tex_scale * Math::lerp(parameters[PARAM_SCALE], 1.0f, p.scale_rand * randomness[PARAM_SCALE]);
+		float base_scale = tex_scale * Math::lerp(parameters[PARAM_SCALE], 1.0f, scale_rand * randomness[PARAM_SCALE]);
 		if (base_scale < 0.000001) {
 			base_scale = 0.000001;
 		}
 
-		p.transform.elements[0] *= base_scale;
-		p.transform.elements[1] *= base_scale;
+		xform.elements[0] *= base_scale;
+		xform.elements[1] *= base_scale;
+
+		xform[2] += velocity * local_delta;
+
+		if (row) {
+			if (active) {
+				Transform2D t = local_coords ? xform : inv_emission_transform * xform;
+
+				row[0] = t.elements[0][0];
+				row[1] = t.elements[1][0];
+				row[2] = 0;
+				row[3] = t.elements[2][0];
+				row[4] = t.elements[0][1];
+				row[5] = t.elements[1][1];
+				row[6] = 0;
+				row[7] = t.elements[2][1];
+			} else {
+				zeromem(row, sizeof(float) * 8);
+			}
 
-		p.transform[2] += p.velocity * local_delta;
+			row[12] = custom[0];
+			row[13] = custom[1];
+			row[14] = custom[2];
+			row[15] = custom[3];
+		}
 	}
 }
 
-void CPUParticles2D::_update_particle_data_buffer() {
-	MutexLock lock(update_mutex);
 
-	int pc = particles.size();
+void CPUParticles2D::_sort_particle_data_buffer() {
+	int *order = particle_order.ptrw();
 
-	int *ow;
-	int *order = nullptr;
-
-	float *w = particle_data.ptrw();
-	const Particle *r = particles.ptr();
-	float *ptr = w;
+	for (int i = 0; i < particle_count; i++) {
+		order[i] = i;
+	}
+	if (draw_order == DRAW_ORDER_LIFETIME) {
+		SortArray<int, SortLifetime> sorter;
+		sorter.compare.times = particles.time.ptr();
+		sorter.sort(order, particle_count);
+	}
 
-	if (draw_order != DRAW_ORDER_INDEX) {
-		ow = particle_order.ptrw();
-		order = ow;
+	const float *src = unsorted_particle_data.ptr();
+	float *dst = particle_data.ptrw();
 
-		for (int i = 0; i < pc; i++) {
-			order[i] = i;
-		}
-		if (draw_order == DRAW_ORDER_LIFETIME) {
-			SortArray<int, SortLifetime> sorter;
-			sorter.compare.particles = r;
-			sorter.sort(order, pc);
-		}
+	for (int i = 0; i < particle_count; i++) {
+		memcpy(dst + i * PARTICLE_DATA_STRIDE, src + order[i] * PARTICLE_DATA_STRIDE, sizeof(float) * PARTICLE_DATA_STRIDE);
 	}
+}
 
-	for (int i = 0; i < pc; i++) {
-		int idx = order ? order[i] : i;
+void CPUParticles2D::_write_particle_transforms() {
+	MutexLock lock(update_mutex);
 
-		Transform2D t = r[idx].transform;
+	const int *order = draw_order != DRAW_ORDER_INDEX ? particle_order.ptr() : nullptr;
+	const Transform2D *transforms = particles.transform.ptr();
+	const uint8_t *actives = particles.active.ptr();
+	float *ptr = particle_data.ptrw();
 
-		if (!local_coords) {
-			t = inv_emission_transform * t;
-		}
+	for (int i = 0; i < particle_count; i++) {
+		int idx = order ? order[i] : i;
+
+		if (actives[idx]) {
+			Transform2D t = inv_emission_transform * transforms[idx];
 
-		if (r[idx].active) {
 			ptr[0] = t.elements[0][0];
 			ptr[1] = t.elements[1][0];
 			ptr[2] = 0;
@@ -978,25 +1140,40 @@ void CPUParticles2D::_update_particle_data_buffer() {
 			ptr[5] = t.elements[1][1];
 			ptr[6] = 0;
 			ptr[7] = t.elements[2][1];
-
 		} else {
 			zeromem(ptr, sizeof(float) * 8);
 		}
 
-		Color c = r[idx].color;
+		ptr += PARTICLE_DATA_STRIDE;
+	}
+}
 
-		ptr[8] = c.r;
-		ptr[9] = c.g;
-		ptr[10] = c.b;
-		ptr[11] = c.a;
+void CPUParticles2D::_curves_changed() {
+	baked_curves_dirty = true;
+}
 
-		ptr[12] = r[idx].custom[0];
-		ptr[13] = r[idx].custom[1];
-		ptr[14] = r[idx].custom[2];
-		ptr[15] = r[idx].custom[3];
+void CPUParticles2D::_bake_curves() {
+	for (int i = 0; i < PARAM_MAX; i++) {
+		if (curve_parameters[i].is_null()) {
+			baked_curves[i].clear();
+			continue;
+		}
+		baked_curves[i].resize(CURVE_BAKE_RESOLUTION);
+		for (int j = 0; j < CURVE_BAKE_RESOLUTION; j++) {
+			baked_curves[i][j] = curve_parameters[i]->interpolate(j / float(CURVE_BAKE_RESOLUTION - 1));
+		}
+	}
 
-		ptr += 16;
+	if (color_ramp.is_valid()) {
+		baked_color_ramp.resize(CURVE_BAKE_RESOLUTION);
+		for (int j = 0; j < CURVE_BAKE_RESOLUTION; j++) {
+			baked_color_ramp[j] = color_ramp->get_color_at_offset(j / float(CURVE_BAKE_RESOLUTION - 1));
+		}
+	} else {
+		baked_color_ramp.clear();
 	}
+
+	baked_curves_dirty = false;
 }
 
 void CPUParticles2D::_set_redraw(bool p_redraw) {
@@ -1072,31 +1249,7 @@ void CPUParticles2D::_notification(int p_what) {
 		inv_emission_transform = get_global_transform().affine_inverse();
 
 		if (!local_coords) {
-			int pc = particles.size();
-
-			float *w = particle_data.ptrw();
-			const Particle *r = particles.ptr();
-			float *ptr = w;
-
-			for (int i = 0; i < pc; i++) {
-				Transform2D t = inv_emission_transform * r[i].transform;
-
-				if (r[i].active) {
-					ptr[0] = t.elements[0][0];
-					ptr[1] = t.elements[1][0];
-					ptr[2] = 0;
-					ptr[3] = t.elements[2][0];
-					ptr[4] = t.elements[0][1];
-					ptr[5] = t.elements[1][1];
-					ptr[6] = 0;
-					ptr[7] = t.elements[2][1];
-
-				} else {
-					zeromem(ptr, sizeof(float) * 8);
-				}
-
-				ptr += 16;
-			}
+			_write_particle_transforms();
 		}
 	}
 }
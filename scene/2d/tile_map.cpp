@@ -34,6 +34,7 @@
 #include "core/io/marshalls.h"
 #include "core/method_bind_ext.gen.inc"
 #include "core/os/os.h"
+#include "core/sort_array.h"
 #include "scene/2d/area_2d.h"
 #include "servers/navigation_server_2d.h"
 #include "servers/physics_server_2d.h"
@@ -79,8 +80,8 @@ void TileMap::_notification(int p_what) {
 			for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
 				Quadrant &q = E->get();
 				if (navigation) {
-					for (Map<PosKey, Quadrant::NavPoly>::Element *F = q.navpoly_ids.front(); F; F = F->next()) {
-						NavigationServer2D::get_singleton()->region_set_map(F->get().region, RID());
+					for (uint32_t i = 0; i < q.navpoly_ids.size(); i++) {
+						NavigationServer2D::get_singleton()->region_set_map(q.navpoly_ids[i].region, RID());
 					}
 					q.navpoly_ids.clear();
 				}
@@ -90,8 +91,8 @@ void TileMap::_notification(int p_what) {
 					q.shape_owner_id = -1;
 				}
 
-				for (Map<PosKey, Quadrant::Occluder>::Element *F = q.occluder_instances.front(); F; F = F->next()) {
-					RS::get_singleton()->free(F->get().id);
+				for (uint32_t i = 0; i < q.occluder_instances.size(); i++) {
+					RS::get_singleton()->free(q.occluder_instances[i].id);
 				}
 				q.occluder_instances.clear();
 			}
@@ -119,7 +120,9 @@ void TileMap::_update_quadrant_space(const RID &p_space) {
 	if (!use_parent) {
 		for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
 			Quadrant &q = E->get();
-			PhysicsServer2D::get_singleton()->body_set_space(q.body, p_space);
+			if (q.body.is_valid()) {
+				PhysicsServer2D::get_singleton()->body_set_space(q.body, p_space);
+			}
 		}
 	}
 }
@@ -146,19 +149,19 @@ void TileMap::_update_quadrant_transform() {
 		Transform2D xform;
 		xform.set_origin(q.pos);
 
-		if (!use_parent) {
+		if (!use_parent && q.body.is_valid()) {
 			xform = global_transform * xform;
 			PhysicsServer2D::get_singleton()->body_set_state(q.body, PhysicsServer2D::BODY_STATE_TRANSFORM, xform);
 		}
 
 		if (navigation) {
-			for (Map<PosKey, Quadrant::NavPoly>::Element *F = q.navpoly_ids.front(); F; F = F->next()) {
-				NavigationServer2D::get_singleton()->region_set_transform(F->get().region, nav_rel * F->get().xform);
+			for (uint32_t i = 0; i < q.navpoly_ids.size(); i++) {
+				NavigationServer2D::get_singleton()->region_set_transform(q.navpoly_ids[i].region, nav_rel * q.navpoly_ids[i].xform);
 			}
 		}
 
-		for (Map<PosKey, Quadrant::Occluder>::Element *F = q.occluder_instances.front(); F; F = F->next()) {
-			RS::get_singleton()->canvas_light_occluder_set_transform(F->get().id, global_transform * F->get().xform);
+		for (uint32_t i = 0; i < q.occluder_instances.size(); i++) {
+			RS::get_singleton()->canvas_light_occluder_set_transform(q.occluder_instances[i].id, global_transform * q.occluder_instances[i].xform);
 		}
 	}
 }
@@ -278,10 +281,13 @@ void TileMap::_fix_cell_transform(Transform2D &xform, const Cell &p_cell, const
 	xform.elements[2] += offset;
 }
 
-void TileMap::_add_shape(int &shape_idx, const Quadrant &p_q, const Ref<Shape2D> &p_shape, const TileSet::ShapeData &p_shape_data, const Transform2D &p_xform, const Vector2 &p_metadata) {
+void TileMap::_add_shape(int &shape_idx, Quadrant &p_q, const Ref<Shape2D> &p_shape, const TileSet::ShapeData &p_shape_data, const Transform2D &p_xform, const Vector2 &p_metadata) {
 	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
 
 	if (!use_parent) {
+		if (!p_q.body.is_valid()) {
+			_create_quadrant_body(p_q);
+		}
 		ps->body_add_shape(p_q.body, p_shape->get_rid(), p_xform);
 		ps->body_set_shape_metadata(p_q.body, shape_idx, p_metadata);
 		ps->body_set_shape_as_one_way_collision(p_q.body, shape_idx, p_shape_data.one_way_collision, p_shape_data.one_way_collision_margin);
@@ -342,38 +348,50 @@ void TileMap::update_dirty_quadrants() {
 	while (dirty_quadrant_list.first()) {
 		Quadrant &q = *dirty_quadrant_list.first()->self();
 
-		for (List<RID>::Element *E = q.canvas_items.front(); E; E = E->next()) {
-			vs->free(E->get());
-		}
+		// Debug drawing hangs off the canvas items, so it needs everything rebuilt together.
+		uint32_t layers = (debug_shapes || debug_navigation) ? (uint32_t)LAYER_ALL : q.dirty_layers;
+		q.dirty_layers = 0;
 
-		q.canvas_items.clear();
+		if (layers & LAYER_CANVAS) {
+			for (List<RID>::Element *E = q.canvas_items.front(); E; E = E->next()) {
+				vs->free(E->get());
+			}
 
-		if (!use_parent) {
-			ps->body_clear_shapes(q.body);
-		} else if (collision_parent) {
-			collision_parent->shape_owner_clear_shapes(q.shape_owner_id);
+			q.canvas_items.clear();
+		}
+
+		if (layers & LAYER_PHYSICS) {
+			if (!use_parent) {
+				if (q.body.is_valid()) {
+					ps->body_clear_shapes(q.body);
+				}
+			} else if (collision_parent) {
+				collision_parent->shape_owner_clear_shapes(q.shape_owner_id);
+			}
 		}
 		int shape_idx = 0;
 
-		if (navigation) {
-			for (Map<PosKey, Quadrant::NavPoly>::Element *E = q.navpoly_ids.front(); E; E = E->next()) {
-				NavigationServer2D::get_singleton()->region_set_map(E->get().region, RID());
+		if (navigation && (layers & LAYER_NAVIGATION)) {
+			for (uint32_t i = 0; i < q.navpoly_ids.size(); i++) {
+				NavigationServer2D::get_singleton()->region_set_map(q.navpoly_ids[i].region, RID());
 			}
 			q.navpoly_ids.clear();
 		}
 
-		for (Map<PosKey, Quadrant::Occluder>::Element *E = q.occluder_instances.front(); E; E = E->next()) {
-			RS::get_singleton()->free(E->get().id);
+		if (layers & LAYER_OCCLUDERS) {
+			for (uint32_t i = 0; i < q.occluder_instances.size(); i++) {
+				RS::get_singleton()->free(q.occluder_instances[i].id);
+			}
+			q.occluder_instances.clear();
 		}
-		q.occluder_instances.clear();
 		Ref<ShaderMaterial> prev_material;
 		int prev_z_index = 0;
 		RID prev_canvas_item;
 		RID prev_debug_canvas_item;
 
 		for (int i = 0; i < q.cells.size(); i++) {
-			Map<PosKey, Cell>::Element *E = tile_map.find(q.cells[i]);
-			Cell &c = E->get();
+			const PosKey &pk = q.cells[i];
+			const Cell &c = *_get_cell(pk);
 			//moment of truth
 			if (!tile_set->has_tile(c.id)) {
 				continue;
@@ -381,56 +399,58 @@ void TileMap::update_dirty_quadrants() {
 			Ref<Texture2D> tex = tile_set->tile_get_texture(c.id);
 			Vector2 tile_ofs = tile_set->tile_get_texture_offset(c.id);
 
-			Vector2 wofs = _map_to_world(E->key().x, E->key().y);
+			Vector2 wofs = _map_to_world(pk.x, pk.y);
 			Vector2 offset = wofs - q.pos + tofs;
 
 			if (!tex.is_valid()) {
 				continue;
 			}
 
-			Ref<ShaderMaterial> mat = tile_set->tile_get_material(c.id);
-			int z_index = tile_set->tile_get_z_index(c.id);
-
-			if (tile_set->tile_get_tile_mode(c.id) == TileSet::AUTO_TILE ||
-					tile_set->tile_get_tile_mode(c.id) == TileSet::ATLAS_TILE) {
-				z_index += tile_set->autotile_get_z_index(c.id, Vector2(c.autotile_coord_x, c.autotile_coord_y));
-			}
-
 			RID canvas_item;
 			RID debug_canvas_item;
 
-			if (prev_canvas_item == RID() || prev_material != mat || prev_z_index != z_index) {
-				canvas_item = vs->canvas_item_create();
-				if (mat.is_valid()) {
-					vs->canvas_item_set_material(canvas_item, mat->get_rid());
-				}
-				vs->canvas_item_set_parent(canvas_item, get_canvas_item());
-				_update_item_material_state(canvas_item);
-				Transform2D xform;
-				xform.set_origin(q.pos);
-				vs->canvas_item_set_transform(canvas_item, xform);
-				vs->canvas_item_set_light_mask(canvas_item, get_light_mask());
-				vs->canvas_item_set_z_index(canvas_item, z_index);
-
-				q.canvas_items.push_back(canvas_item);
-
-				if (debug_shapes) {
-					debug_canvas_item = vs->canvas_item_create();
-					vs->canvas_item_set_parent(debug_canvas_item, canvas_item);
-					vs->canvas_item_set_z_as_relative_to_parent(debug_canvas_item, false);
-					vs->canvas_item_set_z_index(debug_canvas_item, RS::CANVAS_ITEM_Z_MAX - 1);
-					q.canvas_items.push_back(debug_canvas_item);
-					prev_debug_canvas_item = debug_canvas_item;
+			if (layers & LAYER_CANVAS) {
+				Ref<ShaderMaterial> mat = tile_set->tile_get_material(c.id);
+				int z_index = tile_set->tile_get_z_index(c.id);
+
+				if (tile_set->tile_get_tile_mode(c.id) == TileSet::AUTO_TILE ||
+						tile_set->tile_get_tile_mode(c.id) == TileSet::ATLAS_TILE) {
+					z_index += tile_set->autotile_get_z_index(c.id, Vector2(c.autotile_coord_x, c.autotile_coord_y));
 				}
 
-				prev_canvas_item = canvas_item;
-				prev_material = mat;
-				prev_z_index = z_index;
+				if (prev_canvas_item == RID() || prev_material != mat || prev_z_index != z_index) {
+					canvas_item = vs->canvas_item_create();
+					if (mat.is_valid()) {
+						vs->canvas_item_set_material(canvas_item, mat->get_rid());
+					}
+					vs->canvas_item_set_parent(canvas_item, get_canvas_item());
+					_update_item_material_state(canvas_item);
+					Transform2D xform;
+					xform.set_origin(q.pos);
+					vs->canvas_item_set_transform(canvas_item, xform);
+					vs->canvas_item_set_light_mask(canvas_item, get_light_mask());
+					vs->canvas_item_set_z_index(canvas_item, z_index);
+
+					q.canvas_items.push_back(canvas_item);
+
+					if (debug_shapes) {
+						debug_canvas_item = vs->canvas_item_create();
+						vs->canvas_item_set_parent(debug_canvas_item, canvas_item);
+						vs->canvas_item_set_z_as_relative_to_parent(debug_canvas_item, false);
+						vs->canvas_item_set_z_index(debug_canvas_item, RS::CANVAS_ITEM_Z_MAX - 1);
+						q.canvas_items.push_back(debug_canvas_item);
+						prev_debug_canvas_item = debug_canvas_item;
+					}
+
+					prev_canvas_item = canvas_item;
+					prev_material = mat;
+					prev_z_index = z_index;
 
-			} else {
-				canvas_item = prev_canvas_item;
-				if (debug_shapes) {
-					debug_canvas_item = prev_debug_canvas_item;
+				} else {
+					canvas_item = prev_canvas_item;
+					if (debug_shapes) {
+						debug_canvas_item = prev_debug_canvas_item;
+					}
 				}
 			}
 
@@ -448,129 +468,133 @@ void TileMap::update_dirty_quadrants() {
 				s = r.size;
 			}
 
-			Rect2 rect;
-			rect.position = offset.floor();
-			rect.size = s;
-			rect.size.x += fp_adjust;
-			rect.size.y += fp_adjust;
-
-			if (compatibility_mode && !centered_textures) {
-				if (rect.size.y > rect.size.x) {
-					if ((c.flip_h && (c.flip_v || c.transpose)) || (c.flip_v && !c.transpose)) {
-						tile_ofs.y += rect.size.y - rect.size.x;
+			if (layers & LAYER_CANVAS) {
+				Rect2 rect;
+				rect.position = offset.floor();
+				rect.size = s;
+				rect.size.x += fp_adjust;
+				rect.size.y += fp_adjust;
+
+				if (compatibility_mode && !centered_textures) {
+					if (rect.size.y > rect.size.x) {
+						if ((c.flip_h && (c.flip_v || c.transpose)) || (c.flip_v && !c.transpose)) {
+							tile_ofs.y += rect.size.y - rect.size.x;
+						}
+					} else if (rect.size.y < rect.size.x) {
+						if ((c.flip_v && (c.flip_h || c.transpose)) || (c.flip_h && !c.transpose)) {
+							tile_ofs.x += rect.size.x - rect.size.y;
+						}
 					}
-				} else if (rect.size.y < rect.size.x) {
-					if ((c.flip_v && (c.flip_h || c.transpose)) || (c.flip_h && !c.transpose)) {
-						tile_ofs.x += rect.size.x - rect.size.y;
+				}
+
+				if (c.transpose) {
+					SWAP(tile_ofs.x, tile_ofs.y);
+					if (centered_textures) {
+						rect.position.x += cell_size.x / 2 - rect.size.y / 2;
+						rect.position.y += cell_size.y / 2 - rect.size.x / 2;
 					}
+				} else if (centered_textures) {
+					rect.position += cell_size / 2 - rect.size / 2;
 				}
-			}
 
-			if (c.transpose) {
-				SWAP(tile_ofs.x, tile_ofs.y);
-				if (centered_textures) {
-					rect.position.x += cell_size.x / 2 - rect.size.y / 2;
-					rect.position.y += cell_size.y / 2 - rect.size.x / 2;
+				if (c.flip_h) {
+					rect.size.x = -rect.size.x;
+					tile_ofs.x = -tile_ofs.x;
 				}
-			} else if (centered_textures) {
-				rect.position += cell_size / 2 - rect.size / 2;
-			}
 
-			if (c.flip_h) {
-				rect.size.x = -rect.size.x;
-				tile_ofs.x = -tile_ofs.x;
-			}
+				if (c.flip_v) {
+					rect.size.y = -rect.size.y;
+					tile_ofs.y = -tile_ofs.y;
+				}
 
-			if (c.flip_v) {
-				rect.size.y = -rect.size.y;
-				tile_ofs.y = -tile_ofs.y;
-			}
+				if (compatibility_mode && !centered_textures) {
+					if (tile_origin == TILE_ORIGIN_TOP_LEFT) {
+						rect.position += tile_ofs;
 
-			if (compatibility_mode && !centered_textures) {
-				if (tile_origin == TILE_ORIGIN_TOP_LEFT) {
-					rect.position += tile_ofs;
+					} else if (tile_origin == TILE_ORIGIN_BOTTOM_LEFT) {
+						rect.position += tile_ofs;
 
-				} else if (tile_origin == TILE_ORIGIN_BOTTOM_LEFT) {
-					rect.position += tile_ofs;
+						if (c.transpose) {
+							if (c.flip_h) {
+								rect.position.x -= cell_size.x;
+							} else {
+								rect.position.x += cell_size.x;
+							}
+						} else {
+							if (c.flip_v) {
+								rect.position.y -= cell_size.y;
+							} else {
+								rect.position.y += cell_size.y;
+							}
+						}
+
+					} else if (tile_origin == TILE_ORIGIN_CENTER) {
+						rect.position += tile_ofs;
 
-					if (c.transpose) {
 						if (c.flip_h) {
-							rect.position.x -= cell_size.x;
+							rect.position.x -= cell_size.x / 2;
 						} else {
-							rect.position.x += cell_size.x;
+							rect.position.x += cell_size.x / 2;
 						}
-					} else {
+
 						if (c.flip_v) {
-							rect.position.y -= cell_size.y;
+							rect.position.y -= cell_size.y / 2;
 						} else {
-							rect.position.y += cell_size.y;
+							rect.position.y += cell_size.y / 2;
 						}
 					}
-
-				} else if (tile_origin == TILE_ORIGIN_CENTER) {
+				} else {
 					rect.position += tile_ofs;
-
-					if (c.flip_h) {
-						rect.position.x -= cell_size.x / 2;
-					} else {
-						rect.position.x += cell_size.x / 2;
-					}
-
-					if (c.flip_v) {
-						rect.position.y -= cell_size.y / 2;
-					} else {
-						rect.position.y += cell_size.y / 2;
-					}
 				}
-			} else {
-				rect.position += tile_ofs;
-			}
 
-			Ref<Texture2D> normal_map = tile_set->tile_get_normal_map(c.id);
-			Color modulate = tile_set->tile_get_modulate(c.id);
-			Color self_modulate = get_self_modulate();
-			modulate = Color(modulate.r * self_modulate.r, modulate.g * self_modulate.g,
-					modulate.b * self_modulate.b, modulate.a * self_modulate.a);
-			if (r == Rect2()) {
-				tex->draw_rect(canvas_item, rect, false, modulate, c.transpose, normal_map);
-			} else {
-				tex->draw_rect_region(canvas_item, rect, r, modulate, c.transpose, normal_map, Ref<Texture2D>(), Color(1, 1, 1, 1), RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT, RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT, clip_uv);
+				Ref<Texture2D> normal_map = tile_set->tile_get_normal_map(c.id);
+				Color modulate = tile_set->tile_get_modulate(c.id);
+				Color self_modulate = get_self_modulate();
+				modulate = Color(modulate.r * self_modulate.r, modulate.g * self_modulate.g,
+						modulate.b * self_modulate.b, modulate.a * self_modulate.a);
+				if (r == Rect2()) {
+					tex->draw_rect(canvas_item, rect, false, modulate, c.transpose, normal_map);
+				} else {
+					tex->draw_rect_region(canvas_item, rect, r, modulate, c.transpose, normal_map, Ref<Texture2D>(), Color(1, 1, 1, 1), RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT, RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT, clip_uv);
+				}
 			}
 
-			Vector<TileSet::ShapeData> shapes = tile_set->tile_get_shapes(c.id);
+			if (layers & LAYER_PHYSICS) {
+				Vector<TileSet::ShapeData> shapes = tile_set->tile_get_shapes(c.id);
 
-			for (int j = 0; j < shapes.size(); j++) {
-				Ref<Shape2D> shape = shapes[j].shape;
-				if (shape.is_valid()) {
-					if (tile_set->tile_get_tile_mode(c.id) == TileSet::SINGLE_TILE || (shapes[j].autotile_coord.x == c.autotile_coord_x && shapes[j].autotile_coord.y == c.autotile_coord_y)) {
-						Transform2D xform;
-						xform.set_origin(offset.floor());
+				for (int j = 0; j < shapes.size(); j++) {
+					Ref<Shape2D> shape = shapes[j].shape;
+					if (shape.is_valid()) {
+						if (tile_set->tile_get_tile_mode(c.id) == TileSet::SINGLE_TILE || (shapes[j].autotile_coord.x == c.autotile_coord_x && shapes[j].autotile_coord.y == c.autotile_coord_y)) {
+							Transform2D xform;
+							xform.set_origin(offset.floor());
 
-						Vector2 shape_ofs = shapes[j].shape_transform.get_origin();
+							Vector2 shape_ofs = shapes[j].shape_transform.get_origin();
 
-						_fix_cell_transform(xform, c, shape_ofs, s);
+							_fix_cell_transform(xform, c, shape_ofs, s);
 
-						xform *= shapes[j].shape_transform.untranslated();
+							xform *= shapes[j].shape_transform.untranslated();
 
-						if (debug_canvas_item.is_valid()) {
-							vs->canvas_item_add_set_transform(debug_canvas_item, xform);
-							shape->draw(debug_canvas_item, debug_collision_color);
-						}
+							if (debug_canvas_item.is_valid()) {
+								vs->canvas_item_add_set_transform(debug_canvas_item, xform);
+								shape->draw(debug_canvas_item, debug_collision_color);
+							}
 
-						if (shape->has_meta("decomposed")) {
-							Array _shapes = shape->get_meta("decomposed");
-							for (int k = 0; k < _shapes.size(); k++) {
-								Ref<ConvexPolygonShape2D> convex = _shapes[k];
-								if (convex.is_valid()) {
-									_add_shape(shape_idx, q, convex, shapes[j], xform, Vector2(E->key().x, E->key().y));
-#ifdef DEBUG_ENABLED
-								} else {
-									print_error("The TileSet assigned to the TileMap " + get_name() + " has an invalid convex shape.");
-#endif
+							if (shape->has_meta("decomposed")) {
+								Array _shapes = shape->get_meta("decomposed");
+								for (int k = 0; k < _shapes.size(); k++) {
+									Ref<ConvexPolygonShape2D> convex = _shapes[k];
+									if (convex.is_valid()) {
+										_add_shape(shape_idx, q, convex, shapes[j], xform, Vector2(pk.x, pk.y));
+	#ifdef DEBUG_ENABLED
+									} else {
+										print_error("The TileSet assigned to the TileMap " + get_name() + " has an invalid convex shape.");
+	#endif
+									}
 								}
+							} else {
+								_add_shape(shape_idx, q, shape, shapes[j], xform, Vector2(pk.x, pk.y));
 							}
-						} else {
-							_add_shape(shape_idx, q, shape, shapes[j], xform, Vector2(E->key().x, E->key().y));
 						}
 					}
 				}
@@ -580,7 +604,7 @@ void TileMap::update_dirty_quadrants() {
 				vs->canvas_item_add_set_transform(debug_canvas_item, Transform2D());
 			}
 
-			if (navigation) {
+			if (navigation && (layers & LAYER_NAVIGATION)) {
 				Ref<NavigationPolygon> navpoly;
 				Vector2 npoly_ofs;
 				if (tile_set->tile_get_tile_mode(c.id) == TileSet::AUTO_TILE || tile_set->tile_get_tile_mode(c.id) == TileSet::ATLAS_TILE) {
@@ -604,7 +628,7 @@ void TileMap::update_dirty_quadrants() {
 					Quadrant::NavPoly np;
 					np.region = region;
 					np.xform = xform;
-					q.navpoly_ids[E->key()] = np;
+					q.navpoly_ids.push_back(np);
 
 					if (debug_navigation) {
 						RID debug_navigation_item = vs->canvas_item_create();
@@ -655,32 +679,42 @@ void TileMap::update_dirty_quadrants() {
 				}
 			}
 
-			Ref<OccluderPolygon2D> occluder;
-			if (tile_set->tile_get_tile_mode(c.id) == TileSet::AUTO_TILE || tile_set->tile_get_tile_mode(c.id) == TileSet::ATLAS_TILE) {
-				occluder = tile_set->autotile_get_light_occluder(c.id, Vector2(c.autotile_coord_x, c.autotile_coord_y));
-			} else {
-				occluder = tile_set->tile_get_light_occluder(c.id);
-			}
-			if (occluder.is_valid()) {
-				Vector2 occluder_ofs = tile_set->tile_get_occluder_offset(c.id);
-				Transform2D xform;
-				xform.set_origin(offset.floor() + q.pos);
-				_fix_cell_transform(xform, c, occluder_ofs, s);
-
-				RID orid = RS::get_singleton()->canvas_light_occluder_create();
-				RS::get_singleton()->canvas_light_occluder_set_transform(orid, get_global_transform() * xform);
-				RS::get_singleton()->canvas_light_occluder_set_polygon(orid, occluder->get_rid());
-				RS::get_singleton()->canvas_light_occluder_attach_to_canvas(orid, get_canvas());
-				RS::get_singleton()->canvas_light_occluder_set_light_mask(orid, occluder_light_mask);
-				Quadrant::Occluder oc;
-				oc.xform = xform;
-				oc.id = orid;
-				q.occluder_instances[E->key()] = oc;
+			if (layers & LAYER_OCCLUDERS) {
+				Ref<OccluderPolygon2D> occluder;
+				if (tile_set->tile_get_tile_mode(c.id) == TileSet::AUTO_TILE || tile_set->tile_get_tile_mode(c.id) == TileSet::ATLAS_TILE) {
+					occluder = tile_set->autotile_get_light_occluder(c.id, Vector2(c.autotile_coord_x, c.autotile_coord_y));
+				} else {
+					occluder = tile_set->tile_get_light_occluder(c.id);
+				}
+				if (occluder.is_valid()) {
+					Vector2 occluder_ofs = tile_set->tile_get_occluder_offset(c.id);
+					Transform2D xform;
+					xform.set_origin(offset.floor() + q.pos);
+					_fix_cell_transform(xform, c, occluder_ofs, s);
+
+					RID orid = RS::get_singleton()->canvas_light_occluder_create();
+					RS::get_singleton()->canvas_light_occluder_set_transform(orid, get_global_transform() * xform);
+					RS::get_singleton()->canvas_light_occluder_set_polygon(orid, occluder->get_rid());
+					RS::get_singleton()->canvas_light_occluder_attach_to_canvas(orid, get_canvas());
+					RS::get_singleton()->canvas_light_occluder_set_light_mask(orid, occluder_light_mask);
+					Quadrant::Occluder oc;
+					oc.xform = xform;
+					oc.id = orid;
+					q.occluder_instances.push_back(oc);
+				}
 			}
 		}
 
+		if ((layers & LAYER_PHYSICS) && !use_parent && shape_idx == 0 && q.body.is_valid()) {
+			// No collision left in this quadrant, don't keep an empty body around.
+			// Shapes are only counted when they were rebuilt, the body is kept otherwise.
+			ps->free(q.body);
+			q.body = RID();
+		}
 		dirty_quadrant_list.remove(dirty_quadrant_list.first());
-		quadrant_order_dirty = true;
+		if (layers & LAYER_CANVAS) {
+			quadrant_order_dirty = true;
+		}
 	}
 
 	pending_update = false;
@@ -744,22 +778,8 @@ Map<TileMap::PosKey, TileMap::Quadrant>::Element *TileMap::_create_quadrant(cons
 	xform.set_origin(q.pos);
 	//q.canvas_item = RenderingServer::get_singleton()->canvas_item_create();
 	if (!use_parent) {
-		q.body = PhysicsServer2D::get_singleton()->body_create();
-		PhysicsServer2D::get_singleton()->body_set_mode(q.body, use_kinematic ? PhysicsServer2D::BODY_MODE_KINEMATIC : PhysicsServer2D::BODY_MODE_STATIC);
-
-		PhysicsServer2D::get_singleton()->body_attach_object_instance_id(q.body, get_instance_id());
-		PhysicsServer2D::get_singleton()->body_set_collision_layer(q.body, collision_layer);
-		PhysicsServer2D::get_singleton()->body_set_collision_mask(q.body, collision_mask);
-		PhysicsServer2D::get_singleton()->body_set_param(q.body, PhysicsServer2D::BODY_PARAM_FRICTION, friction);
-		PhysicsServer2D::get_singleton()->body_set_param(q.body, PhysicsServer2D::BODY_PARAM_BOUNCE, bounce);
-
-		if (is_inside_tree()) {
-			xform = get_global_transform() * xform;
-			RID space = get_world_2d()->get_space();
-			PhysicsServer2D::get_singleton()->body_set_space(q.body, space);
-		}
-
-		PhysicsServer2D::get_singleton()->body_set_state(q.body, PhysicsServer2D::BODY_STATE_TRANSFORM, xform);
+		// The body is created with the first shape, see _add_shape().
+		q.shape_owner_id = -1;
 	} else if (collision_parent) {
 		xform = get_transform() * xform;
 		q.shape_owner_id = collision_parent->create_shape_owner(this);
@@ -772,10 +792,34 @@ Map<TileMap::PosKey, TileMap::Quadrant>::Element *TileMap::_create_quadrant(cons
 	return quadrant_map.insert(p_qk, q);
 }
 
+void TileMap::_create_quadrant_body(Quadrant &p_q) {
+	Transform2D xform;
+	xform.set_origin(p_q.pos);
+
+	p_q.body = PhysicsServer2D::get_singleton()->body_create();
+	PhysicsServer2D::get_singleton()->body_set_mode(p_q.body, use_kinematic ? PhysicsServer2D::BODY_MODE_KINEMATIC : PhysicsServer2D::BODY_MODE_STATIC);
+
+	PhysicsServer2D::get_singleton()->body_attach_object_instance_id(p_q.body, get_instance_id());
+	PhysicsServer2D::get_singleton()->body_set_collision_layer(p_q.body, collision_layer);
+	PhysicsServer2D::get_singleton()->body_set_collision_mask(p_q.body, collision_mask);
+	PhysicsServer2D::get_singleton()->body_set_param(p_q.body, PhysicsServer2D::BODY_PARAM_FRICTION, friction);
+	PhysicsServer2D::get_singleton()->body_set_param(p_q.body, PhysicsServer2D::BODY_PARAM_BOUNCE, bounce);
+
+	if (is_inside_tree()) {
+		xform = get_global_transform() * xform;
+		RID space = get_world_2d()->get_space();
+		PhysicsServer2D::get_singleton()->body_set_space(p_q.body, space);
+	}
+
+	PhysicsServer2D::get_singleton()->body_set_state(p_q.body, PhysicsServer2D::BODY_STATE_TRANSFORM, xform);
+}
+
 void TileMap::_erase_quadrant(Map<PosKey, Quadrant>::Element *Q) {
 	Quadrant &q = Q->get();
 	if (!use_parent) {
-		PhysicsServer2D::get_singleton()->free(q.body);
+		if (q.body.is_valid()) {
+			PhysicsServer2D::get_singleton()->free(q.body);
+		}
 	} else if (collision_parent) {
 		collision_parent->remove_shape_owner(q.shape_owner_id);
 	}
@@ -789,14 +833,14 @@ void TileMap::_erase_quadrant(Map<PosKey, Quadrant>::Element *Q) {
 	}
 
 	if (navigation) {
-		for (Map<PosKey, Quadrant::NavPoly>::Element *E = q.navpoly_ids.front(); E; E = E->next()) {
-			NavigationServer2D::get_singleton()->region_set_map(E->get().region, RID());
+		for (uint32_t i = 0; i < q.navpoly_ids.size(); i++) {
+			NavigationServer2D::get_singleton()->region_set_map(q.navpoly_ids[i].region, RID());
 		}
 		q.navpoly_ids.clear();
 	}
 
-	for (Map<PosKey, Quadrant::Occluder>::Element *E = q.occluder_instances.front(); E; E = E->next()) {
-		RS::get_singleton()->free(E->get().id);
+	for (uint32_t i = 0; i < q.occluder_instances.size(); i++) {
+		RS::get_singleton()->free(q.occluder_instances[i].id);
 	}
 	q.occluder_instances.clear();
 
@@ -804,8 +848,9 @@ void TileMap::_erase_quadrant(Map<PosKey, Quadrant>::Element *Q) {
 	rect_cache_dirty = true;
 }
 
-void TileMap::_make_quadrant_dirty(Map<PosKey, Quadrant>::Element *Q, bool update) {
+void TileMap::_make_quadrant_dirty(Map<PosKey, Quadrant>::Element *Q, bool update, uint32_t p_layers) {
 	Quadrant &q = Q->get();
+	q.dirty_layers |= p_layers;
 	if (!q.dirty_list.in_list()) {
 		dirty_quadrant_list.add(&q.dirty_list);
 	}
@@ -834,62 +879,204 @@ void TileMap::_set_celld(const Vector2 &p_pos, const Dictionary &p_data) {
 	call("set_cell", args, 7, ce);
 }
 
-void TileMap::set_cell(int p_x, int p_y, int p_tile, bool p_flip_x, bool p_flip_y, bool p_transpose, Vector2 p_autotile_coord) {
-	PosKey pk(p_x, p_y);
+const TileMap::Cell *TileMap::_get_cell(const PosKey &p_pk) const {
+	const CellChunk *chunk = cell_chunks.getptr(p_pk.to_chunk());
+	if (!chunk) {
+		return nullptr;
+	}
+
+	const Cell *cell = &chunk->cells[p_pk.chunk_index()];
+	return cell->id == INVALID_CELL ? nullptr : cell;
+}
+
+TileMap::Cell *TileMap::_get_cell(const PosKey &p_pk) {
+	return const_cast<Cell *>(static_cast<const TileMap *>(this)->_get_cell(p_pk));
+}
+
+void TileMap::_get_used_cells_sorted(LocalVector<PosKey> &r_cells) const {
+	r_cells.clear();
+	r_cells.reserve(cell_count);
+
+	LocalVector<PosKey> chunk_keys;
+	chunk_keys.reserve(cell_chunks.size());
+	const PosKey *K = nullptr;
+	while ((K = cell_chunks.next(K))) {
+		chunk_keys.push_back(*K);
+	}
+
+	if (chunk_keys.empty()) {
+		return;
+	}
+
+	SortArray<PosKey> sorter;
+	sorter.sort(chunk_keys.ptr(), chunk_keys.size());
+
+	// Walk each row of chunks line by line, which yields cells ordered by y, then x.
+	uint32_t row_begin = 0;
+	while (row_begin < chunk_keys.size()) {
+		uint32_t row_end = row_begin + 1;
+		while (row_end < chunk_keys.size() && chunk_keys[row_end].y == chunk_keys[row_begin].y) {
+			row_end++;
+		}
+
+		for (int ly = 0; ly < CHUNK_SIZE; ly++) {
+			for (uint32_t i = row_begin; i < row_end; i++) {
+				const PosKey &ck = chunk_keys[i];
+				const CellChunk *chunk = cell_chunks.getptr(ck);
+				const Cell *cells = &chunk->cells[ly << CHUNK_SHIFT];
+				for (int lx = 0; lx < CHUNK_SIZE; lx++) {
+					if (cells[lx].id != INVALID_CELL) {
+						r_cells.push_back(PosKey(ck.x * CHUNK_SIZE + lx, ck.y * CHUNK_SIZE + ly));
+					}
+				}
+			}
+		}
+
+		row_begin = row_end;
+	}
+}
+
+uint32_t TileMap::_get_cell_layers(const Cell &p_cell) const {
+	if (!tile_set.is_valid() || !tile_set->has_tile(p_cell.id)) {
+		return LAYER_CANVAS;
+	}
+
+	uint32_t layers = LAYER_CANVAS;
+
+	if (tile_set->tile_get_shape_count(p_cell.id) > 0) {
+		layers |= LAYER_PHYSICS;
+	}
+
+	Ref<NavigationPolygon> navpoly;
+	Ref<OccluderPolygon2D> occluder;
+	if (tile_set->tile_get_tile_mode(p_cell.id) == TileSet::AUTO_TILE || tile_set->tile_get_tile_mode(p_cell.id) == TileSet::ATLAS_TILE) {
+		Vector2 coord(p_cell.autotile_coord_x, p_cell.autotile_coord_y);
+		navpoly = tile_set->autotile_get_navigation_polygon(p_cell.id, coord);
+		occluder = tile_set->autotile_get_light_occluder(p_cell.id, coord);
+	} else {
+		navpoly = tile_set->tile_get_navigation_polygon(p_cell.id);
+		occluder = tile_set->tile_get_light_occluder(p_cell.id);
+	}
+
+	if (navpoly.is_valid()) {
+		layers |= LAYER_NAVIGATION;
+	}
+	if (occluder.is_valid()) {
+		layers |= LAYER_OCCLUDERS;
+	}
+
+	return layers;
+}
+
+void TileMap::_set_cell(const PosKey &p_pk, int p_tile, bool p_flip_x, bool p_flip_y, bool p_transpose, int16_t p_autotile_x, int16_t p_autotile_y, CellWriteCache &r_cache) {
+	PosKey ck = p_pk.to_chunk();
+	if (!r_cache.chunk || !(r_cache.chunk_key == ck)) {
+		r_cache.chunk = cell_chunks.getptr(ck);
+		r_cache.chunk_key = ck;
+	}
 
-	Map<PosKey, Cell>::Element *E = tile_map.find(pk);
-	if (!E && p_tile == INVALID_CELL) {
+	CellChunk *chunk = r_cache.chunk;
+	Cell *cell = chunk ? &chunk->cells[p_pk.chunk_index()] : nullptr;
+	bool exists = cell && cell->id != INVALID_CELL;
+	if (!exists && p_tile == INVALID_CELL) {
 		return; //nothing to do
 	}
 
-	PosKey qk = pk.to_quadrant(_get_quadrant_size());
+	PosKey qk = p_pk.to_quadrant(_get_quadrant_size());
+	if (!r_cache.quadrant || !(r_cache.quadrant_key == qk)) {
+		r_cache.quadrant = quadrant_map.find(qk);
+		r_cache.quadrant_key = qk;
+	}
+
+	Map<PosKey, Quadrant>::Element *Q = r_cache.quadrant;
+
 	if (p_tile == INVALID_CELL) {
 		//erase existing
-		tile_map.erase(pk);
-		Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
 		ERR_FAIL_COND(!Q);
+		uint32_t layers = _get_cell_layers(*cell);
+
+		*cell = Cell();
+		cell->id = INVALID_CELL;
+		cell_count--;
+		chunk->used--;
+		if (chunk->used == 0) {
+			cell_chunks.erase(ck);
+			r_cache.chunk = nullptr;
+		}
+
 		Quadrant &q = Q->get();
-		q.cells.erase(pk);
+		q.cells.erase(p_pk);
 		if (q.cells.size() == 0) {
 			_erase_quadrant(Q);
+			r_cache.quadrant = nullptr;
 		} else {
-			_make_quadrant_dirty(Q);
+			_make_quadrant_dirty(Q, true, layers);
 		}
 
 		used_size_cache_dirty = true;
 		return;
 	}
 
-	Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
+	uint32_t layers = 0;
+
+	if (!exists) {
+		if (!chunk) {
+			chunk = &cell_chunks.set(ck, CellChunk())->value();
+			r_cache.chunk = chunk;
+		}
+		cell = &chunk->cells[p_pk.chunk_index()];
+		chunk->used++;
+		cell_count++;
 
-	if (!E) {
-		E = tile_map.insert(pk, Cell());
 		if (!Q) {
 			Q = _create_quadrant(qk);
+			r_cache.quadrant = Q;
 		}
 		Quadrant &q = Q->get();
-		q.cells.insert(pk);
+		q.cells.insert(p_pk);
 	} else {
 		ERR_FAIL_COND(!Q); // quadrant should exist...
 
-		if (E->get().id == p_tile && E->get().flip_h == p_flip_x && E->get().flip_v == p_flip_y && E->get().transpose == p_transpose && E->get().autotile_coord_x == (uint16_t)p_autotile_coord.x && E->get().autotile_coord_y == (uint16_t)p_autotile_coord.y) {
+		if (cell->id == p_tile && cell->flip_h == p_flip_x && cell->flip_v == p_flip_y && cell->transpose == p_transpose && cell->autotile_coord_x == p_autotile_x && cell->autotile_coord_y == p_autotile_y) {
 			return; //nothing changed
 		}
+
+		// Whatever the old tile contributed has to go as well.
+		layers = _get_cell_layers(*cell);
 	}
 
-	Cell &c = E->get();
+	Cell &c = *cell;
 
 	c.id = p_tile;
 	c.flip_h = p_flip_x;
 	c.flip_v = p_flip_y;
 	c.transpose = p_transpose;
-	c.autotile_coord_x = (uint16_t)p_autotile_coord.x;
-	c.autotile_coord_y = (uint16_t)p_autotile_coord.y;
+	c.autotile_coord_x = p_autotile_x;
+	c.autotile_coord_y = p_autotile_y;
 
-	_make_quadrant_dirty(Q);
+	_make_quadrant_dirty(Q, true, layers | _get_cell_layers(c));
 	used_size_cache_dirty = true;
 }
 
+void TileMap::set_cell(int p_x, int p_y, int p_tile, bool p_flip_x, bool p_flip_y, bool p_transpose, Vector2 p_autotile_coord) {
+	CellWriteCache cache;
+	_set_cell(PosKey(p_x, p_y), p_tile, p_flip_x, p_flip_y, p_transpose, (int16_t)p_autotile_coord.x, (int16_t)p_autotile_coord.y, cache);
+}
+
+void TileMap::set_cells(const Vector<Vector2> &p_positions, const Vector<int32_t> &p_tiles) {
+	ERR_FAIL_COND_MSG(p_tiles.size() != 1 && p_tiles.size() != p_positions.size(), "The tiles array must either hold a single tile or one tile per position.");
+
+	int count = p_positions.size();
+	const Vector2 *positions = p_positions.ptr();
+	const int32_t *tiles = p_tiles.ptr();
+	int tile_step = p_tiles.size() == 1 ? 0 : 1;
+
+	CellWriteCache cache;
+	for (int i = 0; i < count; i++) {
+		_set_cell(PosKey(positions[i].x, positions[i].y), tiles[i * tile_step], false, false, false, 0, 0, cache);
+	}
+}
+
 int TileMap::get_cellv(const Vector2 &p_pos) const {
 	return get_cell(p_pos.x, p_pos.y);
 }
@@ -932,8 +1119,8 @@ void TileMap::update_bitmask_region(const Vector2 &p_start, const Vector2 &p_end
 void TileMap::update_cell_bitmask(int p_x, int p_y) {
 	ERR_FAIL_COND_MSG(tile_set.is_null(), "Cannot update cell bitmask if Tileset is not open.");
 	PosKey p(p_x, p_y);
-	Map<PosKey, Cell>::Element *E = tile_map.find(p);
-	if (E != nullptr) {
+	Cell *c = _get_cell(p);
+	if (c != nullptr) {
 		int id = get_cell(p_x, p_y);
 		if (tile_set->tile_get_tile_mode(id) == TileSet::AUTO_TILE) {
 			uint16_t mask = 0;
@@ -993,22 +1180,23 @@ void TileMap::update_cell_bitmask(int p_x, int p_y) {
 				}
 			}
 			Vector2 coord = tile_set->autotile_get_subtile_for_bitmask(id, mask, this, Vector2(p_x, p_y));
-			E->get().autotile_coord_x = (int)coord.x;
-			E->get().autotile_coord_y = (int)coord.y;
+			uint32_t layers = _get_cell_layers(*c);
+			c->autotile_coord_x = (int)coord.x;
+			c->autotile_coord_y = (int)coord.y;
 
 			PosKey qk = p.to_quadrant(_get_quadrant_size());
 			Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
-			_make_quadrant_dirty(Q);
+			_make_quadrant_dirty(Q, true, layers | _get_cell_layers(*c));
 
 		} else if (tile_set->tile_get_tile_mode(id) == TileSet::SINGLE_TILE) {
-			E->get().autotile_coord_x = 0;
-			E->get().autotile_coord_y = 0;
+			c->autotile_coord_x = 0;
+			c->autotile_coord_y = 0;
 		} else if (tile_set->tile_get_tile_mode(id) == TileSet::ATLAS_TILE) {
 			if (tile_set->autotile_get_bitmask(id, Vector2(p_x, p_y)) == TileSet::BIND_CENTER) {
 				Vector2 coord = tile_set->atlastile_get_subtile_by_priority(id, this, Vector2(p_x, p_y));
 
-				E->get().autotile_coord_x = (int)coord.x;
-				E->get().autotile_coord_y = (int)coord.y;
+				c->autotile_coord_x = (int)coord.x;
+				c->autotile_coord_y = (int)coord.y;
 			}
 		}
 	}
@@ -1023,9 +1211,11 @@ void TileMap::update_dirty_bitmask() {
 
 void TileMap::fix_invalid_tiles() {
 	ERR_FAIL_COND_MSG(tile_set.is_null(), "Cannot fix invalid tiles if Tileset is not open.");
-	for (Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
-		if (!tile_set->has_tile(get_cell(E->key().x, E->key().y))) {
-			set_cell(E->key().x, E->key().y, INVALID_CELL);
+	LocalVector<PosKey> cells;
+	_get_used_cells_sorted(cells);
+	for (uint32_t i = 0; i < cells.size(); i++) {
+		if (!tile_set->has_tile(get_cell(cells[i].x, cells[i].y))) {
+			set_cell(cells[i].x, cells[i].y, INVALID_CELL);
 		}
 	}
 }
@@ -1033,64 +1223,63 @@ void TileMap::fix_invalid_tiles() {
 int TileMap::get_cell(int p_x, int p_y) const {
 	PosKey pk(p_x, p_y);
 
-	const Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	const Cell *c = _get_cell(pk);
 
-	if (!E) {
+	if (!c) {
 		return INVALID_CELL;
 	}
 
-	return E->get().id;
+	return c->id;
 }
 
 bool TileMap::is_cell_x_flipped(int p_x, int p_y) const {
 	PosKey pk(p_x, p_y);
 
-	const Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	const Cell *c = _get_cell(pk);
 
-	if (!E) {
+	if (!c) {
 		return false;
 	}
 
-	return E->get().flip_h;
+	return c->flip_h;
 }
 
 bool TileMap::is_cell_y_flipped(int p_x, int p_y) const {
 	PosKey pk(p_x, p_y);
 
-	const Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	const Cell *c = _get_cell(pk);
 
-	if (!E) {
+	if (!c) {
 		return false;
 	}
 
-	return E->get().flip_v;
+	return c->flip_v;
 }
 
 bool TileMap::is_cell_transposed(int p_x, int p_y) const {
 	PosKey pk(p_x, p_y);
 
-	const Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	const Cell *c = _get_cell(pk);
 
-	if (!E) {
+	if (!c) {
 		return false;
 	}
 
-	return E->get().transpose;
+	return c->transpose;
 }
 
 void TileMap::set_cell_autotile_coord(int p_x, int p_y, const Vector2 &p_coord) {
 	PosKey pk(p_x, p_y);
 
-	const Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	Cell *c = _get_cell(pk);
 
-	if (!E) {
+	if (!c) {
 		return;
 	}
 
-	Cell c = E->get();
-	c.autotile_coord_x = p_coord.x;
-	c.autotile_coord_y = p_coord.y;
-	tile_map[pk] = c;
+	uint32_t layers = _get_cell_layers(*c);
+	c->autotile_coord_x = p_coord.x;
+	c->autotile_coord_y = p_coord.y;
 
 	PosKey qk = pk.to_quadrant(_get_quadrant_size());
 	Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
@@ -1099,35 +1288,44 @@ void TileMap::set_cell_autotile_coord(int p_x, int p_y, const Vector2 &p_coord)
 		return;
 	}
 
-	_make_quadrant_dirty(Q);
+	_make_quadrant_dirty(Q, true, layers | _get_cell_layers(*c));
 }
 
 Vector2 TileMap::get_cell_autotile_coord(int p_x, int p_y) const {
 	PosKey pk(p_x, p_y);
 
-	const Map<PosKey, Cell>::Element *E = tile_map.find(pk);
+	const Cell *c = _get_cell(pk);
 
-	if (!E) {
+	if (!c) {
 		return Vector2();
 	}
 
-	return Vector2(E->get().autotile_coord_x, E->get().autotile_coord_y);
+	return Vector2(c->autotile_coord_x, c->autotile_coord_y);
 }
 
 void TileMap::_recreate_quadrants() {
 	_clear_quadrants();
 
-	for (Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
-		PosKey qk = PosKey(E->key().x, E->key().y).to_quadrant(_get_quadrant_size());
+	const PosKey *K = nullptr;
+	while ((K = cell_chunks.next(K))) {
+		const CellChunk &chunk = *cell_chunks.getptr(*K);
+		for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; i++) {
+			if (chunk.cells[i].id == INVALID_CELL) {
+				continue;
+			}
 
-		Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
-		if (!Q) {
-			Q = _create_quadrant(qk);
-			dirty_quadrant_list.add(&Q->get().dirty_list);
-		}
+			PosKey pk(K->x * CHUNK_SIZE + (i & CHUNK_MASK), K->y * CHUNK_SIZE + (i >> CHUNK_SHIFT));
+			PosKey qk = pk.to_quadrant(_get_quadrant_size());
 
-		Q->get().cells.insert(E->key());
-		_make_quadrant_dirty(Q, false);
+			Map<PosKey, Quadrant>::Element *Q = quadrant_map.find(qk);
+			if (!Q) {
+				Q = _create_quadrant(qk);
+				dirty_quadrant_list.add(&Q->get().dirty_list);
+			}
+
+			Q->get().cells.insert(pk);
+			_make_quadrant_dirty(Q, false);
+		}
 	}
 	update_dirty_quadrants();
 }
@@ -1163,7 +1361,8 @@ void TileMap::_update_item_material_state(const RID &p_canvas_item) {
 
 void TileMap::clear() {
 	_clear_quadrants();
-	tile_map.clear();
+	cell_chunks.clear();
+	cell_count = 0;
 	used_size_cache_dirty = true;
 }
 
@@ -1176,6 +1375,7 @@ void TileMap::_set_tile_data(const Vector<int> &p_data) {
 	int offset = (format == FORMAT_2) ? 3 : 2;
 
 	clear();
+	CellWriteCache cache;
 	for (int i = 0; i < c; i += offset) {
 		const uint8_t *ptr = (const uint8_t *)&r[i];
 		uint8_t local[12];
@@ -1210,35 +1410,39 @@ void TileMap::_set_tile_data(const Vector<int> &p_data) {
 			coord_y = decode_uint16(&local[10]);
 		}
 
-		set_cell(x, y, v, flip_h, flip_v, transpose, Vector2(coord_x, coord_y));
+		_set_cell(PosKey(x, y), v, flip_h, flip_v, transpose, coord_x, coord_y, cache);
 	}
 }
 
 Vector<int> TileMap::_get_tile_data() const {
 	Vector<int> data;
-	data.resize(tile_map.size() * 3);
+	data.resize(cell_count * 3);
 	int *w = data.ptrw();
 
 	// Save in highest format
 
+	LocalVector<PosKey> cells;
+	_get_used_cells_sorted(cells);
+
 	int idx = 0;
-	for (const Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
+	for (uint32_t i = 0; i < cells.size(); i++) {
+		const Cell &c = *_get_cell(cells[i]);
 		uint8_t *ptr = (uint8_t *)&w[idx];
-		encode_uint16(E->key().x, &ptr[0]);
-		encode_uint16(E->key().y, &ptr[2]);
-		uint32_t val = E->get().id;
-		if (E->get().flip_h) {
+		encode_uint16(cells[i].x, &ptr[0]);
+		encode_uint16(cells[i].y, &ptr[2]);
+		uint32_t val = c.id;
+		if (c.flip_h) {
 			val |= (1 << 29);
 		}
-		if (E->get().flip_v) {
+		if (c.flip_v) {
 			val |= (1 << 30);
 		}
-		if (E->get().transpose) {
+		if (c.transpose) {
 			val |= (1 << 31);
 		}
 		encode_uint32(val, &ptr[4]);
-		encode_uint16(E->get().autotile_coord_x, &ptr[8]);
-		encode_uint16(E->get().autotile_coord_y, &ptr[10]);
+		encode_uint16(c.autotile_coord_x, &ptr[8]);
+		encode_uint16(c.autotile_coord_y, &ptr[10]);
 		idx += 3;
 	}
 
@@ -1261,7 +1465,9 @@ void TileMap::set_collision_layer(uint32_t p_layer) {
 	if (!use_parent) {
 		for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
 			Quadrant &q = E->get();
-			PhysicsServer2D::get_singleton()->body_set_collision_layer(q.body, collision_layer);
+			if (q.body.is_valid()) {
+				PhysicsServer2D::get_singleton()->body_set_collision_layer(q.body, collision_layer);
+			}
 		}
 	}
 }
@@ -1271,7 +1477,9 @@ void TileMap::set_collision_mask(uint32_t p_mask) {
 	if (!use_parent) {
 		for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
 			Quadrant &q = E->get();
-			PhysicsServer2D::get_singleton()->body_set_collision_mask(q.body, collision_mask);
+			if (q.body.is_valid()) {
+				PhysicsServer2D::get_singleton()->body_set_collision_mask(q.body, collision_mask);
+			}
 		}
 	}
 }
@@ -1336,7 +1544,9 @@ void TileMap::set_collision_friction(float p_friction) {
 	if (!use_parent) {
 		for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
 			Quadrant &q = E->get();
-			PhysicsServer2D::get_singleton()->body_set_param(q.body, PhysicsServer2D::BODY_PARAM_FRICTION, p_friction);
+			if (q.body.is_valid()) {
+				PhysicsServer2D::get_singleton()->body_set_param(q.body, PhysicsServer2D::BODY_PARAM_FRICTION, p_friction);
+			}
 		}
 	}
 }
@@ -1350,7 +1560,9 @@ void TileMap::set_collision_bounce(float p_bounce) {
 	if (!use_parent) {
 		for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
 			Quadrant &q = E->get();
-			PhysicsServer2D::get_singleton()->body_set_param(q.body, PhysicsServer2D::BODY_PARAM_BOUNCE, p_bounce);
+			if (q.body.is_valid()) {
+				PhysicsServer2D::get_singleton()->body_set_param(q.body, PhysicsServer2D::BODY_PARAM_BOUNCE, p_bounce);
+			}
 		}
 	}
 }
@@ -1608,11 +1820,12 @@ bool TileMap::is_centered_textures_enabled() const {
 
 TypedArray<Vector2i> TileMap::get_used_cells() const {
 	TypedArray<Vector2i> a;
-	a.resize(tile_map.size());
-	int i = 0;
-	for (Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
-		Vector2i p(E->key().x, E->key().y);
-		a[i++] = p;
+	LocalVector<PosKey> cells;
+	_get_used_cells_sorted(cells);
+
+	a.resize(cells.size());
+	for (uint32_t i = 0; i < cells.size(); i++) {
+		a[i] = Vector2i(cells[i].x, cells[i].y);
 	}
 
 	return a;
@@ -1620,10 +1833,12 @@ TypedArray<Vector2i> TileMap::get_used_cells() const {
 
 TypedArray<Vector2i> TileMap::get_used_cells_by_index(int p_id) const {
 	TypedArray<Vector2i> a;
-	for (Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
-		if (E->value().id == p_id) {
-			Vector2i p(E->key().x, E->key().y);
-			a.push_back(p);
+	LocalVector<PosKey> cells;
+	_get_used_cells_sorted(cells);
+
+	for (uint32_t i = 0; i < cells.size(); i++) {
+		if (_get_cell(cells[i])->id == p_id) {
+			a.push_back(Vector2i(cells[i].x, cells[i].y));
 		}
 	}
 
@@ -1633,11 +1848,24 @@ TypedArray<Vector2i> TileMap::get_used_cells_by_index(int p_id) const {
 Rect2 TileMap::get_used_rect() { // Not const because of cache
 
 	if (used_size_cache_dirty) {
-		if (tile_map.size() > 0) {
-			used_size_cache = Rect2(tile_map.front()->key().x, tile_map.front()->key().y, 0, 0);
+		if (cell_count > 0) {
+			bool first = true;
+			const PosKey *K = nullptr;
+			while ((K = cell_chunks.next(K))) {
+				const CellChunk &chunk = *cell_chunks.getptr(*K);
+				for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; i++) {
+					if (chunk.cells[i].id == INVALID_CELL) {
+						continue;
+					}
 
-			for (Map<PosKey, Cell>::Element *E = tile_map.front(); E; E = E->next()) {
-				used_size_cache.expand_to(Vector2(E->key().x, E->key().y));
+					Vector2 pos(K->x * CHUNK_SIZE + (i & CHUNK_MASK), K->y * CHUNK_SIZE + (i >> CHUNK_SHIFT));
+					if (first) {
+						used_size_cache = Rect2(pos, Size2());
+						first = false;
+					} else {
+						used_size_cache.expand_to(pos);
+					}
+				}
 			}
 
 			used_size_cache.size += Vector2(1, 1);
@@ -1654,8 +1882,9 @@ Rect2 TileMap::get_used_rect() { // Not const because of cache
 void TileMap::set_occluder_light_mask(int p_mask) {
 	occluder_light_mask = p_mask;
 	for (Map<PosKey, Quadrant>::Element *E = quadrant_map.front(); E; E = E->next()) {
-		for (Map<PosKey, Quadrant::Occluder>::Element *F = E->get().occluder_instances.front(); F; F = F->next()) {
-			RenderingServer::get_singleton()->canvas_light_occluder_set_light_mask(F->get().id, occluder_light_mask);
+		const Quadrant &q = E->get();
+		for (uint32_t i = 0; i < q.occluder_instances.size(); i++) {
+			RenderingServer::get_singleton()->canvas_light_occluder_set_light_mask(q.occluder_instances[i].id, occluder_light_mask);
 		}
 	}
 }
@@ -1765,6 +1994,7 @@ void TileMap::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_occluder_light_mask"), &TileMap::get_occluder_light_mask);
 
 	ClassDB::bind_method(D_METHOD("set_cell", "x", "y", "tile", "flip_x", "flip_y", "transpose", "autotile_coord"), &TileMap::set_cell, DEFVAL(false), DEFVAL(false), DEFVAL(false), DEFVAL(Vector2()));
+	ClassDB::bind_method(D_METHOD("set_cells", "positions", "tiles"), &TileMap::set_cells);
 	ClassDB::bind_method(D_METHOD("set_cellv", "position", "tile", "flip_x", "flip_y", "transpose"), &TileMap::set_cellv, DEFVAL(false), DEFVAL(false), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("_set_celld", "position", "data"), &TileMap::_set_celld);
 	ClassDB::bind_method(D_METHOD("get_cell", "x", "y"), &TileMap::get_cell);
@@ -1849,6 +2079,7 @@ void TileMap::_changed_callback(Object *p_changed, const char *p_prop) {
 TileMap::TileMap() {
 	rect_cache_dirty = true;
 	used_size_cache_dirty = true;
+	cell_count = 0;
 	pending_update = false;
 	quadrant_order_dirty = false;
 	quadrant_size = 16;
@@ -31,6 +31,8 @@
 #ifndef TILE_MAP_H
 #define TILE_MAP_H
 
+#include "core/hash_map.h"
+#include "core/local_vector.h"
 #include "core/self_list.h"
 #include "core/vset.h"
 #include "scene/2d/navigation_2d.h"
@@ -69,6 +71,21 @@ private:
 		FORMAT_2
 	};
 
+	enum {
+		CHUNK_SHIFT = 4,
+		CHUNK_SIZE = 1 << CHUNK_SHIFT,
+		CHUNK_MASK = CHUNK_SIZE - 1
+	};
+
+	// Parts of a quadrant that can be rebuilt independently.
+	enum QuadrantLayer {
+		LAYER_CANVAS = 1,
+		LAYER_PHYSICS = 2,
+		LAYER_NAVIGATION = 4,
+		LAYER_OCCLUDERS = 8,
+		LAYER_ALL = LAYER_CANVAS | LAYER_PHYSICS | LAYER_NAVIGATION | LAYER_OCCLUDERS
+	};
+
 	Ref<TileSet> tile_set;
 	Size2i cell_size;
 	int quadrant_size;
@@ -92,6 +109,10 @@ private:
 
 		bool operator==(const PosKey &p_k) const { return (y == p_k.y && x == p_k.x); }
 
+		// Arithmetic shift rounds down, so negative cells land in the chunk below.
+		PosKey to_chunk() const { return PosKey(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT); }
+		int chunk_index() const { return ((y & CHUNK_MASK) << CHUNK_SHIFT) | (x & CHUNK_MASK); }
+
 		PosKey to_quadrant(const int &p_quadrant_size) const {
 			// rounding down, instead of simply rounding towards zero (truncating)
 			return PosKey(
@@ -123,7 +144,24 @@ private:
 		Cell() { _u64t = 0; }
 	};
 
-	Map<PosKey, Cell> tile_map;
+	struct PosKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const PosKey &p_key) { return hash_one_uint64(p_key.key); }
+	};
+
+	// Cells are stored densely in fixed-size chunks, keyed by chunk coordinate.
+	struct CellChunk {
+		Cell cells[CHUNK_SIZE * CHUNK_SIZE];
+		int used = 0;
+
+		CellChunk() {
+			for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; i++) {
+				cells[i].id = INVALID_CELL;
+			}
+		}
+	};
+
+	HashMap<PosKey, CellChunk, PosKeyHasher> cell_chunks;
+	int cell_count;
 	List<PosKey> dirty_bitmask;
 
 	struct Quadrant {
@@ -133,6 +171,7 @@ private:
 		uint32_t shape_owner_id;
 
 		SelfList<Quadrant> dirty_list;
+		uint32_t dirty_layers = 0;
 
 		struct NavPoly {
 			RID region;
@@ -144,8 +183,8 @@ private:
 			Transform2D xform;
 		};
 
-		Map<PosKey, NavPoly> navpoly_ids;
-		Map<PosKey, Occluder> occluder_instances;
+		LocalVector<NavPoly> navpoly_ids;
+		LocalVector<Occluder> occluder_instances;
 
 		VSet<PosKey> cells;
 
@@ -154,6 +193,7 @@ private:
 			canvas_items = q.canvas_items;
 			body = q.body;
 			shape_owner_id = q.shape_owner_id;
+			dirty_layers = q.dirty_layers;
 			cells = q.cells;
 			navpoly_ids = q.navpoly_ids;
 			occluder_instances = q.occluder_instances;
@@ -164,6 +204,7 @@ private:
 			canvas_items = q.canvas_items;
 			body = q.body;
 			shape_owner_id = q.shape_owner_id;
+			dirty_layers = q.dirty_layers;
 			cells = q.cells;
 			occluder_instances = q.occluder_instances;
 			navpoly_ids = q.navpoly_ids;
@@ -176,6 +217,15 @@ private:
 
 	SelfList<Quadrant>::List dirty_quadrant_list;
 
+	// Lookups reused across consecutive writes, so bulk edits of nearby cells
+	// skip the chunk and quadrant searches.
+	struct CellWriteCache {
+		PosKey chunk_key;
+		CellChunk *chunk = nullptr;
+		PosKey quadrant_key;
+		Map<PosKey, Quadrant>::Element *quadrant = nullptr;
+	};
+
 	bool pending_update;
 
 	Rect2 rect_cache;
@@ -200,11 +250,18 @@ private:
 
 	void _fix_cell_transform(Transform2D &xform, const Cell &p_cell, const Vector2 &p_offset, const Size2 &p_sc);
 
-	void _add_shape(int &shape_idx, const Quadrant &p_q, const Ref<Shape2D> &p_shape, const TileSet::ShapeData &p_shape_data, const Transform2D &p_xform, const Vector2 &p_metadata);
+	const Cell *_get_cell(const PosKey &p_pk) const;
+	Cell *_get_cell(const PosKey &p_pk);
+	void _get_used_cells_sorted(LocalVector<PosKey> &r_cells) const;
+	uint32_t _get_cell_layers(const Cell &p_cell) const;
+	void _set_cell(const PosKey &p_pk, int p_tile, bool p_flip_x, bool p_flip_y, bool p_transpose, int16_t p_autotile_x, int16_t p_autotile_y, CellWriteCache &r_cache);
+
+	void _add_shape(int &shape_idx, Quadrant &p_q, const Ref<Shape2D> &p_shape, const TileSet::ShapeData &p_shape_data, const Transform2D &p_xform, const Vector2 &p_metadata);
 
 	Map<PosKey, Quadrant>::Element *_create_quadrant(const PosKey &p_qk);
 	void _erase_quadrant(Map<PosKey, Quadrant>::Element *Q);
-	void _make_quadrant_dirty(Map<PosKey, Quadrant>::Element *Q, bool update = true);
+	void _create_quadrant_body(Quadrant &p_q);
+	void _make_quadrant_dirty(Map<PosKey, Quadrant>::Element *Q, bool update = true, uint32_t p_layers = LAYER_ALL);
 	void _recreate_quadrants();
 	void _clear_quadrants();
 	void _update_quadrant_space(const RID &p_space);
@@ -254,6 +311,7 @@ public:
 	int get_quadrant_size() const;
 
 	void set_cell(int p_x, int p_y, int p_tile, bool p_flip_x = false, bool p_flip_y = false, bool p_transpose = false, Vector2 p_autotile_coord = Vector2());
+	void set_cells(const Vector<Vector2> &p_positions, const Vector<int32_t> &p_tiles);
 	int get_cell(int p_x, int p_y) const;
 	bool is_cell_x_flipped(int p_x, int p_y) const;
 	bool is_cell_y_flipped(int p_x, int p_y) const;
@@ -31,6 +31,7 @@
 #ifndef CPU_PARTICLES_H
 #define CPU_PARTICLES_H
 
+#include "core/local_vector.h"
 #include "core/rid.h"
 #include "scene/3d/visual_instance_3d.h"
 
@@ -81,21 +82,37 @@ public:
 private:
 	bool emitting;
 
-	struct Particle {
-		Transform transform;
-		Color color;
-		float custom[4];
-		Vector3 velocity;
-		bool active;
-		float angle_rand;
-		float scale_rand;
-		float hue_rot_rand;
-		float anim_offset_rand;
-		float time;
-		float lifetime;
-		Color base_color;
-
-		uint32_t seed;
+	enum {
+		PROCESS_CHUNK_SIZE = 512,
+		CURVE_BAKE_RESOLUTION = 512,
+		PARTICLE_DATA_STRIDE = 12 + 4 + 4,
+	};
+
+	// Particle state, one array per field so every pass over the particles reads
+	// contiguous memory and chunks of them can be processed on separate threads.
+	struct Particles {
+		LocalVector<Transform> transform;
+		LocalVector<Vector3> velocity;
+		LocalVector<Color> base_color;
+		LocalVector<float> custom; // 4 per particle, as sent to the shader.
+		LocalVector<float> time;
+		LocalVector<float> lifetime;
+		LocalVector<float> rand; // Angle, scale, hue rotation and animation offset, 4 per particle.
+		LocalVector<uint32_t> seed;
+		LocalVector<uint8_t> active;
+	} particles;
+
+	int particle_count = 0;
+
+	// Values computed once per step and shared by all the chunks.
+	struct ProcessStep {
+		float delta;
+		float prev_time;
+		float system_phase;
+		uint32_t random_seed;
+		Transform emission_xform;
+		Basis velocity_xform;
+		float *buffer; // Where the step writes the multimesh data, null if it doesn't.
 	};
 
 	float time;
@@ -106,23 +123,23 @@ private:
 
 	RID multimesh;
 
-	Vector<Particle> particles;
 	Vector<float> particle_data;
 	Vector<int> particle_order;
+	LocalVector<float> unsorted_particle_data; // Written by the process step when the draw order needs sorting.
 
 	struct SortLifetime {
-		const Particle *particles;
+		const float *times;
 
 		bool operator()(int p_a, int p_b) const {
-			return particles[p_a].time > particles[p_b].time;
+			return times[p_a] > times[p_b];
 		}
 	};
 
 	struct SortAxis {
-		const Particle *particles;
+		const Transform *transforms;
 		Vector3 axis;
 		bool operator()(int p_a, int p_b) const {
-			return axis.dot(particles[p_a].transform.origin) < axis.dot(particles[p_b].transform.origin);
+			return axis.dot(transforms[p_a].origin) < axis.dot(transforms[p_b].origin);
 		}
 	};
 
@@ -161,6 +178,11 @@ private:
 	Color color;
 	Ref<Gradient> color_ramp;
 
+	// Curves and color ramp sampled into tables, so worker threads only read plain arrays.
+	LocalVector<float> baked_curves[PARAM_MAX]; // Empty if the parameter has no curve.
+	LocalVector<Color> baked_color_ramp;
+	bool baked_curves_dirty = true;
+
 	bool flags[FLAG_MAX];
 
 	EmissionShape emission_shape;
@@ -174,8 +196,13 @@ private:
 	Vector3 gravity;
 
 	void _update_internal();
-	void _particles_process(float p_delta);
-	void _update_particle_data_buffer();
+	void _particles_process(float p_delta, bool p_update_buffer);
+	void _process_chunk(uint32_t p_chunk, const ProcessStep *p_step);
+	void _sort_particle_data_buffer();
+	void _write_particle_transforms();
+
+	void _curves_changed();
+	void _bake_curves();
 
 	Mutex update_mutex;
 
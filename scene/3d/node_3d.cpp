@@ -95,17 +95,17 @@ void Node3D::_propagate_transform_changed(Node3D *p_origin) {
 		return;
 	}
 
-	/*
-	if (data.dirty&DIRTY_GLOBAL)
-		return; //already dirty
-	*/
-
 	data.children_lock++;
 
 	for (List<Node3D *>::Element *E = data.children.front(); E; E = E->next()) {
 		if (E->get()->data.toplevel_active) {
 			continue; //don't propagate to a toplevel
 		}
+		if (E->get()->data.dirty & DIRTY_GLOBAL) {
+			// Already dirty, so is the whole subtree, and the nodes in it that want
+			// a notification are already queued (see _resolve_unnotified_transform()).
+			continue;
+		}
 		E->get()->_propagate_transform_changed(p_origin);
 	}
 #ifdef TOOLS_ENABLED
@@ -211,6 +211,10 @@ void Node3D::_notification(int p_what) {
 		} break;
 
 		case NOTIFICATION_TRANSFORM_CHANGED: {
+			// Leave no notified node dirty, otherwise changes in its parents would stop propagating here.
+			if (data.dirty & DIRTY_GLOBAL) {
+				get_global_transform();
+			}
 #ifdef TOOLS_ENABLED
 			if (data.gizmo.is_valid()) {
 				data.gizmo->transform();
@@ -407,6 +411,9 @@ void Node3D::set_gizmo(const Ref<Node3DGizmo> &p_gizmo) {
 		data.gizmo->free();
 	}
 	data.gizmo = p_gizmo;
+	if (data.gizmo.is_valid()) {
+		_resolve_unnotified_transform();
+	}
 	if (data.gizmo.is_valid() && is_inside_world()) {
 		data.gizmo->create();
 		if (is_visible_in_tree()) {
@@ -674,8 +681,26 @@ Vector3 Node3D::to_global(Vector3 p_local) const {
 	return get_global_transform().xform(p_local);
 }
 
+void Node3D::_resolve_unnotified_transform() {
+	// A dirty node that should be notified but isn't queued would stop the propagation of
+	// later changes before reaching it. Resolve it, as if it had been read when it changed.
+	if (is_inside_tree() && (data.dirty & DIRTY_GLOBAL) && !xform_change.in_list()) {
+		get_global_transform();
+	}
+}
+
 void Node3D::set_notify_transform(bool p_enable) {
 	data.notify_transform = p_enable;
+	if (p_enable) {
+		_resolve_unnotified_transform();
+	}
+}
+
+void Node3D::set_ignore_transform_notification(bool p_ignore) {
+	data.ignore_notification = p_ignore;
+	if (!p_ignore) {
+		_resolve_unnotified_transform();
+	}
 }
 
 bool Node3D::is_transform_notification_enabled() const {
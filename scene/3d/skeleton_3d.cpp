@@ -32,6 +32,7 @@
 
 #include "core/engine.h"
 #include "core/message_queue.h"
+#include "core/os/thread.h"
 #include "core/project_settings.h"
 #include "core/type_info.h"
 #include "scene/3d/physics_body_3d.h"
@@ -223,142 +224,241 @@ void Skeleton3D::_update_process_order() {
 	process_order_dirty = false;
 }
 
-void Skeleton3D::_notification(int p_what) {
-	switch (p_what) {
-		case NOTIFICATION_UPDATE_SKELETON: {
-			RenderingServer *rs = RenderingServer::get_singleton();
-			Bone *bonesptr = bones.ptrw();
-			int len = bones.size();
+static _FORCE_INLINE_ void _transform_concatenate_to_buffer(const Transform &p_a, const Transform &p_b, float *r_dst) {
+	// Same as (p_a * p_b), written straight into the 3x4 row layout used by the rendering server.
+	const Vector3 *b = p_b.basis.elements;
+	for (int i = 0; i < 3; i++) {
+		const Vector3 &a = p_a.basis.elements[i];
+		float *dst = r_dst + i * 4;
+		dst[0] = a.x * b[0].x + a.y * b[1].x + a.z * b[2].x;
+		dst[1] = a.x * b[0].y + a.y * b[1].y + a.z * b[2].y;
+		dst[2] = a.x * b[0].z + a.y * b[1].z + a.z * b[2].z;
+		dst[3] = a.x * p_b.origin.x + a.y * p_b.origin.y + a.z * p_b.origin.z + p_a.origin[i];
+	}
+}
+
+LocalVector<Skeleton3D *> Skeleton3D::dirty_skeletons;
+Mutex Skeleton3D::dirty_skeletons_mutex;
 
-			_update_process_order();
+void Skeleton3D::_update_dirty_skeletons(Skeleton3D *p_caller) {
+	LocalVector<Skeleton3D *> skeletons;
+	{
+		MutexLock lock(dirty_skeletons_mutex);
+		skeletons = dirty_skeletons;
+		dirty_skeletons.clear();
+	}
 
-			const int *order = process_order.ptr();
+	for (uint32_t i = 0; i < skeletons.size(); i++) {
+		skeletons[i]->_update_skin_allocations();
+	}
 
-			for (int i = 0; i < len; i++) {
-				Bone &b = bonesptr[order[i]];
+	// Pose evaluation only touches the skeleton's own bones and skin buffers.
+#ifndef NO_THREADS
+	p_caller->get_tree()->get_work_pool().do_work(skeletons.size(), p_caller, &Skeleton3D::_update_skeleton_pose, (Skeleton3D *const *)skeletons.ptr());
+#else
+	for (uint32_t i = 0; i < skeletons.size(); i++) {
+		p_caller->_update_skeleton_pose(i, (Skeleton3D *const *)skeletons.ptr());
+	}
+#endif
 
-				if (b.global_pose_override_amount >= 0.999) {
-					b.pose_global = b.global_pose_override;
-				} else {
-					if (b.disable_rest) {
-						if (b.enabled) {
-							Transform pose = b.pose;
-							if (b.custom_pose_enable) {
-								pose = b.custom_pose * pose;
-							}
-							if (b.parent >= 0) {
-								b.pose_global = bonesptr[b.parent].pose_global * pose;
-							} else {
-								b.pose_global = pose;
-							}
-						} else {
-							if (b.parent >= 0) {
-								b.pose_global = bonesptr[b.parent].pose_global;
-							} else {
-								b.pose_global = Transform();
-							}
-						}
+	// Clear all flags first, so skeletons modified by bound nodes get queued again.
+	for (uint32_t i = 0; i < skeletons.size(); i++) {
+		skeletons[i]->dirty = false;
+	}
+	for (uint32_t i = 0; i < skeletons.size(); i++) {
+		skeletons[i]->_apply_pose();
+	}
+}
+
+void Skeleton3D::_update_skeleton_pose(uint32_t p_index, Skeleton3D *const *p_skeletons) {
+	p_skeletons[p_index]->_update_pose();
+}
+
+void Skeleton3D::_update_skin_allocations() {
+	for (Set<SkinReference *>::Element *E = skin_bindings.front(); E; E = E->next()) {
+		uint32_t bind_count = E->get()->skin->get_bind_count();
+
+		if (E->get()->bind_count != bind_count) {
+			RS::get_singleton()->skeleton_allocate(E->get()->skeleton, bind_count);
+			E->get()->bind_count = bind_count;
+			E->get()->skin_bone_indices.resize(bind_count);
+			E->get()->skin_bone_indices_ptrs = E->get()->skin_bone_indices.ptrw();
+			E->get()->bone_buffers[0].resize(bind_count * 12);
+			E->get()->bone_buffers[1].resize(bind_count * 12);
+		}
+	}
+}
+
+void Skeleton3D::_update_pose() {
+	Bone *bonesptr = bones.ptrw();
+	int len = bones.size();
+
+	_update_process_order();
+
+	const int *order = process_order.ptr();
+
+	for (int i = 0; i < len; i++) {
+		Bone &b = bonesptr[order[i]];
 
+		if (b.global_pose_override_amount >= 0.999) {
+			b.pose_global = b.global_pose_override;
+		} else {
+			if (b.disable_rest) {
+				if (b.enabled) {
+					Transform pose = b.pose;
+					if (b.custom_pose_enable) {
+						pose = b.custom_pose * pose;
+					}
+					if (b.parent >= 0) {
+						b.pose_global = bonesptr[b.parent].pose_global * pose;
 					} else {
-						if (b.enabled) {
-							Transform pose = b.pose;
-							if (b.custom_pose_enable) {
-								pose = b.custom_pose * pose;
-							}
-							if (b.parent >= 0) {
-								b.pose_global = bonesptr[b.parent].pose_global * (b.rest * pose);
-							} else {
-								b.pose_global = b.rest * pose;
-							}
-						} else {
-							if (b.parent >= 0) {
-								b.pose_global = bonesptr[b.parent].pose_global * b.rest;
-							} else {
-								b.pose_global = b.rest;
-							}
-						}
+						b.pose_global = pose;
 					}
-
-					if (b.global_pose_override_amount >= CMP_EPSILON) {
-						b.pose_global = b.pose_global.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
+				} else {
+					if (b.parent >= 0) {
+						b.pose_global = bonesptr[b.parent].pose_global;
+					} else {
+						b.pose_global = Transform();
 					}
 				}
 
-				if (b.global_pose_override_reset) {
-					b.global_pose_override_amount = 0.0;
+			} else {
+				if (b.enabled) {
+					Transform pose = b.pose;
+					if (b.custom_pose_enable) {
+						pose = b.custom_pose * pose;
+					}
+					if (b.parent >= 0) {
+						b.pose_global = bonesptr[b.parent].pose_global * (b.rest * pose);
+					} else {
+						b.pose_global = b.rest * pose;
+					}
+				} else {
+					if (b.parent >= 0) {
+						b.pose_global = bonesptr[b.parent].pose_global * b.rest;
+					} else {
+						b.pose_global = b.rest;
+					}
 				}
+			}
 
-				for (List<ObjectID>::Element *E = b.nodes_bound.front(); E; E = E->next()) {
-					Object *obj = ObjectDB::get_instance(E->get());
-					ERR_CONTINUE(!obj);
-					Node3D *node_3d = Object::cast_to<Node3D>(obj);
-					ERR_CONTINUE(!node_3d);
-					node_3d->set_transform(b.pose_global);
-				}
+			if (b.global_pose_override_amount >= CMP_EPSILON) {
+				b.pose_global = b.pose_global.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
 			}
+		}
 
-			//update skins
-			for (Set<SkinReference *>::Element *E = skin_bindings.front(); E; E = E->next()) {
-				const Skin *skin = E->get()->skin.operator->();
-				RID skeleton = E->get()->skeleton;
-				uint32_t bind_count = skin->get_bind_count();
-
-				if (E->get()->bind_count != bind_count) {
-					RS::get_singleton()->skeleton_allocate(skeleton, bind_count);
-					E->get()->bind_count = bind_count;
-					E->get()->skin_bone_indices.resize(bind_count);
-					E->get()->skin_bone_indices_ptrs = E->get()->skin_bone_indices.ptrw();
-				}
+		if (b.global_pose_override_reset) {
+			b.global_pose_override_amount = 0.0;
+		}
+	}
 
-				if (E->get()->skeleton_version != version) {
-					for (uint32_t i = 0; i < bind_count; i++) {
-						StringName bind_name = skin->get_bind_name(i);
-
-						if (bind_name != StringName()) {
-							//bind name used, use this
-							bool found = false;
-							for (int j = 0; j < len; j++) {
-								if (bonesptr[j].name == bind_name) {
-									E->get()->skin_bone_indices_ptrs[i] = j;
-									found = true;
-									break;
-								}
-							}
-
-							if (!found) {
-								ERR_PRINT("Skin bind #" + itos(i) + " contains named bind '" + String(bind_name) + "' but Skeleton3D has no bone by that name.");
-								E->get()->skin_bone_indices_ptrs[i] = 0;
-							}
-						} else if (skin->get_bind_bone(i) >= 0) {
-							int bind_index = skin->get_bind_bone(i);
-							if (bind_index >= len) {
-								ERR_PRINT("Skin bind #" + itos(i) + " contains bone index bind: " + itos(bind_index) + " , which is greater than the skeleton bone count: " + itos(len) + ".");
-								E->get()->skin_bone_indices_ptrs[i] = 0;
-							} else {
-								E->get()->skin_bone_indices_ptrs[i] = bind_index;
-							}
-						} else {
-							ERR_PRINT("Skin bind #" + itos(i) + " does not contain a name nor a bone index.");
-							E->get()->skin_bone_indices_ptrs[i] = 0;
+	//update skins
+	for (Set<SkinReference *>::Element *E = skin_bindings.front(); E; E = E->next()) {
+		const Skin *skin = E->get()->skin.operator->();
+		uint32_t bind_count = E->get()->bind_count;
+
+		if (E->get()->skeleton_version != version) {
+			for (uint32_t i = 0; i < bind_count; i++) {
+				StringName bind_name = skin->get_bind_name(i);
+
+				if (bind_name != StringName()) {
+					//bind name used, use this
+					bool found = false;
+					for (int j = 0; j < len; j++) {
+						if (bonesptr[j].name == bind_name) {
+							E->get()->skin_bone_indices_ptrs[i] = j;
+							found = true;
+							break;
 						}
 					}
 
-					E->get()->skeleton_version = version;
-				}
-
-				for (uint32_t i = 0; i < bind_count; i++) {
-					uint32_t bone_index = E->get()->skin_bone_indices_ptrs[i];
-					ERR_CONTINUE(bone_index >= (uint32_t)len);
-					rs->skeleton_bone_set_transform(skeleton, i, bonesptr[bone_index].pose_global * skin->get_bind_pose(i));
+					if (!found) {
+						ERR_PRINT("Skin bind #" + itos(i) + " contains named bind '" + String(bind_name) + "' but Skeleton3D has no bone by that name.");
+						E->get()->skin_bone_indices_ptrs[i] = 0;
+					}
+				} else if (skin->get_bind_bone(i) >= 0) {
+					int bind_index = skin->get_bind_bone(i);
+					if (bind_index >= len) {
+						ERR_PRINT("Skin bind #" + itos(i) + " contains bone index bind: " + itos(bind_index) + " , which is greater than the skeleton bone count: " + itos(len) + ".");
+						E->get()->skin_bone_indices_ptrs[i] = 0;
+					} else {
+						E->get()->skin_bone_indices_ptrs[i] = bind_index;
+					}
+				} else {
+					ERR_PRINT("Skin bind #" + itos(i) + " does not contain a name nor a bone index.");
+					E->get()->skin_bone_indices_ptrs[i] = 0;
 				}
 			}
 
-			dirty = false;
+			E->get()->skeleton_version = version;
+		}
+
+		float *dst = E->get()->bone_buffers[E->get()->bone_buffer_index].ptrw();
+		for (uint32_t i = 0; i < bind_count; i++) {
+			uint32_t bone_index = E->get()->skin_bone_indices_ptrs[i];
+			ERR_CONTINUE(bone_index >= (uint32_t)len);
+			_transform_concatenate_to_buffer(bonesptr[bone_index].pose_global, skin->get_bind_pose(i), dst + i * 12);
+		}
+	}
+}
+
+void Skeleton3D::_apply_pose() {
+	const Bone *bonesptr = bones.ptr();
+	int len = bones.size();
+	const int *order = process_order.ptr();
+
+	for (int i = 0; i < len; i++) {
+		const Bone &b = bonesptr[order[i]];
+
+		for (const List<ObjectID>::Element *E = b.nodes_bound.front(); E; E = E->next()) {
+			Object *obj = ObjectDB::get_instance(E->get());
+			ERR_CONTINUE(!obj);
+			Node3D *node_3d = Object::cast_to<Node3D>(obj);
+			ERR_CONTINUE(!node_3d);
+			node_3d->set_transform(b.pose_global);
+		}
+	}
+
+	for (Set<SkinReference *>::Element *E = skin_bindings.front(); E; E = E->next()) {
+		if (E->get()->bind_count) {
+			RS::get_singleton()->skeleton_set_buffer(E->get()->skeleton, E->get()->bone_buffers[E->get()->bone_buffer_index]);
+			E->get()->bone_buffer_index ^= 1;
+		}
+	}
 
 #ifdef TOOLS_ENABLED
-			emit_signal(SceneStringNames::get_singleton()->pose_updated);
+	emit_signal(SceneStringNames::get_singleton()->pose_updated);
 #endif // TOOLS_ENABLED
+}
+
+void Skeleton3D::_notification(int p_what) {
+	switch (p_what) {
+		case NOTIFICATION_UPDATE_SKELETON: {
+			if (!dirty) {
+				break; // Already updated along with other dirty skeletons.
+			}
 
+#ifndef NO_THREADS
+			if (is_inside_tree() && Thread::get_caller_id() == Thread::get_main_id()) {
+				dirty_skeletons_mutex.lock();
+				bool several = dirty_skeletons.size() > 1;
+				dirty_skeletons_mutex.unlock();
+				if (several) {
+					_update_dirty_skeletons(this);
+					break;
+				}
+			}
+#endif
+
+			{
+				MutexLock lock(dirty_skeletons_mutex);
+				dirty_skeletons.erase(this);
+			}
+
+			_update_skin_allocations();
+			_update_pose();
+			dirty = false;
+			_apply_pose();
 		} break;
 
 #ifndef _3D_DISABLED
@@ -603,6 +703,9 @@ void Skeleton3D::_make_dirty() {
 
 	MessageQueue::get_singleton()->push_notification(this, NOTIFICATION_UPDATE_SKELETON);
 	dirty = true;
+
+	MutexLock lock(dirty_skeletons_mutex);
+	dirty_skeletons.push_back(this);
 }
 
 int Skeleton3D::get_process_order(int p_idx) {
@@ -934,6 +1037,11 @@ Skeleton3D::Skeleton3D() {
 }
 
 Skeleton3D::~Skeleton3D() {
+	if (dirty) {
+		MutexLock lock(dirty_skeletons_mutex);
+		dirty_skeletons.erase(this);
+	}
+
 	//some skins may remain bound
 	for (Set<SkinReference *>::Element *E = skin_bindings.front(); E; E = E->next()) {
 		E->get()->skeleton_node = nullptr;
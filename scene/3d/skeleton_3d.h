@@ -31,6 +31,7 @@
 #ifndef SKELETON_3D_H
 #define SKELETON_3D_H
 
+#include "core/local_vector.h"
 #include "core/rid.h"
 #include "scene/3d/node_3d.h"
 #include "scene/resources/skin.h"
@@ -54,6 +55,11 @@ class SkinReference : public Reference {
 	uint64_t skeleton_version = 0;
 	Vector<uint32_t> skin_bone_indices;
 	uint32_t *skin_bone_indices_ptrs;
+	// 12 floats per bind, in the layout of RenderingServer::skeleton_set_buffer. The server keeps
+	// a reference to the last buffer it was given, so writes alternate between two to avoid a
+	// copy-on-write every frame.
+	Vector<float> bone_buffers[2];
+	uint32_t bone_buffer_index = 0;
 	void _skin_changed();
 
 protected:
@@ -124,6 +130,17 @@ private:
 	void _make_dirty();
 	bool dirty;
 
+	// Skeletons waiting for NOTIFICATION_UPDATE_SKELETON. The first one to be
+	// notified evaluates all of them in parallel.
+	static LocalVector<Skeleton3D *> dirty_skeletons;
+	static Mutex dirty_skeletons_mutex; // Bones may be posed from threaded process callbacks.
+
+	static void _update_dirty_skeletons(Skeleton3D *p_caller);
+	void _update_skeleton_pose(uint32_t p_index, Skeleton3D *const *p_skeletons);
+	void _update_skin_allocations();
+	void _update_pose();
+	void _apply_pose();
+
 	uint64_t version;
 
 	// bind helpers
@@ -32,6 +32,7 @@
 
 #include "core/engine.h"
 #include "core/message_queue.h"
+#include "scene/animation/animation_process_batch.h"
 #include "scene/scene_string_names.h"
 #include "servers/audio/audio_stream.h"
 
@@ -195,7 +196,7 @@ void AnimationPlayer::_notification(int p_what) {
 			}
 
 			if (processing) {
-				_animation_process(get_process_delta_time());
+				_process_batched(get_process_delta_time());
 			}
 		} break;
 		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
@@ -204,10 +205,13 @@ void AnimationPlayer::_notification(int p_what) {
 			}
 
 			if (processing) {
-				_animation_process(get_physics_process_delta_time());
+				_process_batched(get_physics_process_delta_time());
 			}
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
+			if (AnimationProcessBatch::get_singleton()) {
+				AnimationProcessBatch::get_singleton()->remove_player(this);
+			}
 			clear_caches();
 		} break;
 	}
@@ -226,9 +230,11 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 	Animation *a = p_anim->animation.operator->();
 
 	p_anim->node_cache.resize(a->get_track_count());
+	p_anim->key_cursors.resize(a->get_track_count());
 
 	for (int i = 0; i < a->get_track_count(); i++) {
 		p_anim->node_cache.write[i] = nullptr;
+		p_anim->key_cursors[i] = -1;
 		RES resource;
 		Vector<StringName> leftover_path;
 		Node *child = parent->get_node_and_resource(a->track_get_path(i), resource, leftover_path);
@@ -321,8 +327,12 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 	}
 }
 
-void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float p_time, float p_delta, float p_interp, bool p_is_current, bool p_seeked, bool p_started) {
-	_ensure_node_caches(p_anim);
+void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float p_time, float p_delta, float p_interp, bool p_is_current, bool p_seeked, bool p_started, int p_stages) {
+	if (p_stages & PROCESS_STAGE_APPLY) {
+		_ensure_node_caches(p_anim);
+	} else if (p_anim->node_cache.size() != p_anim->animation->get_track_count()) {
+		return; // Caches were cleared after the batch was prepared, they can't be rebuilt from a worker thread.
+	}
 	ERR_FAIL_COND(p_anim->node_cache.size() != p_anim->animation->get_track_count());
 
 	Animation *a = p_anim->animation.operator->();
@@ -331,7 +341,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 	for (int i = 0; i < a->get_track_count(); i++) {
 		// If an animation changes this animation (or it animates itself)
 		// we need to recreate our animation cache
-		if (p_anim->node_cache.size() != a->get_track_count()) {
+		if (p_anim->node_cache.size() != a->get_track_count() && (p_stages & PROCESS_STAGE_APPLY)) {
 			_ensure_node_caches(p_anim);
 		}
 
@@ -349,6 +359,27 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 			continue; // do nothing if track is empty
 		}
 
+		if (p_stages != PROCESS_STAGE_ALL) {
+			bool sample_track = false;
+			switch (a->track_get_type(i)) {
+				case Animation::TYPE_TRANSFORM:
+				case Animation::TYPE_BEZIER: {
+					sample_track = true;
+				} break;
+				case Animation::TYPE_VALUE: {
+					// Capture reads the current value from the object, so it's applied on the main thread.
+					Animation::UpdateMode update_mode = a->value_track_get_update_mode(i);
+					sample_track = update_mode == Animation::UPDATE_CONTINUOUS || (p_delta == 0 && update_mode == Animation::UPDATE_DISCRETE);
+				} break;
+				default: {
+				}
+			}
+
+			if (!(p_stages & (sample_track ? PROCESS_STAGE_SAMPLE : PROCESS_STAGE_APPLY))) {
+				continue;
+			}
+		}
+
 		switch (a->track_get_type(i)) {
 			case Animation::TYPE_TRANSFORM: {
 				if (!nc->spatial) {
@@ -359,7 +390,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 				Quat rot;
 				Vector3 scale;
 
-				Error err = a->transform_track_interpolate(i, p_time, &loc, &rot, &scale);
+				Error err = a->transform_track_interpolate(i, p_time, &loc, &rot, &scale, &p_anim->key_cursors[i]);
 				//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 
 				if (err != OK) {
@@ -440,7 +471,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 
 				if (update_mode == Animation::UPDATE_CONTINUOUS || update_mode == Animation::UPDATE_CAPTURE || (p_delta == 0 && update_mode == Animation::UPDATE_DISCRETE)) { //delta == 0 means seek
 
-					Variant value = a->value_track_interpolate(i, p_time);
+					Variant value = a->value_track_interpolate(i, p_time, &p_anim->key_cursors[i]);
 
 					if (value == Variant()) {
 						continue;
@@ -748,7 +779,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 	}
 }
 
-void AnimationPlayer::_animation_process_data(PlaybackData &cd, float p_delta, float p_blend, bool p_seeked, bool p_started) {
+void AnimationPlayer::_animation_process_data(PlaybackData &cd, float p_delta, float p_blend, bool p_seeked, bool p_started, int p_stages) {
 	float delta = p_delta * speed_scale * cd.speed_scale;
 	float next_pos = cd.pos + delta;
 
@@ -794,15 +825,27 @@ void AnimationPlayer::_animation_process_data(PlaybackData &cd, float p_delta, f
 
 	cd.pos = next_pos;
 
-	_animation_process_animation(cd.from, cd.pos, delta, p_blend, &cd == &playback.current, p_seeked, p_started);
+	_animation_process_animation(cd.from, cd.pos, delta, p_blend, &cd == &playback.current, p_seeked, p_started, p_stages);
+
+	if (!(p_stages & PROCESS_STAGE_APPLY)) {
+		StageCall call;
+		call.anim = cd.from;
+		call.time = cd.pos;
+		call.delta = delta;
+		call.interp = p_blend;
+		call.is_current = &cd == &playback.current;
+		call.seeked = p_seeked;
+		call.started = p_started;
+		apply_calls.push_back(call);
+	}
 }
 
-void AnimationPlayer::_animation_process2(float p_delta, bool p_started) {
+void AnimationPlayer::_animation_process2(float p_delta, bool p_started, int p_stages) {
 	Playback &c = playback;
 
 	accum_pass++;
 
-	_animation_process_data(c.current, p_delta, 1.0f, c.seeked && p_delta != 0, p_started);
+	_animation_process_data(c.current, p_delta, 1.0f, c.seeked && p_delta != 0, p_started, p_stages);
 	if (p_delta != 0) {
 		c.seeked = false;
 	}
@@ -811,7 +854,7 @@ void AnimationPlayer::_animation_process2(float p_delta, bool p_started) {
 	for (List<Blend>::Element *E = c.blend.back(); E; E = prev) {
 		Blend &b = E->get();
 		float blend = b.blend_left / b.blend_time;
-		_animation_process_data(b.data, p_delta, blend, false, false);
+		_animation_process_data(b.data, p_delta, blend, false, false, p_stages);
 
 		b.blend_left -= Math::absf(speed_scale * p_delta);
 
@@ -905,35 +948,83 @@ void AnimationPlayer::_animation_process(float p_delta) {
 		end_reached = false;
 		end_notify = false;
 		_animation_process2(p_delta, playback.started);
+		_animation_process_finish();
 
-		if (playback.started) {
-			playback.started = false;
-		}
+	} else {
+		_set_process(false);
+	}
+}
 
-		_animation_update_transforms();
-		if (end_reached) {
-			if (queued.size()) {
-				String old = playback.assigned;
-				play(queued.front()->get());
-				String new_name = playback.assigned;
-				queued.pop_front();
-				if (end_notify) {
-					emit_signal(SceneStringNames::get_singleton()->animation_changed, old, new_name);
-				}
-			} else {
-				//stop();
-				playing = false;
-				_set_process(false);
-				if (end_notify) {
-					emit_signal(SceneStringNames::get_singleton()->animation_finished, playback.assigned);
-				}
+void AnimationPlayer::_animation_process_finish() {
+	if (playback.started) {
+		playback.started = false;
+	}
+
+	_animation_update_transforms();
+	if (end_reached) {
+		if (queued.size()) {
+			String old = playback.assigned;
+			play(queued.front()->get());
+			String new_name = playback.assigned;
+			queued.pop_front();
+			if (end_notify) {
+				emit_signal(SceneStringNames::get_singleton()->animation_changed, old, new_name);
+			}
+		} else {
+			//stop();
+			playing = false;
+			_set_process(false);
+			if (end_notify) {
+				emit_signal(SceneStringNames::get_singleton()->animation_finished, playback.assigned);
 			}
-			end_reached = false;
 		}
+		end_reached = false;
+	}
+}
 
+void AnimationPlayer::_process_batched(float p_delta) {
+	AnimationProcessBatch *batch = AnimationProcessBatch::get_singleton();
+	if (batch && batch->is_enabled()) {
+		if (_batch_prepare(p_delta)) {
+			batch->add_player(this);
+		}
 	} else {
+		_animation_process(p_delta);
+	}
+}
+
+bool AnimationPlayer::_batch_prepare(float p_delta) {
+	if (!playback.current.from) {
 		_set_process(false);
+		return false;
+	}
+
+	// Node caches can only be built on the main thread.
+	_ensure_node_caches(playback.current.from);
+	for (List<Blend>::Element *E = playback.blend.front(); E; E = E->next()) {
+		_ensure_node_caches(E->get().data.from);
 	}
+
+	batch_delta = p_delta;
+	return true;
+}
+
+void AnimationPlayer::_batch_sample() {
+	end_reached = false;
+	end_notify = false;
+	apply_calls.clear();
+	_animation_process2(batch_delta, playback.started, PROCESS_STAGE_SAMPLE);
+}
+
+void AnimationPlayer::_batch_apply() {
+	// Tracks may call methods that change the player, so the calls are re-checked every time.
+	for (uint32_t i = 0; i < apply_calls.size(); i++) {
+		StageCall call = apply_calls[i];
+		_animation_process_animation(call.anim, call.time, call.delta, call.interp, call.is_current, call.seeked, call.started, PROCESS_STAGE_APPLY);
+	}
+	apply_calls.clear();
+
+	_animation_process_finish();
 }
 
 Error AnimationPlayer::add_animation(const StringName &p_name, const Ref<Animation> &p_animation) {
@@ -1342,6 +1433,7 @@ void AnimationPlayer::clear_caches() {
 	cache_update_size = 0;
 	cache_update_prop_size = 0;
 	cache_update_bezier_size = 0;
+	apply_calls.clear(); // May point to animations that are about to be removed.
 }
 
 void AnimationPlayer::set_active(bool p_active) {
@@ -31,6 +31,7 @@
 #ifndef ANIMATION_PLAYER_H
 #define ANIMATION_PLAYER_H
 
+#include "core/local_vector.h"
 #include "scene/2d/node_2d.h"
 #include "scene/3d/node_3d.h"
 #include "scene/3d/skeleton_3d.h"
@@ -166,6 +167,7 @@ private:
 		String name;
 		StringName next;
 		Vector<TrackNodeCache *> node_cache;
+		LocalVector<int> key_cursors; // Last key sampled in each track, speeds up sequential playback.
 		Ref<Animation> animation;
 	};
 
@@ -223,13 +225,39 @@ private:
 
 	NodePath root;
 
-	void _animation_process_animation(AnimationData *p_anim, float p_time, float p_delta, float p_interp, bool p_is_current = true, bool p_seeked = false, bool p_started = false);
+	enum {
+		PROCESS_STAGE_SAMPLE = 1, // Tracks that only write to the accumulation caches, safe to run on a worker thread.
+		PROCESS_STAGE_APPLY = 2, // Tracks that touch the scene or call methods.
+		PROCESS_STAGE_ALL = PROCESS_STAGE_SAMPLE | PROCESS_STAGE_APPLY,
+	};
+
+	struct StageCall {
+		AnimationData *anim = nullptr;
+		float time = 0;
+		float delta = 0;
+		float interp = 0;
+		bool is_current = false;
+		bool seeked = false;
+		bool started = false;
+	};
+
+	LocalVector<StageCall> apply_calls; // Recorded while sampling, replayed by the apply stage.
+	float batch_delta = 0;
+
+	void _animation_process_animation(AnimationData *p_anim, float p_time, float p_delta, float p_interp, bool p_is_current = true, bool p_seeked = false, bool p_started = false, int p_stages = PROCESS_STAGE_ALL);
 
 	void _ensure_node_caches(AnimationData *p_anim);
-	void _animation_process_data(PlaybackData &cd, float p_delta, float p_blend, bool p_seeked, bool p_started);
-	void _animation_process2(float p_delta, bool p_started);
+	void _animation_process_data(PlaybackData &cd, float p_delta, float p_blend, bool p_seeked, bool p_started, int p_stages = PROCESS_STAGE_ALL);
+	void _animation_process2(float p_delta, bool p_started, int p_stages = PROCESS_STAGE_ALL);
 	void _animation_update_transforms();
 	void _animation_process(float p_delta);
+	void _animation_process_finish();
+
+	friend class AnimationProcessBatch;
+	bool _batch_prepare(float p_delta);
+	void _batch_sample();
+	void _batch_apply();
+	void _process_batched(float p_delta);
 
 	void _node_removed(Node *p_node);
 	void _stop_playing_caches();
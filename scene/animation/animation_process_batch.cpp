@@ -0,0 +1,132 @@
+/*************************************************************************/
+/*  animation_process_batch.cpp                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "animation_process_batch.h"
+
+#include "core/project_settings.h"
+#include "scene/animation/animation_player.h"
+#include "scene/animation/animation_tree.h"
+#include "scene/main/scene_tree.h"
+
+AnimationProcessBatch *AnimationProcessBatch::singleton = nullptr;
+
+void AnimationProcessBatch::add_player(AnimationPlayer *p_player) {
+	ERR_FAIL_COND(flushing);
+	players.push_back(p_player);
+}
+
+void AnimationProcessBatch::remove_player(AnimationPlayer *p_player) {
+	// Only clear the entry, so removing from the apply stage is safe.
+	for (uint32_t i = 0; i < players.size(); i++) {
+		if (players[i] == p_player) {
+			players[i] = nullptr;
+		}
+	}
+}
+
+void AnimationProcessBatch::add_tree(AnimationTree *p_tree) {
+	ERR_FAIL_COND(flushing);
+	trees.push_back(p_tree);
+}
+
+void AnimationProcessBatch::remove_tree(AnimationTree *p_tree) {
+	for (uint32_t i = 0; i < trees.size(); i++) {
+		if (trees[i] == p_tree) {
+			trees[i] = nullptr;
+		}
+	}
+}
+
+void AnimationProcessBatch::_process_sample(uint32_t p_index, void *p_userdata) {
+	if (p_index < players.size()) {
+		if (players[p_index]) {
+			players[p_index]->_batch_sample();
+		}
+	} else if (trees[p_index - players.size()]) {
+		trees[p_index - players.size()]->_process_graph_blend();
+	}
+}
+
+void AnimationProcessBatch::_flush() {
+	uint32_t count = players.size() + trees.size();
+	if (count == 0) {
+		return;
+	}
+
+	flushing = true;
+
+#ifndef NO_THREADS
+	if (count > 1) {
+		// Flushed from the SceneTree's internal process, on the main thread.
+		SceneTree::get_singleton()->get_work_pool().do_work(count, this, &AnimationProcessBatch::_process_sample, nullptr);
+	} else {
+		_process_sample(0, nullptr);
+	}
+#else
+	for (uint32_t i = 0; i < count; i++) {
+		_process_sample(i, nullptr);
+	}
+#endif
+
+	// Method, audio and animation tracks as well as the final write-back touch
+	// the scene, so they are done in the order the nodes were processed.
+	for (uint32_t i = 0; i < players.size(); i++) {
+		if (players[i]) {
+			players[i]->_batch_apply();
+		}
+	}
+	for (uint32_t i = 0; i < trees.size(); i++) {
+		if (trees[i]) {
+			trees[i]->_process_graph_apply();
+		}
+	}
+
+	players.clear();
+	trees.clear();
+
+	flushing = false;
+}
+
+void AnimationProcessBatch::flush() {
+	if (singleton) {
+		singleton->_flush();
+	}
+}
+
+AnimationProcessBatch::AnimationProcessBatch() {
+	singleton = this;
+#ifndef NO_THREADS
+	use_threads = GLOBAL_DEF("animation/processing/use_threads", true);
+#endif
+}
+
+AnimationProcessBatch::~AnimationProcessBatch() {
+	singleton = nullptr;
+}
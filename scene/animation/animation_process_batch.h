@@ -0,0 +1,72 @@
+/*************************************************************************/
+/*  animation_process_batch.h                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef ANIMATION_PROCESS_BATCH_H
+#define ANIMATION_PROCESS_BATCH_H
+
+#include "core/local_vector.h"
+
+class AnimationPlayer;
+class AnimationTree;
+
+// Collects the AnimationPlayers and AnimationTrees processed during the internal
+// (physics) process notifications, samples and blends them in parallel and writes
+// the results back to the scene on the main thread once all of them are done.
+class AnimationProcessBatch {
+	static AnimationProcessBatch *singleton;
+
+	bool use_threads = false;
+	bool flushing = false;
+
+	LocalVector<AnimationPlayer *> players;
+	LocalVector<AnimationTree *> trees;
+
+	void _process_sample(uint32_t p_index, void *p_userdata);
+	void _flush();
+
+public:
+	static AnimationProcessBatch *get_singleton() { return singleton; }
+
+	// Players and trees are processed right away when this returns false.
+	bool is_enabled() const { return use_threads && !flushing; }
+
+	void add_player(AnimationPlayer *p_player);
+	void remove_player(AnimationPlayer *p_player);
+
+	void add_tree(AnimationTree *p_tree);
+	void remove_tree(AnimationTree *p_tree);
+
+	static void flush();
+
+	AnimationProcessBatch();
+	~AnimationProcessBatch();
+};
+
+#endif // ANIMATION_PROCESS_BATCH_H
@@ -33,6 +33,7 @@
 #include "animation_blend_tree.h"
 #include "core/engine.h"
 #include "core/method_bind_ext.gen.inc"
+#include "scene/animation/animation_process_batch.h"
 #include "scene/scene_string_names.h"
 #include "servers/audio/audio_stream.h"
 
@@ -107,7 +108,7 @@ void AnimationNode::blend_animation(const StringName &p_animation, float p_time,
 
 	AnimationState anim_state;
 	anim_state.blend = p_blend;
-	anim_state.track_blends = &blends;
+	anim_state.track_blends = blends;
 	anim_state.delta = p_delta;
 	anim_state.time = p_time;
 	anim_state.animation = animation;
@@ -700,6 +701,7 @@ bool AnimationTree::_update_caches(AnimationPlayer *player) {
 	}
 
 	state.track_count = idx;
+	track_bindings.clear();
 
 	cache_valid = true;
 
@@ -714,10 +716,57 @@ void AnimationTree::_clear_caches() {
 	playing_caches.clear();
 
 	track_cache.clear();
+	track_bindings.clear();
 	cache_valid = false;
 }
 
+LocalVector<AnimationTree::TrackBinding> &AnimationTree::_get_track_bindings(const Ref<Animation> &p_animation) {
+	Map<ObjectID, LocalVector<TrackBinding>>::Element *E = track_bindings.find(p_animation->get_instance_id());
+	if (E && E->get().size() == (uint32_t)p_animation->get_track_count()) {
+		return E->get();
+	}
+
+	if (!E) {
+		E = track_bindings.insert(p_animation->get_instance_id(), LocalVector<TrackBinding>());
+	}
+
+	// Resolve track paths once per animation instead of once per track and frame.
+	LocalVector<TrackBinding> &bindings = E->get();
+	bindings.resize(p_animation->get_track_count());
+	for (int i = 0; i < p_animation->get_track_count(); i++) {
+		TrackBinding &binding = bindings[i];
+		binding = TrackBinding();
+
+		NodePath path = p_animation->track_get_path(i);
+
+		ERR_CONTINUE(!track_cache.has(path));
+
+		TrackCache *track = track_cache[path];
+		if (track->type != p_animation->track_get_type(i)) {
+			continue; //may happen should not
+		}
+
+		ERR_CONTINUE(!state.track_map.has(path));
+		int blend_idx = state.track_map[path];
+
+		ERR_CONTINUE(blend_idx < 0 || blend_idx >= state.track_count);
+
+		binding.track = track;
+		binding.blend_idx = blend_idx;
+		binding.root_motion = root_motion_track == path;
+	}
+
+	return bindings;
+}
+
 void AnimationTree::_process_graph(float p_delta) {
+	if (_process_graph_setup(p_delta)) {
+		_process_graph_blend();
+		_process_graph_apply();
+	}
+}
+
+bool AnimationTree::_process_graph_setup(float p_delta) {
 	_update_properties(); //if properties need updating, update them
 
 	//check all tracks, see if they need modification
@@ -728,14 +777,14 @@ void AnimationTree::_process_graph(float p_delta) {
 		ERR_PRINT("AnimationTree: root AnimationNode is not set, disabling playback.");
 		set_active(false);
 		cache_valid = false;
-		return;
+		return false;
 	}
 
 	if (!has_node(animation_player)) {
 		ERR_PRINT("AnimationTree: no valid AnimationPlayer path set, disabling playback");
 		set_active(false);
 		cache_valid = false;
-		return;
+		return false;
 	}
 
 	AnimationPlayer *player = Object::cast_to<AnimationPlayer>(get_node(animation_player));
@@ -765,12 +814,12 @@ void AnimationTree::_process_graph(float p_delta) {
 		ERR_PRINT("AnimationTree: path points to a node not an AnimationPlayer, disabling playback");
 		set_active(false);
 		cache_valid = false;
-		return;
+		return false;
 	}
 
 	if (!cache_valid) {
 		if (!_update_caches(player)) {
-			return;
+			return false;
 		}
 	}
 
@@ -807,93 +856,73 @@ void AnimationTree::_process_graph(float p_delta) {
 		root->_pre_process(SceneStringNames::get_singleton()->parameters_base_path, nullptr, &state, p_delta, false, Vector<StringName>());
 	}
 
-	if (!state.valid) {
-		return; //state is not valid. do nothing.
-	}
-	//apply value/transform/bezier blends to track caches and execute method/audio/animation tracks
-
-	{
-		bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
-
-		for (List<AnimationNode::AnimationState>::Element *E = state.animation_states.front(); E; E = E->next()) {
-			const AnimationNode::AnimationState &as = E->get();
-
-			Ref<Animation> a = as.animation;
-			float time = as.time;
-			float delta = as.delta;
-			bool seeked = as.seeked;
-
-			for (int i = 0; i < a->get_track_count(); i++) {
-				NodePath path = a->track_get_path(i);
+	return state.valid; //if state is not valid, do nothing.
+}
 
-				ERR_CONTINUE(!track_cache.has(path));
+void AnimationTree::_process_graph_blend() {
+	if (!cache_valid) {
+		return;
+	}
 
-				TrackCache *track = track_cache[path];
-				if (track->type != a->track_get_type(i)) {
-					continue; //may happen should not
-				}
+	//apply value/transform/bezier blends to track caches
 
-				track->root_motion = root_motion_track == path;
+	for (List<AnimationNode::AnimationState>::Element *E = state.animation_states.front(); E; E = E->next()) {
+		const AnimationNode::AnimationState &as = E->get();
 
-				ERR_CONTINUE(!state.track_map.has(path));
-				int blend_idx = state.track_map[path];
+		Ref<Animation> a = as.animation;
+		float time = as.time;
+		float delta = as.delta;
 
-				ERR_CONTINUE(blend_idx < 0 || blend_idx >= state.track_count);
+		LocalVector<TrackBinding> &bindings = _get_track_bindings(a);
 
-				float blend = (*as.track_blends)[blend_idx];
+		for (int i = 0; i < a->get_track_count() && i < (int)bindings.size(); i++) {
+			TrackBinding &binding = bindings[i];
+			TrackCache *track = binding.track;
+			if (!track) {
+				continue;
+			}
 
-				if (blend < CMP_EPSILON) {
-					continue; //nothing to blend
-				}
+			track->root_motion = binding.root_motion;
 
-				switch (track->type) {
-					case Animation::TYPE_TRANSFORM: {
-						TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
-
-						if (track->root_motion) {
-							if (t->process_pass != process_pass) {
-								t->process_pass = process_pass;
-								t->loc = Vector3();
-								t->rot = Quat();
-								t->rot_blend_accum = 0;
-								t->scale = Vector3(1, 1, 1);
-							}
+			float blend = as.track_blends[binding.blend_idx];
 
-							float prev_time = time - delta;
-							if (prev_time < 0) {
-								if (!a->has_loop()) {
-									prev_time = 0;
-								} else {
-									prev_time = a->get_length() + prev_time;
-								}
-							}
-
-							Vector3 loc[2];
-							Quat rot[2];
-							Vector3 scale[2];
-
-							if (prev_time > time) {
-								Error err = a->transform_track_interpolate(i, prev_time, &loc[0], &rot[0], &scale[0]);
-								if (err != OK) {
-									continue;
-								}
+			if (blend < CMP_EPSILON) {
+				continue; //nothing to blend
+			}
 
-								a->transform_track_interpolate(i, a->get_length(), &loc[1], &rot[1], &scale[1]);
+			switch (track->type) {
+				case Animation::TYPE_TRANSFORM: {
+					TrackCacheTransform *t = static_cast<TrackCacheTransform *>(track);
 
-								t->loc += (loc[1] - loc[0]) * blend;
-								t->scale += (scale[1] - scale[0]) * blend;
-								Quat q = Quat().slerp(rot[0].normalized().inverse() * rot[1].normalized(), blend).normalized();
-								t->rot = (t->rot * q).normalized();
+					if (track->root_motion) {
+						if (t->process_pass != process_pass) {
+							t->process_pass = process_pass;
+							t->loc = Vector3();
+							t->rot = Quat();
+							t->rot_blend_accum = 0;
+							t->scale = Vector3(1, 1, 1);
+						}
 
+						float prev_time = time - delta;
+						if (prev_time < 0) {
+							if (!a->has_loop()) {
 								prev_time = 0;
+							} else {
+								prev_time = a->get_length() + prev_time;
 							}
+						}
+
+						Vector3 loc[2];
+						Quat rot[2];
+						Vector3 scale[2];
 
+						if (prev_time > time) {
 							Error err = a->transform_track_interpolate(i, prev_time, &loc[0], &rot[0], &scale[0]);
 							if (err != OK) {
 								continue;
 							}
 
-							a->transform_track_interpolate(i, time, &loc[1], &rot[1], &scale[1]);
+							a->transform_track_interpolate(i, a->get_length(), &loc[1], &rot[1], &scale[1]);
 
 							t->loc += (loc[1] - loc[0]) * blend;
 							t->scale += (scale[1] - scale[0]) * blend;
@@ -901,123 +930,227 @@ void AnimationTree::_process_graph(float p_delta) {
 							t->rot = (t->rot * q).normalized();
 
 							prev_time = 0;
+						}
 
-						} else {
-							Vector3 loc;
-							Quat rot;
-							Vector3 scale;
-
-							Error err = a->transform_track_interpolate(i, time, &loc, &rot, &scale);
-							//ERR_CONTINUE(err!=OK); //used for testing, should be removed
-
-							if (t->process_pass != process_pass) {
-								t->process_pass = process_pass;
-								t->loc = loc;
-								t->rot = rot;
-								t->rot_blend_accum = 0;
-								t->scale = scale;
-							}
+						Error err = a->transform_track_interpolate(i, prev_time, &loc[0], &rot[0], &scale[0]);
+						if (err != OK) {
+							continue;
+						}
 
-							if (err != OK) {
-								continue;
-							}
+						a->transform_track_interpolate(i, time, &loc[1], &rot[1], &scale[1]);
 
-							t->loc = t->loc.lerp(loc, blend);
-							if (t->rot_blend_accum == 0) {
-								t->rot = rot;
-								t->rot_blend_accum = blend;
-							} else {
-								float rot_total = t->rot_blend_accum + blend;
-								t->rot = rot.slerp(t->rot, t->rot_blend_accum / rot_total).normalized();
-								t->rot_blend_accum = rot_total;
-							}
-							t->scale = t->scale.lerp(scale, blend);
-						}
+						t->loc += (loc[1] - loc[0]) * blend;
+						t->scale += (scale[1] - scale[0]) * blend;
+						Quat q = Quat().slerp(rot[0].normalized().inverse() * rot[1].normalized(), blend).normalized();
+						t->rot = (t->rot * q).normalized();
 
-					} break;
-					case Animation::TYPE_VALUE: {
-						TrackCacheValue *t = static_cast<TrackCacheValue *>(track);
+						prev_time = 0;
 
-						Animation::UpdateMode update_mode = a->value_track_get_update_mode(i);
+					} else {
+						Vector3 loc;
+						Quat rot;
+						Vector3 scale;
 
-						if (update_mode == Animation::UPDATE_CONTINUOUS || update_mode == Animation::UPDATE_CAPTURE) { //delta == 0 means seek
+						Error err = a->transform_track_interpolate(i, time, &loc, &rot, &scale, &binding.key_cursor);
+						//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 
-							Variant value = a->value_track_interpolate(i, time);
+						if (t->process_pass != process_pass) {
+							t->process_pass = process_pass;
+							t->loc = loc;
+							t->rot = rot;
+							t->rot_blend_accum = 0;
+							t->scale = scale;
+						}
 
-							if (value == Variant()) {
-								continue;
-							}
+						if (err != OK) {
+							continue;
+						}
 
-							if (t->process_pass != process_pass) {
-								t->value = value;
-								t->process_pass = process_pass;
-							}
+						t->loc = t->loc.lerp(loc, blend);
+						if (t->rot_blend_accum == 0) {
+							t->rot = rot;
+							t->rot_blend_accum = blend;
+						} else {
+							float rot_total = t->rot_blend_accum + blend;
+							t->rot = rot.slerp(t->rot, t->rot_blend_accum / rot_total).normalized();
+							t->rot_blend_accum = rot_total;
+						}
+						t->scale = t->scale.lerp(scale, blend);
+					}
 
-							Variant::interpolate(t->value, value, blend, t->value);
+				} break;
+				case Animation::TYPE_VALUE: {
+					TrackCacheValue *t = static_cast<TrackCacheValue *>(track);
 
-						} else if (delta != 0) {
-							List<int> indices;
-							a->value_track_get_key_indices(i, time, delta, &indices);
+					Animation::UpdateMode update_mode = a->value_track_get_update_mode(i);
 
-							for (List<int>::Element *F = indices.front(); F; F = F->next()) {
-								Variant value = a->track_get_key_value(i, F->get());
-								t->object->set_indexed(t->subpath, value);
-							}
-						}
+					if (update_mode == Animation::UPDATE_CONTINUOUS || update_mode == Animation::UPDATE_CAPTURE) { //delta == 0 means seek
 
-					} break;
-					case Animation::TYPE_METHOD: {
-						if (delta == 0) {
+						Variant value = a->value_track_interpolate(i, time, &binding.key_cursor);
+
+						if (value == Variant()) {
 							continue;
 						}
-						TrackCacheMethod *t = static_cast<TrackCacheMethod *>(track);
 
-						List<int> indices;
+						if (t->process_pass != process_pass) {
+							t->value = value;
+							t->process_pass = process_pass;
+						}
+
+						Variant::interpolate(t->value, value, blend, t->value);
+
+					}
+
+				} break;
+				case Animation::TYPE_BEZIER: {
+					TrackCacheBezier *t = static_cast<TrackCacheBezier *>(track);
+
+					float bezier = a->bezier_track_interpolate(i, time);
+
+					if (t->process_pass != process_pass) {
+						t->value = bezier;
+						t->process_pass = process_pass;
+					}
+
+					t->value = Math::lerp(t->value, bezier, blend);
+
+				} break;
+				default: {
+				} //processed on the main thread
+			}
+		}
+	}
+}
+
+void AnimationTree::_process_graph_apply() {
+	if (!cache_valid) {
+		return;
+	}
 
-						a->method_track_get_key_indices(i, time, delta, &indices);
+	//execute method/audio/animation tracks
+
+	bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
+
+	for (List<AnimationNode::AnimationState>::Element *E = state.animation_states.front(); E; E = E->next()) {
+		const AnimationNode::AnimationState &as = E->get();
+
+		Ref<Animation> a = as.animation;
+		float time = as.time;
+		float delta = as.delta;
+		bool seeked = as.seeked;
+
+		LocalVector<TrackBinding> &bindings = _get_track_bindings(a);
+
+		for (int i = 0; i < a->get_track_count() && i < (int)bindings.size(); i++) {
+			TrackBinding &binding = bindings[i];
+			TrackCache *track = binding.track;
+			if (!track) {
+				continue;
+			}
+
+			track->root_motion = binding.root_motion;
+
+			float blend = as.track_blends[binding.blend_idx];
+
+			if (blend < CMP_EPSILON) {
+				continue; //nothing to blend
+			}
+
+			switch (track->type) {
+				case Animation::TYPE_VALUE: {
+					TrackCacheValue *t = static_cast<TrackCacheValue *>(track);
+
+					Animation::UpdateMode update_mode = a->value_track_get_update_mode(i);
+
+					if (update_mode != Animation::UPDATE_CONTINUOUS && update_mode != Animation::UPDATE_CAPTURE && delta != 0) {
+						List<int> indices;
+						a->value_track_get_key_indices(i, time, delta, &indices);
 
 						for (List<int>::Element *F = indices.front(); F; F = F->next()) {
-							StringName method = a->method_track_get_name(i, F->get());
-							Vector<Variant> params = a->method_track_get_params(i, F->get());
-
-							int s = params.size();
-
-							ERR_CONTINUE(s > VARIANT_ARG_MAX);
-							if (can_call) {
-								t->object->call_deferred(
-										method,
-										s >= 1 ? params[0] : Variant(),
-										s >= 2 ? params[1] : Variant(),
-										s >= 3 ? params[2] : Variant(),
-										s >= 4 ? params[3] : Variant(),
-										s >= 5 ? params[4] : Variant());
-							}
+							Variant value = a->track_get_key_value(i, F->get());
+							t->object->set_indexed(t->subpath, value);
 						}
+					}
 
-					} break;
-					case Animation::TYPE_BEZIER: {
-						TrackCacheBezier *t = static_cast<TrackCacheBezier *>(track);
+				} break;
+				case Animation::TYPE_METHOD: {
+					if (delta == 0) {
+						continue;
+					}
+					TrackCacheMethod *t = static_cast<TrackCacheMethod *>(track);
 
-						float bezier = a->bezier_track_interpolate(i, time);
+					List<int> indices;
 
-						if (t->process_pass != process_pass) {
-							t->value = bezier;
-							t->process_pass = process_pass;
+					a->method_track_get_key_indices(i, time, delta, &indices);
+
+					for (List<int>::Element *F = indices.front(); F; F = F->next()) {
+						StringName method = a->method_track_get_name(i, F->get());
+						Vector<Variant> params = a->method_track_get_params(i, F->get());
+
+						int s = params.size();
+
+						ERR_CONTINUE(s > VARIANT_ARG_MAX);
+						if (can_call) {
+							t->object->call_deferred(
+									method,
+									s >= 1 ? params[0] : Variant(),
+									s >= 2 ? params[1] : Variant(),
+									s >= 3 ? params[2] : Variant(),
+									s >= 4 ? params[3] : Variant(),
+									s >= 5 ? params[4] : Variant());
 						}
+					}
 
-						t->value = Math::lerp(t->value, bezier, blend);
+				} break;
+				case Animation::TYPE_AUDIO: {
+					TrackCacheAudio *t = static_cast<TrackCacheAudio *>(track);
 
-					} break;
-					case Animation::TYPE_AUDIO: {
-						TrackCacheAudio *t = static_cast<TrackCacheAudio *>(track);
+					if (seeked) {
+						//find whathever should be playing
+						int idx = a->track_find_key(i, time);
+						if (idx < 0) {
+							continue;
+						}
 
-						if (seeked) {
-							//find whathever should be playing
-							int idx = a->track_find_key(i, time);
-							if (idx < 0) {
+						Ref<AudioStream> stream = a->audio_track_get_key_stream(i, idx);
+						if (!stream.is_valid()) {
+							t->object->call("stop");
+							t->playing = false;
+							playing_caches.erase(t);
+						} else {
+							float start_ofs = a->audio_track_get_key_start_offset(i, idx);
+							start_ofs += time - a->track_get_key_time(i, idx);
+							float end_ofs = a->audio_track_get_key_end_offset(i, idx);
+							float len = stream->get_length();
+
+							if (start_ofs > len - end_ofs) {
+								t->object->call("stop");
+								t->playing = false;
+								playing_caches.erase(t);
 								continue;
 							}
 
+							t->object->call("set_stream", stream);
+							t->object->call("play", start_ofs);
+
+							t->playing = true;
+							playing_caches.insert(t);
+							if (len && end_ofs > 0) { //force a end at a time
+								t->len = len - start_ofs - end_ofs;
+							} else {
+								t->len = 0;
+							}
+
+							t->start = time;
+						}
+
+					} else {
+						//find stuff to play
+						List<int> to_play;
+						a->track_get_key_indices_in_range(i, time, delta, &to_play);
+						if (to_play.size()) {
+							int idx = to_play.back()->get();
+
 							Ref<AudioStream> stream = a->audio_track_get_key_stream(i, idx);
 							if (!stream.is_valid()) {
 								t->object->call("stop");
@@ -1025,17 +1158,9 @@ void AnimationTree::_process_graph(float p_delta) {
 								playing_caches.erase(t);
 							} else {
 								float start_ofs = a->audio_track_get_key_start_offset(i, idx);
-								start_ofs += time - a->track_get_key_time(i, idx);
 								float end_ofs = a->audio_track_get_key_end_offset(i, idx);
 								float len = stream->get_length();
 
-								if (start_ofs > len - end_ofs) {
-									t->object->call("stop");
-									t->playing = false;
-									playing_caches.erase(t);
-									continue;
-								}
-
 								t->object->call("set_stream", stream);
 								t->object->call("play", start_ofs);
 
@@ -1049,134 +1174,104 @@ void AnimationTree::_process_graph(float p_delta) {
 
 								t->start = time;
 							}
+						} else if (t->playing) {
+							bool loop = a->has_loop();
 
-						} else {
-							//find stuff to play
-							List<int> to_play;
-							a->track_get_key_indices_in_range(i, time, delta, &to_play);
-							if (to_play.size()) {
-								int idx = to_play.back()->get();
-
-								Ref<AudioStream> stream = a->audio_track_get_key_stream(i, idx);
-								if (!stream.is_valid()) {
-									t->object->call("stop");
-									t->playing = false;
-									playing_caches.erase(t);
-								} else {
-									float start_ofs = a->audio_track_get_key_start_offset(i, idx);
-									float end_ofs = a->audio_track_get_key_end_offset(i, idx);
-									float len = stream->get_length();
-
-									t->object->call("set_stream", stream);
-									t->object->call("play", start_ofs);
-
-									t->playing = true;
-									playing_caches.insert(t);
-									if (len && end_ofs > 0) { //force a end at a time
-										t->len = len - start_ofs - end_ofs;
-									} else {
-										t->len = 0;
-									}
-
-									t->start = time;
-								}
-							} else if (t->playing) {
-								bool loop = a->has_loop();
+							bool stop = false;
 
-								bool stop = false;
+							if (!loop && time < t->start) {
+								stop = true;
+							} else if (t->len > 0) {
+								float len = t->start > time ? (a->get_length() - t->start) + time : time - t->start;
 
-								if (!loop && time < t->start) {
+								if (len > t->len) {
 									stop = true;
-								} else if (t->len > 0) {
-									float len = t->start > time ? (a->get_length() - t->start) + time : time - t->start;
-
-									if (len > t->len) {
-										stop = true;
-									}
 								}
+							}
 
-								if (stop) {
-									//time to stop
-									t->object->call("stop");
-									t->playing = false;
-									playing_caches.erase(t);
-								}
+							if (stop) {
+								//time to stop
+								t->object->call("stop");
+								t->playing = false;
+								playing_caches.erase(t);
 							}
 						}
+					}
 
-						float db = Math::linear2db(MAX(blend, 0.00001));
-						if (t->object->has_method("set_unit_db")) {
-							t->object->call("set_unit_db", db);
-						} else {
-							t->object->call("set_volume_db", db);
-						}
-					} break;
-					case Animation::TYPE_ANIMATION: {
-						TrackCacheAnimation *t = static_cast<TrackCacheAnimation *>(track);
+					float db = Math::linear2db(MAX(blend, 0.00001));
+					if (t->object->has_method("set_unit_db")) {
+						t->object->call("set_unit_db", db);
+					} else {
+						t->object->call("set_volume_db", db);
+					}
+				} break;
+				case Animation::TYPE_ANIMATION: {
+					TrackCacheAnimation *t = static_cast<TrackCacheAnimation *>(track);
 
-						AnimationPlayer *player2 = Object::cast_to<AnimationPlayer>(t->object);
+					AnimationPlayer *player2 = Object::cast_to<AnimationPlayer>(t->object);
 
-						if (!player2) {
+					if (!player2) {
+						continue;
+					}
+
+					if (delta == 0 || seeked) {
+						//seek
+						int idx = a->track_find_key(i, time);
+						if (idx < 0) {
 							continue;
 						}
 
-						if (delta == 0 || seeked) {
-							//seek
-							int idx = a->track_find_key(i, time);
-							if (idx < 0) {
-								continue;
-							}
+						float pos = a->track_get_key_time(i, idx);
 
-							float pos = a->track_get_key_time(i, idx);
+						StringName anim_name = a->animation_track_get_key_animation(i, idx);
+						if (String(anim_name) == "[stop]" || !player2->has_animation(anim_name)) {
+							continue;
+						}
 
-							StringName anim_name = a->animation_track_get_key_animation(i, idx);
-							if (String(anim_name) == "[stop]" || !player2->has_animation(anim_name)) {
-								continue;
-							}
+						Ref<Animation> anim = player2->get_animation(anim_name);
 
-							Ref<Animation> anim = player2->get_animation(anim_name);
+						float at_anim_pos;
 
-							float at_anim_pos;
+						if (anim->has_loop()) {
+							at_anim_pos = Math::fposmod(time - pos, anim->get_length()); //seek to loop
+						} else {
+							at_anim_pos = MAX(anim->get_length(), time - pos); //seek to end
+						}
 
-							if (anim->has_loop()) {
-								at_anim_pos = Math::fposmod(time - pos, anim->get_length()); //seek to loop
-							} else {
-								at_anim_pos = MAX(anim->get_length(), time - pos); //seek to end
-							}
+						if (player2->is_playing() || seeked) {
+							player2->play(anim_name);
+							player2->seek(at_anim_pos);
+							t->playing = true;
+							playing_caches.insert(t);
+						} else {
+							player2->set_assigned_animation(anim_name);
+							player2->seek(at_anim_pos, true);
+						}
+					} else {
+						//find stuff to play
+						List<int> to_play;
+						a->track_get_key_indices_in_range(i, time, delta, &to_play);
+						if (to_play.size()) {
+							int idx = to_play.back()->get();
 
-							if (player2->is_playing() || seeked) {
+							StringName anim_name = a->animation_track_get_key_animation(i, idx);
+							if (String(anim_name) == "[stop]" || !player2->has_animation(anim_name)) {
+								if (playing_caches.has(t)) {
+									playing_caches.erase(t);
+									player2->stop();
+									t->playing = false;
+								}
+							} else {
 								player2->play(anim_name);
-								player2->seek(at_anim_pos);
 								t->playing = true;
 								playing_caches.insert(t);
-							} else {
-								player2->set_assigned_animation(anim_name);
-								player2->seek(at_anim_pos, true);
-							}
-						} else {
-							//find stuff to play
-							List<int> to_play;
-							a->track_get_key_indices_in_range(i, time, delta, &to_play);
-							if (to_play.size()) {
-								int idx = to_play.back()->get();
-
-								StringName anim_name = a->animation_track_get_key_animation(i, idx);
-								if (String(anim_name) == "[stop]" || !player2->has_animation(anim_name)) {
-									if (playing_caches.has(t)) {
-										playing_caches.erase(t);
-										player2->stop();
-										t->playing = false;
-									}
-								} else {
-									player2->play(anim_name);
-									t->playing = true;
-									playing_caches.insert(t);
-								}
 							}
 						}
+					}
 
-					} break;
-				}
+				} break;
+				default: {
+				} //already blended
 			}
 		}
 	}
@@ -1236,16 +1331,31 @@ void AnimationTree::advance(float p_time) {
 	_process_graph(p_time);
 }
 
+void AnimationTree::_process_batched(float p_delta) {
+	AnimationProcessBatch *batch = AnimationProcessBatch::get_singleton();
+	if (batch && batch->is_enabled()) {
+		// The graph is evaluated right away, sampling and blending is left to the batch.
+		if (_process_graph_setup(p_delta)) {
+			batch->add_tree(this);
+		}
+	} else {
+		_process_graph(p_delta);
+	}
+}
+
 void AnimationTree::_notification(int p_what) {
 	if (active && p_what == NOTIFICATION_INTERNAL_PHYSICS_PROCESS && process_mode == ANIMATION_PROCESS_PHYSICS) {
-		_process_graph(get_physics_process_delta_time());
+		_process_batched(get_physics_process_delta_time());
 	}
 
 	if (active && p_what == NOTIFICATION_INTERNAL_PROCESS && process_mode == ANIMATION_PROCESS_IDLE) {
-		_process_graph(get_process_delta_time());
+		_process_batched(get_process_delta_time());
 	}
 
 	if (p_what == NOTIFICATION_EXIT_TREE) {
+		if (AnimationProcessBatch::get_singleton()) {
+			AnimationProcessBatch::get_singleton()->remove_tree(this);
+		}
 		_clear_caches();
 		if (last_animation_player.is_valid()) {
 			Object *player = ObjectDB::get_instance(last_animation_player);
@@ -1328,6 +1438,7 @@ String AnimationTree::get_configuration_warning() const {
 
 void AnimationTree::set_root_motion_track(const NodePath &p_track) {
 	root_motion_track = p_track;
+	track_bindings.clear();
 }
 
 NodePath AnimationTree::get_root_motion_track() const {
@@ -65,7 +65,7 @@ public:
 		Ref<Animation> animation;
 		float time;
 		float delta;
-		const Vector<float> *track_blends;
+		Vector<float> track_blends; // Copied, nodes may be shared by trees processed in the same batch.
 		float blend;
 		bool seeked;
 	};
@@ -248,6 +248,17 @@ private:
 	HashMap<NodePath, TrackCache *> track_cache;
 	Set<TrackCache *> playing_caches;
 
+	// Resolved once per animation, so processing doesn't look paths up for every track.
+	struct TrackBinding {
+		TrackCache *track = nullptr; // Null if the track can't be processed.
+		int blend_idx = -1;
+		bool root_motion = false;
+		int key_cursor = -1;
+	};
+
+	Map<ObjectID, LocalVector<TrackBinding>> track_bindings;
+	LocalVector<TrackBinding> &_get_track_bindings(const Ref<Animation> &p_animation);
+
 	Ref<AnimationNode> root;
 
 	AnimationProcessMode process_mode;
@@ -263,6 +274,13 @@ private:
 	bool _update_caches(AnimationPlayer *player);
 	void _process_graph(float p_delta);
 
+	// Processing stages, the blend stage doesn't touch the scene and can run on a worker thread.
+	friend class AnimationProcessBatch;
+	bool _process_graph_setup(float p_delta);
+	void _process_graph_blend();
+	void _process_graph_apply();
+	void _process_batched(float p_delta);
+
 	uint64_t setup_pass;
 	uint64_t process_pass;
 
@@ -29,6 +29,8 @@
 /*************************************************************************/
 
 #include "box_container.h"
+
+#include "core/local_vector.h"
 #include "label.h"
 #include "margin_container.h"
 
@@ -50,7 +52,8 @@ void BoxContainer::_resort() {
 	int stretch_min = 0;
 	int stretch_avail = 0;
 	float stretch_ratio_total = 0;
-	Map<Control *, _MinSizeCache> min_size_cache;
+	LocalVector<_MinSizeCache> min_size_cache; // indexed like the children, avoids a tree lookup per child and pass
+	min_size_cache.resize(get_child_count());
 
 	for (int i = 0; i < get_child_count(); i++) {
 		Control *c = Object::cast_to<Control>(get_child(i));
@@ -80,7 +83,7 @@ void BoxContainer::_resort() {
 			stretch_ratio_total += c->get_stretch_ratio();
 		}
 		msc.final_size = msc.min_size;
-		min_size_cache[c] = msc;
+		min_size_cache[i] = msc;
 		children_count++;
 	}
 
@@ -114,8 +117,7 @@ void BoxContainer::_resort() {
 				continue;
 			}
 
-			ERR_FAIL_COND(!min_size_cache.has(c));
-			_MinSizeCache &msc = min_size_cache[c];
+			_MinSizeCache &msc = min_size_cache[i];
 
 			if (msc.will_stretch) { //wants to stretch
 				//let's see if it can really stretch
@@ -169,7 +171,7 @@ void BoxContainer::_resort() {
 			continue;
 		}
 
-		_MinSizeCache &msc = min_size_cache[c];
+		_MinSizeCache &msc = min_size_cache[i];
 
 		if (first) {
 			first = false;
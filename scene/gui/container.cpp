@@ -121,14 +121,26 @@ void Container::fit_child_in_rect(Control *p_child, const Rect2 &p_rect) {
 		}
 	}
 
+	// Only touch what differs, setters queue a redraw even when nothing changes
+	// and most children keep their rect when a sibling is resized.
 	for (int i = 0; i < 4; i++) {
-		p_child->set_anchor(Margin(i), ANCHOR_BEGIN);
+		if (p_child->get_anchor(Margin(i)) != ANCHOR_BEGIN) {
+			p_child->set_anchor(Margin(i), ANCHOR_BEGIN);
+		}
 	}
 
-	p_child->set_position(r.position);
-	p_child->set_size(r.size);
-	p_child->set_rotation(0);
-	p_child->set_scale(Vector2(1, 1));
+	if (p_child->get_position() != r.position) {
+		p_child->set_position(r.position);
+	}
+	if (p_child->get_size() != r.size) {
+		p_child->set_size(r.size);
+	}
+	if (p_child->get_rotation() != 0) {
+		p_child->set_rotation(0);
+	}
+	if (p_child->get_scale() != Vector2(1, 1)) {
+		p_child->set_scale(Vector2(1, 1));
+	}
 }
 
 void Container::queue_sort() {
@@ -34,6 +34,7 @@
 #include "core/message_queue.h"
 #include "core/os/keyboard.h"
 #include "core/os/os.h"
+#include "core/os/thread.h"
 #include "core/print_string.h"
 #include "core/project_settings.h"
 #include "scene/gui/label.h"
@@ -442,6 +443,10 @@ void Control::add_child_notify(Node *p_child) {
 	if (child_w && child_w->theme.is_null() && (data.theme_owner || data.theme_owner_window)) {
 		_propagate_theme_changed(child_w, data.theme_owner, data.theme_owner_window); //need to propagate here, since many controls may require setting up stuff
 	}
+
+	if ((child_c && child_c->data.theme.is_valid()) || (child_w && child_w->theme.is_valid())) {
+		_invalidate_theme_caches(); //not propagated, but items missing from its theme are now looked up elsewhere
+	}
 }
 
 void Control::remove_child_notify(Node *p_child) {
@@ -456,6 +461,10 @@ void Control::remove_child_notify(Node *p_child) {
 	if (child_w && (child_w->theme_owner || child_w->theme_owner_window) && child_w->theme.is_null()) {
 		_propagate_theme_changed(child_w, nullptr, nullptr);
 	}
+
+	if ((child_c && child_c->data.theme.is_valid()) || (child_w && child_w->theme.is_valid())) {
+		_invalidate_theme_caches();
+	}
 }
 
 void Control::_update_canvas_item_transform() {
@@ -585,6 +594,7 @@ void Control::_notification(int p_notification) {
 
 		} break;
 		case NOTIFICATION_THEME_CHANGED: {
+			_clear_theme_cache();
 			minimum_size_changed();
 			update();
 		} break;
@@ -771,6 +781,45 @@ bool Control::_find_theme_item(Control *p_theme_owner, Window *p_theme_owner_win
 	return false;
 }
 
+template <class T>
+T Control::_get_theme_item_cached(HashMap<ThemeItemKey, T, ThemeItemKeyHasher> &r_cache, T (*p_get_func)(Control *, Window *, const StringName &, const StringName &), const StringName &p_name, const StringName &p_type) const {
+	if (Thread::get_caller_id() != Thread::get_main_id()) {
+		// The caches are written by lookups, only the main thread may use them.
+		return p_get_func(data.theme_owner, data.theme_owner_window, p_name, p_type);
+	}
+
+	if (data.theme_cache_version != Theme::get_change_version()) {
+		_clear_theme_cache();
+	}
+
+	ThemeItemKey key;
+	key.name = p_name;
+	key.type = p_type;
+
+	const T *cached = r_cache.getptr(key);
+	if (cached) {
+		return *cached;
+	}
+
+	T item = p_get_func(data.theme_owner, data.theme_owner_window, p_name, p_type);
+	r_cache.set(key, item);
+	return item;
+}
+
+void Control::_clear_theme_cache() const {
+	data.icon_cache.clear();
+	data.shader_cache.clear();
+	data.style_cache.clear();
+	data.font_cache.clear();
+	data.color_cache.clear();
+	data.constant_cache.clear();
+	data.theme_cache_version = Theme::get_change_version();
+}
+
+void Control::_invalidate_theme_caches() {
+	Theme::bump_change_version();
+}
+
 bool Control::_has_theme_item(Control *p_theme_owner, Window *p_theme_owner_window, bool (Theme::*has_func)(const StringName &, const StringName &) const, const StringName &p_name, const StringName &p_type) {
 	// try with custom themes
 	Control *theme_owner = p_theme_owner;
@@ -822,7 +871,7 @@ Ref<Texture2D> Control::get_theme_icon(const StringName &p_name, const StringNam
 
 	StringName type = p_type ? p_type : get_class_name();
 
-	return get_icons(data.theme_owner, data.theme_owner_window, p_name, type);
+	return _get_theme_item_cached(data.icon_cache, &Control::get_icons, p_name, type);
 }
 
 Ref<Texture2D> Control::get_icons(Control *p_theme_owner, Window *p_theme_owner_window, const StringName &p_name, const StringName &p_type) {
@@ -851,7 +900,7 @@ Ref<Shader> Control::get_theme_shader(const StringName &p_name, const StringName
 
 	StringName type = p_type ? p_type : get_class_name();
 
-	return get_shaders(data.theme_owner, data.theme_owner_window, p_name, type);
+	return _get_theme_item_cached(data.shader_cache, &Control::get_shaders, p_name, type);
 }
 
 Ref<Shader> Control::get_shaders(Control *p_theme_owner, Window *p_theme_owner_window, const StringName &p_name, const StringName &p_type) {
@@ -880,7 +929,7 @@ Ref<StyleBox> Control::get_theme_stylebox(const StringName &p_name, const String
 
 	StringName type = p_type ? p_type : get_class_name();
 
-	return get_styleboxs(data.theme_owner, data.theme_owner_window, p_name, type);
+	return _get_theme_item_cached(data.style_cache, &Control::get_styleboxs, p_name, type);
 }
 
 Ref<StyleBox> Control::get_styleboxs(Control *p_theme_owner, Window *p_theme_owner_window, const StringName &p_name, const StringName &p_type) {
@@ -909,7 +958,7 @@ Ref<Font> Control::get_theme_font(const StringName &p_name, const StringName &p_
 
 	StringName type = p_type ? p_type : get_class_name();
 
-	return get_fonts(data.theme_owner, data.theme_owner_window, p_name, type);
+	return _get_theme_item_cached(data.font_cache, &Control::get_fonts, p_name, type);
 }
 
 Ref<Font> Control::get_fonts(Control *p_theme_owner, Window *p_theme_owner_window, const StringName &p_name, const StringName &p_type) {
@@ -938,7 +987,7 @@ Color Control::get_theme_color(const StringName &p_name, const StringName &p_typ
 
 	StringName type = p_type ? p_type : get_class_name();
 
-	return get_colors(data.theme_owner, data.theme_owner_window, p_name, type);
+	return _get_theme_item_cached(data.color_cache, &Control::get_colors, p_name, type);
 }
 
 Color Control::get_colors(Control *p_theme_owner, Window *p_theme_owner_window, const StringName &p_name, const StringName &p_type) {
@@ -966,7 +1015,7 @@ int Control::get_theme_constant(const StringName &p_name, const StringName &p_ty
 
 	StringName type = p_type ? p_type : get_class_name();
 
-	return get_constants(data.theme_owner, data.theme_owner_window, p_name, type);
+	return _get_theme_item_cached(data.constant_cache, &Control::get_constants, p_name, type);
 }
 
 int Control::get_constants(Control *p_theme_owner, Window *p_theme_owner_window, const StringName &p_name, const StringName &p_type) {
@@ -2062,6 +2111,7 @@ void Control::_propagate_theme_changed(Node *p_at, Control *p_owner, Window *p_o
 }
 
 void Control::_theme_changed() {
+	_invalidate_theme_caches();
 	_propagate_theme_changed(this, this, nullptr, false);
 }
 
@@ -2074,6 +2124,8 @@ void Control::set_theme(const Ref<Theme> &p_theme) {
 		data.theme->disconnect("changed", callable_mp(this, &Control::_theme_changed));
 	}
 
+	_invalidate_theme_caches();
+
 	data.theme = p_theme;
 	if (!p_theme.is_null()) {
 		data.theme_owner = this;
@@ -2872,6 +2924,7 @@ Control::Control() {
 	data.RI = nullptr;
 	data.theme_owner = nullptr;
 	data.theme_owner_window = nullptr;
+	data.theme_cache_version = 0;
 	data.default_cursor = CURSOR_ARROW;
 	data.h_size_flags = SIZE_FILL;
 	data.v_size_flags = SIZE_FILL;
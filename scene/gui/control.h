@@ -140,6 +140,17 @@ private:
 		}
 	};
 
+	struct ThemeItemKey {
+		StringName name;
+		StringName type;
+
+		bool operator==(const ThemeItemKey &p_key) const { return name == p_key.name && type == p_key.type; }
+	};
+
+	struct ThemeItemKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const ThemeItemKey &p_key) { return hash_djb2_one_32(p_key.type.hash(), p_key.name.hash()); }
+	};
+
 	struct Data {
 		Point2 pos_cache;
 		Size2 size_cache;
@@ -196,6 +207,17 @@ private:
 		HashMap<StringName, Color> color_override;
 		HashMap<StringName, int> constant_override;
 
+		// Items resolved through the theme owners, dropped on NOTIFICATION_THEME_CHANGED
+		// or when theme_cache_version no longer matches Theme::get_change_version().
+		// Only used from the main thread.
+		mutable uint64_t theme_cache_version;
+		mutable HashMap<ThemeItemKey, Ref<Texture2D>, ThemeItemKeyHasher> icon_cache;
+		mutable HashMap<ThemeItemKey, Ref<Shader>, ThemeItemKeyHasher> shader_cache;
+		mutable HashMap<ThemeItemKey, Ref<StyleBox>, ThemeItemKeyHasher> style_cache;
+		mutable HashMap<ThemeItemKey, Ref<Font>, ThemeItemKeyHasher> font_cache;
+		mutable HashMap<ThemeItemKey, Color, ThemeItemKeyHasher> color_cache;
+		mutable HashMap<ThemeItemKey, int, ThemeItemKeyHasher> constant_cache;
+
 	} data;
 
 	// used internally
@@ -240,6 +262,11 @@ private:
 
 	_FORCE_INLINE_ static bool _has_theme_item(Control *p_theme_owner, Window *p_theme_owner_window, bool (Theme::*has_func)(const StringName &, const StringName &) const, const StringName &p_name, const StringName &p_type);
 
+	template <class T>
+	_FORCE_INLINE_ T _get_theme_item_cached(HashMap<ThemeItemKey, T, ThemeItemKeyHasher> &r_cache, T (*p_get_func)(Control *, Window *, const StringName &, const StringName &), const StringName &p_name, const StringName &p_type) const;
+	void _clear_theme_cache() const;
+	static void _invalidate_theme_caches();
+
 	static Ref<Texture2D> get_icons(Control *p_theme_owner, Window *p_theme_owner_window, const StringName &p_name, const StringName &p_type = StringName());
 	static Ref<Shader> get_shaders(Control *p_theme_owner, Window *p_theme_owner_window, const StringName &p_name, const StringName &p_type = StringName());
 	static Ref<StyleBox> get_styleboxs(Control *p_theme_owner, Window *p_theme_owner_window, const StringName &p_name, const StringName &p_type = StringName());
@@ -34,7 +34,52 @@ void HTTPRequest::_redirect_request(const String &p_new_url) {
 }
 
 Error HTTPRequest::_request() {
-	return client->connect_to_host(url, port, use_ssl, validate_ssl);
+	if (connection_pool.is_null()) {
+		client->set_blocking_mode(use_threads);
+		return client->connect_to_host(url, port, use_ssl, validate_ssl);
+	}
+
+	Ref<HTTPClient> pooled_client = connection_pool->acquire(url, port, use_ssl, validate_ssl);
+	ERR_FAIL_COND_V(pooled_client.is_null(), ERR_CANT_CONNECT);
+	pooled_client->set_blocking_mode(use_threads);
+	pooled_client->set_read_chunk_size(download_chunk_size);
+
+	{
+		MutexLock lock(client_mutex);
+		client = pooled_client;
+		client_pooled = true;
+	}
+
+	switch (pooled_client->get_status()) {
+		case HTTPClient::STATUS_CANT_CONNECT:
+			return ERR_CANT_CONNECT;
+		case HTTPClient::STATUS_DISCONNECTED:
+			return ERR_INVALID_PARAMETER;
+		default:
+			return OK;
+	}
+}
+
+void HTTPRequest::_release_client() {
+	if (!client_pooled) {
+		client->close();
+		return;
+	}
+
+	Ref<HTTPClient> own_client;
+	own_client.instance();
+	own_client->set_read_chunk_size(download_chunk_size);
+
+	Ref<HTTPClient> pooled_client;
+	{
+		MutexLock lock(client_mutex);
+		pooled_client = client;
+		client = own_client;
+		client_pooled = false;
+	}
+
+	// Keep-alive connections go back to the pool, the pool closes the others.
+	connection_pool->release(pooled_client);
 }
 
 Error HTTPRequest::_parse_url(const String &p_url) {
@@ -109,10 +154,8 @@ Error HTTPRequest::request(const String &p_url, const Vector<String> &p_custom_h
 	if (use_threads) {
 		thread_done = false;
 		thread_request_quit = false;
-		client->set_blocking_mode(true);
 		thread = Thread::create(_thread_func, this);
 	} else {
-		client->set_blocking_mode(false);
 		err = _request();
 		if (err != OK) {
 			call_deferred("_request_done", RESULT_CANT_CONNECT, 0, PackedStringArray(), PackedByteArray());
@@ -165,7 +208,7 @@ void HTTPRequest::cancel_request() {
 		memdelete(file);
 		file = nullptr;
 	}
-	client->close();
+	_release_client();
 	body.resize(0);
 	got_response = false;
 	response_code = -1;
@@ -209,7 +252,7 @@ bool HTTPRequest::_handle_response(bool *ret_value) {
 
 		if (new_request != "") {
 			// Process redirect
-			client->close();
+			_release_client();
 			int new_redirs = redirections + 1; // Because _request() will clear it
 			Error err;
 			if (new_request.begins_with("http")) {
@@ -438,14 +481,27 @@ String HTTPRequest::get_download_file() const {
 void HTTPRequest::set_download_chunk_size(int p_chunk_size) {
 	ERR_FAIL_COND(get_http_client_status() != HTTPClient::STATUS_DISCONNECTED);
 
+	MutexLock lock(client_mutex);
 	client->set_read_chunk_size(p_chunk_size);
+	download_chunk_size = client->get_read_chunk_size();
 }
 
 int HTTPRequest::get_download_chunk_size() const {
-	return client->get_read_chunk_size();
+	return download_chunk_size;
+}
+
+void HTTPRequest::set_connection_pool(const Ref<HTTPClientPool> &p_pool) {
+	ERR_FAIL_COND(get_http_client_status() != HTTPClient::STATUS_DISCONNECTED);
+
+	connection_pool = p_pool;
+}
+
+Ref<HTTPClientPool> HTTPRequest::get_connection_pool() const {
+	return connection_pool;
 }
 
 HTTPClient::Status HTTPRequest::get_http_client_status() const {
+	MutexLock lock(client_mutex);
 	return client->get_status();
 }
 
@@ -509,12 +565,16 @@ void HTTPRequest::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_download_chunk_size"), &HTTPRequest::set_download_chunk_size);
 	ClassDB::bind_method(D_METHOD("get_download_chunk_size"), &HTTPRequest::get_download_chunk_size);
 
+	ClassDB::bind_method(D_METHOD("set_connection_pool", "pool"), &HTTPRequest::set_connection_pool);
+	ClassDB::bind_method(D_METHOD("get_connection_pool"), &HTTPRequest::get_connection_pool);
+
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "download_file", PROPERTY_HINT_FILE), "set_download_file", "get_download_file");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "download_chunk_size", PROPERTY_HINT_RANGE, "256,16777216"), "set_download_chunk_size", "get_download_chunk_size");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_threads"), "set_use_threads", "is_using_threads");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "body_size_limit", PROPERTY_HINT_RANGE, "-1,2000000000"), "set_body_size_limit", "get_body_size_limit");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_redirects", PROPERTY_HINT_RANGE, "-1,64"), "set_max_redirects", "get_max_redirects");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "timeout", PROPERTY_HINT_RANGE, "0,86400"), "set_timeout", "get_timeout");
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "connection_pool", PROPERTY_HINT_RESOURCE_TYPE, "HTTPClientPool", 0), "set_connection_pool", "get_connection_pool");
 
 	ADD_SIGNAL(MethodInfo("request_completed", PropertyInfo(Variant::INT, "result"), PropertyInfo(Variant::INT, "response_code"), PropertyInfo(Variant::PACKED_STRING_ARRAY, "headers"), PropertyInfo(Variant::PACKED_BYTE_ARRAY, "body")));
 
@@ -548,6 +608,8 @@ HTTPRequest::HTTPRequest() {
 	request_sent = false;
 	requesting = false;
 	client.instance();
+	client_pooled = false;
+	download_chunk_size = client->get_read_chunk_size();
 	use_threads = false;
 	thread_done = false;
 	downloaded = 0;
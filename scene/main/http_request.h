@@ -32,7 +32,9 @@
 #define HTTPREQUEST_H
 
 #include "core/io/http_client.h"
+#include "core/io/http_client_pool.h"
 #include "core/os/file_access.h"
+#include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "node.h"
 #include "scene/main/timer.h"
@@ -72,6 +74,12 @@ private:
 
 	bool request_sent;
 	Ref<HTTPClient> client;
+	Ref<HTTPClientPool> connection_pool;
+	bool client_pooled;
+	// With a connection pool, the client is swapped on the request thread.
+	// Only held to swap it, and to read it from the main thread.
+	mutable Mutex client_mutex;
+	int download_chunk_size;
 	PackedByteArray body;
 	volatile bool use_threads;
 
@@ -101,6 +109,7 @@ private:
 
 	Error _parse_url(const String &p_url);
 	Error _request();
+	void _release_client();
 
 	volatile bool thread_done;
 	volatile bool thread_request_quit;
@@ -128,6 +137,9 @@ public:
 	void set_download_chunk_size(int p_chunk_size);
 	int get_download_chunk_size() const;
 
+	void set_connection_pool(const Ref<HTTPClientPool> &p_pool);
+	Ref<HTTPClientPool> get_connection_pool() const;
+
 	void set_body_size_limit(int p_bytes);
 	int get_body_size_limit() const;
 
@@ -213,6 +213,8 @@ void Node::_propagate_enter_tree() {
 		E->get().group = data.tree->add_to_group(E->key(), this);
 	}
 
+	_add_to_process_lists();
+
 	notification(NOTIFICATION_ENTER_TREE);
 
 	if (get_script_instance()) {
@@ -240,6 +242,29 @@ void Node::_propagate_enter_tree() {
 	// enter groups
 }
 
+void Node::_add_to_process_lists() {
+	if (data.idle_process) {
+		data.tree->_process_list_add(SceneTree::PROCESS_LIST_IDLE, this);
+	}
+	if (data.idle_process_internal) {
+		data.tree->_process_list_add(SceneTree::PROCESS_LIST_IDLE_INTERNAL, this);
+	}
+	if (data.physics_process) {
+		data.tree->_process_list_add(SceneTree::PROCESS_LIST_PHYSICS, this);
+	}
+	if (data.physics_process_internal) {
+		data.tree->_process_list_add(SceneTree::PROCESS_LIST_PHYSICS_INTERNAL, this);
+	}
+}
+
+void Node::_remove_from_process_lists() {
+	for (int i = 0; i < SceneTree::PROCESS_LIST_MAX; i++) {
+		if (data.process_list_index[i] != -1) {
+			data.tree->_process_list_remove(SceneTree::ProcessListType(i), this);
+		}
+	}
+}
+
 void Node::_propagate_after_exit_tree() {
 	data.blocked++;
 	for (int i = 0; i < data.children.size(); i++) {
@@ -280,6 +305,8 @@ void Node::_propagate_exit_tree() {
 		E->get().group = nullptr;
 	}
 
+	_remove_from_process_lists();
+
 	data.viewport = nullptr;
 
 	if (data.tree) {
@@ -333,6 +360,10 @@ void Node::move_child(Node *p_child, int p_pos) {
 			E->get().group->changed = true;
 		}
 	}
+	if (data.tree) {
+		// Process lists follow tree order, so any processing node below the moved ones may be out of place now.
+		data.tree->_process_lists_resort();
+	}
 
 	data.blocked--;
 }
@@ -364,10 +395,12 @@ void Node::set_physics_process(bool p_process) {
 
 	data.physics_process = p_process;
 
-	if (data.physics_process) {
-		add_to_group("physics_process", false);
-	} else {
-		remove_from_group("physics_process");
+	if (data.inside_tree) {
+		if (data.physics_process) {
+			data.tree->_process_list_add(SceneTree::PROCESS_LIST_PHYSICS, this);
+		} else {
+			data.tree->_process_list_remove(SceneTree::PROCESS_LIST_PHYSICS, this);
+		}
 	}
 
 	_change_notify("physics_process");
@@ -384,10 +417,12 @@ void Node::set_physics_process_internal(bool p_process_internal) {
 
 	data.physics_process_internal = p_process_internal;
 
-	if (data.physics_process_internal) {
-		add_to_group("physics_process_internal", false);
-	} else {
-		remove_from_group("physics_process_internal");
+	if (data.inside_tree) {
+		if (data.physics_process_internal) {
+			data.tree->_process_list_add(SceneTree::PROCESS_LIST_PHYSICS_INTERNAL, this);
+		} else {
+			data.tree->_process_list_remove(SceneTree::PROCESS_LIST_PHYSICS_INTERNAL, this);
+		}
 	}
 
 	_change_notify("physics_process_internal");
@@ -860,10 +895,12 @@ void Node::set_process(bool p_idle_process) {
 
 	data.idle_process = p_idle_process;
 
-	if (data.idle_process) {
-		add_to_group("idle_process", false);
-	} else {
-		remove_from_group("idle_process");
+	if (data.inside_tree) {
+		if (data.idle_process) {
+			data.tree->_process_list_add(SceneTree::PROCESS_LIST_IDLE, this);
+		} else {
+			data.tree->_process_list_remove(SceneTree::PROCESS_LIST_IDLE, this);
+		}
 	}
 
 	_change_notify("idle_process");
@@ -880,10 +917,12 @@ void Node::set_process_internal(bool p_idle_process_internal) {
 
 	data.idle_process_internal = p_idle_process_internal;
 
-	if (data.idle_process_internal) {
-		add_to_group("idle_process_internal", false);
-	} else {
-		remove_from_group("idle_process_internal");
+	if (data.inside_tree) {
+		if (data.idle_process_internal) {
+			data.tree->_process_list_add(SceneTree::PROCESS_LIST_IDLE_INTERNAL, this);
+		} else {
+			data.tree->_process_list_remove(SceneTree::PROCESS_LIST_IDLE_INTERNAL, this);
+		}
 	}
 
 	_change_notify("idle_process_internal");
@@ -901,27 +940,21 @@ void Node::set_process_priority(int p_priority) {
 		return;
 	}
 
-	if (is_processing()) {
-		data.tree->make_group_changed("idle_process");
-	}
-
-	if (is_processing_internal()) {
-		data.tree->make_group_changed("idle_process_internal");
-	}
-
-	if (is_physics_processing()) {
-		data.tree->make_group_changed("physics_process");
-	}
-
-	if (is_physics_processing_internal()) {
-		data.tree->make_group_changed("physics_process_internal");
-	}
+	data.tree->_process_lists_resort();
 }
 
 int Node::get_process_priority() const {
 	return data.process_priority;
 }
 
+void Node::set_process_thread_safe(bool p_enabled) {
+	data.process_thread_safe = p_enabled;
+}
+
+bool Node::is_process_thread_safe() const {
+	return data.process_thread_safe;
+}
+
 void Node::set_process_input(bool p_enable) {
 	if (p_enable == data.input) {
 		return;
@@ -988,7 +1021,15 @@ StringName Node::get_name() const {
 }
 
 void Node::_set_name_nocheck(const StringName &p_name) {
+	if (data.parent) {
+		data.parent->_child_name_index_remove(this);
+	}
+
 	data.name = p_name;
+
+	if (data.parent) {
+		data.parent->_child_name_index_add(this);
+	}
 }
 
 String Node::invalid_character = ". : @ / \"";
@@ -1009,10 +1050,16 @@ void Node::set_name(const String &p_name) {
 	_validate_node_name(name);
 
 	ERR_FAIL_COND(name == "");
+
+	if (data.parent) {
+		data.parent->_child_name_index_remove(this);
+	}
+
 	data.name = name;
 
 	if (data.parent) {
 		data.parent->_validate_child_name(this);
+		data.parent->_child_name_index_add(this);
 	}
 
 	propagate_notification(NOTIFICATION_PATH_CHANGED);
@@ -1065,18 +1112,7 @@ void Node::_validate_child_name(Node *p_child, bool p_force_human_readable) {
 			unique = false;
 		} else {
 			//check if exists
-			Node **children = data.children.ptrw();
-			int cc = data.children.size();
-
-			for (int i = 0; i < cc; i++) {
-				if (children[i] == p_child) {
-					continue;
-				}
-				if (children[i]->data.name == p_child->data.name) {
-					unique = false;
-					break;
-				}
-			}
+			unique = !_has_child_named(p_child->data.name, p_child);
 		}
 
 		if (!unique) {
@@ -1133,24 +1169,8 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 	}
 
 	//quickly test if proposed name exists
-	int cc = data.children.size(); //children count
-	const Node *const *children_ptr = data.children.ptr();
-
-	{
-		bool exists = false;
-
-		for (int i = 0; i < cc; i++) {
-			if (children_ptr[i] == p_child) { //exclude self in renaming if its already a child
-				continue;
-			}
-			if (children_ptr[i]->data.name == name) {
-				exists = true;
-			}
-		}
-
-		if (!exists) {
-			return; //if it does not exist, it does not need validation
-		}
+	if (!_has_child_named(name, p_child)) { //exclude self in renaming if its already a child
+		return; //if it does not exist, it does not need validation
 	}
 
 	// Extract trailing number
@@ -1175,21 +1195,30 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 		nums = "";
 	}
 
+	// Skip the attempts that were already taken the last time this name was requested,
+	// otherwise adding many nodes with the same name is quadratic. Not used when renaming,
+	// since the child's own name doesn't count as taken.
+	ChildNameIndex *index = p_child->data.parent != this ? data.child_name_index : nullptr;
+	StringName requested = name;
+	if (index) {
+		const ChildNameIndex::SerialHint *hint = index->serial_hints.getptr(requested);
+		if (hint) {
+			name_string = hint->name_string;
+			nums = hint->nums;
+		}
+	}
+
 	for (;;) {
 		StringName attempt = name_string + nums;
-		bool exists = false;
 
-		for (int i = 0; i < cc; i++) {
-			if (children_ptr[i] == p_child) {
-				continue;
-			}
-			if (children_ptr[i]->data.name == attempt) {
-				exists = true;
-			}
-		}
-
-		if (!exists) {
+		if (!_has_child_named(attempt, p_child)) {
 			name = attempt;
+			if (index) {
+				ChildNameIndex::SerialHint hint;
+				hint.name_string = name_string;
+				hint.nums = nums;
+				index->serial_hints.set(requested, hint);
+			}
 			return;
 		} else {
 			if (nums.length() == 0) {
@@ -1209,6 +1238,7 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name) {
 	p_child->data.name = p_name;
 	p_child->data.pos = data.children.size();
 	data.children.push_back(p_child);
+	_child_name_index_add(p_child);
 	p_child->data.parent = this;
 	p_child->notification(NOTIFICATION_PARENTED);
 
@@ -1302,8 +1332,14 @@ void Node::remove_child(Node *p_child) {
 	remove_child_notify(p_child);
 	p_child->notification(NOTIFICATION_UNPARENTED);
 
+	_child_name_index_remove(p_child);
 	data.children.remove(idx);
 
+	if (data.children.empty() && data.child_name_index) {
+		memdelete(data.child_name_index);
+		data.child_name_index = nullptr;
+	}
+
 	//update pointer and size
 	child_count = data.children.size();
 	children = data.children.ptrw();
@@ -1334,7 +1370,91 @@ Node *Node::get_child(int p_index) const {
 	return data.children[p_index];
 }
 
+void Node::_build_child_name_index(const Node *p_exclude) {
+	if (data.child_name_index) {
+		memdelete(data.child_name_index);
+	}
+
+	ChildNameIndex *index = memnew(ChildNameIndex);
+
+	for (int i = 0; i < data.children.size(); i++) {
+		Node *child = data.children[i];
+		if (child == p_exclude) {
+			continue;
+		}
+		if (index->children.has(child->data.name)) {
+			index->has_duplicates = true;
+		} else {
+			index->children.set(child->data.name, child);
+		}
+	}
+
+	data.child_name_index = index;
+}
+
+void Node::_child_name_index_add(Node *p_child) {
+	ChildNameIndex *index = data.child_name_index;
+	if (!index) {
+		// Built here rather than on lookup, so get_node() never writes to the node and can run from several threads.
+		if (data.children.size() >= CHILD_NAME_INDEX_THRESHOLD) {
+			_build_child_name_index();
+		}
+		return;
+	}
+
+	Node **existing = index->children.getptr(p_child->data.name);
+	if (existing && *existing != p_child) {
+		index->has_duplicates = true;
+	} else {
+		index->children.set(p_child->data.name, p_child);
+	}
+}
+
+void Node::_child_name_index_remove(Node *p_child) {
+	ChildNameIndex *index = data.child_name_index;
+	if (!index) {
+		return;
+	}
+
+	if (index->has_duplicates) {
+		// Can't tell which child the name should map to now, rebuild without the removed child.
+		_build_child_name_index(p_child);
+		return;
+	}
+
+	Node **existing = index->children.getptr(p_child->data.name);
+	if (existing && *existing == p_child) {
+		index->children.erase(p_child->data.name);
+	}
+	index->serial_hints.clear();
+}
+
+bool Node::_has_child_named(const StringName &p_name, const Node *p_exclude) const {
+	const ChildNameIndex *index = data.child_name_index;
+	if (index && !index->has_duplicates) {
+		Node *const *child = index->children.getptr(p_name);
+		return child && *child != p_exclude;
+	}
+
+	int cc = data.children.size();
+	const Node *const *cd = data.children.ptr();
+
+	for (int i = 0; i < cc; i++) {
+		if (cd[i] != p_exclude && cd[i]->data.name == p_name) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 Node *Node::_get_child_by_name(const StringName &p_name) const {
+	const ChildNameIndex *index = data.child_name_index;
+	if (index && !index->has_duplicates) {
+		Node *const *child = index->children.getptr(p_name);
+		return child ? *child : nullptr;
+	}
+
 	int cc = data.children.size();
 	Node *const *cd = data.children.ptr();
 
@@ -1387,16 +1507,7 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 			}
 
 		} else {
-			next = nullptr;
-
-			for (int j = 0; j < current->data.children.size(); j++) {
-				Node *child = current->data.children[j];
-
-				if (child->data.name == name) {
-					next = child;
-					break;
-				}
-			}
+			next = current->_get_child_by_name(name);
 			if (next == nullptr) {
 				return nullptr;
 			};
@@ -2759,6 +2870,8 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_process", "enable"), &Node::set_process);
 	ClassDB::bind_method(D_METHOD("set_process_priority", "priority"), &Node::set_process_priority);
 	ClassDB::bind_method(D_METHOD("get_process_priority"), &Node::get_process_priority);
+	ClassDB::bind_method(D_METHOD("set_process_thread_safe", "enabled"), &Node::set_process_thread_safe);
+	ClassDB::bind_method(D_METHOD("is_process_thread_safe"), &Node::is_process_thread_safe);
 	ClassDB::bind_method(D_METHOD("is_processing"), &Node::is_processing);
 	ClassDB::bind_method(D_METHOD("set_process_input", "enable"), &Node::set_process_input);
 	ClassDB::bind_method(D_METHOD("is_processing_input"), &Node::is_processing_input);
@@ -2894,6 +3007,7 @@ void Node::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "multiplayer", PROPERTY_HINT_RESOURCE_TYPE, "MultiplayerAPI", 0), "", "get_multiplayer");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "custom_multiplayer", PROPERTY_HINT_RESOURCE_TYPE, "MultiplayerAPI", 0), "set_custom_multiplayer", "get_custom_multiplayer");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_priority"), "set_process_priority", "get_process_priority");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "process_thread_safe"), "set_process_thread_safe", "is_process_thread_safe");
 
 	BIND_VMETHOD(MethodInfo("_process", PropertyInfo(Variant::FLOAT, "delta")));
 	BIND_VMETHOD(MethodInfo("_physics_process", PropertyInfo(Variant::FLOAT, "delta")));
@@ -2931,6 +3045,10 @@ Node::Node() {
 	data.process_priority = 0;
 	data.physics_process_internal = false;
 	data.idle_process_internal = false;
+	for (int i = 0; i < SceneTree::PROCESS_LIST_MAX; i++) {
+		data.process_list_index[i] = -1;
+	}
+	data.process_thread_safe = false;
 	data.inside_tree = false;
 	data.ready_notified = false;
 
@@ -2943,6 +3061,7 @@ Node::Node() {
 	data.pause_owner = nullptr;
 	data.network_master = 1; //server by default
 	data.path_cache = nullptr;
+	data.child_name_index = nullptr;
 	data.parent_owned = false;
 	data.in_constructor = true;
 	data.viewport = nullptr;
@@ -2958,6 +3077,10 @@ Node::~Node() {
 	data.owned.clear();
 	data.children.clear();
 
+	if (data.child_name_index) {
+		memdelete(data.child_name_index);
+	}
+
 	ERR_FAIL_COND(data.parent);
 	ERR_FAIL_COND(data.children.size());
 
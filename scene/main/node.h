@@ -87,6 +87,23 @@ private:
 		MultiplayerAPI::RPCMode mode;
 	};
 
+	enum {
+		CHILD_NAME_INDEX_THRESHOLD = 32, // Child count from which names are looked up in a hash map.
+	};
+
+	struct ChildNameIndex {
+		struct SerialHint {
+			String name_string;
+			String nums;
+		};
+
+		HashMap<StringName, Node *> children;
+		// Last serial name generated for a requested name. Every attempt before it
+		// was taken, so the next search can start there. Cleared on remove and rename.
+		HashMap<StringName, SerialHint> serial_hints;
+		bool has_duplicates = false; // Children added without validation share a name, fall back to scanning.
+	};
+
 	struct Data {
 		String filename;
 		Ref<SceneState> instance_state;
@@ -131,6 +148,9 @@ private:
 		bool physics_process_internal;
 		bool idle_process_internal;
 
+		int process_list_index[SceneTree::PROCESS_LIST_MAX]; // Position in the SceneTree process lists, -1 if not processing.
+		bool process_thread_safe;
+
 		bool input;
 		bool unhandled_input;
 		bool unhandled_key_input;
@@ -142,6 +162,7 @@ private:
 		bool display_folded;
 
 		mutable NodePath *path_cache;
+		ChildNameIndex *child_name_index;
 
 	} data;
 
@@ -158,6 +179,11 @@ private:
 
 	Node *_get_child_by_name(const StringName &p_name) const;
 
+	void _build_child_name_index(const Node *p_exclude = nullptr);
+	void _child_name_index_add(Node *p_child);
+	void _child_name_index_remove(Node *p_child);
+	bool _has_child_named(const StringName &p_name, const Node *p_exclude) const;
+
 	void _replace_connections_target(Node *p_new_target);
 
 	void _validate_child_name(Node *p_child, bool p_force_human_readable = false);
@@ -169,6 +195,8 @@ private:
 	void _propagate_ready();
 	void _propagate_exit_tree();
 	void _propagate_after_exit_tree();
+	void _add_to_process_lists();
+	void _remove_from_process_lists();
 	void _propagate_validate_owner();
 	void _print_stray_nodes();
 	void _propagate_pause_owner(Node *p_owner);
@@ -355,6 +383,9 @@ public:
 	void set_process_priority(int p_priority);
 	int get_process_priority() const;
 
+	void set_process_thread_safe(bool p_enabled);
+	bool is_process_thread_safe() const;
+
 	void set_process_input(bool p_enable);
 	bool is_processing_input() const;
 
@@ -31,6 +31,7 @@
 #include "scene_tree.h"
 
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/trace_profiler.h"
 #include "core/input/input.h"
 #include "core/io/marshalls.h"
 #include "core/io/resource_loader.h"
@@ -405,9 +406,12 @@ void SceneTree::init() {
 }
 
 bool SceneTree::iteration(float p_time) {
+	TRACE_ZONE("SceneTree::iteration");
 	root_lock++;
 
 	current_frame++;
+	physics_picking_queries = 0;
+	physics_picking_usec = 0;
 
 	flush_transform_notifications();
 
@@ -416,14 +420,19 @@ bool SceneTree::iteration(float p_time) {
 
 	emit_signal("physics_frame");
 
-	_notify_group_pause("physics_process_internal", Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
-	_notify_group_pause("physics_process", Node::NOTIFICATION_PHYSICS_PROCESS);
+	_notify_process_list(PROCESS_LIST_PHYSICS_INTERNAL, Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
+	_call_internal_process_callbacks();
+	_notify_process_list(PROCESS_LIST_PHYSICS, Node::NOTIFICATION_PHYSICS_PROCESS);
 	_flush_ugc();
 	MessageQueue::get_singleton()->flush(); //small little hack
 	flush_transform_notifications();
 	call_group_flags(GROUP_CALL_REALTIME, "_viewports", "update_worlds");
 	root_lock--;
 
+	if (multiplayer_poll) {
+		multiplayer->flush_batches(); //send what this physics frame batched
+	}
+
 	_flush_delete_queue();
 	_call_idle_callbacks();
 
@@ -431,6 +440,7 @@ bool SceneTree::iteration(float p_time) {
 }
 
 bool SceneTree::idle(float p_time) {
+	TRACE_ZONE("SceneTree::idle");
 	//print_line("ram: "+itos(OS::get_singleton()->get_static_memory_usage())+" sram: "+itos(OS::get_singleton()->get_dynamic_memory_usage()));
 	//print_line("node count: "+itos(get_node_count()));
 	//print_line("TEXTURE RAM: "+itos(RS::get_singleton()->get_render_info(RS::INFO_TEXTURE_MEM_USED)));
@@ -451,8 +461,9 @@ bool SceneTree::idle(float p_time) {
 
 	flush_transform_notifications();
 
-	_notify_group_pause("idle_process_internal", Node::NOTIFICATION_INTERNAL_PROCESS);
-	_notify_group_pause("idle_process", Node::NOTIFICATION_PROCESS);
+	_notify_process_list(PROCESS_LIST_IDLE_INTERNAL, Node::NOTIFICATION_INTERNAL_PROCESS);
+	_call_internal_process_callbacks();
+	_notify_process_list(PROCESS_LIST_IDLE, Node::NOTIFICATION_PROCESS);
 
 	_flush_ugc();
 	MessageQueue::get_singleton()->flush(); //small little hack
@@ -461,6 +472,10 @@ bool SceneTree::idle(float p_time) {
 
 	root_lock--;
 
+	if (multiplayer_poll) {
+		multiplayer->flush_batches(); //send what this frame batched
+	}
+
 	_flush_delete_queue();
 
 	//go through timers
@@ -831,6 +846,163 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 	}
 }
 
+void SceneTree::_process_list_add(ProcessListType p_type, Node *p_node) {
+	MutexLock lock(process_lists_mutex);
+
+	ProcessList &list = process_lists[p_type];
+	ERR_FAIL_COND(p_node->data.process_list_index[p_type] != -1);
+
+	p_node->data.process_list_index[p_type] = list.nodes.size();
+	list.nodes.push_back(p_node);
+}
+
+void SceneTree::_process_list_remove(ProcessListType p_type, Node *p_node) {
+	MutexLock lock(process_lists_mutex);
+
+	ProcessList &list = process_lists[p_type];
+	int index = p_node->data.process_list_index[p_type];
+	ERR_FAIL_INDEX(index, (int)list.nodes.size());
+	ERR_FAIL_COND(list.nodes[index] != p_node);
+
+	// Don't move the others, this may happen while the list is being processed.
+	list.nodes[index] = nullptr;
+	list.removed_count++;
+	p_node->data.process_list_index[p_type] = -1;
+}
+
+void SceneTree::_process_lists_resort() {
+	MutexLock lock(process_lists_mutex);
+
+	for (int i = 0; i < PROCESS_LIST_MAX; i++) {
+		process_lists[i].resort = true;
+	}
+}
+
+void SceneTree::_update_process_list(ProcessListType p_type) {
+	MutexLock lock(process_lists_mutex);
+
+	ProcessList &list = process_lists[p_type];
+
+	if (list.removed_count) {
+		uint32_t to = 0;
+		uint32_t sorted_count = 0;
+		for (uint32_t from = 0; from < list.nodes.size(); from++) {
+			Node *n = list.nodes[from];
+			if (!n) {
+				continue;
+			}
+			if (from < list.sorted_count) {
+				sorted_count++;
+			}
+			list.nodes[to] = n;
+			n->data.process_list_index[p_type] = to;
+			to++;
+		}
+		list.nodes.resize(to);
+		list.sorted_count = sorted_count;
+		list.removed_count = 0;
+	}
+
+	if (list.resort) {
+		list.sorted_count = 0;
+		list.resort = false;
+	}
+
+	uint32_t count = list.nodes.size();
+	if (list.sorted_count >= count) {
+		return;
+	}
+
+	// Only the nodes added since the last dispatch need sorting, then they are merged
+	// with the rest. Comparing tree order is not cheap.
+	Node **nodes = list.nodes.ptr();
+	SortArray<Node *, Node::ComparatorWithPriority> sorter;
+	sorter.sort(&nodes[list.sorted_count], count - list.sorted_count);
+
+	if (list.sorted_count > 0) {
+		Node::ComparatorWithPriority compare;
+		process_sort_buffer.resize(count);
+		uint32_t a = 0;
+		uint32_t b = list.sorted_count;
+		for (uint32_t i = 0; i < count; i++) {
+			if (b >= count || (a < list.sorted_count && !compare(nodes[b], nodes[a]))) {
+				process_sort_buffer[i] = nodes[a++];
+			} else {
+				process_sort_buffer[i] = nodes[b++];
+			}
+		}
+		memcpy(nodes, process_sort_buffer.ptr(), sizeof(Node *) * count);
+		process_sort_buffer.clear();
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		nodes[i]->data.process_list_index[p_type] = i;
+	}
+	list.sorted_count = count;
+}
+
+void SceneTree::_process_thread_safe_node(uint32_t p_index, int p_notification) {
+	process_thread_batch[p_index]->notification(p_notification);
+}
+
+void SceneTree::_notify_process_list(ProcessListType p_type, int p_notification) {
+	_update_process_list(p_type);
+
+	ProcessList &list = process_lists[p_type];
+
+	// Nodes added while processing wait until the next frame.
+	uint32_t count = list.nodes.size();
+	bool threads = p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS;
+
+	for (uint32_t i = 0; i < count; i++) {
+		Node *n = list.nodes[i];
+		if (!n) {
+			continue;
+		}
+		if (pause && !n->can_process()) {
+			continue;
+		}
+
+		if (threads && n->data.process_thread_safe) {
+			// Consecutive thread-safe nodes with the same priority are processed together.
+			int priority = n->data.process_priority;
+			process_thread_batch.clear();
+
+			uint32_t to = i;
+			for (; to < count; to++) {
+				Node *m = list.nodes[to];
+				if (!m) {
+					continue;
+				}
+				if (!m->data.process_thread_safe || m->data.process_priority != priority) {
+					break;
+				}
+				if (pause && !m->can_process()) {
+					continue;
+				}
+				process_thread_batch.push_back(m);
+			}
+
+#ifndef NO_THREADS
+			if (process_thread_batch.size() > 1) {
+				get_work_pool().do_work(process_thread_batch.size(), this, &SceneTree::_process_thread_safe_node, p_notification);
+			} else
+#endif
+			{
+				for (uint32_t j = 0; j < process_thread_batch.size(); j++) {
+					process_thread_batch[j]->notification(p_notification);
+				}
+			}
+
+			process_thread_batch.clear();
+			i = to - 1;
+			continue;
+		}
+
+		n->notification(p_notification);
+	}
+}
+
 /*
 void SceneMainLoop::_update_listener_2d() {
 
@@ -1004,10 +1176,27 @@ void SceneTree::queue_delete(Object *p_object) {
 	delete_queue.push_back(p_object->get_instance_id());
 }
 
+#ifndef NO_THREADS
+// Shared by the thread-safe process batches and by nodes that split their own
+// work across threads. Only to be used from the main thread.
+ThreadWorkPool &SceneTree::get_work_pool() {
+	if (!work_pool_initialized) {
+		work_pool.init();
+		work_pool_initialized = true;
+	}
+	return work_pool;
+}
+#endif
+
 int SceneTree::get_node_count() const {
 	return node_count;
 }
 
+void SceneTree::add_physics_picking_stats(int p_queries, uint64_t p_usec) {
+	physics_picking_queries += p_queries;
+	physics_picking_usec += p_usec;
+}
+
 void SceneTree::set_edited_scene_root(Node *p_node) {
 #ifdef TOOLS_ENABLED
 	edited_scene_root = p_node;
@@ -1303,6 +1492,20 @@ void SceneTree::add_idle_callback(IdleCallback p_callback) {
 	idle_callbacks[idle_callback_count++] = p_callback;
 }
 
+SceneTree::IdleCallback SceneTree::internal_process_callbacks[SceneTree::MAX_IDLE_CALLBACKS];
+int SceneTree::internal_process_callback_count = 0;
+
+void SceneTree::_call_internal_process_callbacks() {
+	for (int i = 0; i < internal_process_callback_count; i++) {
+		internal_process_callbacks[i]();
+	}
+}
+
+void SceneTree::add_internal_process_callback(IdleCallback p_callback) {
+	ERR_FAIL_COND(internal_process_callback_count >= MAX_IDLE_CALLBACKS);
+	internal_process_callbacks[internal_process_callback_count++] = p_callback;
+}
+
 void SceneTree::get_argument_options(const StringName &p_function, int p_idx, List<String> *r_options) const {
 	if (p_function == "change_scene") {
 		DirAccessRef dir_access = DirAccess::create(DirAccess::ACCESS_RESOURCES);
@@ -1360,6 +1563,8 @@ SceneTree::SceneTree() {
 	root = nullptr;
 	pause = false;
 	current_frame = 0;
+	physics_picking_queries = 0;
+	physics_picking_usec = 0;
 	current_event = 0;
 	tree_changed_name = "tree_changed";
 	node_added_name = "node_added";
@@ -1445,6 +1650,12 @@ SceneTree::~SceneTree() {
 		memdelete(root);
 	}
 
+#ifndef NO_THREADS
+	if (work_pool_initialized) {
+		work_pool.finish();
+	}
+#endif
+
 	if (singleton == this) {
 		singleton = nullptr;
 	}
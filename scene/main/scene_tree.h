@@ -32,9 +32,12 @@
 #define SCENE_MAIN_LOOP_H
 
 #include "core/io/multiplayer_api.h"
+#include "core/local_vector.h"
 #include "core/os/main_loop.h"
+#include "core/os/mutex.h"
 #include "core/os/thread_safe.h"
 #include "core/self_list.h"
+#include "core/thread_work_pool.h"
 #include "scene/resources/mesh.h"
 #include "scene/resources/world_2d.h"
 #include "scene/resources/world_3d.h"
@@ -113,6 +116,10 @@ private:
 	int64_t current_event;
 	int node_count;
 
+	// Physics picking done by all viewports during the current physics frame.
+	int physics_picking_queries;
+	uint64_t physics_picking_usec;
+
 #ifdef TOOLS_ENABLED
 	Node *edited_scene_root;
 #endif
@@ -180,6 +187,40 @@ private:
 	void make_group_changed(const StringName &p_group);
 
 	void _notify_group_pause(const StringName &p_group, int p_notification);
+
+	enum ProcessListType {
+		PROCESS_LIST_IDLE,
+		PROCESS_LIST_IDLE_INTERNAL,
+		PROCESS_LIST_PHYSICS,
+		PROCESS_LIST_PHYSICS_INTERNAL,
+		PROCESS_LIST_MAX
+	};
+
+	// Processing nodes are kept out of the group map, so dispatching needs no lookups or copies.
+	struct ProcessList {
+		LocalVector<Node *> nodes; // Removed nodes are left as null until the next dispatch.
+		uint32_t sorted_count = 0; // Nodes before this are in process order, the rest were just added.
+		uint32_t removed_count = 0;
+		bool resort = false; // Priorities or tree order changed.
+	};
+
+	ProcessList process_lists[PROCESS_LIST_MAX];
+	LocalVector<Node *> process_sort_buffer;
+	Mutex process_lists_mutex; // Thread-safe nodes may start or stop processing from a worker thread.
+
+	LocalVector<Node *> process_thread_batch;
+#ifndef NO_THREADS
+	bool work_pool_initialized = false;
+	ThreadWorkPool work_pool;
+#endif
+
+	void _process_list_add(ProcessListType p_type, Node *p_node);
+	void _process_list_remove(ProcessListType p_type, Node *p_node);
+	void _process_lists_resort();
+	void _update_process_list(ProcessListType p_type);
+	void _notify_process_list(ProcessListType p_type, int p_notification);
+	void _process_thread_safe_node(uint32_t p_index, int p_notification);
+
 	Variant _call_group_flags(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	Variant _call_group(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
@@ -203,6 +244,11 @@ private:
 	static int idle_callback_count;
 	void _call_idle_callbacks();
 
+	// Called right after internal (physics) process notifications, so batched work is done before user process callbacks.
+	static IdleCallback internal_process_callbacks[MAX_IDLE_CALLBACKS];
+	static int internal_process_callback_count;
+	void _call_internal_process_callbacks();
+
 	void _main_window_focus_in();
 	void _main_window_close();
 	void _main_window_go_back();
@@ -304,6 +350,14 @@ public:
 
 	int get_node_count() const;
 
+	void add_physics_picking_stats(int p_queries, uint64_t p_usec);
+	int get_physics_picking_queries() const { return physics_picking_queries; }
+	uint64_t get_physics_picking_usec() const { return physics_picking_usec; }
+
+#ifndef NO_THREADS
+	ThreadWorkPool &get_work_pool();
+#endif
+
 	void queue_delete(Object *p_object);
 
 	void get_nodes_in_group(const StringName &p_group, List<Node *> *p_list);
@@ -348,6 +402,7 @@ public:
 	bool is_refusing_new_network_connections() const;
 
 	static void add_idle_callback(IdleCallback p_callback);
+	static void add_internal_process_callback(IdleCallback p_callback);
 
 	//default texture settings
 
@@ -566,6 +566,9 @@ void Viewport::_notification(int p_what) {
 				PhysicsDirectSpaceState3D::RayResult result;
 				PhysicsDirectSpaceState2D *ss2d = PhysicsServer2D::get_singleton()->space_get_direct_state(find_world_2d()->get_space());
 
+				uint64_t picking_begin = OS::get_singleton()->get_ticks_usec();
+				int picking_queries = 0;
+
 				if (physics_has_last_mousepos) {
 					// if no mouse event exists, create a motion one. This is necessary because objects or camera may have moved.
 					// while this extra event is sent, it is checked if both camera and last object and last ID did not move. If nothing changed, the event is discarded to avoid flooding with unnecessary motion events every frame
@@ -594,6 +597,21 @@ void Viewport::_notification(int p_what) {
 					}
 				}
 
+				// Consecutive motion events are merged into the last one, only the final
+				// position of the pointer in this frame gets picked.
+				for (List<Ref<InputEvent>>::Element *E = physics_picking_events.front(); E;) {
+					List<Ref<InputEvent>>::Element *N = E->next();
+					Ref<InputEventMouseMotion> motion = E->get();
+					if (N && motion.is_valid() && motion->get_device() == N->get()->get_device()) {
+						Ref<InputEventMouseMotion> merged = motion->duplicate();
+						if (merged->accumulate(N->get())) {
+							N->get() = merged;
+							physics_picking_events.erase(E);
+						}
+					}
+					E = N;
+				}
+
 				while (physics_picking_events.size()) {
 					Ref<InputEvent> ev = physics_picking_events.front()->get();
 					physics_picking_events.pop_front();
@@ -685,6 +703,7 @@ void Viewport::_notification(int p_what) {
 							Vector2 point = canvas_transform.affine_inverse().xform(pos);
 
 							int rc = ss2d->intersect_point_on_canvas(point, canvas_layer_id, res, 64, Set<RID>(), 0xFFFFFFFF, true, true, true);
+							picking_queries++;
 							for (int i = 0; i < rc; i++) {
 								if (res[i].collider_id.is_valid() && res[i].collider) {
 									CollisionObject2D *co = Object::cast_to<CollisionObject2D>(res[i].collider);
@@ -772,7 +791,15 @@ void Viewport::_notification(int p_what) {
 
 							PhysicsDirectSpaceState3D *space = PhysicsServer3D::get_singleton()->space_get_direct_state(find_world_3d()->get_space());
 							if (space) {
-								bool col = space->intersect_ray(from, from + dir * 10000, result, Set<RID>(), 0xFFFFFFFF, true, true, true);
+								// Nothing past the far plane can be seen, so there is no point in testing it.
+								// The far plane is zfar away along the view axis, so off-center rays must be longer.
+								real_t ray_length = camera->get_zfar();
+								real_t axis_cos = dir.dot(-camera->get_global_transform().basis.get_axis(2));
+								if (axis_cos > CMP_EPSILON) {
+									ray_length /= axis_cos;
+								}
+								bool col = space->intersect_ray(from, from + dir * ray_length, result, Set<RID>(), 0xFFFFFFFF, true, true, true);
+								picking_queries++;
 								ObjectID new_collider;
 								if (col) {
 									CollisionObject3D *co = Object::cast_to<CollisionObject3D>(result.collider);
@@ -811,6 +838,8 @@ void Viewport::_notification(int p_what) {
 					}
 #endif
 				}
+
+				get_tree()->add_physics_picking_stats(picking_queries, OS::get_singleton()->get_ticks_usec() - picking_begin);
 			}
 
 		} break;
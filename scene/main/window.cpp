@@ -1083,6 +1083,10 @@ void Window::add_child_notify(Node *p_child) {
 		Control::_propagate_theme_changed(child_w, theme_owner, theme_owner_window); //need to propagate here, since many controls may require setting up stuff
 	}
 
+	if ((child_c && child_c->data.theme.is_valid()) || (child_w && child_w->theme.is_valid())) {
+		Control::_invalidate_theme_caches(); //not propagated, but items missing from its theme are now looked up elsewhere
+	}
+
 	if (is_inside_tree() && wrap_controls) {
 		child_controls_changed();
 	}
@@ -1101,6 +1105,10 @@ void Window::remove_child_notify(Node *p_child) {
 		Control::_propagate_theme_changed(child_w, nullptr, nullptr);
 	}
 
+	if ((child_c && child_c->data.theme.is_valid()) || (child_w && child_w->theme.is_valid())) {
+		Control::_invalidate_theme_caches();
+	}
+
 	if (is_inside_tree() && wrap_controls) {
 		child_controls_changed();
 	}
@@ -1111,6 +1119,8 @@ void Window::set_theme(const Ref<Theme> &p_theme) {
 		return;
 	}
 
+	Control::_invalidate_theme_caches();
+
 	theme = p_theme;
 
 	if (!p_theme.is_null()) {
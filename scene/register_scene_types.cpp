@@ -71,6 +71,7 @@
 #include "scene/animation/animation_blend_tree.h"
 #include "scene/animation/animation_node_state_machine.h"
 #include "scene/animation/animation_player.h"
+#include "scene/animation/animation_process_batch.h"
 #include "scene/animation/animation_tree.h"
 #include "scene/animation/root_motion_view.h"
 #include "scene/animation/tween.h"
@@ -234,6 +235,8 @@ static Ref<ResourceFormatLoaderBMFont> resource_loader_bmfont;
 static Ref<ResourceFormatSaverShader> resource_saver_shader;
 static Ref<ResourceFormatLoaderShader> resource_loader_shader;
 
+static AnimationProcessBatch *animation_process_batch = nullptr;
+
 void register_scene_types() {
 	SceneStringNames::create();
 
@@ -404,6 +407,9 @@ void register_scene_types() {
 	ClassDB::register_class<AnimationNodeTimeSeek>();
 	ClassDB::register_class<AnimationNodeTransition>();
 
+	animation_process_batch = memnew(AnimationProcessBatch);
+	SceneTree::add_internal_process_callback(AnimationProcessBatch::flush);
+
 	ClassDB::register_class<ShaderGlobalsOverride>(); //can be used in any shader
 
 	OS::get_singleton()->yield(); //may take time to init
@@ -960,5 +966,9 @@ void unregister_scene_types() {
 
 	ParticlesMaterial::finish_shaders();
 	CanvasItemMaterial::finish_shaders();
+
+	memdelete(animation_process_batch);
+	animation_process_batch = nullptr;
+
 	SceneStringNames::free();
 }
@@ -31,6 +31,7 @@
 #include "animation.h"
 #include "scene/scene_string_names.h"
 
+#include "core/io/marshalls.h"
 #include "core/math/geometry_3d.h"
 
 #define ANIM_MIN_LENGTH 0.001
@@ -77,8 +78,44 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 		} else if (what == "enabled") {
 			track_set_enabled(track, p_value);
 		} else if (what == "keys" || what == "key_values") {
-			if (track_get_type(track) == TYPE_TRANSFORM) {
+			if (track_get_type(track) == TYPE_TRANSFORM && p_value.get_type() == Variant::DICTIONARY) {
 				TransformTrack *tt = static_cast<TransformTrack *>(tracks[track]);
+				Dictionary d = p_value;
+				ERR_FAIL_COND_V(!d.has("times"), false);
+				ERR_FAIL_COND_V(!d.has("transitions"), false);
+				ERR_FAIL_COND_V(!d.has("data"), false);
+
+				Vector<float> times = d["times"];
+				Vector<float> transitions = d["transitions"];
+				Vector<uint8_t> data = d["data"];
+				int key_count = times.size();
+				ERR_FAIL_COND_V(transitions.size() != key_count, false);
+				ERR_FAIL_COND_V(data.size() != key_count * 18, false);
+
+				tt->transforms.clear();
+				tt->loc_bounds = d.get("loc_bounds", AABB());
+				tt->scale_bounds = d.get("scale_bounds", AABB());
+				tt->compressed_times.resize(key_count);
+				tt->compressed_keys.resize(key_count);
+
+				const uint8_t *r = data.ptr();
+				for (int i = 0; i < key_count; i++) {
+					tt->compressed_times.write[i].time = times[i];
+					tt->compressed_times.write[i].transition = transitions[i];
+
+					CompressedTransformKey &ck = tt->compressed_keys.write[i];
+					const uint8_t *ofs = &r[i * 18];
+					for (int j = 0; j < 3; j++) {
+						ck.loc[j] = decode_uint16(&ofs[j * 2]);
+						ck.rot[j] = decode_uint16(&ofs[6 + j * 2]);
+						ck.scale[j] = decode_uint16(&ofs[12 + j * 2]);
+					}
+				}
+				tt->compressed = true;
+
+			} else if (track_get_type(track) == TYPE_TRANSFORM) {
+				TransformTrack *tt = static_cast<TransformTrack *>(tracks[track]);
+				_transform_track_decompress(tt);
 				Vector<float> values = p_value;
 				int vcount = values.size();
 				ERR_FAIL_COND_V(vcount % 12, false); // should be multiple of 11
@@ -353,7 +390,45 @@ bool Animation::_get(const StringName &p_name, Variant &r_ret) const {
 		} else if (what == "enabled") {
 			r_ret = track_is_enabled(track);
 		} else if (what == "keys") {
-			if (track_get_type(track) == TYPE_TRANSFORM) {
+			if (track_is_compressed(track)) {
+				const TransformTrack *tt = static_cast<const TransformTrack *>(tracks[track]);
+
+				int kk = tt->compressed_times.size();
+				Vector<float> key_times;
+				Vector<float> key_transitions;
+				Vector<uint8_t> data;
+				key_times.resize(kk);
+				key_transitions.resize(kk);
+				data.resize(kk * 18);
+
+				float *wti = key_times.ptrw();
+				float *wtr = key_transitions.ptrw();
+				uint8_t *w = data.ptrw();
+
+				for (int i = 0; i < kk; i++) {
+					wti[i] = tt->compressed_times[i].time;
+					wtr[i] = tt->compressed_times[i].transition;
+
+					const CompressedTransformKey &ck = tt->compressed_keys[i];
+					uint8_t *ofs = &w[i * 18];
+					for (int j = 0; j < 3; j++) {
+						encode_uint16(ck.loc[j], &ofs[j * 2]);
+						encode_uint16(ck.rot[j], &ofs[6 + j * 2]);
+						encode_uint16(ck.scale[j], &ofs[12 + j * 2]);
+					}
+				}
+
+				Dictionary d;
+				d["times"] = key_times;
+				d["transitions"] = key_transitions;
+				d["loc_bounds"] = tt->loc_bounds;
+				d["scale_bounds"] = tt->scale_bounds;
+				d["data"] = data;
+
+				r_ret = d;
+				return true;
+
+			} else if (track_get_type(track) == TYPE_TRANSFORM) {
 				Vector<float> keys;
 				int kk = track_get_key_count(track);
 				keys.resize(kk * 12);
@@ -778,16 +853,24 @@ Error Animation::transform_track_get_key(int p_track, int p_key, Vector3 *r_loc,
 
 	TransformTrack *tt = static_cast<TransformTrack *>(t);
 	ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, ERR_INVALID_PARAMETER);
-	ERR_FAIL_INDEX_V(p_key, tt->transforms.size(), ERR_INVALID_PARAMETER);
+
+	TransformKey key;
+	if (tt->compressed) {
+		ERR_FAIL_INDEX_V(p_key, tt->compressed_keys.size(), ERR_INVALID_PARAMETER);
+		key = _decompress_transform_key(tt->compressed_keys[p_key], tt->loc_bounds, tt->scale_bounds);
+	} else {
+		ERR_FAIL_INDEX_V(p_key, tt->transforms.size(), ERR_INVALID_PARAMETER);
+		key = tt->transforms[p_key].value;
+	}
 
 	if (r_loc) {
-		*r_loc = tt->transforms[p_key].value.loc;
+		*r_loc = key.loc;
 	}
 	if (r_rot) {
-		*r_rot = tt->transforms[p_key].value.rot;
+		*r_rot = key.rot;
 	}
 	if (r_scale) {
-		*r_scale = tt->transforms[p_key].value.scale;
+		*r_scale = key.scale;
 	}
 
 	return OK;
@@ -799,6 +882,7 @@ int Animation::transform_track_insert_key(int p_track, float p_time, const Vecto
 	ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, -1);
 
 	TransformTrack *tt = static_cast<TransformTrack *>(t);
+	_transform_track_decompress(tt);
 
 	TKey<TransformKey> tkey;
 	tkey.time = p_time;
@@ -824,6 +908,7 @@ void Animation::track_remove_key(int p_track, int p_idx) {
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_idx, tt->transforms.size());
 			tt->transforms.remove(p_idx);
 
@@ -870,6 +955,16 @@ int Animation::track_find_key(int p_track, float p_time, bool p_exact) const {
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed) {
+				int k = _find(tt->compressed_times, p_time);
+				if (k < 0 || k >= tt->compressed_times.size()) {
+					return -1;
+				}
+				if (tt->compressed_times[k].time != p_time && p_exact) {
+					return -1;
+				}
+				return k;
+			}
 			int k = _find(tt->transforms, p_time);
 			if (k < 0 || k >= tt->transforms.size()) {
 				return -1;
@@ -1054,6 +1149,9 @@ int Animation::track_get_key_count(int p_track) const {
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed) {
+				return tt->compressed_times.size();
+			}
 			return tt->transforms.size();
 		} break;
 		case TYPE_VALUE: {
@@ -1088,13 +1186,16 @@ Variant Animation::track_get_key_value(int p_track, int p_key_idx) const {
 
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
-			TransformTrack *tt = static_cast<TransformTrack *>(t);
-			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), Variant());
+			Vector3 loc;
+			Quat rot;
+			Vector3 scale;
+			Error err = transform_track_get_key(p_track, p_key_idx, &loc, &rot, &scale);
+			ERR_FAIL_COND_V(err != OK, Variant());
 
 			Dictionary d;
-			d["location"] = tt->transforms[p_key_idx].value.loc;
-			d["rotation"] = tt->transforms[p_key_idx].value.rot;
-			d["scale"] = tt->transforms[p_key_idx].value.scale;
+			d["location"] = loc;
+			d["rotation"] = rot;
+			d["scale"] = scale;
 
 			return d;
 		} break;
@@ -1157,6 +1258,10 @@ float Animation::track_get_key_time(int p_track, int p_key_idx) const {
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed) {
+				ERR_FAIL_INDEX_V(p_key_idx, tt->compressed_times.size(), -1);
+				return tt->compressed_times[p_key_idx].time;
+			}
 			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), -1);
 			return tt->transforms[p_key_idx].time;
 		} break;
@@ -1202,6 +1307,7 @@ void Animation::track_set_key_time(int p_track, int p_key_idx, float p_time) {
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 			TKey<TransformKey> key = tt->transforms[p_key_idx];
 			key.time = p_time;
@@ -1266,6 +1372,10 @@ float Animation::track_get_key_transition(int p_track, int p_key_idx) const {
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->compressed) {
+				ERR_FAIL_INDEX_V(p_key_idx, tt->compressed_times.size(), -1);
+				return tt->compressed_times[p_key_idx].transition;
+			}
 			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), -1);
 			return tt->transforms[p_key_idx].transition;
 		} break;
@@ -1302,6 +1412,7 @@ void Animation::track_set_key_value(int p_track, int p_key_idx, const Variant &p
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 
 			Dictionary d = p_value;
@@ -1385,6 +1496,7 @@ void Animation::track_set_key_transition(int p_track, int p_key_idx, float p_tra
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 			tt->transforms.write[p_key_idx].transition = p_transition;
 		} break;
@@ -1411,12 +1523,31 @@ void Animation::track_set_key_transition(int p_track, int p_key_idx, float p_tra
 }
 
 template <class K>
-int Animation::_find(const Vector<K> &p_keys, float p_time) const {
+int Animation::_find(const Vector<K> &p_keys, float p_time, int *p_cursor) const {
 	int len = p_keys.size();
 	if (len == 0) {
 		return -2;
 	}
 
+	const K *keys = &p_keys[0];
+
+	if (p_cursor) {
+		// Playback usually samples forward in small steps, so the key found for
+		// the previous sample (or the one after it) is checked before searching.
+		int cursor = *p_cursor;
+		for (int i = 0; i < 2; i++, cursor++) {
+			if (cursor < -1 || cursor >= len) {
+				break;
+			}
+			bool after_key = cursor < 0 || keys[cursor].time < p_time || Math::is_equal_approx(p_time, keys[cursor].time);
+			bool before_next = cursor + 1 >= len || (p_time < keys[cursor + 1].time && !Math::is_equal_approx(p_time, keys[cursor + 1].time));
+			if (after_key && before_next) {
+				*p_cursor = cursor;
+				return cursor;
+			}
+		}
+	}
+
 	int low = 0;
 	int high = len - 1;
 	int middle = 0;
@@ -1427,12 +1558,13 @@ int Animation::_find(const Vector<K> &p_keys, float p_time) const {
 	}
 #endif
 
-	const K *keys = &p_keys[0];
-
 	while (low <= high) {
 		middle = (low + high) / 2;
 
 		if (Math::is_equal_approx(p_time, keys[middle].time)) { //match
+			if (p_cursor) {
+				*p_cursor = middle;
+			}
 			return middle;
 		} else if (p_time < keys[middle].time) {
 			high = middle - 1; //search low end of array
@@ -1445,6 +1577,10 @@ int Animation::_find(const Vector<K> &p_keys, float p_time) const {
 		middle--;
 	}
 
+	if (p_cursor) {
+		*p_cursor = middle;
+	}
+
 	return middle;
 }
 
@@ -1582,30 +1718,31 @@ float Animation::_cubic_interpolate(const float &p_pre_a, const float &p_a, cons
 	return _interpolate(p_a, p_b, p_c);
 }
 
-template <class T>
-T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok) const {
-	int len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+template <class K>
+bool Animation::_find_interpolation_keys(const Vector<K> &p_keys, float p_time, bool p_loop_wrap, int *p_cursor, int &r_idx, int &r_next, int &r_len, float &r_c) const {
+	int key_count = p_keys.size();
+	int len;
+	if (key_count > 0 && p_keys[key_count - 1].time <= length) {
+		len = key_count; // no keys past the end, skip the search
+	} else {
+		len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+	}
 
 	if (len <= 0) {
 		// (-1 or -2 returned originally) (plus one above)
 		// meaning no keys, or only key time is larger than length
-		if (p_ok) {
-			*p_ok = false;
-		}
-		return T();
+		return false;
 	} else if (len == 1) { // one key found (0+1), return it
-
-		if (p_ok) {
-			*p_ok = true;
-		}
-		return p_keys[0].value;
+		r_idx = r_next = 0;
+		r_len = len;
+		r_c = 0;
+		return true;
 	}
 
-	int idx = _find(p_keys, p_time);
+	int idx = _find(p_keys, p_time, p_cursor);
 
-	ERR_FAIL_COND_V(idx == -2, T());
+	ERR_FAIL_COND_V(idx == -2, false);
 
-	bool result = true;
 	int next = 0;
 	float c = 0;
 	// prepare for all cases of interpolation
@@ -1677,11 +1814,36 @@ T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, Interpola
 			if (loop) {
 				idx = next = 0;
 			} else {
-				result = false;
+				return false;
 			}
 		}
 	}
 
+	float tr = p_keys[idx].transition;
+
+	if (tr == 0) {
+		// don't interpolate if not needed
+		next = idx;
+	} else if (tr != 1.0 && idx != next) {
+		c = Math::ease(c, tr);
+	}
+
+	r_idx = idx;
+	r_next = next;
+	r_len = len;
+	r_c = c;
+	return true;
+}
+
+template <class T>
+T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *p_cursor) const {
+	int idx = 0;
+	int next = 0;
+	int len = 0;
+	float c = 0;
+
+	bool result = _find_interpolation_keys(p_keys, p_time, p_loop_wrap, p_cursor, idx, next, len, c);
+
 	if (p_ok) {
 		*p_ok = result;
 	}
@@ -1689,17 +1851,11 @@ T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, Interpola
 		return T();
 	}
 
-	float tr = p_keys[idx].transition;
-
-	if (tr == 0 || idx == next) {
+	if (idx == next) {
 		// don't interpolate if not needed
 		return p_keys[idx].value;
 	}
 
-	if (tr != 1.0) {
-		c = Math::ease(c, tr);
-	}
-
 	switch (p_interp) {
 		case INTERPOLATION_NEAREST: {
 			return p_keys[idx].value;
@@ -1727,7 +1883,45 @@ T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, Interpola
 	// do a barrel roll
 }
 
-Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale) const {
+Animation::TransformKey Animation::_compressed_transform_track_interpolate(const TransformTrack *p_track, float p_time, bool *p_ok, int *p_cursor) const {
+	int idx = 0;
+	int next = 0;
+	int len = 0;
+	float c = 0;
+
+	bool result = _find_interpolation_keys(p_track->compressed_times, p_time, p_track->loop_wrap, p_cursor, idx, next, len, c);
+
+	if (p_ok) {
+		*p_ok = result;
+	}
+	if (!result) {
+		return TransformKey();
+	}
+
+	const CompressedTransformKey *keys = p_track->compressed_keys.ptr();
+	TransformKey a = _decompress_transform_key(keys[idx], p_track->loc_bounds, p_track->scale_bounds);
+
+	if (idx == next || p_track->interpolation == INTERPOLATION_NEAREST) {
+		return a;
+	}
+
+	TransformKey b = _decompress_transform_key(keys[next], p_track->loc_bounds, p_track->scale_bounds);
+
+	if (p_track->interpolation == INTERPOLATION_CUBIC) {
+		int pre = MAX(idx - 1, 0);
+		int post = next + 1;
+		if (post >= len) {
+			post = next;
+		}
+		TransformKey pre_key = _decompress_transform_key(keys[pre], p_track->loc_bounds, p_track->scale_bounds);
+		TransformKey post_key = _decompress_transform_key(keys[post], p_track->loc_bounds, p_track->scale_bounds);
+		return _cubic_interpolate(pre_key, a, b, post_key, c);
+	}
+
+	return _interpolate(a, b, c);
+}
+
+Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale, int *p_cursor) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, ERR_INVALID_PARAMETER);
@@ -1736,7 +1930,12 @@ Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3
 
 	bool ok = false;
 
-	TransformKey tk = _interpolate(tt->transforms, p_time, tt->interpolation, tt->loop_wrap, &ok);
+	TransformKey tk;
+	if (tt->compressed) {
+		tk = _compressed_transform_track_interpolate(tt, p_time, &ok, p_cursor);
+	} else {
+		tk = _interpolate(tt->transforms, p_time, tt->interpolation, tt->loop_wrap, &ok, p_cursor);
+	}
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -1757,7 +1956,7 @@ Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3
 	return OK;
 }
 
-Variant Animation::value_track_interpolate(int p_track, float p_time) const {
+Variant Animation::value_track_interpolate(int p_track, float p_time, int *p_cursor) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), 0);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_VALUE, Variant());
@@ -1765,7 +1964,7 @@ Variant Animation::value_track_interpolate(int p_track, float p_time) const {
 
 	bool ok = false;
 
-	Variant res = _interpolate(vt->values, p_time, (vt->update_mode == UPDATE_CONTINUOUS || vt->update_mode == UPDATE_CAPTURE) ? vt->interpolation : INTERPOLATION_NEAREST, vt->loop_wrap, &ok);
+	Variant res = _interpolate(vt->values, p_time, (vt->update_mode == UPDATE_CONTINUOUS || vt->update_mode == UPDATE_CAPTURE) ? vt->interpolation : INTERPOLATION_NEAREST, vt->loop_wrap, &ok, p_cursor);
 
 	if (ok) {
 		return res;
@@ -1933,8 +2132,13 @@ void Animation::track_get_key_indices_in_range(int p_track, float p_time, float
 			switch (t->type) {
 				case TYPE_TRANSFORM: {
 					const TransformTrack *tt = static_cast<const TransformTrack *>(t);
-					_track_get_key_indices_in_range(tt->transforms, from_time, length, p_indices);
-					_track_get_key_indices_in_range(tt->transforms, 0, to_time, p_indices);
+					if (tt->compressed) {
+						_track_get_key_indices_in_range(tt->compressed_times, from_time, length, p_indices);
+						_track_get_key_indices_in_range(tt->compressed_times, 0, to_time, p_indices);
+					} else {
+						_track_get_key_indices_in_range(tt->transforms, from_time, length, p_indices);
+						_track_get_key_indices_in_range(tt->transforms, 0, to_time, p_indices);
+					}
 
 				} break;
 				case TYPE_VALUE: {
@@ -1989,7 +2193,11 @@ void Animation::track_get_key_indices_in_range(int p_track, float p_time, float
 	switch (t->type) {
 		case TYPE_TRANSFORM: {
 			const TransformTrack *tt = static_cast<const TransformTrack *>(t);
-			_track_get_key_indices_in_range(tt->transforms, from_time, to_time, p_indices);
+			if (tt->compressed) {
+				_track_get_key_indices_in_range(tt->compressed_times, from_time, to_time, p_indices);
+			} else {
+				_track_get_key_indices_in_range(tt->transforms, from_time, to_time, p_indices);
+			}
 
 		} break;
 		case TYPE_VALUE: {
@@ -2581,6 +2789,9 @@ void Animation::copy_track(int p_track, Ref<Animation> p_to_animation) {
 	for (int i = 0; i < track_get_key_count(p_track); i++) {
 		p_to_animation->track_insert_key(dst_track, track_get_key_time(p_track, i), track_get_key_value(p_track, i), track_get_key_transition(p_track, i));
 	}
+	if (track_is_compressed(p_track)) {
+		p_to_animation->_transform_track_compress(static_cast<TransformTrack *>(p_to_animation->tracks[dst_track]));
+	}
 }
 
 void Animation::_bind_methods() {
@@ -2669,6 +2880,10 @@ void Animation::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("clear"), &Animation::clear);
 	ClassDB::bind_method(D_METHOD("copy_track", "track_idx", "to_animation"), &Animation::copy_track);
 
+	ClassDB::bind_method(D_METHOD("compress"), &Animation::compress);
+	ClassDB::bind_method(D_METHOD("decompress"), &Animation::decompress);
+	ClassDB::bind_method(D_METHOD("track_is_compressed", "track_idx"), &Animation::track_is_compressed);
+
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "length", PROPERTY_HINT_RANGE, "0.001,99999,0.001"), "set_length", "get_length");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "loop"), "set_loop", "has_loop");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "step", PROPERTY_HINT_RANGE, "0,4096,0.001"), "set_step", "get_step");
@@ -2913,9 +3128,210 @@ void Animation::_transform_track_optimize(int p_idx, float p_allowed_linear_err,
 void Animation::optimize(float p_allowed_linear_err, float p_allowed_angular_err, float p_max_optimizable_angle) {
 	for (int i = 0; i < tracks.size(); i++) {
 		if (tracks[i]->type == TYPE_TRANSFORM) {
+			TransformTrack *tt = static_cast<TransformTrack *>(tracks[i]);
+			bool compressed = tt->compressed;
+			_transform_track_decompress(tt);
 			_transform_track_optimize(i, p_allowed_linear_err, p_allowed_angular_err, p_max_optimizable_angle);
+			if (compressed) {
+				_transform_track_compress(tt);
+			}
+		}
+	}
+}
+
+Animation::CompressedTransformKey Animation::_compress_transform_key(const TransformKey &p_key, const AABB &p_loc_bounds, const AABB &p_scale_bounds) {
+	CompressedTransformKey ck;
+
+	for (int i = 0; i < 3; i++) {
+		float loc = p_loc_bounds.size[i] > 0 ? (p_key.loc[i] - p_loc_bounds.position[i]) / p_loc_bounds.size[i] : 0;
+		ck.loc[i] = CLAMP(Math::fast_ftoi(loc * 65535.0), 0, 65535);
+		float scale = p_scale_bounds.size[i] > 0 ? (p_key.scale[i] - p_scale_bounds.position[i]) / p_scale_bounds.size[i] : 0;
+		ck.scale[i] = CLAMP(Math::fast_ftoi(scale * 65535.0), 0, 65535);
+	}
+
+	// Smallest three: drop the largest component, it can be recovered from the
+	// others since the quaternion is normalized. Flipping the sign so that it's
+	// positive doesn't change the rotation.
+	Quat rot = p_key.rot.normalized();
+	const real_t *q = &rot.x;
+	int largest = 0;
+	for (int i = 1; i < 4; i++) {
+		if (Math::abs(q[i]) > Math::abs(q[largest])) {
+			largest = i;
+		}
+	}
+	real_t sign = q[largest] < 0 ? -1 : 1;
+
+	int j = 0;
+	for (int i = 0; i < 4; i++) {
+		if (i == largest) {
+			continue;
+		}
+		// The remaining components are within [-1/sqrt(2), 1/sqrt(2)].
+		float c = (q[i] * sign * Math_SQRT12 + 0.5) * 32767.0;
+		ck.rot[j++] = CLAMP(Math::fast_ftoi(c), 0, 32767);
+	}
+	ck.rot[0] |= (largest & 1) << 15;
+	ck.rot[1] |= (largest >> 1) << 15;
+
+	return ck;
+}
+
+Animation::TransformKey Animation::_decompress_transform_key(const CompressedTransformKey &p_key, const AABB &p_loc_bounds, const AABB &p_scale_bounds) {
+	TransformKey key;
+
+	const real_t loc_step = 1.0 / 65535.0;
+	key.loc.x = p_loc_bounds.position.x + p_loc_bounds.size.x * (p_key.loc[0] * loc_step);
+	key.loc.y = p_loc_bounds.position.y + p_loc_bounds.size.y * (p_key.loc[1] * loc_step);
+	key.loc.z = p_loc_bounds.position.z + p_loc_bounds.size.z * (p_key.loc[2] * loc_step);
+	key.scale.x = p_scale_bounds.position.x + p_scale_bounds.size.x * (p_key.scale[0] * loc_step);
+	key.scale.y = p_scale_bounds.position.y + p_scale_bounds.size.y * (p_key.scale[1] * loc_step);
+	key.scale.z = p_scale_bounds.position.z + p_scale_bounds.size.z * (p_key.scale[2] * loc_step);
+
+	const real_t rot_step = Math_SQRT2 / 32767.0;
+	real_t a = (p_key.rot[0] & 0x7FFF) * rot_step - Math_SQRT12;
+	real_t b = (p_key.rot[1] & 0x7FFF) * rot_step - Math_SQRT12;
+	real_t c = (p_key.rot[2] & 0x7FFF) * rot_step - Math_SQRT12;
+	real_t d = Math::sqrt(MAX((real_t)0.0, 1 - (a * a + b * b + c * c)));
+
+	switch ((p_key.rot[0] >> 15) | ((p_key.rot[1] >> 15) << 1)) {
+		case 0: {
+			key.rot = Quat(d, a, b, c);
+		} break;
+		case 1: {
+			key.rot = Quat(a, d, b, c);
+		} break;
+		case 2: {
+			key.rot = Quat(a, b, d, c);
+		} break;
+		default: {
+			key.rot = Quat(a, b, c, d);
+		} break;
+	}
+
+	return key;
+}
+
+void Animation::_transform_track_compress(TransformTrack *p_track) {
+	if (p_track->compressed) {
+		return;
+	}
+
+	const TKey<TransformKey> *keys = p_track->transforms.ptr();
+	int key_count = p_track->transforms.size();
+
+	p_track->loc_bounds = AABB();
+	p_track->scale_bounds = AABB();
+	for (int i = 0; i < key_count; i++) {
+		if (i == 0) {
+			p_track->loc_bounds.position = keys[i].value.loc;
+			p_track->scale_bounds.position = keys[i].value.scale;
+		} else {
+			p_track->loc_bounds.expand_to(keys[i].value.loc);
+			p_track->scale_bounds.expand_to(keys[i].value.scale);
+		}
+	}
+
+	p_track->compressed_times.resize(key_count);
+	p_track->compressed_keys.resize(key_count);
+	Key *times = p_track->compressed_times.ptrw();
+	CompressedTransformKey *compressed_keys = p_track->compressed_keys.ptrw();
+
+	int count = 0;
+	for (int i = 0; i < key_count; i++) {
+		CompressedTransformKey ck = _compress_transform_key(keys[i].value, p_track->loc_bounds, p_track->scale_bounds);
+
+		// After quantization, held poses often produce runs of identical keys. A key
+		// between two identical neighbors with the same transitions adds nothing.
+		if (count >= 2 && ck == compressed_keys[count - 1] && ck == compressed_keys[count - 2] && keys[i].transition == times[count - 1].transition && times[count - 1].transition == times[count - 2].transition) {
+			count--;
+		}
+
+		times[count].time = keys[i].time;
+		times[count].transition = keys[i].transition;
+		compressed_keys[count] = ck;
+		count++;
+	}
+
+	p_track->compressed_times.resize(count);
+	p_track->compressed_keys.resize(count);
+	p_track->transforms.clear();
+	p_track->compressed = true;
+}
+
+void Animation::_transform_track_decompress(TransformTrack *p_track) {
+	if (!p_track->compressed) {
+		return;
+	}
+
+	int key_count = p_track->compressed_times.size();
+	p_track->transforms.resize(key_count);
+	TKey<TransformKey> *keys = p_track->transforms.ptrw();
+	for (int i = 0; i < key_count; i++) {
+		keys[i].time = p_track->compressed_times[i].time;
+		keys[i].transition = p_track->compressed_times[i].transition;
+		keys[i].value = _decompress_transform_key(p_track->compressed_keys[i], p_track->loc_bounds, p_track->scale_bounds);
+	}
+
+	p_track->compressed_times.clear();
+	p_track->compressed_keys.clear();
+	p_track->compressed = false;
+}
+
+void Animation::compress() {
+	for (int i = 0; i < tracks.size(); i++) {
+		if (tracks[i]->type == TYPE_TRANSFORM) {
+			_transform_track_compress(static_cast<TransformTrack *>(tracks[i]));
+		}
+	}
+	emit_changed();
+}
+
+void Animation::decompress() {
+	for (int i = 0; i < tracks.size(); i++) {
+		if (tracks[i]->type == TYPE_TRANSFORM) {
+			_transform_track_decompress(static_cast<TransformTrack *>(tracks[i]));
+		}
+	}
+	emit_changed();
+}
+
+bool Animation::track_is_compressed(int p_track) const {
+	ERR_FAIL_INDEX_V(p_track, tracks.size(), false);
+	if (tracks[p_track]->type != TYPE_TRANSFORM) {
+		return false;
+	}
+	return static_cast<const TransformTrack *>(tracks[p_track])->compressed;
+}
+
+int Animation::get_memory_usage() const {
+	int usage = sizeof(Animation) + tracks.size() * sizeof(Track *);
+	for (int i = 0; i < tracks.size(); i++) {
+		switch (tracks[i]->type) {
+			case TYPE_TRANSFORM: {
+				const TransformTrack *tt = static_cast<const TransformTrack *>(tracks[i]);
+				usage += sizeof(TransformTrack);
+				usage += tt->transforms.size() * sizeof(TKey<TransformKey>);
+				usage += tt->compressed_times.size() * sizeof(Key) + tt->compressed_keys.size() * sizeof(CompressedTransformKey);
+			} break;
+			case TYPE_VALUE: {
+				usage += sizeof(ValueTrack) + static_cast<const ValueTrack *>(tracks[i])->values.size() * sizeof(TKey<Variant>);
+			} break;
+			case TYPE_METHOD: {
+				usage += sizeof(MethodTrack) + static_cast<const MethodTrack *>(tracks[i])->methods.size() * sizeof(MethodKey);
+			} break;
+			case TYPE_BEZIER: {
+				usage += sizeof(BezierTrack) + static_cast<const BezierTrack *>(tracks[i])->values.size() * sizeof(TKey<BezierKey>);
+			} break;
+			case TYPE_AUDIO: {
+				usage += sizeof(AudioTrack) + static_cast<const AudioTrack *>(tracks[i])->values.size() * sizeof(TKey<AudioKey>);
+			} break;
+			case TYPE_ANIMATION: {
+				usage += sizeof(AnimationTrack) + static_cast<const AnimationTrack *>(tracks[i])->values.size() * sizeof(TKey<StringName>);
+			} break;
 		}
 	}
+	return usage;
 }
 
 Animation::Animation() {
@@ -99,11 +99,36 @@ private:
 		Vector3 scale;
 	};
 
+	// Location and scale are quantized to 16 bits per axis within the track bounds,
+	// rotations keep the three smallest quaternion components at 15 bits each, the
+	// index of the dropped component is stored in the top bits of rot[0] and rot[1].
+	struct CompressedTransformKey {
+		uint16_t loc[3];
+		uint16_t rot[3];
+		uint16_t scale[3];
+
+		bool operator==(const CompressedTransformKey &p_key) const {
+			for (int i = 0; i < 3; i++) {
+				if (loc[i] != p_key.loc[i] || rot[i] != p_key.rot[i] || scale[i] != p_key.scale[i]) {
+					return false;
+				}
+			}
+			return true;
+		}
+	};
+
 	/* TRANSFORM TRACK */
 
 	struct TransformTrack : public Track {
 		Vector<TKey<TransformKey>> transforms;
 
+		// When compressed, keys live in compressed_times/compressed_keys and transforms is empty.
+		bool compressed = false;
+		Vector<Key> compressed_times;
+		Vector<CompressedTransformKey> compressed_keys;
+		AABB loc_bounds;
+		AABB scale_bounds;
+
 		TransformTrack() { type = TYPE_TRANSFORM; }
 	};
 
@@ -191,7 +216,7 @@ private:
 	int _insert(float p_time, T &p_keys, const V &p_value);
 
 	template <class K>
-	inline int _find(const Vector<K> &p_keys, float p_time) const;
+	inline int _find(const Vector<K> &p_keys, float p_time, int *p_cursor = nullptr) const;
 
 	_FORCE_INLINE_ Animation::TransformKey _interpolate(const Animation::TransformKey &p_a, const Animation::TransformKey &p_b, float p_c) const;
 
@@ -206,8 +231,18 @@ private:
 	_FORCE_INLINE_ Variant _cubic_interpolate(const Variant &p_pre_a, const Variant &p_a, const Variant &p_b, const Variant &p_post_b, float p_c) const;
 	_FORCE_INLINE_ float _cubic_interpolate(const float &p_pre_a, const float &p_a, const float &p_b, const float &p_post_b, float p_c) const;
 
+	template <class K>
+	_FORCE_INLINE_ bool _find_interpolation_keys(const Vector<K> &p_keys, float p_time, bool p_loop_wrap, int *p_cursor, int &r_idx, int &r_next, int &r_len, float &r_c) const;
+
 	template <class T>
-	_FORCE_INLINE_ T _interpolate(const Vector<TKey<T>> &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok) const;
+	_FORCE_INLINE_ T _interpolate(const Vector<TKey<T>> &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *p_cursor = nullptr) const;
+
+	TransformKey _compressed_transform_track_interpolate(const TransformTrack *p_track, float p_time, bool *p_ok, int *p_cursor) const;
+
+	static CompressedTransformKey _compress_transform_key(const TransformKey &p_key, const AABB &p_loc_bounds, const AABB &p_scale_bounds);
+	static TransformKey _decompress_transform_key(const CompressedTransformKey &p_key, const AABB &p_loc_bounds, const AABB &p_scale_bounds);
+	void _transform_track_compress(TransformTrack *p_track);
+	void _transform_track_decompress(TransformTrack *p_track);
 
 	template <class T>
 	_FORCE_INLINE_ void _track_get_key_indices_in_range(const Vector<T> &p_array, float from_time, float to_time, List<int> *p_indices) const;
@@ -329,9 +364,9 @@ public:
 	void track_set_interpolation_loop_wrap(int p_track, bool p_enable);
 	bool track_get_interpolation_loop_wrap(int p_track) const;
 
-	Error transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale) const;
+	Error transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale, int *p_cursor = nullptr) const;
 
-	Variant value_track_interpolate(int p_track, float p_time) const;
+	Variant value_track_interpolate(int p_track, float p_time, int *p_cursor = nullptr) const;
 	void value_track_get_key_indices(int p_track, float p_time, float p_delta, List<int> *p_indices) const;
 	void value_track_set_update_mode(int p_track, UpdateMode p_mode);
 	UpdateMode value_track_get_update_mode(int p_track) const;
@@ -357,6 +392,11 @@ public:
 
 	void optimize(float p_allowed_linear_err = 0.05, float p_allowed_angular_err = 0.01, float p_max_optimizable_angle = Math_PI * 0.125);
 
+	void compress();
+	void decompress();
+	bool track_is_compressed(int p_track) const;
+	int get_memory_usage() const;
+
 	Animation();
 	~Animation();
 };
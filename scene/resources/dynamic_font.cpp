@@ -111,6 +111,8 @@ DynamicFontData::~DynamicFontData() {
 
 ////////////////////
 HashMap<String, Vector<uint8_t>> DynamicFontAtSize::_fontdata;
+Vector<DynamicFontAtSize::CharTexture> DynamicFontAtSize::textures;
+Mutex DynamicFontAtSize::textures_mutex;
 
 Error DynamicFontAtSize::_load() {
 	int error = FT_Init_FreeType(&library);
@@ -307,22 +309,18 @@ float DynamicFontAtSize::draw_char(RID p_canvas_item, const Point2 &p_pos, CharT
 
 	// use normal character size if there's no outline character
 	if (p_outline && !ch->found) {
-		FT_GlyphSlot slot = face->glyph;
+		// Only the advance is needed, so there is no point in rendering the glyph.
 		int error = FT_Load_Char(face, p_char, FT_HAS_COLOR(face) ? FT_LOAD_COLOR : FT_LOAD_DEFAULT);
 		if (!error) {
-			error = FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL);
-			if (!error) {
-				Character character = Character::not_found();
-				character = const_cast<DynamicFontAtSize *>(this)->_bitmap_to_character(slot->bitmap, slot->bitmap_top, slot->bitmap_left, slot->advance.x / 64.0);
-				advance = character.advance;
-			}
+			advance = face->glyph->advance.x / 64.0 * scale_color_font / oversampling;
 		}
 	}
 
 	if (ch->found) {
-		ERR_FAIL_COND_V(ch->texture_idx < -1 || ch->texture_idx >= font->textures.size(), 0);
-
 		if (!p_advance_only && ch->texture_idx != -1) {
+			RID texture = _get_texture_rid(ch->texture_idx);
+			ERR_FAIL_COND_V(!texture.is_valid(), 0);
+
 			Point2 cpos = p_pos;
 			cpos.x += ch->h_align;
 			cpos.y -= font->get_ascent();
@@ -331,7 +329,6 @@ float DynamicFontAtSize::draw_char(RID p_canvas_item, const Point2 &p_pos, CharT
 			if (FT_HAS_COLOR(face)) {
 				modulate.r = modulate.g = modulate.b = 1.0;
 			}
-			RID texture = font->textures[ch->texture_idx].texture->get_rid();
 			RenderingServer::get_singleton()->canvas_item_add_texture_rect_region(p_canvas_item, Rect2(cpos, ch->rect.size), texture, ch->rect_uv, modulate, false, RID(), RID(), Color(1, 1, 1, 1), false);
 		}
 
@@ -383,7 +380,7 @@ DynamicFontAtSize::TexturePosition DynamicFontAtSize::_find_texture_pos_for_glyp
 	for (int i = 0; i < textures.size(); i++) {
 		const CharTexture &ct = textures[i];
 
-		if (ct.texture->get_format() != p_image_format) {
+		if (ct.format != p_image_format) {
 			continue;
 		}
 
@@ -437,6 +434,7 @@ DynamicFontAtSize::TexturePosition DynamicFontAtSize::_find_texture_pos_for_glyp
 
 		CharTexture tex;
 		tex.texture_size = texsize;
+		tex.format = p_image_format;
 		tex.imgdata.resize(texsize * texsize * p_color_size); //grayscale alpha
 
 		{
@@ -472,6 +470,8 @@ DynamicFontAtSize::Character DynamicFontAtSize::_bitmap_to_character(FT_Bitmap b
 	int color_size = bitmap.pixel_mode == FT_PIXEL_MODE_BGRA ? 4 : 2;
 	Image::Format require_format = color_size == 4 ? Image::FORMAT_RGBA8 : Image::FORMAT_LA8;
 
+	MutexLock lock(textures_mutex);
+
 	TexturePosition tex_pos = _find_texture_pos_for_glyph(color_size, require_format, mw, mh);
 	ERR_FAIL_COND_V(tex_pos.index < 0, Character::not_found());
 
@@ -513,17 +513,9 @@ DynamicFontAtSize::Character DynamicFontAtSize::_bitmap_to_character(FT_Bitmap b
 		}
 	}
 
-	//blit to image and texture
-	{
-		Ref<Image> img = memnew(Image(tex.texture_size, tex.texture_size, 0, require_format, tex.imgdata));
-
-		if (tex.texture.is_null()) {
-			tex.texture.instance();
-			tex.texture->create_from_image(img);
-		} else {
-			tex.texture->update(img); //update
-		}
-	}
+	// uploaded lazily, see _get_texture_rid()
+	tex.dirty = true;
+	tex.glyph_count++;
 
 	// update height array
 
@@ -629,13 +621,61 @@ void DynamicFontAtSize::_update_char(CharType p_char) {
 	char_map[p_char] = character;
 }
 
+RID DynamicFontAtSize::_get_texture_rid(int p_idx) {
+	MutexLock lock(textures_mutex);
+	ERR_FAIL_INDEX_V(p_idx, textures.size(), RID());
+
+	CharTexture &tex = textures.write[p_idx];
+	if (tex.dirty) {
+		Ref<Image> img = memnew(Image(tex.texture_size, tex.texture_size, 0, tex.format, tex.imgdata));
+
+		if (tex.texture.is_null()) {
+			tex.texture.instance();
+			tex.texture->create_from_image(img);
+		} else {
+			tex.texture->update(img); //update
+		}
+		tex.dirty = false;
+	}
+
+	return tex.texture->get_rid();
+}
+
+void DynamicFontAtSize::_release_textures() {
+	MutexLock lock(textures_mutex);
+
+	const CharType *key = nullptr;
+	while ((key = char_map.next(key))) {
+		const Character &chr = char_map[*key];
+		if (!chr.found || chr.texture_idx < 0 || chr.texture_idx >= textures.size()) {
+			continue;
+		}
+
+		CharTexture &tex = textures.write[chr.texture_idx];
+		tex.glyph_count--;
+		if (tex.glyph_count == 0) {
+			// Nobody uses this page anymore, start filling it again from scratch.
+			memset(tex.imgdata.ptrw(), 0, tex.imgdata.size());
+			for (int i = 0; i < tex.offsets.size(); i++) {
+				tex.offsets.write[i] = 0;
+			}
+			tex.dirty = true;
+		}
+	}
+}
+
+void DynamicFontAtSize::finish_textures() {
+	MutexLock lock(textures_mutex);
+	textures.clear();
+}
+
 void DynamicFontAtSize::update_oversampling() {
 	if (oversampling == font_oversampling || !valid) {
 		return;
 	}
 
 	FT_Done_FreeType(library);
-	textures.clear();
+	_release_textures();
 	char_map.clear();
 	oversampling = font_oversampling;
 	valid = false;
@@ -656,6 +696,7 @@ DynamicFontAtSize::~DynamicFontAtSize() {
 	if (valid) {
 		FT_Done_FreeType(library);
 	}
+	_release_textures();
 	font->size_cache.erase(id);
 	font.unref();
 }
@@ -673,6 +714,8 @@ void DynamicFont::_reload_cache() {
 		return;
 	}
 
+	_clear_string_size_cache();
+
 	data_at_size = data->_get_dynamic_font_at_size(cache_id);
 	if (outline_cache_id.outline_size > 0) {
 		outline_data_at_size = data->_get_dynamic_font_at_size(outline_cache_id);
@@ -790,6 +833,7 @@ void DynamicFont::set_spacing(int p_type, int p_value) {
 		spacing_space = p_value;
 	}
 
+	_clear_string_size_cache();
 	emit_changed();
 	_change_notify();
 }
@@ -849,6 +893,35 @@ Size2 DynamicFont::get_char_size(CharType p_char, CharType p_next) const {
 	return ret;
 }
 
+Size2 DynamicFont::get_string_size(const String &p_string) const {
+	if (!data_at_size.is_valid() || p_string.empty()) {
+		return Font::get_string_size(p_string);
+	}
+
+	{
+		MutexLock lock(string_size_cache_mutex);
+		const float *width = string_size_cache.getptr(p_string);
+		if (width) {
+			return Size2(*width, get_height());
+		}
+	}
+
+	Size2 size = Font::get_string_size(p_string);
+
+	MutexLock lock(string_size_cache_mutex);
+	if (string_size_cache.size() >= STRING_SIZE_CACHE_MAX) {
+		string_size_cache.clear();
+	}
+	string_size_cache.set(p_string, size.width);
+
+	return size;
+}
+
+void DynamicFont::_clear_string_size_cache() {
+	MutexLock lock(string_size_cache_mutex);
+	string_size_cache.clear();
+}
+
 bool DynamicFont::is_distance_field_hint() const {
 	return false;
 }
@@ -877,6 +950,7 @@ void DynamicFont::set_fallback(int p_idx, const Ref<DynamicFontData> &p_data) {
 	ERR_FAIL_INDEX(p_idx, fallbacks.size());
 	fallbacks.write[p_idx] = p_data;
 	fallback_data_at_size.write[p_idx] = fallbacks.write[p_idx]->_get_dynamic_font_at_size(cache_id);
+	_clear_string_size_cache();
 }
 
 void DynamicFont::add_fallback(const Ref<DynamicFontData> &p_data) {
@@ -886,6 +960,7 @@ void DynamicFont::add_fallback(const Ref<DynamicFontData> &p_data) {
 	if (outline_cache_id.outline_size > 0) {
 		fallback_outline_data_at_size.push_back(fallbacks.write[fallbacks.size() - 1]->_get_dynamic_font_at_size(outline_cache_id));
 	}
+	_clear_string_size_cache();
 
 	_change_notify();
 	emit_changed();
@@ -906,6 +981,7 @@ void DynamicFont::remove_fallback(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, fallbacks.size());
 	fallbacks.remove(p_idx);
 	fallback_data_at_size.remove(p_idx);
+	_clear_string_size_cache();
 	emit_changed();
 	_change_notify();
 }
@@ -1031,6 +1107,7 @@ void DynamicFont::initialize_dynamic_fonts() {
 void DynamicFont::finish_dynamic_fonts() {
 	memdelete(dynamic_fonts);
 	dynamic_fonts = nullptr;
+	DynamicFontAtSize::finish_textures();
 }
 
 void DynamicFont::update_oversampling() {
@@ -1057,6 +1134,7 @@ void DynamicFont::update_oversampling() {
 					}
 				}
 
+				E->self()->_clear_string_size_cache();
 				changed.push_back(Ref<DynamicFont>(E->self()));
 			}
 
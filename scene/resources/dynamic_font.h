@@ -130,11 +130,20 @@ class DynamicFontAtSize : public Reference {
 	struct CharTexture {
 		Vector<uint8_t> imgdata;
 		int texture_size;
+		Image::Format format;
 		Vector<int> offsets;
 		Ref<ImageTexture> texture;
+		int glyph_count = 0;
+		bool dirty = false;
 	};
 
-	Vector<CharTexture> textures;
+	// Glyph pages are shared by all fonts and sizes. Newly rasterized glyphs only
+	// mark their page dirty, it gets uploaded once when something is drawn from it.
+	static Vector<CharTexture> textures;
+	static Mutex textures_mutex;
+
+	static RID _get_texture_rid(int p_idx);
+	void _release_textures();
 
 	struct Character {
 		bool found;
@@ -195,6 +204,8 @@ public:
 	void set_texture_flags(uint32_t p_flags);
 	void update_oversampling();
 
+	static void finish_textures();
+
 	DynamicFontAtSize();
 	~DynamicFontAtSize();
 };
@@ -232,6 +243,16 @@ private:
 
 	Color outline_color;
 
+	enum {
+		STRING_SIZE_CACHE_MAX = 4096
+	};
+
+	// Widths of recently measured strings at the current size and spacing.
+	mutable HashMap<String, float> string_size_cache;
+	mutable Mutex string_size_cache_mutex;
+
+	void _clear_string_size_cache();
+
 protected:
 	void _reload_cache();
 
@@ -277,6 +298,7 @@ public:
 	virtual float get_underline_thickness() const;
 
 	virtual Size2 get_char_size(CharType p_char, CharType p_next = 0) const;
+	virtual Size2 get_string_size(const String &p_string) const;
 
 	virtual bool is_distance_field_hint() const;
 
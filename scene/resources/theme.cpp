@@ -32,10 +32,17 @@
 #include "core/os/file_access.h"
 #include "core/print_string.h"
 
+std::atomic<uint64_t> Theme::change_version(1);
+
 void Theme::_emit_theme_changed() {
 	emit_changed();
 }
 
+void Theme::_changed() {
+	// Not deferred, items cached by controls must not outlive the change.
+	bump_change_version();
+}
+
 Vector<String> Theme::_get_icon_list(const String &p_type) const {
 	Vector<String> ilret;
 	List<StringName> il;
@@ -303,6 +310,7 @@ Ref<Theme> Theme::get_default() {
 
 void Theme::set_default(const Ref<Theme> &p_default) {
 	default_theme = p_default;
+	bump_change_version();
 }
 
 Ref<Theme> Theme::get_project_default() {
@@ -311,18 +319,22 @@ Ref<Theme> Theme::get_project_default() {
 
 void Theme::set_project_default(const Ref<Theme> &p_project_default) {
 	project_default_theme = p_project_default;
+	bump_change_version();
 }
 
 void Theme::set_default_icon(const Ref<Texture2D> &p_icon) {
 	default_icon = p_icon;
+	bump_change_version();
 }
 
 void Theme::set_default_style(const Ref<StyleBox> &p_style) {
 	default_style = p_style;
+	bump_change_version();
 }
 
 void Theme::set_default_font(const Ref<Font> &p_font) {
 	default_font = p_font;
+	bump_change_version();
 }
 
 void Theme::set_icon(const StringName &p_name, const StringName &p_type, const Ref<Texture2D> &p_icon) {
@@ -845,6 +857,7 @@ void Theme::_bind_methods() {
 }
 
 Theme::Theme() {
+	connect("changed", callable_mp(this, &Theme::_changed));
 }
 
 Theme::~Theme() {
@@ -38,6 +38,8 @@
 #include "scene/resources/style_box.h"
 #include "scene/resources/texture.h"
 
+#include <atomic>
+
 class Theme : public Resource {
 	GDCLASS(Theme, Resource);
 	RES_BASE_EXTENSION("theme");
@@ -70,6 +72,10 @@ protected:
 	static Ref<StyleBox> default_style;
 	static Ref<Font> default_font;
 
+	// Bumped whenever any theme or one of the defaults changes, so resolved items can be cached.
+	static std::atomic<uint64_t> change_version;
+	void _changed();
+
 	Ref<Font> default_theme_font;
 
 	static void _bind_methods();
@@ -85,6 +91,9 @@ public:
 	static void set_default_style(const Ref<StyleBox> &p_style);
 	static void set_default_font(const Ref<Font> &p_font);
 
+	static uint64_t get_change_version() { return change_version.load(std::memory_order_relaxed); }
+	static void bump_change_version() { change_version.fetch_add(1, std::memory_order_relaxed); }
+
 	void set_default_theme_font(const Ref<Font> &p_default_font);
 	Ref<Font> get_default_theme_font() const;
 
@@ -34,6 +34,7 @@
 #include "broad_phase_2d_hash_grid.h"
 #include "collision_solver_2d_sw.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/trace_profiler.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
 
@@ -1223,6 +1224,7 @@ void PhysicsServer2DSW::init() {
 };
 
 void PhysicsServer2DSW::step(real_t p_step) {
+	TRACE_ZONE("PhysicsServer2D::step");
 	if (!active) {
 		return;
 	}
@@ -1249,6 +1251,7 @@ void PhysicsServer2DSW::sync() {
 };
 
 void PhysicsServer2DSW::flush_queries() {
+	TRACE_ZONE("PhysicsServer2D::flush_queries");
 	if (!active) {
 		return;
 	}
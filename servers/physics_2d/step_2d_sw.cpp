@@ -29,6 +29,7 @@
 /*************************************************************************/
 
 #include "step_2d_sw.h"
+#include "core/debugger/trace_profiler.h"
 #include "core/os/os.h"
 
 void Step2DSW::_populate_island(Body2DSW *p_body, Body2DSW **p_island, Constraint2DSW **p_constraint_island) {
@@ -129,6 +130,7 @@ void Step2DSW::_check_suspend(Body2DSW *p_island, real_t p_delta) {
 }
 
 void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
+	TRACE_ZONE("Step2DSW::step");
 	p_space->lock(); // can't access space during this
 
 	p_space->setup(); //update inertias, etc
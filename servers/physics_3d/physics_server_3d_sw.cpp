@@ -33,6 +33,7 @@
 #include "broad_phase_3d_basic.h"
 #include "broad_phase_octree.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/trace_profiler.h"
 #include "core/os/os.h"
 #include "joints/cone_twist_joint_3d_sw.h"
 #include "joints/generic_6dof_joint_3d_sw.h"
@@ -1295,6 +1296,7 @@ void PhysicsServer3DSW::init() {
 };
 
 void PhysicsServer3DSW::step(real_t p_step) {
+	TRACE_ZONE("PhysicsServer3D::step");
 #ifndef _3D_DISABLED
 
 	if (!active) {
@@ -1321,6 +1323,7 @@ void PhysicsServer3DSW::step(real_t p_step) {
 }
 
 void PhysicsServer3DSW::flush_queries() {
+	TRACE_ZONE("PhysicsServer3D::flush_queries");
 #ifndef _3D_DISABLED
 
 	if (!active) {
@@ -31,6 +31,7 @@
 #include "step_3d_sw.h"
 #include "joints_3d_sw.h"
 
+#include "core/debugger/trace_profiler.h"
 #include "core/os/os.h"
 
 void Step3DSW::_populate_island(Body3DSW *p_body, Body3DSW **p_island, Constraint3DSW **p_constraint_island) {
@@ -140,6 +141,7 @@ void Step3DSW::_check_suspend(Body3DSW *p_island, real_t p_delta) {
 }
 
 void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
+	TRACE_ZONE("Step3DSW::step");
 	p_space->lock(); // can't access space during this
 
 	p_space->setup(); //update inertias, etc
@@ -2707,6 +2707,26 @@ void RasterizerStorageRD::_multimesh_mark_all_dirty(MultiMesh *multimesh, bool p
 	}
 }
 
+void RasterizerStorageRD::_multimesh_mark_range_dirty(MultiMesh *multimesh, int p_from, int p_count) {
+	uint32_t from_region = p_from / MULTIMESH_DIRTY_REGION_SIZE;
+	uint32_t to_region = (p_from + p_count - 1) / MULTIMESH_DIRTY_REGION_SIZE;
+
+	for (uint32_t i = from_region; i <= to_region; i++) {
+		if (!multimesh->data_cache_dirty_regions[i]) {
+			multimesh->data_cache_dirty_regions[i] = true;
+			multimesh->data_cache_used_dirty_regions++;
+		}
+	}
+
+	multimesh->aabb_dirty = true;
+
+	if (!multimesh->dirty) {
+		multimesh->dirty_list = multimesh_dirty_list;
+		multimesh_dirty_list = multimesh;
+		multimesh->dirty = true;
+	}
+}
+
 void RasterizerStorageRD::_multimesh_re_create_aabb(MultiMesh *multimesh, const float *p_data, int p_instances) {
 	ERR_FAIL_COND(multimesh->mesh.is_null());
 	AABB aabb;
@@ -2991,6 +3011,27 @@ void RasterizerStorageRD::multimesh_set_buffer(RID p_multimesh, const Vector<flo
 	}
 }
 
+void RasterizerStorageRD::multimesh_set_buffer_range(RID p_multimesh, int p_from_instance, const Vector<float> &p_buffer) {
+	MultiMesh *multimesh = multimesh_owner.getornull(p_multimesh);
+	ERR_FAIL_COND(!multimesh);
+	ERR_FAIL_COND(p_buffer.size() % multimesh->stride_cache != 0);
+
+	int count = p_buffer.size() / multimesh->stride_cache;
+	if (count == 0) {
+		return;
+	}
+	ERR_FAIL_COND(p_from_instance < 0 || p_from_instance + count > multimesh->instances);
+
+	// Ranges go through the local copy, so only the regions they touch are uploaded
+	// and the AABB can be rebuilt from it.
+	_multimesh_make_local(multimesh);
+
+	copymem(multimesh->data_cache.ptrw() + p_from_instance * multimesh->stride_cache, p_buffer.ptr(), p_buffer.size() * sizeof(float));
+	multimesh->buffer_set = true;
+
+	_multimesh_mark_range_dirty(multimesh, p_from_instance, count);
+}
+
 Vector<float> RasterizerStorageRD::multimesh_get_buffer(RID p_multimesh) const {
 	MultiMesh *multimesh = multimesh_owner.getornull(p_multimesh);
 	ERR_FAIL_COND_V(!multimesh, Vector<float>());
@@ -3058,18 +3099,49 @@ void RasterizerStorageRD::_update_dirty_multimeshes() {
 				uint32_t data_cache_dirty_region_count = (multimesh->instances - 1) / MULTIMESH_DIRTY_REGION_SIZE + 1;
 				uint32_t visible_region_count = (visible_instances - 1) / MULTIMESH_DIRTY_REGION_SIZE + 1;
 
-				uint32_t region_size = multimesh->stride_cache * MULTIMESH_DIRTY_REGION_SIZE * sizeof(float);
+				uint32_t region_floats = multimesh->stride_cache * MULTIMESH_DIRTY_REGION_SIZE;
+				uint32_t region_size = region_floats * sizeof(float);
+				uint64_t total_size = multimesh->stride_cache * multimesh->instances * sizeof(float);
 
-				if (multimesh->data_cache_used_dirty_regions > 32 || multimesh->data_cache_used_dirty_regions > visible_region_count / 2) {
-					//if there too many dirty regions, or represent the majority of regions, just copy all, else transfer cost piles up too much
-					RD::get_singleton()->buffer_update(multimesh->buffer, 0, MIN(visible_region_count * region_size, multimesh->instances * multimesh->stride_cache * sizeof(float)), data, false);
+				if (multimesh->data_cache_used_dirty_regions > visible_region_count / 2) {
+					//if dirty regions represent the majority of regions, just copy all
+					RD::get_singleton()->buffer_update(multimesh->buffer, 0, MIN(visible_region_count * region_size, total_size), data, false);
 				} else {
-					//not that many regions? update them all
+					//adjacent dirty regions are uploaded together, one update per run
+					uint32_t run_count = 0;
+					uint32_t first_dirty = visible_region_count;
+					uint32_t last_dirty = 0;
 					for (uint32_t i = 0; i < visible_region_count; i++) {
 						if (multimesh->data_cache_dirty_regions[i]) {
+							if (i == 0 || !multimesh->data_cache_dirty_regions[i - 1]) {
+								run_count++;
+							}
+							first_dirty = MIN(first_dirty, i);
+							last_dirty = i;
+						}
+					}
+
+					if (run_count > 32) {
+						//too many separate transfers, send the whole span covering them instead
+						uint64_t offset = first_dirty * region_size;
+						uint64_t size = MIN((uint64_t)(last_dirty + 1) * region_size, total_size) - offset;
+						RD::get_singleton()->buffer_update(multimesh->buffer, offset, size, &data[first_dirty * region_floats], false);
+					} else if (run_count > 0) {
+						uint32_t i = first_dirty;
+						while (i <= last_dirty) {
+							if (!multimesh->data_cache_dirty_regions[i]) {
+								i++;
+								continue;
+							}
+							uint32_t run_end = i + 1;
+							while (run_end <= last_dirty && multimesh->data_cache_dirty_regions[run_end]) {
+								run_end++;
+							}
+
 							uint64_t offset = i * region_size;
-							uint64_t size = multimesh->stride_cache * multimesh->instances * sizeof(float);
-							RD::get_singleton()->buffer_update(multimesh->buffer, offset, MIN(region_size, size - offset), &data[i * region_size], false);
+							uint64_t size = MIN((uint64_t)run_end * region_size, total_size) - offset;
+							RD::get_singleton()->buffer_update(multimesh->buffer, offset, size, &data[i * region_floats], false);
+							i = run_end;
 						}
 					}
 				}
@@ -3149,6 +3221,18 @@ int RasterizerStorageRD::skeleton_get_bone_count(RID p_skeleton) const {
 	return skeleton->size;
 }
 
+void RasterizerStorageRD::skeleton_set_buffer(RID p_skeleton, const Vector<float> &p_buffer) {
+	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
+
+	ERR_FAIL_COND(!skeleton);
+	ERR_FAIL_COND(p_buffer.size() != skeleton->data.size());
+
+	//shares the buffer, it only gets copied if single bones are modified afterwards
+	skeleton->data = p_buffer;
+
+	_skeleton_make_dirty(skeleton);
+}
+
 void RasterizerStorageRD::skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform &p_transform) {
 	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
 
@@ -381,6 +381,7 @@ private:
 	_FORCE_INLINE_ void _multimesh_make_local(MultiMesh *multimesh) const;
 	_FORCE_INLINE_ void _multimesh_mark_dirty(MultiMesh *multimesh, int p_index, bool p_aabb);
 	_FORCE_INLINE_ void _multimesh_mark_all_dirty(MultiMesh *multimesh, bool p_data, bool p_aabb);
+	void _multimesh_mark_range_dirty(MultiMesh *multimesh, int p_from, int p_count);
 	_FORCE_INLINE_ void _multimesh_re_create_aabb(MultiMesh *multimesh, const float *p_data, int p_instances);
 	void _update_dirty_multimeshes();
 
@@ -933,6 +934,7 @@ public:
 	Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const;
 
 	void multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_buffer);
+	void multimesh_set_buffer_range(RID p_multimesh, int p_from_instance, const Vector<float> &p_buffer);
 	Vector<float> multimesh_get_buffer(RID p_multimesh) const;
 
 	void multimesh_set_visible_instances(RID p_multimesh, int p_visible);
@@ -999,6 +1001,7 @@ public:
 	RID skeleton_create();
 	void skeleton_allocate(RID p_skeleton, int p_bones, bool p_2d_skeleton = false);
 	void skeleton_set_base_transform_2d(RID p_skeleton, const Transform2D &p_base_transform);
+	void skeleton_set_buffer(RID p_skeleton, const Vector<float> &p_buffer);
 	void skeleton_set_world_transform(RID p_skeleton, bool p_enable, const Transform &p_world_transform);
 	int skeleton_get_bone_count(RID p_skeleton) const;
 	void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform &p_transform);
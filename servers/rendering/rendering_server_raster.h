@@ -277,6 +277,7 @@ public:
 	BIND2RC(Color, multimesh_instance_get_custom_data, RID, int)
 
 	BIND2(multimesh_set_buffer, RID, const Vector<float> &)
+	BIND3(multimesh_set_buffer_range, RID, int, const Vector<float> &)
 	BIND1RC(Vector<float>, multimesh_get_buffer, RID)
 
 	BIND2(multimesh_set_visible_instances, RID, int)
@@ -307,6 +308,7 @@ public:
 	BIND3(skeleton_bone_set_transform_2d, RID, int, const Transform2D &)
 	BIND2RC(Transform2D, skeleton_bone_get_transform_2d, RID, int)
 	BIND2(skeleton_set_base_transform_2d, RID, const Transform2D &)
+	BIND2(skeleton_set_buffer, RID, const Vector<float> &)
 
 	/* Light API */
 
@@ -30,6 +30,7 @@
 
 #include "rendering_server_scene.h"
 
+#include "core/debugger/trace_profiler.h"
 #include "core/os/os.h"
 #include "rendering_server_globals.h"
 #include "rendering_server_raster.h"
@@ -1876,6 +1877,7 @@ void RenderingServerScene::render_camera(RID p_render_buffers, Ref<XRInterface>
 };
 
 void RenderingServerScene::_prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_force_environment, RID p_force_camera_effects, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, bool p_using_shadows) {
+	TRACE_ZONE("RenderingServerScene::_prepare_scene");
 	// Note, in stereo rendering:
 	// - p_cam_transform will be a transform in the middle of our two eyes
 	// - p_cam_projection is a wider frustrum that encompasses both eyes
@@ -2227,6 +2229,7 @@ void RenderingServerScene::_prepare_scene(const Transform p_cam_transform, const
 }
 
 void RenderingServerScene::_render_scene(RID p_render_buffers, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, RID p_force_camera_effects, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass) {
+	TRACE_ZONE("RenderingServerScene::_render_scene");
 	Scenario *scenario = scenario_owner.getornull(p_scenario);
 
 	/* ENVIRONMENT */
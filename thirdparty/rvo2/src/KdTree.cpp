@@ -51,6 +51,44 @@ void KdTree::buildAgentTree(std::vector<Agent *> agents) {
 	}
 }
 
+void KdTree::rebuildAgentTree() {
+    if (!agents_.empty()) {
+        buildAgentTreeRecursive(0, agents_.size(), 0);
+    }
+}
+
+void KdTree::refitAgentTree() {
+    if (!agents_.empty()) {
+        refitAgentTreeRecursive(0);
+    }
+}
+
+void KdTree::refitAgentTreeRecursive(size_t node) {
+    AgentTreeNode &treeNode = agentTree_[node];
+
+    if (treeNode.end - treeNode.begin <= RVO_MAX_LEAF_SIZE) {
+        treeNode.minCoord = agents_[treeNode.begin]->position_;
+        treeNode.maxCoord = agents_[treeNode.begin]->position_;
+
+        for (size_t i = treeNode.begin + 1; i < treeNode.end; ++i) {
+            for (size_t c = 0; c < 3; ++c) {
+                treeNode.maxCoord[c] = std::max(treeNode.maxCoord[c], agents_[i]->position_[c]);
+                treeNode.minCoord[c] = std::min(treeNode.minCoord[c], agents_[i]->position_[c]);
+            }
+        }
+    } else {
+        refitAgentTreeRecursive(treeNode.left);
+        refitAgentTreeRecursive(treeNode.right);
+
+        const AgentTreeNode &left = agentTree_[treeNode.left];
+        const AgentTreeNode &right = agentTree_[treeNode.right];
+        for (size_t c = 0; c < 3; ++c) {
+            treeNode.maxCoord[c] = std::max(left.maxCoord[c], right.maxCoord[c]);
+            treeNode.minCoord[c] = std::min(left.minCoord[c], right.minCoord[c]);
+        }
+    }
+}
+
 void KdTree::buildAgentTreeRecursive(size_t begin, size_t end, size_t node) {
     agentTree_[node].begin = begin;
     agentTree_[node].end = end;
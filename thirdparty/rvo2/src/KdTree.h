@@ -46,6 +46,8 @@
 // Note: Slightly modified to work better with Godot.
 // - Removed `sim_`.
 // - KdTree things are public
+// - Added `rebuildAgentTree` to rebuild the tree in place without reallocating.
+// - Added `refitAgentTree` to update the node bounds without repartitioning.
 namespace RVO {
 class Agent;
 class RVOSimulator;
@@ -102,8 +104,24 @@ public:
 		 */
     void buildAgentTree(std::vector<Agent *> agents);
 
+    /**
+		 * \brief   Rebuilds the agent <i>k</i>d-tree in place, after the agents
+		 *          moved, reusing the agent order of the previous build.
+		 */
+    void rebuildAgentTree();
+
+    /**
+		 * \brief   Updates the node bounds of the agent <i>k</i>d-tree after the
+		 *          agents moved, keeping the partitioning of the last build.
+		 *          Queries stay exact, they only get slower as the partitioning
+		 *          drifts away from the agent positions.
+		 */
+    void refitAgentTree();
+
     void buildAgentTreeRecursive(size_t begin, size_t end, size_t node);
 
+    void refitAgentTreeRecursive(size_t node);
+
     /**
 		 * \brief   Computes the agent neighbors of the specified agent.
 		 * \param   agent    A pointer to the agent for which agent neighbors are to be computed.